@@ -0,0 +1,112 @@
+/**
+ * CArena class
+ *
+ *      A region of memory for objects that all go away together: the
+ * request being answered, the document being parsed. Memory is handed
+ * out from CObjectPool-sized chunks by moving a pointer along, and is
+ * only given back when the arena is reset or destroyed.
+ *      Pooled classes (DEFINE_POOLED_OBJECT and DECLARE_POOLED_OBJECT)
+ * take their objects from the arena while a CArenaScope for it is open
+ * on the thread:
+ *
+ *          CArena arena;
+ *          {
+ *              CArenaScope scope( arena );
+ *              pRequest = new CHttpRequest( address );  // from the arena
+ *              pRequest->parse( stream );               // and its headers
+ *          }
+ *          ...
+ *          delete pRequest;                             // no free()
+ *
+ *      Objects are still deleted as usual, so their destructors run; the
+ * delete just doesn't free anything. An object that outlives its arena
+ * is safe: the arena's chunks are kept until the last of its objects is
+ * deleted. That keeps all of them, though, so scopes should be kept to
+ * code that only makes objects owned by the scope's result.
+ *      Memory from Allocate() isn't counted the same way, and is only good
+ * until the next Reset(). An arena is meant for one thread at a time;
+ * its objects can be deleted on any thread.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_ARENA_H__
+#define IASLIB_ARENA_H__
+
+#include "Object.h"
+#include "ObjectPool.h"
+
+namespace IASLib
+{
+    class CArena : public CObject
+    {
+        public:
+                // The chunks handed out since the last reset, and how many
+                // objects in them are still alive, plus one for the arena
+                // itself while it still owns them.
+            struct Region
+            {
+                CObjectPool::Chunk     *m_pChunks;
+                volatile long           m_nReferences;
+            };
+
+        protected:
+            Region                 *m_pRegion;
+            char                   *m_pNext;
+            char                   *m_pEnd;
+            size_t                  m_nBytesAllocated;
+            size_t                  m_nBytesReserved;
+            unsigned long long      m_ullObjects;
+
+        public:
+                                    CArena( void );
+            virtual                ~CArena( void );
+
+                                    DEFINE_OBJECT( CArena )
+
+            void                   *Allocate( size_t nSize );
+            void                   *AllocateObject( size_t nSize );
+            void                    Reset( void );
+
+            size_t                  GetBytesAllocated( void ) const { return m_nBytesAllocated; }
+            size_t                  GetBytesReserved( void ) const { return m_nBytesReserved; }
+            unsigned long long      GetObjectCount( void ) const { return m_ullObjects; }
+            size_t                  GetLiveObjects( void ) const;
+
+            static void             ReleaseObject( void *p );
+
+            static CArena          *GetCurrent( void );
+            static CArena          *SetCurrent( CArena *pArena );
+
+        protected:
+            bool                    NewRegion( void );
+            void                   *Carve( size_t nSize );
+            static void             ReleaseRegion( Region *pRegion );
+
+        private:
+                                    CArena( const CArena &oSource );
+            CArena                 &operator =( const CArena &oSource );
+    };
+
+        // Makes an arena the thread's current one until the scope ends,
+        // when whichever was current before is put back.
+    class CArenaScope
+    {
+        protected:
+            CArena                 *m_pPrevious;
+
+        public:
+                                    CArenaScope( CArena &arena ) { m_pPrevious = CArena::SetCurrent( &arena ); }
+                                   ~CArenaScope( void ) { CArena::SetCurrent( m_pPrevious ); }
+
+        private:
+                                    CArenaScope( const CArenaScope &oSource );
+            CArenaScope            &operator =( const CArenaScope &oSource );
+    };
+} // End of Namespace IASLib
+
+#endif // IASLIB_ARENA_H__
@@ -123,7 +123,7 @@ namespace IASLib
                                 CDate( const CDate &oSource );
                                 CDate( const char *strSource );
                                 CDate( tm_type &tmSource );
-                                CDate( long lEpochDay, long lMilliseconds ) { m_lEpochDay = lEpochDay; m_lMilliseconds = lMilliseconds; }
+                                CDate( long lEpochDay, long lMilliseconds ) { m_lEpochDay = lEpochDay; m_lMilliseconds = lMilliseconds; m_bIsGMT = true; }
             virtual            ~CDate();
 
                                 DEFINE_OBJECT( CDate )
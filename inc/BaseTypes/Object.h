@@ -147,10 +147,45 @@ namespace IASLib
 #define IMPLEMENT_OBJECT(x,y)
 #endif
 
+    // The pooled variants also give the class an operator new and delete
+    // that take its objects from a CObjectPool of its own (or from the
+    // thread's CArena, inside a CArenaScope), which is worth it for classes
+    // made and thrown away in great numbers. With memory debugging on
+    // they're fenced and checked like any other class instead.
+#ifdef IASLIB_RTTI__
+#ifdef IASLIB_MEMORY_DEBUGGING__
+#define IASLIB_POOLED_OPERATORS(x)
+#endif
+#endif
+
+#ifndef IASLIB_POOLED_OPERATORS
+#define IASLIB_POOLED_OPERATORS(x) static IASLib::CObjectPool *GetObjectPool( void ) \
+                                   { \
+                                       static IASLib::CObjectPool *s_pPool = IASLib::CObjectPool::Create( sizeof( x ), #x ); \
+                                       return s_pPool; \
+                                   } \
+                                   void *operator new( size_t size ) \
+                                   { \
+                                       return GetObjectPool()->Allocate( size ); \
+                                   } \
+                                   void operator delete( void *p, size_t size ) \
+                                   { \
+                                       GetObjectPool()->Release( p, size ); \
+                                   }
+#endif
+
+#define DEFINE_POOLED_OBJECT(x) DEFINE_OBJECT(x) \
+                                IASLIB_POOLED_OPERATORS(x)
+
+#define DECLARE_POOLED_OBJECT(x,y) DECLARE_OBJECT(x,y) \
+                                   IASLIB_POOLED_OPERATORS(x)
+
 #ifdef IASLIB_DEBUG__
 #define ASSERT(x) { if ( !(x) ) IASLib::CObject::CallAssertHandler( __FILE__, __LINE__, #x ); }
 #else
 #define ASSERT(x)
 #endif
 
+#include "ObjectPool.h"
+
 #endif
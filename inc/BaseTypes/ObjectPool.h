@@ -0,0 +1,117 @@
+/**
+ * CObjectPool class
+ *
+ *      A pool of blocks, all the size of one class, for the operator new
+ * and delete that DEFINE_POOLED_OBJECT and DECLARE_POOLED_OBJECT give a
+ * class. Released blocks go on a free list to be handed out again, so a
+ * class that is made and thrown away by the thousand (hash slats, XML
+ * properties, headers) doesn't go to the system allocator every time.
+ *      Each thread keeps a short list of blocks from every pool, filled
+ * from and emptied into the pool a batch at a time, so most allocations
+ * take no lock. The memory itself is carved out of CHUNK_BYTES chunks
+ * that stay with the pool for the life of the process.
+ *      Blocks asked for that are bigger than the pool's (a derived class
+ * that didn't ask for a pool of its own) go to the global operator new,
+ * as do all of a class too big to pool (over MAX_POOLED_BLOCK bytes).
+ *      While a CArenaScope is open on the thread, a pool hands out blocks
+ * from the scope's CArena instead (unless it was made not to). Chunks are
+ * aligned on their own size, with a header saying whose they are, which
+ * is how a block being released finds its way back.
+ *      With IASLIB_MEMORY_DEBUGGING__, pooled classes are fenced and
+ * checked by CObject::allocate() like any other, and no pool is used.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_OBJECTPOOL_H__
+#define IASLIB_OBJECTPOOL_H__
+
+#include "Object.h"
+#include "../Threading/Mutex.h"
+
+namespace IASLib
+{
+    class CObjectPool : public CObject
+    {
+        public:
+            enum
+            {
+                CHUNK_BYTES = 16384,
+                CHUNK_POOL_MAGIC = 0x9001C4C4,
+                CHUNK_ARENA_MAGIC = 0xA7E4C4C4,
+                MAX_POOLED_BLOCK = 2048,
+                MAX_CACHED_POOLS = 64
+            };
+
+                // The front of every chunk, pool's or arena's. The owner is
+                // the pool, or the arena's region.
+            struct Chunk
+            {
+                size_t                  m_nMagic;
+                void                   *m_pOwner;
+                Chunk                  *m_pNext;
+                size_t                  m_nBytes;
+            };
+
+            struct PoolStats
+            {
+                size_t                  m_nBlockSize;
+                size_t                  m_nChunks;
+                size_t                  m_nBytesReserved;
+                size_t                  m_nBlocksCarved;
+                size_t                  m_nFree;
+                unsigned long long      m_ullOversize;
+            };
+
+        protected:
+            const char             *m_strName;
+            size_t                  m_nBlockSize;
+            size_t                  m_nBatch;
+            size_t                  m_nCacheIndex;
+            bool                    m_bUseArenas;
+
+            void                   *m_pFree;
+            size_t                  m_nFree;
+            Chunk                  *m_pChunks;
+            char                   *m_pUnused;
+            char                   *m_pUnusedEnd;
+            size_t                  m_nChunks;
+            size_t                  m_nBlocksCarved;
+            unsigned long long      m_ullOversize;
+            CMutex                  m_mutexPool;
+
+        public:
+                                    CObjectPool( size_t nObjectSize, const char *strName, bool bUseArenas = true );
+            virtual                ~CObjectPool( void );
+
+                                    DEFINE_OBJECT( CObjectPool )
+
+            void                   *Allocate( size_t nSize );
+            void                    Release( void *p, size_t nSize );
+
+            size_t                  GetBlockSize( void ) const { return m_nBlockSize; }
+            const char             *GetName( void ) const { return m_strName; }
+            void                    GetStats( PoolStats &stats );
+
+            size_t                  TakeBatch( void **ppList );
+            void                    GiveBatch( void *pList, size_t nCount );
+
+            static CObjectPool     *Create( size_t nObjectSize, const char *strName, bool bUseArenas = true );
+            static void             ReleaseThreadCaches( void );
+
+            static Chunk           *AllocateChunk( size_t nBytes );
+            static void             ReleaseChunk( Chunk *pChunk );
+            static Chunk           *GetChunk( void *p ) { return (Chunk *)( (size_t)p & ~(size_t)( CHUNK_BYTES - 1 ) ); }
+
+        protected:
+            void                   *TakeBlock( void );
+    };
+} // End of Namespace IASLib
+
+#include "Arena.h"
+
+#endif // IASLIB_OBJECTPOOL_H__
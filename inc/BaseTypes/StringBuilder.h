@@ -0,0 +1,88 @@
+/*
+ * CStringBuilder Class
+ *
+ *      Builds a string a piece at a time in one growing buffer. Appending
+ * to a CString has to make sure the string's stub isn't shared first, and
+ * numbers and formatted text go through a temporary CString (and
+ * Format()'s shared buffer, under a global lock). The builder appends
+ * characters, strings, numbers and printf style formats straight into
+ * its own buffer, which grows geometrically, so building a string of N
+ * characters takes time linear in N. ToString() hands back the result.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_STRINGBUILDER_H__
+#define IASLIB_STRINGBUILDER_H__
+
+#include <stdarg.h>
+#include "Object.h"
+#include "String_.h"
+
+namespace IASLib
+{
+    class CStringBuilder : public CObject
+    {
+        public:
+            enum
+            {
+                DEFAULT_CAPACITY = 64
+            };
+
+        protected:
+            IASLibChar__   *m_strBuffer;
+            size_t          m_nLength;
+            size_t          m_nCapacity;
+
+        public:
+                            CStringBuilder( size_t nCapacity = DEFAULT_CAPACITY );
+                            CStringBuilder( const CStringBuilder &oSource );
+            virtual        ~CStringBuilder( void );
+
+                            DEFINE_OBJECT( CStringBuilder )
+
+            CStringBuilder &Append( const IASLibChar__ *strSource );
+            CStringBuilder &Append( const IASLibChar__ *strSource, size_t nLength );
+            CStringBuilder &Append( const CString &strSource );
+            CStringBuilder &Append( IASLibChar__ chSource );
+            CStringBuilder &Append( IASLibChar__ chSource, size_t nCount );
+
+            CStringBuilder &AppendInt( long long nValue );
+            CStringBuilder &AppendUnsigned( unsigned long long nValue );
+            CStringBuilder &AppendHex( unsigned long long nValue, bool bUpperCase = false );
+            CStringBuilder &AppendDouble( double dValue, int nPrecision = 6 );
+            CStringBuilder &AppendFormat( const IASLibChar__ *strFormat, ... );
+            CStringBuilder &AppendFormatV( const IASLibChar__ *strFormat, va_list vaArgList );
+
+            CStringBuilder &operator +=( const IASLibChar__ *strSource ) { return Append( strSource ); }
+            CStringBuilder &operator +=( const CString &strSource ) { return Append( strSource ); }
+            CStringBuilder &operator +=( IASLibChar__ chSource ) { return Append( chSource ); }
+            CStringBuilder &operator +=( int nSource ) { return AppendInt( nSource ); }
+            CStringBuilder &operator +=( long nSource ) { return AppendInt( nSource ); }
+            CStringBuilder &operator +=( unsigned int nSource ) { return AppendUnsigned( nSource ); }
+            CStringBuilder &operator +=( unsigned long nSource ) { return AppendUnsigned( nSource ); }
+            CStringBuilder &operator +=( double dSource ) { return AppendDouble( dSource ); }
+
+            CStringBuilder &operator =( const CStringBuilder &oSource );
+
+            void            Reserve( size_t nCapacity );
+            void            Truncate( size_t nLength );
+            void            Clear( void ) { Truncate( 0 ); }
+
+            size_t          GetLength( void ) const { return m_nLength; }
+            size_t          GetCapacity( void ) const { return m_nCapacity; }
+            const IASLibChar__ *GetBuffer( void ) const { return ( m_strBuffer ) ? m_strBuffer : ""; }
+                            operator const IASLibChar__ *( void ) const { return GetBuffer(); }
+
+            CString         ToString( void ) const;
+
+        protected:
+            IASLibChar__   *Extend( size_t nLength );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_STRINGBUILDER_H__
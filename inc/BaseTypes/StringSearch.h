@@ -0,0 +1,72 @@
+/*
+ * CStringSearch Class
+ *
+ *      The byte searching underneath CString: finding a character or a
+ * substring, with or without regard to case, and comparing without
+ * regard to case. Every search takes explicit lengths, so nothing has to
+ * be copied or lower-cased first, and embedded nulls are fine.
+ *      On x86 processors the searches run sixteen (SSE2) or thirty-two
+ * (AVX2) bytes at a time, picked when first used; substrings are found by
+ * looking for the needle's first and last bytes together, and only
+ * comparing the rest where both match. Elsewhere, or with acceleration
+ * turned off, plain byte loops do the same work.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_STRINGSEARCH_H__
+#define IASLIB_STRINGSEARCH_H__
+
+#include <stddef.h>
+
+namespace IASLib
+{
+    class CStringSearch
+    {
+        public:
+            enum SearchLevel
+            {
+                LEVEL_UNSELECTED,
+                LEVEL_SCALAR,
+                LEVEL_SSE2,
+                LEVEL_AVX2
+            };
+
+                // Every search returns an offset from pHaystack, or
+                // IASLib::NOT_FOUND.
+            static size_t       FindChar( const char *pHaystack, size_t nLength, char chFind );
+            static size_t       FindCharNoCase( const char *pHaystack, size_t nLength, char chFind );
+            static size_t       Find( const char *pHaystack, size_t nLength, const char *pNeedle, size_t nNeedle );
+            static size_t       FindNoCase( const char *pHaystack, size_t nLength, const char *pNeedle, size_t nNeedle );
+
+            static bool         EqualsNoCase( const char *pFirst, const char *pSecond, size_t nLength );
+            static char         ToLower( char chSource ) { return (char)s_achLower[ (unsigned char)chSource ]; }
+
+            static void         SetAcceleration( bool bEnable );
+            static const char  *GetImplementation( void );
+
+        protected:
+            static SearchLevel  s_eLevel;
+            static const unsigned char s_achLower[256];
+
+            static SearchLevel  GetLevel( void ) { return ( s_eLevel != LEVEL_UNSELECTED ) ? s_eLevel : SelectLevel( true ); }
+            static SearchLevel  SelectLevel( bool bEnable );
+
+            static size_t       FindCharScalar( const char *pHaystack, size_t nLength, char chFind, char chOther );
+            static size_t       FindScalar( const char *pHaystack, size_t nLength, const char *pNeedle, size_t nNeedle, bool bNoCase );
+            static bool         EqualsNoCaseScalar( const char *pFirst, const char *pSecond, size_t nLength );
+
+            static size_t       FindCharSse2( const char *pHaystack, size_t nLength, char chFind, char chOther );
+            static size_t       FindSse2( const char *pHaystack, size_t nLength, const char *pNeedle, size_t nNeedle, bool bNoCase );
+            static bool         EqualsNoCaseSse2( const char *pFirst, const char *pSecond, size_t nLength );
+
+            static size_t       FindCharAvx2( const char *pHaystack, size_t nLength, char chFind, char chOther );
+            static size_t       FindAvx2( const char *pHaystack, size_t nLength, const char *pNeedle, size_t nNeedle, bool bNoCase );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_STRINGSEARCH_H__
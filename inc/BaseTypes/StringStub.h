@@ -37,6 +37,13 @@ namespace IASLib
     class CStringStub
     {
         public:
+            enum
+            {
+                    // Buffers bigger than this are given back when the
+                    // string shrinks to under a quarter of them.
+                SHRINK_THRESHOLD = 1024
+            };
+
             IASLibChar__  *m_strData;
             size_t      m_nLength;
             size_t      m_nSize;
@@ -57,12 +64,25 @@ namespace IASLib
                         CStringStub( const CStringStub &oSource );// throw (CException);
             virtual    ~CStringStub( void );
 
+#ifndef IASLIB_MEMORY_DEBUGGING__
+                // Stubs come from a pool of their own, which never uses
+                // arenas: strings are shared far too freely for a stub to
+                // be trusted to go away with the scope it was made in.
+            void       *operator new( size_t size );
+            void        operator delete( void *p, size_t size );
+#endif
+
             void        AddRef( void );
             void        RemoveRef( void );// throw (CException);
 
             int         GetRefCount( void );
 
             void        ChangeSize( size_t nLength );
+            void        Reserve( size_t nCapacity );
+            size_t      GetCapacity( void ) const;
+
+        protected:
+            void        Reallocate( size_t nSize );
     };
 }
 
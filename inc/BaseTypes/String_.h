@@ -248,6 +248,10 @@ namespace IASLib
 
             void        Clear( void );
 
+                            // Make room for the string to grow without being reallocated
+            void        Reserve( size_t nCapacity );
+            size_t      GetCapacity( void ) const;
+
             static CString FormatString( const char *fmt, ... );
 
             virtual int hashcode( void );
@@ -58,12 +58,22 @@ namespace IASLib
             CString getPrevHash( void ) { return sPrevHash; }
         
             CString getHash( void );
+
+            uint32_t getIndex( void ) const { return _nIndex; }
+            int64_t getNonce( void ) const { return _nNonce; }
+            CString getData( void ) const { return _sData; }
+            const CDate &getTime( void ) const { return _tTime; }
         
-            void mineBlock(uint32_t nDifficulty);
+            bool mineBlock(uint32_t nDifficulty, size_t nThreads = 0);
+
+            bool isValid( void ) const { return calculateHash() == _sHash; }
 
         private:
+            CBlock(uint32_t nIndexIn, const CString &sDataIn, const CDate &tTimeIn, int64_t nNonceIn, const CString &sPrevHashIn, const CString &sHashIn);
+
             CString calculateHash() const;
             friend class CBlockchain;
+            friend class CBlockStore;
             void setPreviousHash( CString hash ) { sPrevHash = hash; }
     };
 } // namespace IASLib
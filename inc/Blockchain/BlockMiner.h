@@ -0,0 +1,89 @@
+/**
+ *  Block Miner Class
+ *
+ *      Searches for a nonce that gives a block a hash with the required
+ * number of leading zero hex digits. The part of the block's text that
+ * comes before the nonce never changes, so it's hashed once and the
+ * SHA256 state saved; each try only hashes the rest. The nonce space is
+ * split across threads, which all stop as soon as one of them finds an
+ * answer, and the difficulty is checked on the raw digest bytes.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_BLOCKMINER_H__
+#define IASLIB_BLOCKMINER_H__
+
+#include "BaseTypes/String_.h"
+#include "Encryption/Sha256.h"
+#include "Threading/Mutex.h"
+#include "Threading/Thread.h"
+#include "Blockchain/Block.h"
+
+namespace IASLib
+{
+    class CBlockMiner : public CObject
+    {
+        protected:
+            enum
+            {
+                CHECK_INTERVAL = 1024
+            };
+
+            CSHA256         m_ctxPrefix;
+            CString         m_strSuffix;
+            uint32_t        m_nDifficulty;
+
+            CMutex          m_mutexResult;
+            bool            m_bFound;
+            int64_t         m_nNonce;
+            uint8           m_aDigest[CSHA256::DIGEST_SIZE];
+            uint64          m_ullHashes;
+
+        public:
+                            CBlockMiner( const CString &strPrefix, const CString &strSuffix, uint32_t nDifficulty );
+            virtual        ~CBlockMiner( void );
+
+                            DEFINE_OBJECT( CBlockMiner )
+
+            bool            Mine( int64_t nStartNonce, size_t nThreads = 0 );
+
+            int64_t         GetNonce( void ) { return m_nNonce; }
+            const uint8    *GetDigest( void ) { return m_aDigest; }
+            uint64          GetHashCount( void ) { return m_ullHashes; }
+
+            void            Search( int64_t nFirstNonce, int64_t nStride );
+
+            static bool     MeetsDifficulty( const uint8 *pDigest, uint32_t nDifficulty );
+            static size_t   FormatNonce( int64_t nNonce, char *strBuffer );
+
+        protected:
+            bool            IsFound( void );
+            void            Found( int64_t nNonce, const uint8 *pDigest, uint64 ullHashes );
+            void            Searched( uint64 ullHashes );
+    };
+
+#ifdef IASLIB_MULTI_THREADED__
+    class CBlockMinerThread : public CThread
+    {
+        protected:
+            CBlockMiner    *m_pMiner;
+            int64_t         m_nFirstNonce;
+            int64_t         m_nStride;
+
+        public:
+                            CBlockMinerThread( CBlockMiner *pMiner, int64_t nFirstNonce, int64_t nStride );
+            virtual        ~CBlockMinerThread( void );
+
+                            DEFINE_OBJECT( CBlockMinerThread )
+
+            virtual void   *Run( void );
+    };
+#endif // IASLIB_MULTI_THREADED__
+} // namespace IASLib
+
+#endif // IASLIB_BLOCKMINER_H__
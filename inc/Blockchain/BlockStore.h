@@ -0,0 +1,177 @@
+/**
+ *  Block Store Class
+ *
+ *      Keeps a chain's blocks on disk, so a chain survives a restart
+ * without being mined again. Blocks are only ever appended, each one
+ * written as a length prefixed record to the end of the current segment
+ * file (blocks-00000.dat, blocks-00001.dat, ...); once a segment reaches
+ * its size limit, a new one is started.
+ *      Segments are read through memory maps. Two indexes are kept in
+ * memory: by height (the block's position in the chain), and by hash, an
+ * open addressed table of hash codes pointing into the height index, so a
+ * block can be found by either in constant time. Both are rebuilt when
+ * the store is opened, by scanning the segments; the scan also checks
+ * every block's hash, and runs on several threads, a segment at a time.
+ * A torn record at the end of the last segment (from a crash mid-write)
+ * is cut off; damage anywhere else fails the open.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_BLOCKSTORE_H__
+#define IASLIB_BLOCKSTORE_H__
+
+#include "BaseTypes/String_.h"
+#include "Threading/Mutex.h"
+#include "Threading/Thread.h"
+#include "Blockchain/Block.h"
+
+#ifndef IASLIB_WIN32__
+
+namespace IASLib
+{
+    class CBlockStore : public CObject
+    {
+        public:
+            enum
+            {
+                RECORD_MAGIC = 0x42534149,          // "IASB"
+                RECORD_HEADER_SIZE = 8,
+                DEFAULT_SEGMENT_SIZE = 64 * 1024 * 1024
+            };
+
+        protected:
+                // Where a block's record is: its segment and offset
+            struct Location
+            {
+                uint32_t        m_nSegment;
+                uint64_t        m_nOffset;
+            };
+
+            struct HashSlot
+            {
+                uint64_t        m_nHashCode;
+                size_t          m_nHeight;
+            };
+
+            struct Segment
+            {
+                int             m_hFile;
+                uint8_t        *m_pMap;
+                size_t          m_nMapped;
+                size_t          m_nSize;
+
+                    // Filled in by the scan at open
+                uint64_t       *m_anOffsets;
+                size_t          m_nRecords;
+                size_t          m_nCapacity;
+                size_t          m_nGoodSize;
+                bool            m_bDamaged;
+            };
+
+                // A record, read in place from a segment's map
+            struct Record
+            {
+                uint32_t        m_nIndex;
+                int64_t         m_nNonce;
+                int32_t         m_nEpochDay;
+                int32_t         m_nMilliseconds;
+                const char     *m_pPrevHash;
+                uint32_t        m_nPrevHash;
+                const char     *m_pHash;
+                uint32_t        m_nHash;
+                const char     *m_pData;
+                uint32_t        m_nData;
+                size_t          m_nRecordSize;
+            };
+
+            CString             m_strDirectory;
+            size_t              m_nSegmentLimit;
+            bool                m_bSyncWrites;
+            bool                m_bOpen;
+
+            Segment            *m_aSegments;
+            size_t              m_nSegments;
+
+            Location           *m_aHeights;
+            size_t              m_nHeights;
+            size_t              m_nHeightCapacity;
+
+            HashSlot           *m_aHashSlots;
+            size_t              m_nHashSlots;
+
+            CString             m_strLastError;
+            CMutex              m_mutexStore;
+
+        public:
+                                CBlockStore( void );
+            virtual            ~CBlockStore( void );
+
+                                DEFINE_OBJECT( CBlockStore )
+
+            bool                Open( const char *strDirectory, size_t nThreads = 0 );
+            void                Close( void );
+            bool                Sync( void );
+
+            bool                Append( CBlock *pBlock );
+
+            size_t              GetHeight( void );
+            CBlock             *GetBlock( size_t nHeight );
+            CBlock             *FindBlock( const char *strHash );
+            bool                FindHeight( const char *strHash, size_t &nHeight );
+
+            void                SetSegmentLimit( size_t nBytes ) { m_nSegmentLimit = nBytes; }
+            void                SetSyncWrites( bool bSync ) { m_bSyncWrites = bSync; }
+            size_t              GetSegmentCount( void ) { return m_nSegments; }
+            const char         *GetLastError( void ) { return (const char *)m_strLastError; }
+
+            void                ScanSegment( size_t nSegment );
+
+            static uint64_t     HashCode( const char *pHash, size_t nLength );
+
+        protected:
+            bool                OpenSegment( size_t nSegment, bool bCreate );
+            bool                MapSegment( Segment &segment );
+            void                CloseSegment( Segment &segment );
+            CString             GetSegmentPath( size_t nSegment );
+
+            bool                ReadRecord( size_t nHeight, Record &record );
+            static bool         ParseRecord( const uint8_t *pRecord, size_t nAvailable, Record &record );
+            static bool         CheckHash( const Record &record );
+            CBlock             *MakeBlock( const Record &record );
+
+            void                AddHeight( uint32_t nSegment, uint64_t nOffset );
+            void                AddHash( const char *pHash, size_t nLength, size_t nHeight );
+            bool                LookupHash( const char *pHash, size_t nLength, size_t &nHeight );
+            void                GrowHashSlots( void );
+    };
+
+#ifdef IASLIB_MULTI_THREADED__
+    class CBlockStoreScanner : public CThread
+    {
+        protected:
+            CBlockStore        *m_pStore;
+            size_t              m_nFirst;
+            size_t              m_nLast;
+            size_t              m_nStride;
+            volatile bool       m_bFinished;
+
+        public:
+                                CBlockStoreScanner( CBlockStore *pStore, size_t nFirst, size_t nLast, size_t nStride );
+            virtual            ~CBlockStoreScanner( void );
+
+                                DEFINE_OBJECT( CBlockStoreScanner )
+
+            virtual void       *Run( void );
+
+            bool                IsFinished( void ) { return m_bFinished; }
+    };
+#endif // IASLIB_MULTI_THREADED__
+} // namespace IASLib
+
+#endif // IASLIB_WIN32__
+#endif // IASLIB_BLOCKSTORE_H__
@@ -23,6 +23,7 @@
 #include "BaseTypes/Date.h"
 #include "Collections/Array.h"
 #include "Blockchain/Block.h"
+#include "Blockchain/BlockStore.h"
 
 namespace IASLib
 {
@@ -31,14 +32,35 @@ namespace IASLib
         private:
             __uint32_t m_nDifficulty;
             CArray   m_aChain;
+#ifndef IASLIB_WIN32__
+                // A persistent chain keeps its blocks in the store, and
+                // only the last one in memory.
+            CBlockStore *m_pStore;
+            CBlock     *m_pLastBlock;
+            CString     m_strStoreError;
+#endif
 
         public:
             DECLARE_OBJECT( CBlockchain, CObject );
 
             CBlockchain();
             CBlockchain( __uint32_t difficulty );
+#ifndef IASLIB_WIN32__
+            CBlockchain( const char *strDirectory, __uint32_t difficulty = 6 );
+#endif
+            virtual ~CBlockchain();
 
-            void addBlock(CBlock *bNew);
+            bool addBlock(CBlock *bNew);
+
+            size_t getLength();
+            CBlock *getBlock( size_t nHeight );
+            CBlock *findBlock( const char *strHash );
+
+            bool isPersistent() const;
+#ifndef IASLIB_WIN32__
+            CBlockStore *getStore() { return m_pStore; }
+            const CString &getStoreError() const { return m_strStoreError; }
+#endif
 
         private:
             CBlock *getLastBlock() const;
@@ -47,8 +47,8 @@ namespace IASLib
              */
             virtual const char *computeHash() const = 0;
         public:
-            MerkleNode( const MerkleNode *_left, MerkleNode *_right ) : left(_left), right(_right), value(nullptr), hash( nullptr ) {}
-            MerkleNode( const T &_value ) : value( new T(value) ), left(nullptr), right(nullptr), hash( hash_func(value)) {}
+            MerkleNode( const MerkleNode *_left, MerkleNode *_right ) : hash( nullptr ), left(_left), right(_right), value(nullptr) {}
+            MerkleNode( const T &_value ) : hash( hash_func(_value) ), left(nullptr), right(nullptr), value( new T(_value) ) {}
 
             virtual ~MerkleNode() {}
 
@@ -0,0 +1,148 @@
+/**
+ *  Merkle Tree Class
+ *
+ *      A Merkle tree of SHA256 hashes, kept level by level in flat arrays
+ * rather than as a tree of nodes: level zero holds the leaf hashes, and
+ * each level above holds the hashes of the pairs below it, so the root is
+ * the one hash on the top level. As with MerkleNode, a parent is the hash
+ * of its children's hashes concatenated, and an unpaired node at the end
+ * of a level is paired with itself.
+ *      Appending a leaf or changing one only rehashes the path from that
+ * leaf to the root. A whole batch of leaves can be built in one go, with
+ * each level's hashes split across threads. An inclusion proof is the
+ * sibling hash at each level, which is all a verifier needs (along with
+ * the leaf and the root) to check that the leaf is in the tree.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_MERKLETREE_H__
+#define IASLIB_MERKLETREE_H__
+
+#include "BaseTypes/Object.h"
+#include "Encryption/Sha256.h"
+#include "Threading/Thread.h"
+
+namespace IASLib
+{
+    class CMerkleProof : public CObject
+    {
+        public:
+            enum
+            {
+                MAX_DEPTH = 64
+            };
+
+        protected:
+            size_t          m_nLeaf;
+            size_t          m_nDepth;
+            uint8           m_aaSiblings[MAX_DEPTH][CSHA256::DIGEST_SIZE];
+
+        public:
+                            CMerkleProof( void );
+            virtual        ~CMerkleProof( void );
+
+                            DEFINE_OBJECT( CMerkleProof )
+
+            bool            Verify( const uint8 *pLeafHash, const uint8 *pRoot ) const;
+
+            size_t          GetLeaf( void ) const { return m_nLeaf; }
+            size_t          GetDepth( void ) const { return m_nDepth; }
+            const uint8    *GetSibling( size_t nLevel ) const { return m_aaSiblings[nLevel]; }
+
+            size_t          GetSerializedSize( void ) const { return 9 + m_nDepth * CSHA256::DIGEST_SIZE; }
+            size_t          Serialize( uint8 *pBuffer ) const;
+            bool            Deserialize( const uint8 *pBuffer, size_t nLength );
+
+        protected:
+            friend class CMerkleTree;
+    };
+
+    class CMerkleTree : public CObject
+    {
+        public:
+            enum
+            {
+                MAX_LEVELS = CMerkleProof::MAX_DEPTH + 1,
+                PARALLEL_THRESHOLD = 8192
+            };
+
+        protected:
+            struct Level
+            {
+                uint8          *m_pHashes;
+                size_t          m_nCount;
+                size_t          m_nCapacity;
+            };
+
+            Level           m_aLevels[MAX_LEVELS];
+            size_t          m_nLevels;
+
+        public:
+                            CMerkleTree( void );
+            virtual        ~CMerkleTree( void );
+
+                            DEFINE_OBJECT( CMerkleTree )
+
+            void            Clear( void );
+
+            size_t          Append( const void *pData, size_t nLength );
+            size_t          AppendHash( const uint8 *pLeafHash );
+            bool            Update( size_t nLeaf, const void *pData, size_t nLength );
+            bool            UpdateHash( size_t nLeaf, const uint8 *pLeafHash );
+
+            void            Build( const uint8 * const *apData, const size_t *anLengths, size_t nLeaves, size_t nThreads = 0 );
+            void            BuildFromHashes( const uint8 *pLeafHashes, size_t nLeaves, size_t nThreads = 0 );
+
+            size_t          GetLeafCount( void ) const { return ( m_nLevels ) ? m_aLevels[0].m_nCount : 0; }
+            size_t          GetDepth( void ) const { return ( m_nLevels ) ? m_nLevels - 1 : 0; }
+            const uint8    *GetLeafHash( size_t nLeaf ) const;
+            bool            GetRoot( uint8 *pRoot ) const;
+
+            bool            GetProof( size_t nLeaf, CMerkleProof &proof ) const;
+            size_t          GetProofs( const size_t *anLeaves, size_t nCount, CMerkleProof *aProofs ) const;
+
+            static void     HashPair( const uint8 *pLeft, const uint8 *pRight, uint8 *pParent );
+            static void     HashLevel( const uint8 *pChildren, size_t nChildren, uint8 *pParents, size_t nFirst, size_t nLast );
+
+        protected:
+            void            Reserve( size_t nLevel, size_t nCount );
+            void            RehashPath( size_t nLeaf );
+            void            BuildLevels( size_t nThreads );
+
+            static size_t   GetThreadCount( size_t nThreads, size_t nItems );
+    };
+
+#ifdef IASLIB_MULTI_THREADED__
+        // Hashes one slice of a level, either leaves from their data or
+        // parents from the level below.
+    class CMerkleHashThread : public CThread
+    {
+        protected:
+            const uint8 * const *m_apData;
+            const size_t   *m_anLengths;
+            const uint8    *m_pChildren;
+            size_t          m_nChildren;
+            uint8          *m_pHashes;
+            size_t          m_nFirst;
+            size_t          m_nLast;
+            volatile bool   m_bFinished;
+
+        public:
+                            CMerkleHashThread( const uint8 * const *apData, const size_t *anLengths, uint8 *pLeafHashes, size_t nFirst, size_t nLast );
+                            CMerkleHashThread( const uint8 *pChildren, size_t nChildren, uint8 *pParents, size_t nFirst, size_t nLast );
+            virtual        ~CMerkleHashThread( void );
+
+                            DEFINE_OBJECT( CMerkleHashThread )
+
+            virtual void   *Run( void );
+            void            Finish( void );
+    };
+#endif // IASLIB_MULTI_THREADED__
+} // namespace IASLib
+
+#endif // IASLIB_MERKLETREE_H__
@@ -31,7 +31,7 @@ namespace IASLib
                         CHashSlat( const char *strKey, CObject *pElement );
             virtual    ~CHashSlat( void );
 
-                        DEFINE_OBJECT( CHashSlat )
+                        DEFINE_POOLED_OBJECT( CHashSlat )
 
             CObject    *GetElement( void ) { return m_pElement; }
             void        SetElement( CObject *pElement, bool bDeleteCurrent )
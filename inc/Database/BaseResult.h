@@ -21,6 +21,7 @@
 #define IASLIB_BASERESULT_H__
 
 #include "../Collections/StringArray.h"
+#include "../BaseTypes/Date.h"
 #include <stdlib.h>
 
 #ifdef IASLIB_DATABASE__
@@ -29,6 +30,17 @@ namespace IASLib
 {
     class CBaseResult : public CObject
     {
+        public:
+                // The native type of a value, for results that keep them
+            enum ColumnType
+            {
+                COLUMN_NULL,
+                COLUMN_INTEGER,
+                COLUMN_FLOAT,
+                COLUMN_TEXT,
+                COLUMN_BLOB
+            };
+
         protected:
             size_t              m_nColumns;
             size_t              m_nRows;
@@ -38,6 +50,18 @@ namespace IASLib
             size_t              m_nCurrentRow;
             bool                m_bValid;
 
+                // Column names as callers have spelled them, resolved to
+                // their index the first time each is asked for.
+            struct ColumnLookup
+            {
+                CString         m_strName;
+                size_t          m_nIndex;
+            };
+
+            ColumnLookup       *m_aLookups;
+            size_t              m_nLookups;
+            size_t              m_nNextLookup;
+
         public:
                                 CBaseResult( void );
             virtual            ~CBaseResult( void );
@@ -61,9 +85,32 @@ namespace IASLib
 
             virtual CString     operator []( size_t nColumn );
 
+            virtual ColumnType  GetColumnType( size_t nColumn );
+            virtual bool        IsNull( size_t nColumn );
+            virtual long long   GetInt64( size_t nColumn );
+            virtual double      GetDouble( size_t nColumn );
+            virtual CDate       GetDate( size_t nColumn );
+            virtual const void *GetBlob( size_t nColumn, size_t &nLength );
+
+            bool                IsNull( const char *pszColumn ) { return IsNull( FindColumn( pszColumn ) ); }
+            long long           GetInt64( const char *pszColumn ) { return GetInt64( FindColumn( pszColumn ) ); }
+            double              GetDouble( const char *pszColumn ) { return GetDouble( FindColumn( pszColumn ) ); }
+            CDate               GetDate( const char *pszColumn ) { return GetDate( FindColumn( pszColumn ) ); }
+            const void         *GetBlob( const char *pszColumn, size_t &nLength ) { return GetBlob( FindColumn( pszColumn ), nLength ); }
+
             virtual bool        IsColumn( const char *pszColumn );
+            virtual size_t      FindColumn( const char *pszColumn );
 
             virtual bool        SetRow( size_t nRow );
+
+                // Forward-only results can't go back with Prev() or SetRow(),
+                // and don't know how many rows they have until the end.
+            virtual bool        IsForwardOnly( void ) { return false; }
+
+            static CDate        ParseDate( const char *strValue );
+
+        protected:
+            void                ResetColumnIndex( void );
     };
 } // namespace IASLib
 
@@ -30,6 +30,7 @@
 #define BULK_TYPE_CHAR      3
 #define BULK_TYPE_DATE      4
 #define BULK_TYPE_VARCHAR   5
+#define BULK_TYPE_INT64     6
 
 namespace IASLib
 {
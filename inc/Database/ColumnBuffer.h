@@ -0,0 +1,79 @@
+/*
+ *  Column Buffer Class
+ *
+ *  Holds one column of a result set, every row's value in its native
+ * type. Numbers are kept as numbers, in one array of fixed size slots,
+ * and text and blobs are packed end to end in a single growing block of
+ * characters, so a result of any size costs a handful of allocations per
+ * column, instead of an object per value.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_COLUMNBUFFER_H__
+#define IASLIB_COLUMNBUFFER_H__
+
+#include "BaseResult.h"
+
+#ifdef IASLIB_DATABASE__
+
+namespace IASLib
+{
+    class CColumnBuffer : public CObject
+    {
+        protected:
+                // One value: a number, or where its bytes start in the
+                // character block, and how many there are.
+            struct Slot
+            {
+                union
+                {
+                    long long   m_nInteger;
+                    double      m_dFloat;
+                    size_t      m_nOffset;
+                };
+                size_t          m_nLength;
+            };
+
+            unsigned char      *m_anTypes;
+            Slot               *m_aSlots;
+            size_t              m_nRows;
+            size_t              m_nCapacity;
+
+            char               *m_pchData;
+            size_t              m_nDataLength;
+            size_t              m_nDataCapacity;
+
+        public:
+                                CColumnBuffer( void );
+            virtual            ~CColumnBuffer( void );
+
+                                DEFINE_OBJECT( CColumnBuffer )
+
+            void                AppendNull( void );
+            void                AppendInt64( long long nValue );
+            void                AppendDouble( double dValue );
+            void                AppendText( const char *pchValue, size_t nLength );
+            void                AppendBlob( const void *pData, size_t nLength );
+
+            size_t              Rows( void ) { return m_nRows; }
+            void                Clear( void );
+
+            CBaseResult::ColumnType GetType( size_t nRow );
+            long long           GetInt64( size_t nRow );
+            double              GetDouble( size_t nRow );
+            const char         *GetText( size_t nRow, size_t &nLength );
+
+        protected:
+            Slot               &NewSlot( CBaseResult::ColumnType eType );
+            size_t              AppendData( const void *pData, size_t nLength );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_DATABASE__
+
+#endif // IASLIB_COLUMNBUFFER_H__
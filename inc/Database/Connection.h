@@ -21,6 +21,7 @@
 #include "../Streams/Stream.h"
 #include "StoredProc.h"
 #include "Cursor.h"
+#include "PreparedStatement.h"
 
 #ifdef IASLIB_DATABASE__
 
@@ -47,6 +48,9 @@ namespace IASLib
             virtual bool            IsValid( void ) { return ( ( Connected() ) && ( ! IsDead() ) ); }
 
             virtual CCursor        *Cursor( const char *strQueryString, bool bUpdatable = false ) = 0;
+
+                // Databases that can't stream a result just buffer it
+            virtual CCursor        *ForwardCursor( const char *strQueryString ) { return Cursor( strQueryString ); }
             virtual bool            Execute( const char *strExecString ) = 0;
 
             virtual int             MajorErrorCode( void ) = 0;
@@ -61,6 +65,9 @@ namespace IASLib
 
             virtual CStoredProc    *StoredProc( const char *strProcCall, const char *strParamList = NULL ) = 0;
 
+                // Databases without prepared statement support return NULL
+            virtual CPreparedStatement *Prepare( const char *strSQL ) { strSQL = strSQL; return NULL; }
+
             virtual bool            IsDead( void ) = 0;
 
 		    virtual int				GetDBType( void ) = 0;
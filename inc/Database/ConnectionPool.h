@@ -0,0 +1,128 @@
+/*
+ *  Connection Pool Class
+ *
+ *  Keeps a bounded set of open connections to one database that threads
+ * borrow with Acquire() and hand back with Return(), instead of opening
+ * and releasing a connection for every piece of work. The pool opens
+ * connections as they're needed, up to its maximum size, after which
+ * Acquire() waits (forever, for a while, or not at all) for another
+ * thread to return one.
+ *  Connections are checked with IsDead() when they're borrowed, and dead
+ * ones are closed and replaced. Connections that sit idle for longer than
+ * the idle timeout are closed, down to the pool's minimum size. The most
+ * recently returned connection is always lent out first, so the cold ones
+ * are the ones that age out.
+ *  A borrowed connection belongs to the pool: hand it back with Return()
+ * (passing bDiscard if it's no longer usable), never Release() it.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_CONNECTIONPOOL_H__
+#define IASLIB_CONNECTIONPOOL_H__
+
+#include "../BaseTypes/String_.h"
+#include "../Threading/Mutex.h"
+#include "../Threading/Semaphore.h"
+#include "Connection.h"
+
+#ifdef IASLIB_DATABASE__
+#ifdef IASLIB_MULTI_THREADED__
+
+namespace IASLib
+{
+    class CDatabase;
+
+    class CConnectionPool : public CObject
+    {
+        public:
+            enum
+            {
+                DEFAULT_IDLE_TIMEOUT = 60000
+            };
+
+                // Counters since the pool was created (or ResetStats()).
+                // Waits are acquires that found the pool full; wait times
+                // are in microseconds.
+            struct PoolStats
+            {
+                unsigned long long  m_ullAcquires;
+                unsigned long long  m_ullWaits;
+                unsigned long long  m_ullTimeouts;
+                unsigned long long  m_ullTotalWaitMicros;
+                unsigned long long  m_ullMaxWaitMicros;
+                unsigned long long  m_ullCreated;
+                unsigned long long  m_ullDiscarded;
+                unsigned long long  m_ullEvicted;
+            };
+
+        protected:
+            struct IdleConnection
+            {
+                CConnection        *m_pConnection;
+                unsigned long long  m_ullReturned;
+            };
+
+            CDatabase              *m_pDatabase;
+            CString                 m_strDBName;
+            CString                 m_strUserName;
+            CString                 m_strPassword;
+            CString                 m_strApplication;
+            CString                 m_strName;
+
+            size_t                  m_nMinSize;
+            size_t                  m_nMaxSize;
+            unsigned long           m_ulIdleTimeout;
+
+                // Idle connections, oldest first
+            IdleConnection         *m_aIdle;
+            size_t                  m_nIdle;
+            size_t                  m_nOpen;
+
+            PoolStats               m_stats;
+
+            CMutex                  m_mutexPool;
+            CMutex                  m_mutexConnect;
+            CSemaphore              m_semSlots;
+
+        public:
+                                    CConnectionPool( CDatabase *pDatabase, const char *strDBName, const char *strUserName, const char *strPassword, const char *strApplication, const char *strName, size_t nMinSize, size_t nMaxSize, unsigned long ulIdleTimeout = DEFAULT_IDLE_TIMEOUT );
+            virtual                ~CConnectionPool( void );
+
+                                    DEFINE_OBJECT( CConnectionPool )
+
+            bool                    Fill( void );
+
+            CConnection            *Acquire( long lTimeout = -1 );
+            bool                    Return( CConnection *pConnection, bool bDiscard = false );
+
+            size_t                  EvictIdle( void );
+
+            size_t                  GetMinSize( void ) { return m_nMinSize; }
+            size_t                  GetMaxSize( void ) { return m_nMaxSize; }
+            unsigned long           GetIdleTimeout( void ) { return m_ulIdleTimeout; }
+            void                    SetIdleTimeout( unsigned long ulIdleTimeout ) { m_ulIdleTimeout = ulIdleTimeout; }
+
+            size_t                  GetOpenCount( void );
+            size_t                  GetIdleCount( void );
+            size_t                  GetInUseCount( void );
+            PoolStats               GetStats( void );
+            void                    ResetStats( void );
+
+            static unsigned long long GetMicroseconds( void );
+
+        protected:
+            CConnection            *Open( void );
+            void                    Close( CConnection *pConnection );
+            bool                    IsBorrowedLocked( CConnection *pConnection );
+            size_t                  EvictLocked( unsigned long long ullNow, CConnection **apEvicted );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_MULTI_THREADED__
+#endif // IASLIB_DATABASE__
+#endif // IASLIB_CONNECTIONPOOL_H__
@@ -21,6 +21,7 @@
 #include "ConnectionArray.h"
 #include "Connection.h"
 #include "BulkCopyConnection.h"
+#include "ConnectionPool.h"
 
 #ifdef IASLIB_DATABASE__
 
@@ -43,10 +44,13 @@ namespace IASLib
             int                             m_nConnections;
             CConnectionArray                m_aConnections;
             CString                         m_strVendor;
+#ifdef IASLIB_MULTI_THREADED__
+            CConnectionPool                *m_pPool;
+#endif
         public:
                                             CDatabase( void );
                                             CDatabase( const char *strVendor );
-            virtual                        ~CDatabase( void ) {};
+            virtual                        ~CDatabase( void );
 
                                             DEFINE_OBJECT( CDatabase )
 
@@ -70,6 +74,15 @@ namespace IASLib
             virtual int                     ReleaseConnection( CConnection *pCon ) = 0;
 
             virtual bool                    SetTimeout( int nTimeout ) = 0;
+
+#ifdef IASLIB_MULTI_THREADED__
+                // Connection pooling
+            bool                            CreatePool( const char *strDBName, const char *strUserName, const char *strPassword, size_t nMinSize, size_t nMaxSize, unsigned long ulIdleTimeout = CConnectionPool::DEFAULT_IDLE_TIMEOUT, const char *strApplication = "", const char *strName = "Pooled" );
+            CConnection                    *AcquireConnection( long lTimeout = -1 );
+            bool                            ReturnConnection( CConnection *pCon, bool bDiscard = false );
+            CConnectionPool                *GetPool( void ) { return m_pPool; }
+            void                            ClosePool( void );
+#endif
     };
 } // namespace IASLib
 
@@ -0,0 +1,65 @@
+/*
+ *  Prepared Statement Class
+ *
+ *  Abstract base class for a statement that is compiled once by the
+ * database and then executed any number of times with different values
+ * bound to its parameters. Values are bound, not spliced into the SQL
+ * text, so they never need escaping.
+ *  Parameters are numbered from 1, in the order their placeholders
+ * appear in the statement (the same as the database's own numbering).
+ *  Statements come from CConnection::Prepare(), and are handed back with
+ * Close() so that the connection can keep the compiled statement for the
+ * next caller with the same SQL. A statement must be closed before its
+ * connection is released.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_PREPAREDSTATEMENT_H__
+#define IASLIB_PREPAREDSTATEMENT_H__
+
+#include "Cursor.h"
+
+#ifdef IASLIB_DATABASE__
+
+namespace IASLib
+{
+    class CPreparedStatement : public CObject
+    {
+        public:
+                                CPreparedStatement( void ) {}
+            virtual            ~CPreparedStatement( void ) {}
+
+                                DECLARE_OBJECT( CPreparedStatement, CObject )
+
+            virtual const char *GetSQL( void ) = 0;
+            virtual size_t      ParameterCount( void ) = 0;
+            virtual size_t      ParameterIndex( const char *strName ) = 0;
+
+            virtual bool        BindNull( size_t nParam ) = 0;
+            virtual bool        Bind( size_t nParam, int nValue ) = 0;
+            virtual bool        Bind( size_t nParam, long long nValue ) = 0;
+            virtual bool        Bind( size_t nParam, double dValue ) = 0;
+            virtual bool        Bind( size_t nParam, const char *strValue ) = 0;
+            virtual bool        Bind( size_t nParam, const char *pchValue, size_t nLength ) = 0;
+            virtual bool        BindBlob( size_t nParam, const void *pData, size_t nLength ) = 0;
+            virtual bool        ClearBindings( void ) = 0;
+
+            virtual bool        Execute( void ) = 0;
+            virtual CCursor    *Cursor( bool bUpdatable = false ) = 0;
+            virtual CCursor    *ForwardCursor( void ) = 0;
+            virtual bool        Reset( void ) = 0;
+
+            virtual size_t      RowsAffected( void ) = 0;
+
+            virtual bool        Close( void ) = 0;
+            virtual bool        IsValid( void ) = 0;
+    };
+} // namespace IASLib
+
+#endif // IASLIB_DATABASE__
+#endif // IASLIB_PREPAREDSTATEMENT_H__
@@ -0,0 +1,177 @@
+/*
+ *  Query Executor Class
+ *
+ *  Runs queries on a connection from a thread of its own, so the threads
+ * that ask for them don't have to sit and wait on the database. Each call
+ * to Cursor(), Execute() or StoredProc() queues the query and returns at
+ * once with a CAsyncQuery, which the caller can Wait() on when it
+ * actually needs the result, poll, or leave to a callback. Queued queries
+ * are run back to back, in the order they were submitted.
+ *  The executor owns its connection while it runs: nothing else may use
+ * the connection until the executor has been shut down. Work that needs
+ * more than one statement (prepared statements, transactions) is done by
+ * subclassing CAsyncQuery and overriding Perform(), which is called on
+ * the executor's thread with the connection.
+ *  Where threads aren't available, queries are run as they're submitted,
+ * so the handle comes back already done.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_QUERYEXECUTOR_H__
+#define IASLIB_QUERYEXECUTOR_H__
+
+#include "../BaseTypes/String_.h"
+#include "../Collections/Array.h"
+#include "../Threading/Thread.h"
+#include "../Threading/Mutex.h"
+#include "../Threading/Semaphore.h"
+#include "Connection.h"
+
+#ifdef IASLIB_DATABASE__
+#ifdef IASLIB_MULTI_THREADED__
+
+namespace IASLib
+{
+    class CAsyncQuery;
+
+        // Called on the executor's thread when a query finishes (or is
+        // cancelled). The query is only good for the length of the call,
+        // unless the callback keeps a reference with AddRef().
+    typedef void (*AsyncQueryCallback)( CAsyncQuery *pQuery, void *pUserData );
+
+    /**
+     * Async Query
+     *
+     *      The handle for one queued query, and, once it has run, its
+     * result. Handles are reference counted, since both the caller and the
+     * executor hold one: the caller calls Release() when it's done with it.
+     */
+    class CAsyncQuery : public CObject
+    {
+        public:
+            enum QueryType
+            {
+                QUERY_CURSOR,
+                QUERY_FORWARD_CURSOR,
+                QUERY_EXECUTE,
+                QUERY_STORED_PROC,
+                QUERY_CUSTOM
+            };
+
+            enum QueryStatus
+            {
+                STATUS_QUEUED,
+                STATUS_RUNNING,
+                STATUS_COMPLETE,
+                STATUS_FAILED,
+                STATUS_CANCELLED
+            };
+
+        protected:
+            QueryType               m_eType;
+            QueryStatus             m_eStatus;
+            CString                 m_strSQL;
+            CString                 m_strParamList;
+            CCursor                *m_pCursor;
+            CStoredProc            *m_pStoredProc;
+            int                     m_nErrorCode;
+            CString                 m_strError;
+
+            AsyncQueryCallback      m_pfnCallback;
+            void                   *m_pUserData;
+
+            int                     m_nReferences;
+            CMutex                  m_mutexState;
+            CSemaphore              m_semDone;
+
+        public:
+                                    CAsyncQuery( const char *strSQL = "", QueryType eType = QUERY_CUSTOM, const char *strParamList = NULL );
+            virtual                ~CAsyncQuery( void );
+
+                                    DEFINE_OBJECT( CAsyncQuery )
+
+            void                    AddRef( void );
+            void                    Release( void );
+
+            void                    SetCallback( AsyncQueryCallback pfnCallback, void *pUserData ) { m_pfnCallback = pfnCallback; m_pUserData = pUserData; }
+
+            bool                    Wait( long lTimeout = -1 );
+            bool                    Cancel( void );
+
+            QueryType               GetQueryType( void ) { return m_eType; }
+            QueryStatus             GetStatus( void );
+            bool                    IsDone( void );
+            bool                    Succeeded( void ) { return ( GetStatus() == STATUS_COMPLETE ); }
+
+            const char             *GetSQL( void ) { return (const char *)m_strSQL; }
+            CCursor                *GetCursor( void ) { return m_pCursor; }
+            CCursor                *TakeCursor( void );
+            CStoredProc            *GetStoredProc( void ) { return m_pStoredProc; }
+            CStoredProc            *TakeStoredProc( void );
+            int                     GetErrorCode( void ) { return m_nErrorCode; }
+            const char             *GetError( void ) { return (const char *)m_strError; }
+
+                // Does the query's work, on the executor's thread.
+            virtual bool            Perform( CConnection *pConnection );
+
+        protected:
+            friend class CQueryExecutor;
+
+            bool                    Start( void );
+            void                    Finish( bool bSucceeded, CConnection *pConnection );
+            void                    Cancelled( void );
+    };
+
+    class CQueryExecutor : public CThread
+    {
+        protected:
+            CConnection            *m_pConnection;
+            bool                    m_bOwnsConnection;
+            CArray                  m_aQueue;
+            CMutex                  m_mutexQueue;
+            CSemaphore              m_semAvailable;
+            size_t                  m_nCompleted;
+            size_t                  m_nFailed;
+            size_t                  m_nPeakQueue;
+                // No thread to run on; queries run as they're submitted
+            bool                    m_bInline;
+
+        public:
+                                    CQueryExecutor( CConnection *pConnection, bool bOwnsConnection = false );
+            virtual                ~CQueryExecutor( void );
+
+                                    DEFINE_OBJECT( CQueryExecutor )
+
+            virtual void           *Run( void );
+
+            CAsyncQuery            *Cursor( const char *strQuery, AsyncQueryCallback pfnCallback = NULL, void *pUserData = NULL );
+            CAsyncQuery            *ForwardCursor( const char *strQuery, AsyncQueryCallback pfnCallback = NULL, void *pUserData = NULL );
+            CAsyncQuery            *Execute( const char *strQuery, AsyncQueryCallback pfnCallback = NULL, void *pUserData = NULL );
+            CAsyncQuery            *StoredProc( const char *strProcCall, const char *strParamList = NULL, AsyncQueryCallback pfnCallback = NULL, void *pUserData = NULL );
+            bool                    Submit( CAsyncQuery *pQuery );
+
+            void                    Shutdown( void );
+
+            CConnection            *GetConnection( void ) { return m_pConnection; }
+            size_t                  GetQueueSize( void );
+            size_t                  GetPeakQueueSize( void ) { return m_nPeakQueue; }
+            size_t                  GetCompletedCount( void ) { return m_nCompleted; }
+            size_t                  GetFailedCount( void ) { return m_nFailed; }
+
+            virtual unsigned long   GetCapabilities( void ) { return CThread::CapabilityFlags::STATE; }
+
+        protected:
+            CAsyncQuery            *Queue( CAsyncQuery *pQuery, AsyncQueryCallback pfnCallback, void *pUserData );
+            void                    RunQueued( void );
+            CAsyncQuery            *Next( void );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_MULTI_THREADED__
+#endif // IASLIB_DATABASE__
+#endif // IASLIB_QUERYEXECUTOR_H__
@@ -0,0 +1,97 @@
+/*
+ *  SQL Lite Bulk Copy Connection
+ *
+ *      Bulk loading for SQLite, with the same interface as the Sybase
+ * bulk copy: pick the table with SetTable(), bind a buffer to each column
+ * with BindColumn(), then fill the buffers and call SendRow() once per
+ * row, and Flush() at the end.
+ *      Underneath, every row runs the same prepared INSERT, and the rows
+ * are committed in batches (by default, all of them in one transaction)
+ * rather than each in its own implicit transaction, which is what makes
+ * row by row inserts into SQLite slow. The journal mode and synchronous
+ * setting can be relaxed for the load as well.
+ *      The connection has its own SQLite connection to the database file,
+ * which isn't shared with (or counted among) the database's connections.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_SQLITEBULKCOPYCONNECTION_H__
+#define IASLIB_SQLITEBULKCOPYCONNECTION_H__
+
+#ifdef IASLIB_DATABASE__
+#ifdef IASLIB_DB_SQLITE__
+
+#include "../BulkCopyConnection.h"
+#include "../../Collections/StringArray.h"
+
+namespace IASLib
+{
+    class CSQLiteConnection;
+    class CSQLiteDatabase;
+    class CPreparedStatement;
+
+    class CSQLiteBulkCopyConnection : public CBulkCopyConnection
+    {
+        protected:
+                // A column's buffer, as given to BindColumn()
+            struct ColumnBinding
+            {
+                int             m_nDataType;
+                void           *m_pDataBuffer;
+                int             m_nBufferLength;
+            };
+
+            CSQLiteConnection  *m_pConnection;
+            CPreparedStatement *m_pInsert;
+            CString             m_strTable;
+            CStringArray        m_astrColumns;
+            ColumnBinding      *m_aBindings;
+            size_t              m_nBindings;
+
+            size_t              m_nBatchSize;
+            size_t              m_nBatchRows;
+            size_t              m_nRowsSent;
+            bool                m_bBatchOpen;
+
+        public:
+                                CSQLiteBulkCopyConnection( const char *strDBName, const char *strName = "NoName" );
+            virtual            ~CSQLiteBulkCopyConnection( void );
+
+                                DEFINE_OBJECT( CSQLiteBulkCopyConnection )
+
+            virtual bool        IsDead( void );
+
+            virtual bool        SetTable( const char *strTableName );
+            virtual bool        BindColumn( int nColumnNumber, int nDataType, void *pDataBuffer, int nBufferLength );
+            virtual bool        SendRow( void );
+            virtual bool        Flush( void );
+
+            bool                Release( void );
+
+            void                SetBatchSize( size_t nBatchSize ) { m_nBatchSize = nBatchSize; }
+            size_t              GetBatchSize( void ) { return m_nBatchSize; }
+            bool                SetJournalMode( const char *strMode );
+            bool                SetSynchronous( const char *strSetting );
+
+            size_t              GetRowsSent( void ) { return m_nRowsSent; }
+            size_t              Columns( void ) { return m_astrColumns.Length(); }
+
+            int                 MajorErrorCode( void );
+            const char         *MajorErrorMessage( void );
+
+        protected:
+            bool                PrepareInsert( void );
+            bool                BindRow( void );
+            void                CloseInsert( void );
+            bool                Pragma( const char *strName, const char *strValue );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_DB_SQLITE__
+#endif // IASLIB_DATABASE__
+#endif // IASLIB_SQLITEBULKCOPYCONNECTION_H__
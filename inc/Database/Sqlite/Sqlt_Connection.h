@@ -23,11 +23,13 @@
 
 #include "../../BaseTypes/Date.h"
 #include "../Connection.h"
+#include "../../Collections/Hash.h"
 #include "sqlite3.h"
 
 namespace IASLib
 {
     class CSQLiteDatabase;
+    class CSQLiteStatement;
 
     typedef int (open_func_type)(const char *, sqlite3 **);
     typedef void (free_func_type)( void * );
@@ -35,9 +37,31 @@ namespace IASLib
     typedef int  (close_func_type)(sqlite3 *);
     typedef const char *(error_msg_func_type)(sqlite3*);
     typedef int (exec_func_type)(sqlite3*,const char *,sqlite3_callback,void *,char ** );
+    typedef int (prepare_func_type)(sqlite3*,const char *,int,sqlite3_stmt **,const char **);
+    typedef int (stmt_func_type)(sqlite3_stmt *);
+    typedef int (bind_null_func_type)(sqlite3_stmt*,int);
+    typedef int (bind_int64_func_type)(sqlite3_stmt*,int,sqlite3_int64);
+    typedef int (bind_double_func_type)(sqlite3_stmt*,int,double);
+    typedef int (bind_text_func_type)(sqlite3_stmt*,int,const char *,int,void(*)(void *));
+    typedef int (bind_blob_func_type)(sqlite3_stmt*,int,const void *,int,void(*)(void *));
+    typedef int (bind_index_func_type)(sqlite3_stmt*,const char *);
+    typedef const char *(column_name_func_type)(sqlite3_stmt*,int);
+    typedef const unsigned char *(column_text_func_type)(sqlite3_stmt*,int);
+    typedef int (column_int_func_type)(sqlite3_stmt*,int);
+    typedef sqlite3_int64 (column_int64_func_type)(sqlite3_stmt*,int);
+    typedef double (column_double_func_type)(sqlite3_stmt*,int);
+    typedef const void *(column_blob_func_type)(sqlite3_stmt*,int);
+    typedef int (changes_func_type)(sqlite3 *);
+    typedef sqlite3_int64 (last_rowid_func_type)(sqlite3 *);
 
     class CSQLiteConnection : public CConnection
     {
+        public:
+            enum
+            {
+                DEFAULT_STATEMENT_CACHE_SIZE = 64
+            };
+
         protected:
             sqlite3                *m_pSLDatabase;
             char                   *m_pstrErrorStorage;
@@ -46,6 +70,17 @@ namespace IASLib
             int                     m_nLastErrorCode;
             CSQLiteDatabase       *m_pDatabase;
             bool                    m_bValid;
+            bool                    m_bTransactionOpen;
+
+                // Idle prepared statements, by SQL text, and in least
+                // recently used order (the head is the most recent).
+            CHash                   m_hashStatements;
+            CSQLiteStatement       *m_pLruHead;
+            CSQLiteStatement       *m_pLruTail;
+            size_t                  m_nCachedStatements;
+            size_t                  m_nStatementCacheSize;
+            size_t                  m_nStatementCacheHits;
+            size_t                  m_nStatementCacheMisses;
 
         public:
                                     CSQLiteConnection( const char *strDBName, const char *strName, CSQLiteDatabase * );
@@ -58,6 +93,7 @@ namespace IASLib
             virtual bool            RollbackTransaction( void );
 
             virtual CCursor        *Cursor( const char *strQueryString, bool bUpdatable = false );
+            virtual CCursor        *ForwardCursor( const char *strQueryString );
             virtual bool            Execute( const char *strExecString );
 
             virtual int             MajorErrorCode( void );
@@ -74,9 +110,28 @@ namespace IASLib
 
             virtual bool            IsDead( void );
 
+            virtual CPreparedStatement *Prepare( const char *strSQL );
+
             void                    SetTimeout( int nTimeMS );
 
+            void                    SetStatementCacheSize( size_t nStatements );
+            size_t                  GetStatementCacheSize( void ) { return m_nStatementCacheSize; }
+            size_t                  GetCachedStatementCount( void ) { return m_nCachedStatements; }
+            size_t                  GetStatementCacheHits( void ) { return m_nStatementCacheHits; }
+            size_t                  GetStatementCacheMisses( void ) { return m_nStatementCacheMisses; }
+            void                    ClearStatementCache( void );
+
 		    virtual int				GetDBType( void ) { return DB_SQLITE; }
+
+        protected:
+            friend class CSQLiteStatement;
+            friend class CSQLiteForwardCursor;
+
+            void                    ReturnStatement( CSQLiteStatement *pStatement );
+            void                    TrimStatementCache( void );
+            bool                    OpenTransaction( void );
+            void                    SetStatementError( void );
+
         private:
             open_func_type         *m_fnSqlOpen;
             free_func_type         *m_fnSqlFree;
@@ -84,6 +139,28 @@ namespace IASLib
             close_func_type        *m_fnSqlClose;
             error_msg_func_type    *m_fnSqlErrMsg;
             exec_func_type         *m_fnSqlExec;
+            prepare_func_type      *m_fnSqlPrepare;
+            stmt_func_type         *m_fnSqlStep;
+            stmt_func_type         *m_fnSqlReset;
+            stmt_func_type         *m_fnSqlFinalize;
+            stmt_func_type         *m_fnSqlClearBindings;
+            stmt_func_type         *m_fnSqlColumnCount;
+            stmt_func_type         *m_fnSqlParamCount;
+            bind_null_func_type    *m_fnSqlBindNull;
+            bind_int64_func_type   *m_fnSqlBindInt64;
+            bind_double_func_type  *m_fnSqlBindDouble;
+            bind_text_func_type    *m_fnSqlBindText;
+            bind_blob_func_type    *m_fnSqlBindBlob;
+            bind_index_func_type   *m_fnSqlParamIndex;
+            column_name_func_type  *m_fnSqlColumnName;
+            column_text_func_type  *m_fnSqlColumnText;
+            column_int_func_type   *m_fnSqlColumnBytes;
+            column_int_func_type   *m_fnSqlColumnType;
+            column_int64_func_type *m_fnSqlColumnInt64;
+            column_double_func_type *m_fnSqlColumnDouble;
+            column_blob_func_type  *m_fnSqlColumnBlob;
+            changes_func_type      *m_fnSqlChanges;
+            last_rowid_func_type   *m_fnSqlLastRowId;
     };
 } // namespace IASLib
 
@@ -22,6 +22,7 @@
 #ifdef IASLIB_DB_SQLITE__
 
 #include "../Cursor.h"
+#include "../ColumnBuffer.h"
 #include "sqlite3.h"
 #include "Sqlt_Connection.h"
 
@@ -37,6 +38,10 @@ namespace IASLib
         protected:
             CSQLiteConnection *m_pConnection;
 
+                // Cursors filled from a prepared statement keep each column
+                // in its native type, instead of in m_aastrData.
+            CColumnBuffer     **m_apColumns;
+
         public:
             DEFINE_OBJECT( CSQLiteCursor );
 
@@ -51,10 +56,26 @@ namespace IASLib
 
             virtual bool        Next( void );
             virtual bool        Prev( void );
-        
+
+            using CBaseResult::GetColumn;
+            using CBaseResult::IsNull;
+            using CBaseResult::GetInt64;
+            using CBaseResult::GetDouble;
+            using CBaseResult::GetDate;
+            using CBaseResult::GetBlob;
+
+            virtual CString     GetColumn( size_t nColumn );
+            virtual ColumnType  GetColumnType( size_t nColumn );
+            virtual long long   GetInt64( size_t nColumn );
+            virtual double      GetDouble( size_t nColumn );
+            virtual const void *GetBlob( size_t nColumn, size_t &nLength );
+
             void                SetValid( void ) { m_bValid = true; }
 
+            static CString      ColumnHeader( const char *strName );
+
             friend int CursorCallback( void *, int, char **, char **);
+            friend class CSQLiteStatement;
     };
 } // namespace IASLib
 
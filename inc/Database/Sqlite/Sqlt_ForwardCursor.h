@@ -0,0 +1,83 @@
+/*
+ *  SQL Lite Forward Cursor
+ *
+ *      Forward-only cursor class for SQLite. Unlike CSQLiteCursor, which
+ * collects every row of the result before the caller sees the first, this
+ * cursor steps the underlying statement once per Next(), and only ever
+ * holds the current row, which lives in SQLite's own buffers. Scanning a
+ * table of any size takes the same memory as scanning one row.
+ *      The price is that the cursor can't go back: Prev() and SetRow()
+ * always fail, and Rows() only counts the rows seen so far. Values from
+ * GetText() point into SQLite and are only good until the next Next().
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_SQLITEFORWARDCURSOR_H__
+#define IASLIB_SQLITEFORWARDCURSOR_H__
+
+#ifdef IASLIB_DATABASE__
+#ifdef IASLIB_DB_SQLITE__
+
+#include "../Cursor.h"
+#include "sqlite3.h"
+
+namespace IASLib
+{
+    class CSQLiteConnection;
+    class CSQLiteStatement;
+
+    class CSQLiteForwardCursor : public CCursor
+    {
+        protected:
+            CSQLiteConnection  *m_pConnection;
+            CSQLiteStatement   *m_pStatement;
+            bool                m_bOwnsStatement;
+            bool                m_bHasRow;
+
+        public:
+                                CSQLiteForwardCursor( CSQLiteStatement *pStatement, bool bOwnsStatement );
+            virtual            ~CSQLiteForwardCursor( void );
+
+                                DEFINE_OBJECT( CSQLiteForwardCursor )
+
+            virtual int         Close( void );
+
+            virtual int         DeleteRow( const char *strTable );
+            virtual int         InsertRow( const char *strTable );
+            virtual int         UpdateRow( const char *strTable );
+
+            virtual bool        Next( void );
+            virtual bool        Prev( void ) { return false; }
+            virtual bool        SetRow( size_t nRow );
+            virtual bool        IsForwardOnly( void ) { return true; }
+
+            using CBaseResult::IsNull;
+            using CBaseResult::GetInt64;
+            using CBaseResult::GetDouble;
+            using CBaseResult::GetDate;
+            using CBaseResult::GetBlob;
+
+            virtual CString     GetColumn( const char *pszColumn );
+            virtual CString     GetColumn( size_t nColumn );
+            virtual ColumnType  GetColumnType( size_t nColumn );
+            virtual long long   GetInt64( size_t nColumn );
+            virtual double      GetDouble( size_t nColumn );
+            virtual const void *GetBlob( size_t nColumn, size_t &nLength );
+
+            const char         *GetText( size_t nColumn );
+            size_t              GetLength( size_t nColumn );
+            bool                HasRow( void ) { return m_bHasRow; }
+
+        protected:
+            bool                Step( void );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_DB_SQLITE__
+#endif // IASLIB_DATABASE__
+#endif // IASLIB_SQLITEFORWARDCURSOR_H__
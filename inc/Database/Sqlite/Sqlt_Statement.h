@@ -0,0 +1,84 @@
+/*
+ *  SQL Lite Statement
+ *
+ *      Prepared statement class for SQLite. The statement is compiled
+ * once with sqlite3_prepare_v2, and then bound, stepped and reset as
+ * many times as needed. Closing the statement hands it back to its
+ * connection's statement cache, still compiled, for the next caller
+ * that prepares the same SQL.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_SQLITESTATEMENT_H__
+#define IASLIB_SQLITESTATEMENT_H__
+
+#ifdef IASLIB_DATABASE__
+#ifdef IASLIB_DB_SQLITE__
+
+#include "../PreparedStatement.h"
+#include "sqlite3.h"
+
+namespace IASLib
+{
+    class CSQLiteConnection;
+
+    class CSQLiteStatement : public CPreparedStatement
+    {
+        protected:
+            CSQLiteConnection  *m_pConnection;
+            sqlite3_stmt       *m_pStatement;
+            CString             m_strSQL;
+            size_t              m_nRowsAffected;
+
+                // The connection's LRU list of idle statements
+            CSQLiteStatement   *m_pLruNext;
+            CSQLiteStatement   *m_pLruPrev;
+
+        public:
+                                CSQLiteStatement( CSQLiteConnection *pConnection, const char *strSQL, sqlite3_stmt *pStatement );
+            virtual            ~CSQLiteStatement( void );
+
+                                DEFINE_OBJECT( CSQLiteStatement )
+
+            virtual const char *GetSQL( void ) { return (const char *)m_strSQL; }
+            virtual size_t      ParameterCount( void );
+            virtual size_t      ParameterIndex( const char *strName );
+
+            virtual bool        BindNull( size_t nParam );
+            virtual bool        Bind( size_t nParam, int nValue );
+            virtual bool        Bind( size_t nParam, long long nValue );
+            virtual bool        Bind( size_t nParam, double dValue );
+            virtual bool        Bind( size_t nParam, const char *strValue );
+            virtual bool        Bind( size_t nParam, const char *pchValue, size_t nLength );
+            virtual bool        BindBlob( size_t nParam, const void *pData, size_t nLength );
+            virtual bool        ClearBindings( void );
+
+            virtual bool        Execute( void );
+            virtual CCursor    *Cursor( bool bUpdatable = false );
+            virtual CCursor    *ForwardCursor( void );
+            virtual bool        Reset( void );
+
+            virtual size_t      RowsAffected( void ) { return m_nRowsAffected; }
+            long long           LastInsertId( void );
+
+            virtual bool        Close( void );
+            virtual bool        IsValid( void ) { return ( m_pStatement != NULL ); }
+
+            sqlite3_stmt       *GetHandle( void ) { return m_pStatement; }
+
+        protected:
+            bool                CheckBind( int nResult );
+
+            friend class CSQLiteConnection;
+            friend class CSQLiteForwardCursor;
+    };
+} // namespace IASLib
+
+#endif // IASLIB_DB_SQLITE__
+#endif // IASLIB_DATABASE__
+#endif // IASLIB_SQLITESTATEMENT_H__
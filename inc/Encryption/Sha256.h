@@ -5,6 +5,12 @@
  * can be used to provide a one-way hash function that complies with the 
  * SHA256 standard. 
  *
+ * The compression function is picked at run time: the x86 SHA extensions
+ * when the processor has them, the portable C code otherwise. Digest()
+ * hashes a whole message into raw bytes without a context or hex string,
+ * and DigestMany() hashes a batch of independent messages, eight at a
+ * time across the AVX2 lanes when that is the faster path.
+ *
  * Author: Jeffrey R. Naujok
  * Created: December 20, 2019
  * 
@@ -30,6 +36,11 @@ namespace IASLib
             static const uint32 sha256_k[];
             static const uint32 SHA224_256_BLOCK_SIZE = (512/8);
 
+            typedef void (*TransformFunc)( uint32 *pState, const uint8 *pBlocks, size_t nBlocks );
+
+            static TransformFunc s_pfnTransform;
+            static bool         s_bMultiBuffer;
+
         public:
             DECLARE_OBJECT( CSHA256, CObject );
 
@@ -40,10 +51,25 @@ namespace IASLib
             void final(uint8 *digest);
 
             static CString StringDigest(CString &input);
-        
+
+            static void Digest( const void *pData, size_t nLength, uint8 *pDigest );
+            static void DigestMany( const uint8 * const *apData, const size_t *anLengths, uint8 *pDigests, size_t nCount );
+            static void HexDigest( const uint8 *pDigest, char *strHex );
+
+            static void SetAcceleration( bool bEnable );
+            static const char *GetImplementation( void );
+
         protected:
             void transform(const uint8 *message, uint32 block_nb);
-            uint32  m_tot_len;
+
+            static size_t PadTail( const uint8 *pRemainder, size_t nRemaining, uint64 ullTotal, uint8 *pTail );
+            static void SelectTransform( bool bEnable );
+            static void TransformDispatch( uint32 *pState, const uint8 *pBlocks, size_t nBlocks );
+            static void TransformScalar( uint32 *pState, const uint8 *pBlocks, size_t nBlocks );
+            static void TransformShaNi( uint32 *pState, const uint8 *pBlocks, size_t nBlocks );
+            static void TransformAvx2x8( uint32 *pStates, const uint8 * const *apBlocks );
+
+            uint64  m_tot_len;
             uint32  m_len;
             uint8   m_block[2*SHA224_256_BLOCK_SIZE];
             uint32  m_h[8];
@@ -63,6 +63,8 @@
 #include "BaseTypes/String_.h"
 #endif
 #include "BaseTypes/StringTokenizer.h"
+#include "BaseTypes/StringBuilder.h"
+#include "BaseTypes/StringSearch.h"
 
     // Date and Time
 #include "BaseTypes/Date.h"
@@ -82,6 +84,9 @@
 
 #include "Blockchain/Block.h"
 #include "Blockchain/Blockchain.h"
+#include "Blockchain/BlockMiner.h"
+#include "Blockchain/MerkleTree.h"
+#include "Blockchain/BlockStore.h"
 
 //***************
 //  COLLECTIONS
@@ -126,11 +131,15 @@
 //************
 #include "Database/BaseResult.h"
 #include "Database/BulkCopyConnection.h"
+#include "Database/ColumnBuffer.h"
 #include "Database/Connection.h"
 #include "Database/ConnectionArray.h"
+#include "Database/ConnectionPool.h"
 #include "Database/Cursor.h"
 #include "Database/Database.h"
 #include "Database/OutParam.h"
+#include "Database/PreparedStatement.h"
+#include "Database/QueryExecutor.h"
 #include "Database/ResultSet.h"
 #include "Database/StoredProc.h"
     //-------------
@@ -155,9 +164,12 @@
     //--------------
     //  SQLite 3.0
     //--------------
+#include "Database/Sqlite/Sqlt_BulkCopyConnection.h"
 #include "Database/Sqlite/Sqlt_Connection.h"
 #include "Database/Sqlite/Sqlt_Cursor.h"
 #include "Database/Sqlite/Sqlt_Database.h"
+#include "Database/Sqlite/Sqlt_ForwardCursor.h"
+#include "Database/Sqlite/Sqlt_Statement.h"
 #endif
 
 #ifdef IASLIB_DB_SYBASE__
@@ -265,6 +277,7 @@
 #include "NetworkServices/HTTP/Handlers/HttpHandlerFactory.h"
 #include "NetworkServices/HTTP/Handlers/BaseHttpHandlerFactory.h"
 #include "NetworkServices/HTTP/Handlers/HttpGetHandler.h"
+#include "NetworkServices/HTTP/Handlers/HttpMetricsHandler.h"
 #include "NetworkServices/HTTP/Handlers/HttpHeadHandler.h"
 #include "NetworkServices/HTTP/Handlers/HttpPostHandler.h"
 #include "NetworkServices/HTTP/Handlers/HttpOptionsHandler.h"
@@ -304,6 +317,7 @@
 #include "Sockets/ServerSocket.h"
 #include "Sockets/SecureSocket.h"
 #include "Sockets/SecureClientSocket.h"
+#include "Sockets/TlsContextRegistry.h"
 #include "Sockets/Socket.h"
 #include "Sockets/InternetAddress.h"
 #include "Sockets/UDPSocket.h"
@@ -314,6 +328,8 @@
 
 #ifdef IASLIB_STATS__
 #include "Stats/Histogram.h"
+#include "Stats/LatencyHistogram.h"
+#include "Stats/Metrics.h"
 #endif
 
 //**********
@@ -321,6 +337,7 @@
 //**********
 
 #include "Status/CPUUsage.h"
+#include "Status/ThreadProfiler.h"
 
 //***********
 //  STREAMS
@@ -28,7 +28,7 @@ namespace IASLib
             CList   m_aElements;
 
         public:
-            DEFINE_OBJECT( CArrayNode );
+            DEFINE_POOLED_OBJECT( CArrayNode );
 
             CArrayNode( void );
             ~CArrayNode( void );
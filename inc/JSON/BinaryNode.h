@@ -11,7 +11,7 @@ namespace IASLib {
     private:
         CDataBlock  *dataBlock;
     public:
-        DEFINE_OBJECT(CBinaryNode)
+        DEFINE_POOLED_OBJECT(CBinaryNode)
 
         CBinaryNode( CString name, CString value );
 
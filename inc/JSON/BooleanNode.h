@@ -11,7 +11,7 @@ namespace IASLib {
         bool bValue;
         bool bIsNull;
     public:
-        DEFINE_OBJECT(CBooleanNode)
+        DEFINE_POOLED_OBJECT(CBooleanNode)
 
         CBooleanNode( CJsonNode *parent, CString name, CString value );
 
@@ -16,6 +16,8 @@ namespace IASLib {
     public:
         DEFINE_OBJECT( CJsonParser )
 
+        // The nodes are pooled, so a tree that's thrown away as a whole
+        // can be parsed inside a CArenaScope and made in one go.
         static CJsonNode *parse( CString jsonData );
         static CJsonNode *parse( CStream *jsonData );
 
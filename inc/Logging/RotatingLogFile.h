@@ -6,6 +6,17 @@
 ** tracking data. It can be accessed by multiple threads and can date
 ** and time stamp each entry. It is also possible to set the default
 ** format for the log entry.
+**      The log is rotated on an interval, when it grows past a size, or
+** both. Writers only ever append to the open file; the rotating is done
+** by a CLogRotator thread, which opens the next file and swaps it in
+** under the lock, so the only thing a writer can wait on is a pointer
+** being changed. The same thread compresses the finished files (with
+** zlib, when the library has it) and deletes the oldest, keeping no more
+** than the number of files and total size asked for. Without threads,
+** or if the thread can't be started, all of it happens on the write that
+** finds the log due for rotation.
+**      Each line is flushed as it's written unless bAutoFlush is turned
+** off, in which case the rotator flushes the file once a second.
 **
 **  Author: Jeffrey R. Naujok
 **  Created: August 1, 2019
@@ -19,12 +30,17 @@
 
 #include "LogSink.h"
 #include "../Threading/Mutex.h"
+#include "../Threading/Thread.h"
+#include "../Threading/Semaphore.h"
 #include "../Files/File.h"
 #include "../BaseTypes/String_.h"
 #include "../BaseTypes/Date.h"
+#include <time.h>
 
 namespace IASLib
 {
+    class CLogRotator;
+
     class CRotatingLogFile : public CLogSink
     {
         public:
@@ -33,38 +49,79 @@ namespace IASLib
                 HOURLY,
                 DAILY,
                 WEEKLY,
-                MONTHLY
+                MONTHLY,
+                NEVER
             };
 
 
         protected:
-            CDate               m_lastChanged;
-            size_t              m_nInterval;
             CFile              *m_fileOutputFile;
-#ifdef IASLIB_MULTI_THREADED__            
+#ifdef IASLIB_MULTI_THREADED__
             CMutex              m_mutexProtect;
+            CSemaphore          m_semRotate;
+            CLogRotator        *m_pRotator;
+            CMutex              m_mutexHousekeeping;
 #endif
             CString             m_strFileNameTemplate;
+            CString             m_strCurrentName;
+            CString             m_strSegmentFilter;
+            CDate               m_dttOpened;
             size_t              m_nFilesToKeep;
+            size_t              m_nMaxFileBytes;
+            size_t              m_nBytesWritten;
+            unsigned long long  m_ullMaxTotalBytes;
+            time_t              m_tNextRotation;
             bool                m_bAutoFlush;
+            bool                m_bCompress;
+            bool                m_bFixedName;
+            volatile bool       m_bRotateRequested;
+            bool                m_bCleanupPending;
             Interval            m_rotationInterval;
-            int                 m_nCurrentDOW;
-            int                 m_nCurrentMonth;
-            int                 m_nCurrentDay;
-            int                 m_nCurrentHour;
 
         public:
                                 DEFINE_OBJECT( CRotatingLogFile );
-                                CRotatingLogFile( Level level, const char *strFileNameTemplate, Interval rotationInterval = Interval::DAILY, int nFilesToKeep = 3, bool bAutoFlush = false );
+                                CRotatingLogFile( Level level, const char *strFileNameTemplate, Interval rotationInterval = Interval::DAILY, int nFilesToKeep = 3, bool bAutoFlush = true, size_t nMaxFileBytes = 0 );
             virtual            ~CRotatingLogFile( void );
 
             virtual bool        writeLine( const char *message );
 
             void                setAutoFlush( bool bAutoFlush );
+            void                setCompress( bool bCompress ) { m_bCompress = bCompress; }
+            void                setMaxFileSize( size_t nMaxFileBytes ) { m_nMaxFileBytes = nMaxFileBytes; }
+            void                setMaxTotalSize( unsigned long long ullMaxTotalBytes ) { m_ullMaxTotalBytes = ullMaxTotalBytes; }
+
+            CString             getCurrentFileName( void );
 
         private:
-            void                rotateLog( void );
-            bool                isPastRotation( void );
+            friend class CLogRotator;
+
+            void                housekeeping( void );
+            bool                rotationDue( void );
+            bool                rotateLog( void );
+            void                cleanUp( void );
+            bool                compressFile( const CString &strFileName );
+            CString             nextFileName( const CDate &when );
+            CString             segmentFileName( const CDate &when );
+            CString             uniqueFileName( const CString &strFileName );
+            time_t              nextRotation( time_t tNow );
+    };
+
+#ifdef IASLIB_MULTI_THREADED__
+        // Rotates, flushes, compresses and prunes for one log. It wakes once
+        // a second, or as soon as a writer finds the file too big.
+    class CLogRotator : public CThread
+    {
+        protected:
+            CRotatingLogFile   *m_pLog;
+
+        public:
+                                CLogRotator( CRotatingLogFile *pLog );
+            virtual            ~CLogRotator( void );
+
+                                DEFINE_OBJECT( CLogRotator )
+
+            virtual void       *Run( void );
     };
+#endif // IASLIB_MULTI_THREADED__
 } // namespace IASLib
 #endif // IASLIB_ROTATINGLOGFILE_H__
@@ -1,9 +1,12 @@
 /***********************************************************************
-** 
+**
 **  CMemoryBlock Class
 **
 **      This class handles allocating a single page of memory (4K) and
-** is basically a self-contained item. 
+** is basically a self-contained item. Pages are taken from (and given
+** back to) the operating system in runs, aligned on a boundary of the
+** caller's choosing, so that the heaps built on top of them can find
+** the start of a run from any address inside it.
 **
 **  Created:
 **      8/24/2004
@@ -17,36 +20,32 @@
 #ifndef IASLIB_MEMORYBLOCK_H__
 #define IASLIB_MEMORYBLOCK_H__
 
-#include "MemoryHeap.h"
-#include "MemoryBlock.h"
-
-    // This is for GCC to handle the packing pragma.
-#ifndef HANDLE_PRAGMA_PACK_PUSH_POP
-#define HANDLE_PRAGMA_PACK_PUSH_POP
-#endif
+#ifdef IASLIB_MEMORY_MANAGER__
 
-#ifdef IASLIB_WIN32__
-#pragma pack( push, _standard_packing_ )
-#endif
-
-#pragma pack(1)
+#include <stddef.h>
 
 namespace IASLib
 {
 
     class CMemoryBlock
     {
+        public:
+            enum
+            {
+                PAGE_BYTES = 4096
+            };
+
         protected:
-            char        m_Data[4096];
+            char        m_Data[ PAGE_BYTES ];
+
         public:
-                        CMemoryBlock( void );
-            
+            char               *GetData( void ) { return m_Data; }
+
+            static CMemoryBlock *AllocatePages( size_t nPages, size_t nAlignment = PAGE_BYTES );
+            static void         ReleasePages( CMemoryBlock *pPages, size_t nPages );
     };
 }
 
-#ifdef IASLIB_WIN32__
-#pragma pack( pop, _standard_packing_ )
-#endif
-
+#endif // IASLIB_MEMORY_MANAGER__
 
-#endif // IASLIB_MEMORYFIXEDHEAP_H__
+#endif // IASLIB_MEMORYBLOCK_H__
@@ -1,5 +1,5 @@
 /***********************************************************************
-** 
+**
 **  CMemoryFixedHeap Class
 **
 **      This class encodes a fixed block size memory heap. This will
@@ -12,6 +12,12 @@
 ** (notably the CString class) as it will cause the block to be moved
 ** and copied often. This may be meaningless, as it's unclear how often
 ** this happens in standard memory allocators.
+**      The heap carves its blocks out of slabs: runs of SLAB_PAGES
+** CMemoryBlock pages, aligned on their own size, with a header at the
+** front. Any block's slab is found by masking its address, which is how
+** a block is released without being told its size. Released blocks go
+** on their slab's free list; slabs with nothing allocated from them stay
+** with the heap until Compact() gives them back to the system.
 **
 **  Created:
 **      8/24/2004
@@ -25,19 +31,105 @@
 #ifndef IASLIB_MEMORYFIXEDHEAP_H__
 #define IASLIB_MEMORYFIXEDHEAP_H__
 
+#ifdef IASLIB_MEMORY_MANAGER__
+
 #include "../MemoryManager/MemoryHeap.h"
 #include "../MemoryManager/MemoryBlock.h"
+#include "../Threading/Mutex.h"
 
 namespace IASLib
 {
 
     class CMemoryFixedHeap : public CMemoryHeap
     {
+        public:
+            enum
+            {
+                SLAB_PAGES = 16,
+                SLAB_BYTES = SLAB_PAGES * CMemoryBlock::PAGE_BYTES,
+                SLAB_HEADER_BYTES = 128,
+                SLAB_MAGIC = 0x51AB51AB
+            };
+
+                // The header at the front of every slab. Blocks too big
+                // for any fixed heap get a slab of their own, with no heap,
+                // so that they can be told apart the same way.
+            struct Slab
+            {
+                size_t              m_nMagic;
+                CMemoryFixedHeap   *m_pHeap;
+                size_t              m_nBlockSize;
+                size_t              m_nPages;
+                char               *m_pData;
+                char               *m_pUnused;
+                char               *m_pEnd;
+                void               *m_pFree;
+                size_t              m_nInUse;
+                bool                m_bFull;
+                Slab               *m_pNext;
+                Slab               *m_pPrev;
+            };
+
+                // Counters for the heap. Allocations and releases only
+                // count the blocks that came through Allocate() and
+                // Release(); the memory manager adds in the ones that went
+                // through its thread caches, and fills in m_nCached.
+            struct HeapStats
+            {
+                size_t              m_nBlockSize;
+                size_t              m_nSlabs;
+                size_t              m_nEmptySlabs;
+                size_t              m_nBytesReserved;
+                size_t              m_nInUse;
+                size_t              m_nCached;
+                unsigned long long  m_ullAllocations;
+                unsigned long long  m_ullReleases;
+            };
+
         protected:
-            CMemoryBlock    **m_aBlocks;
+            size_t                  m_nBlockSize;
+            size_t                  m_nBlocksPerSlab;
+            Slab                   *m_pPartial;
+            Slab                   *m_pFull;
+            size_t                  m_nSlabs;
+            size_t                  m_nEmptySlabs;
+            size_t                  m_nInUse;
+            unsigned long long      m_ullAllocations;
+            unsigned long long      m_ullReleases;
+            CMutex                  m_mutexHeap;
+
         public:
+                                    CMemoryFixedHeap( void );
+                                    CMemoryFixedHeap( size_t nBlockSize );
+            virtual                ~CMemoryFixedHeap( void );
+
+                                    DEFINE_OBJECT( CMemoryFixedHeap )
+
+            void                    SetBlockSize( size_t nBlockSize );
+
+            virtual void           *Allocate( size_t nSize );
+            virtual void            Release( void *p );
+            virtual size_t          GetBlockSize( void *p ) { return m_nBlockSize; }
+            virtual size_t          Compact( void );
+
+            size_t                  AllocateBatch( void **ppList, size_t nCount );
+            void                    ReleaseBatch( void *pList );
+            void                    AddCounts( unsigned long long ullAllocations, unsigned long long ullReleases );
+
+            size_t                  GetBlockSize( void ) { return m_nBlockSize; }
+            void                    GetStats( HeapStats &stats );
+
+            static Slab            *GetSlab( void *p ) { return (Slab *)( (size_t)p & ~( (size_t)SLAB_BYTES - 1 ) ); }
+
+        protected:
+            Slab                   *NewSlab( void );
+            void                   *TakeBlock( void );
+            void                    PutBlock( void *p );
+            void                    Unlink( Slab *pSlab, Slab **ppList );
+            void                    Link( Slab *pSlab, Slab **ppList );
     };
 }
 
+#endif // IASLIB_MEMORY_MANAGER__
 
 #endif // IASLIB_MEMORYFIXEDHEAP_H__
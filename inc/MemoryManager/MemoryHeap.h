@@ -1,5 +1,5 @@
 /***********************************************************************
-** 
+**
 **  CMemoryHeap Class
 **
 **      This file defines the base abstract class for memory heaps. It
@@ -19,16 +19,31 @@
 #ifndef IASLIB_MEMORYHEAP_H__
 #define IASLIB_MEMORYHEAP_H__
 
+#ifdef IASLIB_MEMORY_MANAGER__
+
+#include "../BaseTypes/Object.h"
 #include "MemoryBlock.h"
 
 namespace IASLib
 {
     class CMemoryHeap : public CObject
     {
-        protected:
         public:
+                                    CMemoryHeap( void ) {}
+            virtual                ~CMemoryHeap( void ) {}
+
+                                    DEFINE_OBJECT( CMemoryHeap )
+
+            virtual void           *Allocate( size_t nSize ) = 0;
+            virtual void            Release( void *p ) = 0;
+            virtual size_t          GetBlockSize( void *p ) = 0;
+
+                // Gives unused memory back to the operating system, and
+                // returns the number of bytes that were released.
+            virtual size_t          Compact( void ) = 0;
     };
 }
 
+#endif // IASLIB_MEMORY_MANAGER__
 
 #endif // IASLIB_MEMORYHEAP_H__
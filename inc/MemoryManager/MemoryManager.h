@@ -5,7 +5,7 @@
  * class that provides memory allocation based on the derived type. Each
  * different type of memory manager can then provide memory usage based
  * on how it needs to be used rather than one global solution.
- *  For example, global objects with long lifetimes are more sensibly 
+ *  For example, global objects with long lifetimes are more sensibly
  * allocated off a static heap, much like the standard malloc or new
  * commmands. On the other hand, small blocks of memory that are rapidly
  * allocated and deallocated should be taken from a fixed-block heap
@@ -13,8 +13,21 @@
  * memory from these fixed-size heaps rapidly and with quick re-use.
  *  All derived memory managers must supply both a production version,
  * which does not need to do range and bounds checking, and a debugging
- * version which *must* identify leaked memory, overwrites, double-frees, 
- * or out-of-range writes. 
+ * version which *must* identify leaked memory, overwrites, double-frees,
+ * or out-of-range writes.
+ *  The base manager is the fixed-block one. Requests up to
+ * MAX_SMALL_BLOCK bytes are rounded up to one of SIZE_CLASSES block sizes
+ * (16 byte steps to 128, then four sizes per doubling) and served by a
+ * CMemoryFixedHeap for that size. Each thread keeps a small cache of
+ * blocks for every size, filled from and emptied into the heaps in
+ * batches, so that most allocations and releases never take a lock.
+ * Larger requests get pages of their own, straight from the system; a
+ * few of the runs released are kept back to be handed out again, since
+ * the system calls cost far more than the blocks' own work.
+ *  GetBlockSize() returns the size a block was rounded up to, which the
+ * caller is free to use. Blocks from the debugging calls carry a header
+ * and guard bytes, are tracked until they're released, and report their
+ * requested size instead.
  *
  *
  *	Author: Jeffrey R. Naujok
@@ -32,48 +45,128 @@
 #ifdef IASLIB_MEMORY_MANAGER__
 
 #include "../BaseTypes/Object.h"
+#include "../Threading/Mutex.h"
+#include "MemoryFixedHeap.h"
 
 namespace IASLib
 {
 
     class CMemoryManager : public CObject
     {
+        public:
+            enum
+            {
+                SIZE_CLASSES = 32,
+                MAX_SMALL_BLOCK = 8192,
+                LARGE_CACHE_RUNS = 8,
+                LARGE_CACHE_PAGES = 256
+            };
+
+            typedef CMemoryFixedHeap::HeapStats     HeapStats;
+
+                // A thread's cached blocks, for one size class. The
+                // counters are the thread's own allocations and releases,
+                // which are only added to the heap's when the thread ends.
+            struct CacheBin
+            {
+                void                   *m_pHead;
+                size_t                  m_nCount;
+                unsigned long long      m_ullAllocations;
+                unsigned long long      m_ullReleases;
+            };
+
+            struct ThreadCache
+            {
+                CMemoryManager         *m_pOwner;
+                CacheBin                m_aBins[ SIZE_CLASSES ];
+                ThreadCache            *m_pNext;
+                ThreadCache            *m_pPrev;
+            };
+
         protected:
+                // The front of a block from AllocateDebug(). The links come
+                // first, since the heaps reuse the first word of a released
+                // block, and the magic number has to outlive the release for
+                // a second one to be caught.
+            struct DebugHeader
+            {
+                DebugHeader            *m_pPrev;
+                DebugHeader            *m_pNext;
+                size_t                  m_nMagic;
+                size_t                  m_nSize;
+                const char             *m_strFile;
+                size_t                  m_nLine;
+                unsigned char           m_achGuard[ 16 ];
+            };
+
             static CMemoryManager  *m_pNewAllocator;
+
+            CMemoryFixedHeap        m_aHeaps[ SIZE_CLASSES ];
+            size_t                  m_anBatch[ SIZE_CLASSES ];
+            unsigned char           m_achClass[ MAX_SMALL_BLOCK / 16 + 1 ];
+
+            size_t                  m_nLargeBlocks;
+            size_t                  m_nLargeBytes;
+            unsigned long long      m_ullLargeAllocations;
+            unsigned long long      m_ullLargeReleases;
+            CMemoryFixedHeap::Slab *m_pLargeCache;
+            size_t                  m_nLargeCached;
+            size_t                  m_nLargeCachedBytes;
+            CMutex                  m_mutexLarge;
+
+            ThreadCache            *m_pCaches;
+            CMutex                  m_mutexCaches;
+
+            DebugHeader            *m_pDebugBlocks;
+            size_t                  m_nDebugBlocks;
+            CMutex                  m_mutexDebug;
+
         public:
-            virtual void   *Allocate( size_t size ) = 0;
-            virtual void   *Reallocate( void *p, size_t size ) = 0;
-            virtual void    Release( void *p ) = 0; 
+                                    CMemoryManager( void );
+            virtual                ~CMemoryManager( void );
+
+                                    DEFINE_OBJECT( CMemoryManager )
+
+            virtual void           *Allocate( size_t size );
+            virtual void           *Reallocate( void *p, size_t size );
+            virtual void            Release( void *p );
+            virtual size_t          GetBlockSize( void *p );
 
-            virtual void   *AllocateDebug( size_t size, const char *strFile, int nLine ) = 0;
-            virtual void   *ReallocateDebug( void *p, size_t size, const char *strFile, int nLine  ) = 0;
-            virtual void    ReleaseDebug( void *p ) = 0;
+            virtual void           *AllocateDebug( size_t size, const char *strFile, int nLine );
+            virtual void           *ReallocateDebug( void *p, size_t size, const char *strFile, int nLine  );
+            virtual void            ReleaseDebug( void *p, const char *strFile = NULL, int nLine = 0 );
+            virtual size_t          ReportLeaks( void );
 
-            virtual void    Compact( void );
+            virtual size_t          Compact( void );
 
-            virtual void    Collect( void );
+            virtual void            Collect( void );
 
-            static CMemoryManager *GetNewAllocator( void ) { return m_pNewAllocator; }
+            size_t                  GetClassCount( void ) { return SIZE_CLASSES; }
+            bool                    GetClassStats( size_t nClass, HeapStats &stats );
+            void                    GetLargeStats( HeapStats &stats );
+
+            static CMemoryManager *GetNewAllocator( void ) { return ( m_pNewAllocator ) ? m_pNewAllocator : GetDefaultAllocator(); }
             static void            SetNewAllocator( CMemoryManager *pNewAllocator );
-    };
-}
 
-#ifdef IASLIB_DEBUG__
-inline void * __cdecl operator new(size_t size, const char *file, int line)
-{
-    return IASLib::CMemoryManager::GetNewAllocator()->AllocateDebug( size, file, line );
-};
+            static void            ReleaseThreadCache( ThreadCache *pCache );
 
-inline void __cdecl operator delete(void *p )
-{
-    IASLib::CMemoryManager::GetNewAllocator()->ReleaseDebug( p );
-};
-#endif
-
-#ifdef IASLIB_DEBUG__
-    #define DEBUG_NEW new(__FILE__, __LINE__)
-    #define new DEBUG_NEW
-#endif
+        protected:
+            size_t                  GetClass( size_t nSize ) { return m_achClass[ ( nSize + 15 ) >> 4 ]; }
+            bool                    IsOwnHeap( CMemoryFixedHeap *pHeap ) { return ( ( pHeap >= m_aHeaps ) && ( pHeap < m_aHeaps + SIZE_CLASSES ) ); }
+
+            ThreadCache            *GetThreadCache( void );
+            void                    FlushBin( CacheBin *pBin, size_t nKeep );
+            void                    DestroyCache( ThreadCache *pCache );
+
+            void                   *AllocateLarge( size_t nSize );
+            void                    ReleaseLarge( CMemoryFixedHeap::Slab *pSlab );
+
+            DebugHeader            *GetDebugHeader( void *p );
+            bool                    CheckGuards( DebugHeader *pHeader, const char *strFile, int nLine );
+
+            static CMemoryManager  *GetDefaultAllocator( void );
+    };
+}
 
 #endif // IASLIB Memory Manager
 
@@ -29,6 +29,7 @@ namespace IASLib
 
             CTextPlainEntity( void );
             CTextPlainEntity( CStream &stream, size_t nContentLength );
+            CTextPlainEntity( const CString &strBody );
 
             virtual ~CTextPlainEntity( void );
 
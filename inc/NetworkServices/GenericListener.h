@@ -41,6 +41,11 @@ namespace IASLib
 
             virtual ~CGenericListener( void );
 
+                // Returns the response data produced for a datagram request. When the
+                // listener is built without a UDP socket the caller is responsible
+                // for transmitting this data.
+            virtual CString getOutput( void );
+
             virtual void addResponseHeaders( CGenericResponse *response ) = 0;
     };
 } // namespace IASLib
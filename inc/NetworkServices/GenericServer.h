@@ -38,6 +38,7 @@ namespace IASLib
 
         public:
                                 CGenericServer( void );
+                                CGenericServer( const char *strServerName, bool bStartSuspended );
                                 CGenericServer( CSocket *pSocket );
                                 CGenericServer( CUDPSocket *pUdpSocket );
             virtual            ~CGenericServer( void );
@@ -0,0 +1,46 @@
+/**
+ * HTTP Metrics Handler class
+ *
+ * This class answers GET /metrics with everything in the metrics
+ * registry, in the Prometheus text format, for a scraper to collect.
+ * Any other path is left to CHttpGetHandler. Register it with a handler
+ * factory in place of the plain GET handler; a server whose own GET
+ * handler is already taken can call serveMetrics() from that instead.
+ *
+ * Author: Jeffrey R. Naujok
+ * Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_NETWORKING__
+#ifdef IASLIB_STATS__
+
+#ifndef IASLIB_HTTPMETRICSHANDLER_H__
+#define IASLIB_HTTPMETRICSHANDLER_H__
+
+#include "NetworkServices/HTTP/Handlers/HttpGetHandler.h"
+
+namespace IASLib
+{
+    class CHttpMetricsHandler : public CHttpGetHandler
+    {
+        IASLIB_DEFINE_HTTP_HANDLER( CHttpMetricsHandler, "GET" );
+        public:
+            DEFINE_OBJECT( CHttpMetricsHandler );
+
+            CHttpMetricsHandler( CString uri, CString version );
+
+            virtual ~CHttpMetricsHandler( void );
+
+            virtual bool process( CHttpRequest *request, CHttpResponse *response );
+
+            static bool isMetricsUri( const CString &uri );
+            static void serveMetrics( CHttpResponse *response );
+    };
+}
+#endif // IASLIB_HTTPMETRICSHANDLER_H__
+
+#endif // IASLIB_STATS__
+#endif // IASLIB_NETWORKING__
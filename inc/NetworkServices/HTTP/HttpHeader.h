@@ -40,7 +40,7 @@ namespace IASLib
                                 /// Destructor
             virtual        ~CHttpHeader( void );
 
-                            DEFINE_OBJECT( CHttpHeader )
+                            DEFINE_POOLED_OBJECT( CHttpHeader )
 
             CHttpHeader    &operator =( const CHttpHeader &oSource );
     };
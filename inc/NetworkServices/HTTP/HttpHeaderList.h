@@ -32,7 +32,7 @@ namespace IASLib
                                 CHttpHeaderList( void );
             virtual            ~CHttpHeaderList( void );
 
-                                DEFINE_OBJECT( CHttpHeaderList );
+                                DEFINE_POOLED_OBJECT( CHttpHeaderList );
 
             virtual CIterator  *Enumerate( void );
 
@@ -43,7 +43,7 @@ namespace IASLib
 	                        CHttpRequest( const char *method, const char *uri );
 	        virtual        ~CHttpRequest( void );
 
-                            DEFINE_OBJECT( CHttpRequest )
+                            DEFINE_POOLED_OBJECT( CHttpRequest )
 
                     // GET, PUT, HEAD, POST, OPTIONS, TRACE, DELETE
             virtual void    setRequestType( const char *requestType );
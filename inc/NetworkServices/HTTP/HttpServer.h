@@ -31,6 +31,7 @@
 #include "NetworkServices/GenericServer.h"
 #include "NetworkServices/HTTP/Handlers/HttpHandler.h"
 #include "NetworkServices/HTTP/Handlers/HttpHandlerFactory.h"
+#include "Stats/LatencyHistogram.h"
 
 namespace IASLib
 {
@@ -41,6 +42,9 @@ namespace IASLib
             bool            m_bUseKeepalive;
             bool            m_bSecure;
             CArray          m_aHandlerFactories;
+#ifdef IASLIB_STATS__
+            CLatencyHistogram m_histLatency;
+#endif
         public:
                                 // Bind to a port on all interfaces
 	                        CHttpServer( int nHTTPPort=80, bool bSecure = false );
@@ -57,6 +61,12 @@ namespace IASLib
             virtual void    RemoveHandlerFactory( CHttpHandlerFactory *pFactory );            
 
             virtual CHttpHandler   *GetHandler( CHttpRequest *request, CUUID erid );
+
+#ifdef IASLIB_STATS__
+                                // How long handlers take, in microseconds,
+                                // recorded by every listener.
+            CLatencyHistogram &GetLatencyHistogram( void ) { return m_histLatency; }
+#endif
     };
 } // namespace IASLib
 
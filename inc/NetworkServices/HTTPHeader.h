@@ -38,7 +38,7 @@ namespace IASLib
                                 /// Destructor
             virtual        ~CHTTPHeader( void );
 
-                            DEFINE_OBJECT( CHTTPHeader )
+                            DEFINE_POOLED_OBJECT( CHTTPHeader )
 
             CHTTPHeader    &operator =( const CHTTPHeader &oSource );
             bool            IsHeader( const char *strCompareName );
@@ -30,7 +30,7 @@ namespace IASLib
             CStringArray values;
 
         public:
-            DEFINE_OBJECT(CHeader);
+            DEFINE_POOLED_OBJECT(CHeader);
 
             CHeader( CString name );
             CHeader( void );
@@ -0,0 +1,171 @@
+/**
+ * SIP Dialog Worker class
+ *
+ *      This class provides one of the fixed set of worker threads that
+ * process SIP messages for a CSipServer. The server hashes the Call-ID
+ * of every inbound message onto a worker, so every message belonging to
+ * a dialog is processed, in order, by the same thread. Since a dialog is
+ * never touched by more than one worker, handlers do not need to lock any
+ * per-dialog state.
+ *      Responses to datagram requests are gathered by the worker and sent
+ * as a batch once its queue has been drained.
+ *      Each worker also owns the SIP transactions for its dialogs, and
+ * drives their retransmission timers between batches of messages.
+ *
+ * Author: Jeffrey R. Naujok
+ * Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_NETWORKING__
+#ifdef IASLIB_MULTI_THREADED__
+
+#ifndef IASLIB_SIPDIALOGWORKER_H__
+#define IASLIB_SIPDIALOGWORKER_H__
+
+#include "Threading/Thread.h"
+#include "Threading/Mutex.h"
+#include "Threading/Semaphore.h"
+#include "Sockets/Socket.h"
+#include "Sockets/UDPSocket.h"
+#include "NetworkServices/SIP/SipTransactionManager.h"
+
+namespace IASLib
+{
+    // Forward definition for wiring parent server
+    class CSipServer;
+
+    /**
+     * SIP TCP Connection
+     *
+     *      A reference counted wrapper around an accepted stream socket. The
+     * server's I/O thread holds one reference while the connection is
+     * registered for events, and every message in flight to a worker holds
+     * another, so the socket (and its descriptor) cannot be re-used while a
+     * worker may still write a response to it.
+     */
+    class CSipTcpConnection : public CObject
+    {
+        protected:
+            CSocket            *m_pSocket;
+            CString             m_strBuffer;
+            struct sockaddr_storage m_stPeer;
+            socklen_t           m_nPeerLength;
+            int                 m_nReferences;
+            bool                m_bClosed;
+            CMutex              m_mutexRefs;
+            CMutex              m_mutexSend;
+
+        public:
+                                CSipTcpConnection( CSocket *pSocket );
+            virtual            ~CSipTcpConnection( void );
+
+                                DEFINE_OBJECT( CSipTcpConnection );
+
+            void                AddRef( void );
+            void                Release( void );
+
+            void                Close( void );
+            bool                IsClosed( void ) { return m_bClosed; }
+
+            int                 Send( const CString &strData );
+
+            CSocket            *GetSocket( void ) { return m_pSocket; }
+            CString            &GetBuffer( void ) { return m_strBuffer; }
+
+            const struct sockaddr *GetPeerAddress( void ) const { return (const struct sockaddr *)&m_stPeer; }
+            socklen_t           GetPeerAddressLength( void ) const { return m_nPeerLength; }
+    };
+
+    /**
+     * SIP Inbound Message
+     *
+     *      A single framed SIP message waiting for a worker, along with
+     * where its response should go: either a datagram peer address, or
+     * the TCP connection it arrived on.
+     */
+    class CSipInboundMessage : public CObject
+    {
+        protected:
+            CString                 m_strData;
+            struct sockaddr_storage m_stAddress;
+            socklen_t               m_nAddressLength;
+            CSipTcpConnection      *m_pConnection;
+            CSipInboundMessage     *m_pNext;           // In a worker's queue
+
+            friend class CSipDialogWorker;
+
+        public:
+                                    CSipInboundMessage( const char *pchData, size_t nLength, const struct sockaddr *pAddress, socklen_t nAddressLength );
+                                    CSipInboundMessage( const CString &strData, CSipTcpConnection *pConnection, const struct sockaddr *pAddress, socklen_t nAddressLength );
+            virtual                ~CSipInboundMessage( void );
+
+                                    DEFINE_OBJECT( CSipInboundMessage );
+
+            const CString          &GetData( void ) const { return m_strData; }
+            const struct sockaddr  *GetAddress( void ) const { return (const struct sockaddr *)&m_stAddress; }
+            socklen_t               GetAddressLength( void ) const { return m_nAddressLength; }
+            CSipTcpConnection      *GetConnection( void ) { return m_pConnection; }
+    };
+
+    class CSipDialogWorker : public CThread, public CSipTransactionOwner
+    {
+        public:
+            enum
+            {
+                SEND_BATCH_SIZE = 64
+            };
+
+        protected:
+            CSipServer             *m_pServer;
+            CUDPSocket             *m_pUdpSocket;
+                // Messages waiting, oldest first, linked through the
+                // messages themselves, so queueing one never copies or
+                // shifts anything.
+            CMutex                  m_mutexQueue;
+            CSipInboundMessage     *m_pQueueHead;
+            CSipInboundMessage     *m_pQueueTail;
+            volatile size_t         m_nQueued;
+            CSemaphore              m_semAvailable;
+            size_t                  m_nProcessed;
+            CSipTransactionManager  m_transactions;
+
+                // Pending datagrams, flushed with a single batched send.
+            CUDPSocket::Datagram    m_aPending[ SEND_BATCH_SIZE ];
+            CString                 m_astrPending[ SEND_BATCH_SIZE ];
+            size_t                  m_nPending;
+
+        public:
+                                    CSipDialogWorker( CSipServer *pServer, CUDPSocket *pUdpSocket, size_t nWorkerNumber );
+            virtual                ~CSipDialogWorker( void );
+
+                                    DEFINE_OBJECT( CSipDialogWorker );
+
+            virtual void           *Run( void );
+
+            void                    Enqueue( CSipInboundMessage *pMessage );
+            void                    Shutdown( void );
+
+            size_t                  GetQueueSize( void ) { return m_nQueued; }
+            size_t                  GetProcessedCount( void ) { return m_nProcessed; }
+            size_t                  GetAbsorbedCount( void ) { return m_transactions.GetAbsorbedCount(); }
+            CSipTransactionManager &GetTransactionManager( void ) { return m_transactions; }
+
+                // CSipTransactionOwner
+            virtual void            SendTransactionMessage( CSipTransaction *pTransaction, const CString &strMessage );
+
+            virtual unsigned long   GetCapabilities( void ) { return CThread::CapabilityFlags::STATE; }
+
+        protected:
+            void                    Process( CSipInboundMessage *pMessage );
+            void                    QueueDatagram( const struct sockaddr *pAddress, socklen_t nAddressLength, const CString &strData );
+            void                    FlushResponses( void );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_SIPDIALOGWORKER_H__
+
+#endif // IASLIB_MULTI_THREADED__
+#endif // IASLIB_NETWORKING__
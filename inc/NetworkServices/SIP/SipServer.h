@@ -17,6 +17,15 @@
  * response to the request. 
  *      By default the handler factory is set to the base handlers
  * that return default responses to most SIP commands.
+ *      Inbound messages are read by the server thread (batched
+ * datagram reads for UDP, an epoll loop for TCP) and handed to a
+ * fixed set of dialog workers. The worker is chosen by hashing the
+ * Call-ID, so every message of a dialog is processed in order on
+ * the same thread.
+ *      A UDP server can also be given several receive sockets. They
+ * all bind the SIP port with SO_REUSEPORT, each is read by its own
+ * thread, and the kernel spreads the inbound datagrams between them.
+ * Since dispatch is still by Call-ID, dialogs stay on one worker.
  *
  *	Author: Jeffrey R. Naujok
  *	Created: October 2, 2019
@@ -31,25 +40,71 @@
 #define IASLIB_SIPSERVER_H__
 
 #include "Collections/Array.h"
+#include "Collections/Hash.h"
 #include "Sockets/ServerSocket.h"
 #include "NetworkServices/GenericServer.h"
+#include "NetworkServices/SIP/SipDialogWorker.h"
 #include "NetworkServices/SIP/Handlers/SipHandler.h"
 #include "NetworkServices/SIP/Handlers/SipHandlerFactory.h"
 
 namespace IASLib
 {
+    class CSipServer;
+
+    /**
+     * SIP UDP Receiver
+     *
+     *      Reads one of the extra SO_REUSEPORT sockets of a UDP SIP server,
+     * and dispatches what it reads to the server's dialog workers.
+     */
+    class CSipUdpReceiver : public CThread
+    {
+        protected:
+            CSipServer     *m_pServer;
+            CUDPSocket     *m_pSocket;
+
+        public:
+                            CSipUdpReceiver( CSipServer *pServer, CUDPSocket *pSocket, size_t nReceiverNumber );
+            virtual        ~CSipUdpReceiver( void );
+
+                            DEFINE_OBJECT( CSipUdpReceiver );
+
+            virtual void   *Run( void );
+
+            virtual unsigned long GetCapabilities( void ) { return CThread::CapabilityFlags::STATE; }
+    };
+
     class CSipServer : public CGenericServer  
     {
+        public:
+            enum
+            {
+                RECEIVE_BATCH_SIZE = 32,        // Datagrams read per system call
+                MAX_DATAGRAM_SIZE = 65536,      // Largest possible UDP payload
+                MAX_STREAM_BUFFER = 65536,      // Largest unframed TCP backlog per connection
+                POLL_TIMEOUT_MS = 250           // How often the I/O loop checks for shutdown
+            };
+
         protected:
             bool            m_bSecure;
             CArray          m_aHandlerFactories;
             bool            m_bIsUDP;
+            int             m_nPort;
+            CServerSocket  *m_pServerSocket;
+            CArray          m_aWorkers;
+            CArray          m_aReceivers;
+            size_t          m_nWorkers;
+            volatile long   m_nNextWorker;
+            CHash           m_hashConnections;
+            int             m_hEpoll;
 
         public:
                                 // Bind to a port on all interfaces Note Port 5060 is default for SIP, 5061 for SIPS
-	                        CSipServer( int nSipPort=5060, bool bSecure = false, bool useUDP = false );
+                                // A worker count of zero uses one worker per online processor. More
+                                // than one receive socket only applies to UDP.
+	                        CSipServer( int nSipPort=5060, bool bSecure = false, bool useUDP = false, size_t nWorkerThreads = 0, size_t nReceiveSockets = 1 );
                                 // Bind to a port on a specific interface
-	                        CSipServer( const char *boundInterface, int nSipPort=5060, bool bSecure = false, bool useUDP = false );
+	                        CSipServer( const char *boundInterface, int nSipPort=5060, bool bSecure = false, bool useUDP = false, size_t nWorkerThreads = 0, size_t nReceiveSockets = 1 );
 
 	        virtual        ~CSipServer( void );
 
@@ -57,6 +112,13 @@ namespace IASLib
 
             virtual void   *Run( void );
 
+            virtual size_t  GetWorkerCount( void ) { return m_nWorkers; }
+            virtual size_t  GetReceiverCount( void ) { return m_aReceivers.GetCount() + 1; }
+            virtual size_t  GetWorkerIndex( const char *pchMessage, size_t nLength );
+
+            static const char *FindHeaderValue( const char *pchMessage, size_t nLength, const char *strName, const char *strCompactName, size_t &nValueLength );
+            static size_t   FrameMessage( const char *pchBuffer, size_t nLength );
+
             virtual void    AddHandlerFactory( CSipHandlerFactory *pFactory );            
             virtual void    RemoveHandlerFactory( CSipHandlerFactory *pFactory );         
 
@@ -65,6 +127,17 @@ namespace IASLib
             virtual bool    isUdp( void ) { return m_bIsUDP; }
 
             virtual bool    isSecure( void ) { return m_bSecure; }
+
+            void            Dispatch( CSipInboundMessage *pMessage );
+            void            ReceiveDatagrams( CUDPSocket *pSocket, CThread *pThread );
+
+        protected:
+            void            Initialize( int nSipPort, size_t nWorkerThreads, size_t nReceiveSockets );
+
+            void            RunTcp( void );
+            void            AcceptConnections( void );
+            void            ReadConnection( CSipTcpConnection *pConnection );
+            void            CloseConnection( CSipTcpConnection *pConnection );
     };
 } // namespace IASLib
 
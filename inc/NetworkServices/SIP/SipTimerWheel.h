@@ -0,0 +1,105 @@
+/**
+ * SIP Timer Wheel class
+ *
+ *      This class provides a hashed timing wheel for the SIP transaction
+ * timers. Timers are dropped into a slot chosen by their expiry tick, and
+ * a timer further out than one revolution of the wheel simply carries the
+ * number of revolutions left to wait. Scheduling and cancelling are
+ * constant time, and advancing the wheel only visits the slots that have
+ * come due, so thousands of outstanding transactions cost no more than a
+ * handful.
+ *      The wheel is not locked. It is owned by a single dialog worker, and
+ * is only ever touched from that worker's thread.
+ *
+ * Author: Jeffrey R. Naujok
+ * Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_NETWORKING__
+
+#ifndef IASLIB_SIPTIMERWHEEL_H__
+#define IASLIB_SIPTIMERWHEEL_H__
+
+#include "BaseTypes/String_.h"
+
+namespace IASLib
+{
+    /**
+     * SIP Timer Target
+     *
+     *      Anything that schedules timers on the wheel implements this
+     * interface to be told when one of them fires.
+     */
+    class CSipTimerTarget
+    {
+        public:
+            virtual        ~CSipTimerTarget( void ) {}
+
+                // Called when a timer fires. The timer has already been removed
+                // from the wheel, so its handle is no longer valid.
+            virtual void    OnTimer( int nTimer ) = 0;
+    };
+
+    class CSipTimerWheel : public CObject
+    {
+        public:
+                // A scheduled timer. The wheel owns the storage, callers only
+                // keep the pointer so that they can cancel it.
+            struct Timer
+            {
+                Timer              *m_pNext;
+                Timer              *m_pPrev;
+                CSipTimerTarget    *m_pTarget;
+                int                 m_nTimer;
+                size_t              m_nRounds;
+            };
+
+            enum
+            {
+                DEFAULT_TICK_MS = 10,
+                DEFAULT_SLOTS = 1024
+            };
+
+        protected:
+            Timer                  *m_aSlots;
+            size_t                  m_nSlots;
+            size_t                  m_nSlotMask;
+            size_t                  m_nCurrentSlot;
+            unsigned long           m_ulTickMilliseconds;
+            unsigned long long      m_ullLastTick;
+            size_t                  m_nTimers;
+            Timer                  *m_pFreeList;
+
+        public:
+                                    CSipTimerWheel( unsigned long ulTickMilliseconds = DEFAULT_TICK_MS, size_t nSlots = DEFAULT_SLOTS );
+            virtual                ~CSipTimerWheel( void );
+
+                                    DEFINE_OBJECT( CSipTimerWheel );
+
+            Timer                  *Schedule( CSipTimerTarget *pTarget, int nTimer, unsigned long ulDelayMilliseconds );
+            Timer                  *Schedule( CSipTimerTarget *pTarget, int nTimer, unsigned long ulDelayMilliseconds, unsigned long long ullNow );
+            void                    Cancel( Timer *pTimer );
+
+            size_t                  Advance( void );
+            size_t                  Advance( unsigned long long ullNow );
+
+            unsigned long           GetNextTimeout( void );
+            size_t                  GetCount( void ) { return m_nTimers; }
+
+            static unsigned long long GetMilliseconds( void );
+
+        protected:
+            static void             Link( Timer *pList, Timer *pTimer );
+            static void             Unlink( Timer *pTimer );
+
+            Timer                  *AllocateTimer( void );
+            void                    FreeTimer( Timer *pTimer );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_SIPTIMERWHEEL_H__
+
+#endif // IASLIB_NETWORKING__
@@ -0,0 +1,166 @@
+/**
+ * SIP Transaction classes
+ *
+ *      These classes hold the RFC 3261 (section 17) transaction state for
+ * a single request and its responses. Server transactions absorb
+ * retransmitted requests by re-sending the last response, so the handlers
+ * only ever see a request once, and re-send final INVITE responses over
+ * unreliable transports until the ACK arrives (timers G and H). Client
+ * transactions retransmit a request until it is answered or times out
+ * (timers A/B for INVITE, E/F for everything else).
+ *      All timers run on the CSipTimerWheel owned by the transaction's
+ * manager. Transactions are not locked, since the manager and all of its
+ * transactions belong to a single dialog worker.
+ *
+ * Author: Jeffrey R. Naujok
+ * Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_NETWORKING__
+#ifdef IASLIB_MULTI_THREADED__
+
+#ifndef IASLIB_SIPTRANSACTION_H__
+#define IASLIB_SIPTRANSACTION_H__
+
+#include "BaseTypes/String_.h"
+#include "Sockets/Socket.h"
+#include "NetworkServices/SIP/SipTimerWheel.h"
+
+namespace IASLib
+{
+    // Forward definitions
+    class CSipTransactionManager;
+    class CSipTcpConnection;
+
+    class CSipTransaction : public CObject, public CSipTimerTarget
+    {
+        public:
+            enum TransactionState
+            {
+                TRYING,
+                CALLING,
+                PROCEEDING,
+                COMPLETED,
+                CONFIRMED,
+                ACCEPTED,
+                TERMINATED
+            };
+
+                // The RFC 3261 timers (timer L is from RFC 6026); the guard
+                // timer is ours, and ends a server transaction that has sent
+                // a provisional response but never a final one.
+            enum TransactionTimer
+            {
+                TIMER_A,
+                TIMER_B,
+                TIMER_D,
+                TIMER_E,
+                TIMER_F,
+                TIMER_G,
+                TIMER_H,
+                TIMER_I,
+                TIMER_J,
+                TIMER_K,
+                TIMER_L,
+                TIMER_GUARD,
+                TIMER_COUNT
+            };
+
+                // RFC 3261 timer values, in milliseconds
+            enum
+            {
+                T1 = 500,
+                T2 = 4000,
+                T4 = 5000
+            };
+
+        protected:
+            CSipTransactionManager *m_pManager;
+            CString                 m_strKey;
+            CString                 m_strBranch;
+            CString                 m_strMethod;
+            bool                    m_bInvite;
+            TransactionState        m_eState;
+            int                     m_nStatusCode;
+
+                // The last message this side sent: a response for server
+                // transactions, the request (or ACK) for client transactions.
+            CString                 m_strMessage;
+
+            struct sockaddr_storage m_stAddress;
+            socklen_t               m_nAddressLength;
+            CSipTcpConnection      *m_pConnection;
+
+            CSipTimerWheel::Timer  *m_apTimers[ TIMER_COUNT ];
+            unsigned long           m_ulRetransmitInterval;
+
+        public:
+                                    CSipTransaction( CSipTransactionManager *pManager, const CString &strKey, const CString &strBranch, const CString &strMethod, const struct sockaddr *pAddress, socklen_t nAddressLength, CSipTcpConnection *pConnection );
+            virtual                ~CSipTransaction( void );
+
+                                    DEFINE_OBJECT( CSipTransaction );
+
+            const CString          &GetKey( void ) const { return m_strKey; }
+            const CString          &GetBranch( void ) const { return m_strBranch; }
+            const CString          &GetMethod( void ) const { return m_strMethod; }
+            TransactionState        GetState( void ) const { return m_eState; }
+            int                     GetStatusCode( void ) const { return m_nStatusCode; }
+            bool                    IsInvite( void ) const { return m_bInvite; }
+            bool                    IsReliable( void ) const { return ( m_pConnection != NULL ); }
+
+            const struct sockaddr  *GetAddress( void ) const { return (const struct sockaddr *)&m_stAddress; }
+            socklen_t               GetAddressLength( void ) const { return m_nAddressLength; }
+            CSipTcpConnection      *GetConnection( void ) { return m_pConnection; }
+
+        protected:
+            void                    StartTimer( TransactionTimer eTimer, unsigned long ulMilliseconds );
+            void                    StopTimer( TransactionTimer eTimer );
+            void                    StopAllTimers( void );
+
+            void                    Transmit( void );
+            void                    Terminate( void );
+    };
+
+    class CSipServerTransaction : public CSipTransaction
+    {
+        public:
+                                    CSipServerTransaction( CSipTransactionManager *pManager, const CString &strKey, const CString &strBranch, const CString &strMethod, const struct sockaddr *pAddress, socklen_t nAddressLength, CSipTcpConnection *pConnection );
+            virtual                ~CSipServerTransaction( void );
+
+                                    DEFINE_OBJECT( CSipServerTransaction );
+
+            void                    ReceiveRetransmission( void );
+            void                    ReceiveAck( void );
+            void                    SendResponse( const CString &strResponse, int nStatusCode );
+
+            virtual void            OnTimer( int nTimer );
+    };
+
+    class CSipClientTransaction : public CSipTransaction
+    {
+        protected:
+            CString                 m_strRequest;
+
+        public:
+                                    CSipClientTransaction( CSipTransactionManager *pManager, const CString &strKey, const CString &strBranch, const CString &strMethod, const CString &strRequest, const struct sockaddr *pAddress, socklen_t nAddressLength, CSipTcpConnection *pConnection );
+            virtual                ~CSipClientTransaction( void );
+
+                                    DEFINE_OBJECT( CSipClientTransaction );
+
+            void                    Start( void );
+            void                    ReceiveResponse( const CString &strResponse, int nStatusCode );
+
+            virtual void            OnTimer( int nTimer );
+
+        protected:
+            CString                 BuildAck( const CString &strResponse );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_SIPTRANSACTION_H__
+
+#endif // IASLIB_MULTI_THREADED__
+#endif // IASLIB_NETWORKING__
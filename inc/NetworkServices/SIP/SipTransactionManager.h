@@ -0,0 +1,93 @@
+/**
+ * SIP Transaction Manager class
+ *
+ *      This class matches inbound SIP messages to their transactions
+ * (RFC 3261 section 17.1.3 and 17.2.3), keyed on the branch parameter of
+ * the top Via header and the method. A retransmitted request is answered
+ * from the transaction, and never reaches the handlers a second time.
+ *      Each dialog worker owns one manager. Since the server always hands
+ * every message of a Call-ID to the same worker, a transaction is only
+ * ever seen by one thread, and none of this needs to be locked.
+ *
+ * Author: Jeffrey R. Naujok
+ * Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_NETWORKING__
+#ifdef IASLIB_MULTI_THREADED__
+
+#ifndef IASLIB_SIPTRANSACTIONMANAGER_H__
+#define IASLIB_SIPTRANSACTIONMANAGER_H__
+
+#include "Collections/Hash.h"
+#include "NetworkServices/SIP/SipTimerWheel.h"
+#include "NetworkServices/SIP/SipTransaction.h"
+
+namespace IASLib
+{
+    /**
+     * SIP Transaction Owner
+     *
+     *      Implemented by whoever owns the transport, so that transactions
+     * can send (and re-send) messages from their timers, and report the
+     * outcome of client transactions.
+     */
+    class CSipTransactionOwner
+    {
+        public:
+            virtual        ~CSipTransactionOwner( void ) {}
+
+            virtual void    SendTransactionMessage( CSipTransaction *pTransaction, const CString &strMessage ) = 0;
+            virtual void    TransactionResponse( CSipClientTransaction *, int, const CString & ) {}
+            virtual void    TransactionTimeout( CSipClientTransaction * ) {}
+    };
+
+    class CSipTransactionManager : public CObject
+    {
+        protected:
+            CSipTransactionOwner   *m_pOwner;
+            CSipTimerWheel          m_wheel;
+            CHash                   m_hashTransactions;
+            size_t                  m_nAbsorbed;
+
+        public:
+                                    CSipTransactionManager( CSipTransactionOwner *pOwner );
+            virtual                ~CSipTransactionManager( void );
+
+                                    DEFINE_OBJECT( CSipTransactionManager );
+
+            CSipServerTransaction  *ReceiveRequest( const CString &strRequest, const struct sockaddr *pAddress, socklen_t nAddressLength, CSipTcpConnection *pConnection, bool &bAbsorbed );
+            bool                    ReceiveResponse( const CString &strResponse );
+
+            void                    SendResponse( CSipServerTransaction *pTransaction, const CString &strResponse );
+            void                    Discard( CSipTransaction *pTransaction ) { Terminated( pTransaction ); }
+            CSipClientTransaction  *SendRequest( const CString &strRequest, const struct sockaddr *pAddress, socklen_t nAddressLength, CSipTcpConnection *pConnection );
+
+            size_t                  Advance( void ) { return m_wheel.Advance(); }
+            unsigned long           GetNextTimeout( void ) { return m_wheel.GetNextTimeout(); }
+
+            size_t                  GetTransactionCount( void ) { return m_hashTransactions.GetLength(); }
+            size_t                  GetAbsorbedCount( void ) { return m_nAbsorbed; }
+
+            static bool             GetTransactionId( const char *pchMessage, size_t nLength, CString &strBranch, CString &strMethod );
+            static int              GetStatusCode( const char *pchMessage, size_t nLength );
+
+        protected:
+            friend class CSipTransaction;
+            friend class CSipServerTransaction;
+            friend class CSipClientTransaction;
+
+            CSipTimerWheel         &GetWheel( void ) { return m_wheel; }
+            CSipTransactionOwner   *GetOwner( void ) { return m_pOwner; }
+
+            void                    Terminated( CSipTransaction *pTransaction );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_SIPTRANSACTIONMANAGER_H__
+
+#endif // IASLIB_MULTI_THREADED__
+#endif // IASLIB_NETWORKING__
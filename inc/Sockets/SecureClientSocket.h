@@ -26,6 +26,7 @@ namespace IASLib
     {
         public:
 	                    CSecureClientSocket( const char *strConnectTo, int nPort );
+                        CSecureClientSocket( const char *strConnectTo, int nPort, bool bVerifyPeer, const char *strCAFile = NULL );
 	        virtual    ~CSecureClientSocket();
 
                         DEFINE_OBJECT( CSecureClientSocket )
@@ -21,6 +21,7 @@
 #ifdef IASLIB_NETWORKING__
 
 #include "Socket.h"
+#include "TlsContextRegistry.h"
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 
@@ -28,12 +29,30 @@ namespace IASLib
 {
     class CSecureSocket : public CSocket
     {
+        public:
+                // The result of one step of a handshake. An event loop waits
+                // for the socket to become readable (or writable) and then
+                // calls ContinueHandshake() again.
+            enum HandshakeStatus
+            {
+                HANDSHAKE_COMPLETE,
+                HANDSHAKE_WANT_READ,
+                HANDSHAKE_WANT_WRITE,
+                HANDSHAKE_FAILED
+            };
+
         protected:
-            SSL_CTX         *m_pContext;
+            SSL_CTX         *m_pContext;        // Shared, owned by CTlsContextRegistry
+            SSL             *m_pSsl;
+            bool             m_bHandshakeComplete;
+            CString          m_strSessionKey;   // "host:port" for client session reuse
+
         public:
                             CSecureSocket( SOCKET hSocket, const char *strSockName, void *AddressIn=NULL );
+                            CSecureSocket( SOCKET hSocket, const char *strSockName, void *AddressIn, SSL_CTX *pContext );
 	                        CSecureSocket( int nPort, bool bBlocking = true );
                             CSecureSocket( const char *strConnectTo, int nPort );
+                            CSecureSocket( const char *strConnectTo, int nPort, SSL_CTX *pContext );
 	        virtual        ~CSecureSocket();
 
                             DEFINE_OBJECT( CSecureSocket )
@@ -51,10 +70,16 @@ namespace IASLib
             virtual void            SetNonBlocking( bool bDontBlock );
             virtual bool            HasData( void );
 
-        private:
-            void                    initSsl( void );
-            SSL_CTX                *createContext();
-            void                    configureContext( SSL_CTX *context );
+            HandshakeStatus         ContinueHandshake( void );
+            bool                    DoHandshake( void );
+            bool                    IsSessionReused( void );
+            SSL                    *GetSsl( void ) { return m_pSsl; }
+            const CString          &GetSessionKey( void ) const { return m_strSessionKey; }
+
+        protected:
+            void                    AttachServer( SSL_CTX *pContext );
+            void                    AttachClient( const char *strConnectTo, int nPort, SSL_CTX *pContext );
+            bool                    WaitFor( HandshakeStatus eStatus );
     };
 } // namespace IASLib
 
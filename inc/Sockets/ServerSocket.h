@@ -3,6 +3,10 @@
  *
  *      This class provides an interface for creating a server
  * socket connection.
+ *      Built from a CSocketConfig, the listener takes its backlog from
+ * the configuration, and can share its port with other listeners
+ * (SO_REUSEPORT) so that several threads can each accept on their own
+ * socket while the kernel balances new connections between them.
  *
  *	Author: Jeffrey R. Naujok
  *	Created: 4/02/1997
@@ -24,18 +28,25 @@ namespace IASLib
 {
     class CServerSocket : public CSocket
     {
+        public:
+            enum
+            {
+                DEFAULT_BACKLOG = SOMAXCONN
+            };
+
         protected:
             bool m_bSecure;
             CSocketConfig config;
 
         public:
-                        CServerSocket( CSocketConfig config, int nPort, const char *bindAddress );
-	                    CServerSocket( int nPort, int nMaxBacklog = 16, bool bSecure = false );
+                        CServerSocket( CSocketConfig config, int nPort, const char *bindAddress = NULL, bool bSecure = false );
+	                    CServerSocket( int nPort, int nMaxBacklog = DEFAULT_BACKLOG, bool bSecure = false );
 	        virtual    ~CServerSocket( void );
 
                         DEFINE_OBJECT( CServerSocket )
 
             virtual CSocket    *Accept( void );
+            virtual SOCKET      AcceptHandle( struct sockaddr_storage *pAddress, socklen_t *pnAddressLength );
             virtual bool        isSecure( void ) { return m_bSecure; }
     };
 }
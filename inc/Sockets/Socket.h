@@ -72,6 +72,7 @@ namespace IASLib
                             DEFINE_OBJECT( CSocket )
 
             virtual bool            IsConnected( void ) { return (m_hSocket != NULL_SOCKET ) ? true:false; }
+            virtual SOCKET          GetHandle( void ) { return m_hSocket; }
             virtual bool            IsHandshakeComplete( void ) { return IsConnected(); }
             virtual unsigned char   Read( void );
             virtual int             Read( char *pchBuffer, int nBufferSize );
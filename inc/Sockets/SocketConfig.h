@@ -34,6 +34,7 @@ namespace IASLib
             bool keepAlive;
             bool linger;
             bool reuseSocket;
+            bool reusePort;
             int timeoutMillis;
             bool noDelay;
             bool blocking;
@@ -49,6 +50,7 @@ namespace IASLib
             bool isKeepAlive(){ return keepAlive;}
             bool isLinger(){return linger;}
             bool isReuseSocket(){return reuseSocket;}
+            bool isReusePort(){return reusePort;}
             int getTimeout(){return timeoutMillis;}
             bool    isTcpNoDelay(){return noDelay;}
             bool isBlocking() { return blocking; }
@@ -71,6 +73,7 @@ namespace IASLib
             bool keepAlive;
             bool linger;
             bool reuseSocket;
+            bool reusePort;
             int timeoutMillis;
             bool noDelay;
             bool blocking;
@@ -85,6 +88,7 @@ namespace IASLib
             CSocketConfigBuilder setKeepalive( bool keepalive );
             CSocketConfigBuilder setLinger( bool linger );
             CSocketConfigBuilder setReuseAddress( bool reuse );
+            CSocketConfigBuilder setReusePort( bool reuse );
             CSocketConfigBuilder setTimeout( int timeoutMillis );
             CSocketConfigBuilder setTCPNoDelay( bool noDelay );
             CSocketConfigBuilder setBlocking( bool blocking );
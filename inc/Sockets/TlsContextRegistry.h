@@ -0,0 +1,61 @@
+/**
+ *  TLS Context Registry class
+ *
+ *      This class keeps the process-wide set of OpenSSL contexts that the
+ * secure sockets share. OpenSSL is initialized exactly once, and each
+ * distinct server certificate (or client verification setup) gets one
+ * SSL_CTX for the life of the process, rather than one per connection.
+ *      Sharing the context is what makes session resumption work at all:
+ * the server side session cache and the session ticket keys both live in
+ * the SSL_CTX, so a context built per socket could never resume anything.
+ * On the client side, sessions are kept here, keyed on "host:port", and
+ * handed back to the next connection to the same peer.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_TLSCONTEXTREGISTRY_H__
+#define IASLIB_TLSCONTEXTREGISTRY_H__
+
+#ifdef IASLIB_NETWORKING__
+
+#include "../BaseTypes/String_.h"
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+
+namespace IASLib
+{
+    class CTlsContextRegistry
+    {
+        public:
+            enum
+            {
+                DEFAULT_SESSION_CACHE_SIZE = 20480,
+                DEFAULT_SESSION_TIMEOUT = 300       // seconds
+            };
+
+        public:
+            static void             Initialize( void );
+            static void             Shutdown( void );
+
+            static SSL_CTX         *GetServerContext( const char *strCertFile = "cert.pem", const char *strKeyFile = "key.pem" );
+            static SSL_CTX         *GetClientContext( bool bVerifyPeer = false, const char *strCAFile = NULL );
+
+            static SSL_SESSION     *GetClientSession( const char *strSessionKey );
+            static void             StoreClientSession( const char *strSessionKey, SSL_SESSION *pSession );
+            static void             RemoveClientSession( const char *strSessionKey );
+            static size_t           GetClientSessionCount( void );
+
+        private:
+            static SSL_CTX         *CreateServerContext( const char *strCertFile, const char *strKeyFile );
+            static SSL_CTX         *CreateClientContext( bool bVerifyPeer, const char *strCAFile );
+            static int              NewClientSession( SSL *pSsl, SSL_SESSION *pSession );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_NETWORKING__
+#endif // IASLIB_TLSCONTEXTREGISTRY_H__
@@ -4,6 +4,11 @@
  *      This base class provides platform independent support for UDP
  * sockets. This is the base class for both the UDP server and client socket
  * classes.
+ *      Besides the single datagram Read() and Send(), the socket can move
+ * a whole batch of datagrams per system call (recvmmsg/sendmmsg where the
+ * platform has them) into and out of caller-owned buffers. A server socket
+ * can also be opened with SO_REUSEPORT, so that several threads can each
+ * own a socket on the same port and let the kernel spread the load.
  *
  *	Author: Jeffrey R. Naujok
  *	Created: 7/11/2019
@@ -26,6 +31,23 @@ namespace IASLib
 {
     class CUDPSocket : public CObject
     {
+        public:
+            enum
+            {
+                MAX_BATCH = 64          // Datagrams moved per recvmmsg/sendmmsg call
+            };
+
+                // One slot of a batched read or send. The caller owns the buffer;
+                // on a read, m_nLength and the address are filled in.
+            struct Datagram
+            {
+                char                   *m_pchBuffer;
+                size_t                  m_nBufferSize;
+                size_t                  m_nLength;
+                struct sockaddr_storage m_stAddress;
+                socklen_t               m_nAddressLength;
+            };
+
         protected:
     #ifdef IASLIB_WIN32__
             static bool     m_bInitialized;     // Used to assure WSA is initialized in Windoze
@@ -37,8 +59,9 @@ namespace IASLib
             CString         m_strAddress;
             CString         m_strSocketName;
         public:
-                            // Server socket
-	                        CUDPSocket( int nPort );
+                            // Server socket. With bReusePort, any number of sockets may
+                            // bind the same port, and the kernel spreads datagrams over them.
+	                        CUDPSocket( int nPort, bool bReusePort = false );
                             // client socket
                             CUDPSocket( void );
 	        virtual        ~CUDPSocket( void );
@@ -48,8 +71,11 @@ namespace IASLib
             virtual void setName( const char *name ) { m_strSocketName = name; }
             virtual CString getName( void ) { return m_strSocketName; }
             virtual bool            IsConnected( void ) { return (m_hSocket != NULL_SOCKET ) ? true:false; }
+            virtual SOCKET          GetHandle( void ) { return m_hSocket; }
             virtual int             Read( char *pchBuffer, int nBufferSize, CInternetAddress &incomingAddress );
             virtual int             Send( const char *pchBuffer, int nBufferSize, const CInternetAddress &targetAddress );
+            virtual size_t          ReadBatch( Datagram *aDatagrams, size_t nCount, bool bWait = true );
+            virtual size_t          SendBatch( const Datagram *aDatagrams, size_t nCount );
             virtual int             GetPort( void ) { return m_nPort; }
             virtual const CInternetAddress &GetAddress( void ) const { return *m_addrIPAddress; }
             virtual void            Close( void );
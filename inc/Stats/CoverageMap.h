@@ -5,6 +5,13 @@
  * of a limited resource based on the use of small, non-overlapping parts
  * of that range. For the main example, this is used to analyze memory
  * and disk fragmentation. 
+ *  Allocated space is kept as a balanced (AVL) tree of ranges, ordered by
+ * their start. Ranges that touch or overlap are merged as they're made,
+ * so the tree only ever holds one node per extent, and allocating or
+ * releasing a range takes O(log n) plus a step for each extent it joins
+ * or cuts. The used and free totals and the fragmentation are kept up to
+ * date as ranges change, and Dump() walks the tree straight out to the
+ * stream, a line at a time.
  *
  *	Author: Jeffrey R. Naujok
  *	Created: 8/31/2007
@@ -20,7 +27,7 @@
 
 #ifdef IASLIB_STATS__
 
-#include "../Collections/SortedArray.h"
+#include "../BaseTypes/Object.h"
 #include "../Streams/Stream.h"
 
 namespace IASLib
@@ -34,7 +41,17 @@ namespace IASLib
                 XML         = 0x0002,
             };
         protected:
-            CSortedArray    m_aCoverageMap;
+            struct Range
+            {
+                size_t      m_nStart;
+                size_t      m_nEnd;
+                Range      *m_pLeft;
+                Range      *m_pRight;
+                int         m_nHeight;
+            };
+
+            Range          *m_pRoot;
+            size_t          m_nRanges;
             size_t          m_nMinimum;
             size_t          m_nMaximum;
             double          m_fFragmentation;
@@ -45,27 +62,58 @@ namespace IASLib
                             CCoverageMap( void );
             virtual        ~CCoverageMap( void );
 
+                            DEFINE_OBJECT( CCoverageMap )
+
+                // Both return false if any of the range was already in the
+                // state asked for; the rest of it is still changed. A Release
+                // without a size frees from nBase to the end of its extent.
             bool            Allocate( size_t nBase, size_t nSize );
             bool            Release( size_t nBase, size_t nSize = IASLib::NOT_FOUND );
+            bool            IsAllocated( size_t nLocation ) const;
+            void            Clear( void );
 
-            size_t          GetSize( void ) { return m_nMaximum - m_nMinimum; }
+            size_t          GetSize( void ) { return ( m_nMaximum > m_nMinimum ) ? m_nMaximum - m_nMinimum : 0; }
             size_t          GetUsed( void ) { return m_nUsed; }
             size_t          GetFree( void ) { return m_nFree; }
+            size_t          GetRanges( void ) { return m_nRanges; }
+
+                // 0.0 when the used space is one extent, 1.0 when no two used
+                // blocks are next to each other.
+            double          GetFragmentation( void ) { return m_fFragmentation; }
 
-            void            SetBlockSize( size_t nBlockSize ) { m_nBlockSize = nBlockSize; }
+            void            SetBlockSize( size_t nBlockSize ) { m_nBlockSize = ( nBlockSize ) ? nBlockSize : 1; updateStats(); }
 
 
             void            Dump( CStream &oStream, OutputFormatSpecifier nFormat, bool bFillInGaps = false );
 
         private:
+                            CCoverageMap( const CCoverageMap &oSource );
+            CCoverageMap   &operator =( const CCoverageMap &oSource );
+
+            Range          *findFloor( size_t nLocation ) const;
+            Range          *findCeiling( size_t nLocation ) const;
+            void            insertRange( size_t nStart, size_t nEnd );
+            void            removeRange( size_t nStart );
+            void            updateStats( void );
+
+            static Range   *insert( Range *pNode, Range *pNew );
+            static Range   *remove( Range *pNode, size_t nStart );
+            static Range   *removeMinimum( Range *pNode, Range **ppMinimum );
+            static Range   *balance( Range *pNode );
+            static Range   *rotateLeft( Range *pNode );
+            static Range   *rotateRight( Range *pNode );
+            static void     deleteAll( Range *pNode );
+
+            void            dumpRanges( CStream &oStream, OutputFormatSpecifier nFormat, bool bFillInGaps, Range *pNode, size_t &nLast );
+            void            dumpLine( CStream &oStream, OutputFormatSpecifier nFormat, size_t nStart, size_t nEnd, const char *strState );
+
             int             m_nLinePosition;
-            size_t          FindCategory( const char *strCategoryName );
 
             void            FormatStart( CStream &oStream, OutputFormatSpecifier nFormat );
 
             void            FormatStartLine( CStream &oStream, OutputFormatSpecifier nFormat );
 
-            void            FormatValue( CStream &oStream, int nValue, OutputFormatSpecifier nFormat );
+            void            FormatValue( CStream &oStream, size_t nValue, OutputFormatSpecifier nFormat );
             void            FormatValue( CStream &oStream, const char *strValue, OutputFormatSpecifier nFormat );
 
             void            FormatEndLine( CStream &oStream, OutputFormatSpecifier nFormat );
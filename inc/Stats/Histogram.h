@@ -4,6 +4,8 @@
  *  This class provides a means of producing a histogram of data. The 
  * histogram can have any number of buckets and categories to drop 
  * data into. 
+ *  It isn't meant to be added to from more than one thread at a time;
+ * for latencies recorded by every request, use CLatencyHistogram.
  *
  *	Author: Jeffrey R. Naujok
  *	Created: 1/15/1994
@@ -0,0 +1,125 @@
+/**
+ * Latency Histogram Class
+ *
+ *  This class records values, usually latencies in microseconds, from
+ * any number of threads at once, and answers percentile questions about
+ * them (p50, p99, p99.9) the way an HDR histogram does. Buckets are log-
+ * linear: every value under 128 has a bucket of its own, and each power
+ * of two above that is split into 64, so a value is never off by more
+ * than about 1.5%. They're kept in a flat array, found with a shift, not
+ * a search.
+ *  Each thread records into one of a few shards, each its own array, with
+ * an atomic add; nothing is locked and threads on different shards don't
+ * share cache lines. Reading merges the shards into a CLatencySnapshot.
+ * A snapshot can also reset the counts as it reads them, without losing
+ * any recorded meanwhile, for reporting by intervals.
+ *  Values past MAX_VALUE (about twelve days in microseconds) are counted
+ * as MAX_VALUE.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_LATENCYHISTOGRAM_H__
+#define IASLIB_LATENCYHISTOGRAM_H__
+
+#ifdef IASLIB_STATS__
+
+#include "../BaseTypes/Object.h"
+#include "../BaseTypes/String_.h"
+
+namespace IASLib
+{
+    class CLatencySnapshot;
+
+    class CLatencyHistogram : public CObject
+    {
+        public:
+            enum
+            {
+                SUB_BUCKET_BITS = 7,
+                SUB_BUCKETS = 1 << SUB_BUCKET_BITS,
+                HALF_SUB_BUCKETS = SUB_BUCKETS / 2,
+                MAX_VALUE_BITS = 40,
+                BUCKETS = SUB_BUCKETS + ( MAX_VALUE_BITS - SUB_BUCKET_BITS ) * HALF_SUB_BUCKETS,
+                SHARDS = 16
+            };
+
+            static const unsigned long long MAX_VALUE = ( 1ULL << MAX_VALUE_BITS ) - 1;
+
+        protected:
+            struct Shard
+            {
+                volatile unsigned long long m_aullCounts[ BUCKETS ];
+                volatile unsigned long long m_ullSum;
+            };
+
+            Shard *volatile         m_apShards[ SHARDS ];
+
+        public:
+                                    CLatencyHistogram( void );
+            virtual                ~CLatencyHistogram( void );
+
+                                    DEFINE_OBJECT( CLatencyHistogram )
+
+            void                    Record( unsigned long long ullValue );
+
+            void                    Snapshot( CLatencySnapshot &snapshot, bool bReset = false );
+            void                    Reset( void );
+
+            static size_t           BucketIndex( unsigned long long ullValue );
+            static unsigned long long BucketLow( size_t nBucket );
+            static unsigned long long BucketHigh( size_t nBucket );
+
+            static unsigned long long Now( void );
+
+        protected:
+            Shard                  *GetShard( void );
+
+        private:
+                                    CLatencyHistogram( const CLatencyHistogram &oSource );
+            CLatencyHistogram      &operator =( const CLatencyHistogram &oSource );
+    };
+
+        // The counts from a CLatencyHistogram, merged, at one moment (or
+        // for one interval, if it was reset by the snapshot before).
+    class CLatencySnapshot : public CObject
+    {
+        protected:
+            unsigned long long     *m_pullCounts;
+            unsigned long long      m_ullCount;
+            unsigned long long      m_ullSum;
+
+        public:
+                                    CLatencySnapshot( void );
+                                    CLatencySnapshot( const CLatencySnapshot &oSource );
+            virtual                ~CLatencySnapshot( void );
+
+                                    DEFINE_OBJECT( CLatencySnapshot )
+
+            CLatencySnapshot       &operator =( const CLatencySnapshot &oSource );
+
+            void                    Clear( void );
+            void                    Add( const CLatencySnapshot &oOther );
+
+            unsigned long long      GetCount( void ) const { return m_ullCount; }
+            unsigned long long      GetSum( void ) const { return m_ullSum; }
+            unsigned long long      GetCountAt( size_t nBucket ) const { return ( nBucket < CLatencyHistogram::BUCKETS ) ? m_pullCounts[ nBucket ] : 0; }
+            double                  GetMean( void ) const;
+            unsigned long long      GetMin( void ) const;
+            unsigned long long      GetMax( void ) const;
+            unsigned long long      GetValueAtPercentile( double dPercentile ) const;
+
+            CString                 ToString( void ) const;
+
+        private:
+            friend class CLatencyHistogram;
+    };
+} // namespace IASLib
+
+#endif // IASLIB_STATS__
+
+#endif // IASLIB_LATENCYHISTOGRAM_H__
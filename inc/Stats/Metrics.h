@@ -0,0 +1,176 @@
+/**
+ * Metrics Classes
+ *
+ *  These classes keep the process' operational metrics: counters, that
+ * only go up; gauges, that are set or moved up and down; and summaries,
+ * that hold a CLatencyHistogram and report its percentiles. Each one is
+ * made once, by name, in the CMetricsRegistry, and kept for the life of
+ * the process, so code can hold on to the pointer and update it without
+ * looking it up again.
+ *  Updates don't lock. A counter is split into cells, each on a cache
+ * line of its own, and a thread adds to the one it was given, so threads
+ * counting the same thing don't fight over the line; reading sums them.
+ * A gauge is a single value changed with an atomic add.
+ *  The registry writes out everything it holds in the Prometheus text
+ * format, for CHttpMetricsHandler to serve.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_METRICS_H__
+#define IASLIB_METRICS_H__
+
+#ifdef IASLIB_STATS__
+
+#include "../BaseTypes/Object.h"
+#include "../BaseTypes/String_.h"
+#include "../Collections/Array.h"
+#include "../Threading/Mutex.h"
+#include "LatencyHistogram.h"
+
+namespace IASLib
+{
+    class CMetric : public CObject
+    {
+        public:
+            enum Type
+            {
+                COUNTER,
+                GAUGE,
+                SUMMARY
+            };
+
+        protected:
+            CString                 m_strName;
+            CString                 m_strHelp;
+            Type                    m_type;
+
+        public:
+                                    CMetric( const char *strName, const char *strHelp, Type type );
+            virtual                ~CMetric( void );
+
+                                    DEFINE_OBJECT( CMetric )
+
+            const CString          &GetName( void ) const { return m_strName; }
+            const CString          &GetHelp( void ) const { return m_strHelp; }
+            Type                    GetMetricType( void ) const { return m_type; }
+
+                // Appends the metric, with its HELP and TYPE lines, to strOut
+                // in the Prometheus text format.
+            virtual void            Write( CString &strOut ) = 0;
+
+        private:
+                                    CMetric( const CMetric &oSource );
+            CMetric                &operator =( const CMetric &oSource );
+    };
+
+    class CCounter : public CMetric
+    {
+        public:
+            enum
+            {
+                CELLS = 16,
+                CELL_BYTES = 64
+            };
+
+        protected:
+            struct Cell
+            {
+                volatile unsigned long long m_ullValue;
+                char                m_achPad[ CELL_BYTES - sizeof( unsigned long long ) ];
+            };
+
+            Cell                    m_aCells[ CELLS ];
+
+        public:
+                                    CCounter( const char *strName, const char *strHelp );
+            virtual                ~CCounter( void );
+
+                                    DEFINE_OBJECT( CCounter )
+
+            void                    Add( unsigned long long ullAmount = 1 );
+            unsigned long long      Get( void ) const;
+
+            virtual void            Write( CString &strOut );
+    };
+
+    class CGauge : public CMetric
+    {
+        protected:
+            volatile long long      m_llValue;
+
+        public:
+                                    CGauge( const char *strName, const char *strHelp );
+            virtual                ~CGauge( void );
+
+                                    DEFINE_OBJECT( CGauge )
+
+            void                    Set( long long llValue );
+            void                    Add( long long llAmount );
+            long long               Get( void ) const { return m_llValue; }
+
+            virtual void            Write( CString &strOut );
+    };
+
+        // Recorded values are whole numbers, as CLatencyHistogram wants them
+        // (usually microseconds); the scale turns them into the unit that's
+        // exported, which Prometheus would like to be seconds.
+    class CSummary : public CMetric
+    {
+        protected:
+            CLatencyHistogram       m_histValues;
+            double                  m_dScale;
+
+        public:
+                                    CSummary( const char *strName, const char *strHelp, double dScale = 0.000001 );
+            virtual                ~CSummary( void );
+
+                                    DEFINE_OBJECT( CSummary )
+
+            void                    Record( unsigned long long ullValue ) { m_histValues.Record( ullValue ); }
+            CLatencyHistogram      &GetHistogram( void ) { return m_histValues; }
+            double                  GetScale( void ) const { return m_dScale; }
+
+            virtual void            Write( CString &strOut );
+    };
+
+    class CMetricsRegistry : public CObject
+    {
+        protected:
+            CArray                  m_aMetrics;
+#ifdef IASLIB_MULTI_THREADED__
+            CMutex                  m_mutexRegistry;
+#endif
+
+                                    CMetricsRegistry( void );
+
+        public:
+            virtual                ~CMetricsRegistry( void );
+
+                                    DEFINE_OBJECT( CMetricsRegistry )
+
+            static CMetricsRegistry *GetInstance( void );
+
+                // These return the metric of that name, making it the first
+                // time. A name that's already taken by another type of metric
+                // gets NULL.
+            CCounter               *GetCounter( const char *strName, const char *strHelp );
+            CGauge                 *GetGauge( const char *strName, const char *strHelp );
+            CSummary               *GetSummary( const char *strName, const char *strHelp, double dScale = 0.000001 );
+
+            CMetric                *Find( const char *strName );
+
+            CString                 Format( void );
+
+        private:
+            CMetric                *find( const char *strName );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_STATS__
+
+#endif // IASLIB_METRICS_H__
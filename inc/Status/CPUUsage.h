@@ -9,6 +9,10 @@
  * object is created. To get elapsed time, use the Elapsed function
  * and pass it the previous or the current snapshot to get the 
  * difference.
+ *  A snapshot can be of the whole process, or of just the calling
+ * thread. There are also quick calls for the CPU time of one thread,
+ * the caller or any other, as a single count of microseconds, for
+ * timing work on a thread without the cost of a whole snapshot.
  *
  *	Author: Jeffrey R. Naujok
  *	Created: 2/24/2005
@@ -24,11 +28,19 @@
 
 #include "../BaseTypes/Object.h"
 #include "../BaseTypes/String_.h"
+#include "../Threading/Thread.h"
 
 namespace IASLib
 {
     class CCPUUsage : public CObject
     {
+        public:
+            enum Scope
+            {
+                PROCESS,
+                THREAD
+            };
+
         protected:
             int         m_nTotalSeconds;
             int         m_nTotaluSeconds;
@@ -39,6 +51,7 @@ namespace IASLib
 
         public:
                         CCPUUsage( void );
+                        CCPUUsage( Scope scope );
                         CCPUUsage( const CCPUUsage &oSource );
             virtual    ~CCPUUsage( void );
 
@@ -53,6 +66,14 @@ namespace IASLib
             void        GetTotalTime( int &nSec, int &nMicroSec );
             void        GetUserTime( int &nSec, int &nMicroSec );
             void        GetSystemTime( int &nSec, int &nMicroSec );
+
+            static unsigned long long GetThreadTime( void );
+#ifdef IASLIB_MULTI_THREADED__
+            static unsigned long long GetThreadTime( THREAD_T ptThread );
+#endif
+
+        protected:
+            void        Capture( Scope scope );
     };
 } // namespace IASLib
 
@@ -0,0 +1,93 @@
+/*
+ * Thread Profiler Class
+ *
+ *  This class answers "which threads, and which pool tasks, are using
+ * the CPU?" in a running process, without a debugger or an outside tool.
+ * Every CThread is labelled with its name as it starts, and a pooled
+ * thread is labelled with the class of the task it's running while it
+ * runs it. Two things are kept for each thread and task pair:
+ *
+ *  - The exact CPU time of every pool task, measured with the thread's
+ *    CPU clock as the task starts and finishes. This is always on.
+ *  - Samples: while the profiler is started, a SIGPROF timer ticks with
+ *    the process' CPU time, and each tick is counted against the labels
+ *    of whichever thread was running. Threads that spend time outside a
+ *    task (a listener spinning, say) show up here too.
+ *
+ *  Counting a sample takes no lock and makes no allocation, so it's safe
+ * in a signal handler; the table has a fixed size, and samples that
+ * don't fit in it are counted as dropped. Report() sorts it all into a
+ * table, busiest first.
+ *  Sampling needs POSIX signals; on Windows, Start() returns false and
+ * only the task times are kept. If nothing handled SIGPROF before Start(),
+ * Stop() leaves it ignored rather than fatal, since a last tick can still
+ * be on its way.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifndef IASLIB_THREADPROFILER_H__
+#define IASLIB_THREADPROFILER_H__
+
+#ifdef IASLIB_MULTI_THREADED__
+
+#include "../BaseTypes/Object.h"
+#include "../BaseTypes/String_.h"
+
+namespace IASLib
+{
+    class CThreadProfiler : public CObject
+    {
+        public:
+            enum
+            {
+                MAX_ENTRIES = 1024,
+                MAX_LABELS = 1024,
+                DEFAULT_HERTZ = 97
+            };
+
+            struct Entry
+            {
+                volatile unsigned long long m_ullKey;
+                const char *volatile m_strThread;
+                const char *volatile m_strTask;
+                volatile unsigned long long m_ullSamples;
+                volatile unsigned long long m_ullTasks;
+                volatile unsigned long long m_ullTaskMicros;
+            };
+
+        public:
+                                    DEFINE_OBJECT( CThreadProfiler )
+
+            static bool             Start( unsigned int nHertz = DEFAULT_HERTZ );
+            static void             Stop( void );
+            static bool             IsRunning( void );
+            static void             Reset( void );
+
+                // The name is copied, once, into a table kept for the life of
+                // the process, so it can be counted against after the thread
+                // is gone.
+            static void             SetThreadLabel( const char *strName );
+
+                // The task label isn't copied, so it must live as long as the
+                // process does; a class name from GetType() does.
+            static void             SetTaskLabel( const char *strTask );
+            static void             RecordTask( const char *strTask, unsigned long long ullMicros );
+
+            static unsigned long long GetSamples( void );
+            static unsigned long long GetDroppedSamples( void );
+
+            static CString          Report( void );
+
+        private:
+                                    CThreadProfiler( void );
+    };
+} // namespace IASLib
+
+#endif // IASLIB_MULTI_THREADED__
+
+#endif // IASLIB_THREADPROFILER_H__
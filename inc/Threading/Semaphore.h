@@ -39,6 +39,7 @@ namespace IASLib
             void                Wait( void );
             void                Post( void );
             bool                TryWait( void );
+            bool                TimedWait( unsigned long ulMilliseconds );
     };
 } // Namespace IASLib
 #endif // IASLIB_MULTI_THREADED__
@@ -9,6 +9,11 @@
 **      It also provides a static interface for checking whether the
 ** server is active and can also check the thread information to see
 ** if it should be shut down, etc.
+**      Given more than one acceptor, the server opens that many
+** listening sockets on the same port (SO_REUSEPORT), each accepted on
+** by its own thread, and the kernel balances new connections between
+** them. HandleConnection is then called from all of those threads at
+** once, and must be safe to do so.
 **
 **  $AUTHOR$
 **  $LOG$
@@ -21,6 +26,7 @@
 #include "../BaseTypes/Object.h"
 #include "../Sockets/ServerSocket.h"
 #include "../Threading/Thread.h"
+#include "../Collections/Array.h"
 
 #ifdef IASLIB_NETWORKING__
 #ifdef IASLIB_MULTI_THREADED__
@@ -32,14 +38,45 @@ namespace IASLib
             int             m_nPortNumber;
             int             m_nMaxBacklog;
             CServerSocket  *m_pServerSocket;
+            size_t          m_nAcceptors;
+            CArray          m_aAcceptors;
 
         public:
-                            CServerThread( const char *strThreadName, int nPortNumber, int nMaxBacklog = 16 );
+                            CServerThread( const char *strThreadName, int nPortNumber, int nMaxBacklog = CServerSocket::DEFAULT_BACKLOG );
+                            CServerThread( const char *strThreadName, int nPortNumber, size_t nAcceptors, int nMaxBacklog = CServerSocket::DEFAULT_BACKLOG );
             virtual        ~CServerThread( void );
 
             virtual void   *Run( void );
 
             virtual bool    HandleConnection( CSocket *pSocket ) = 0;
+
+            void            AcceptConnections( CServerSocket *pSocket, CThread *pThread );
+
+        protected:
+            CServerSocket  *CreateServerSocket( void );
+            void            StopAcceptors( void );
+    };
+
+    /**
+     * Server Acceptor Thread
+     *
+     *      One of the extra accepting threads of a multi-acceptor
+     * CServerThread. It owns its own listening socket, and hands every
+     * connection it accepts to the server's HandleConnection.
+     */
+    class CServerAcceptorThread : public CThread
+    {
+        protected:
+            CServerThread  *m_pServer;
+            CServerSocket  *m_pServerSocket;
+
+        public:
+                            CServerAcceptorThread( CServerThread *pServer, CServerSocket *pServerSocket, size_t nAcceptorNumber );
+            virtual        ~CServerAcceptorThread( void );
+
+            virtual void   *Run( void );
+
+            CServerSocket  *GetServerSocket( void ) { return m_pServerSocket; }
     };
 } // namespace IASLib
 #endif // IASLIB_MULTI_THREADED__
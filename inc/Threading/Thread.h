@@ -59,6 +59,7 @@
                 bool            m_bNoDelete;
                 bool            m_bDaemon;
                 CString         m_strThreadName;
+                unsigned long long m_ullCPUTime;
 
         #ifdef IASLIB_PTHREAD__
                 pthread_attr_t  m_stAttributes;
@@ -114,6 +115,9 @@
 
                 bool                    IsDaemon( void ) { return m_bDaemon; }
 
+                unsigned long long      GetCPUTime( void );
+                void                    RecordCPUTime( void );
+
                 void                    SetTimeout( int nSeconds );
 
                 virtual void            RequestShutdown( void ) { m_bShutdown = true; }
@@ -123,6 +127,17 @@
 
                 static bool             Equals( THREAD_T ptThread1, THREAD_T ptThread2 );
 
+                    // Whether threads really run in this build; without a
+                    // thread library, a CThread is made but never started.
+                static bool             IsAvailable( void )
+                {
+        #if defined( IASLIB_PTHREAD__ ) || defined( IASLIB_WIN32__ ) || defined( IASLIB_SUN__ )
+                    return true;
+        #else
+                    return false;
+        #endif
+                }
+
                 void                    Sleep( int nSeconds );
                 void                    Millisleep( int milliseconds );
 
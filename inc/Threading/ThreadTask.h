@@ -5,6 +5,10 @@
  * threadable tasks within the IAS library. It is recommended to subclass
  * this class with a concrete class for implementing tasks that are meant to
  * run threaded.
+ *  Tasks that are made and thrown away for every request should use
+ * DECLARE_POOLED_OBJECT (or DEFINE_POOLED_OBJECT) in place of the usual
+ * macro, so each concrete task class gets a pool of its own; this class
+ * can't usefully have one, since nothing is ever just a CThreadTask.
  *
  *
  *	Author: Jeffrey R. Naujok
@@ -45,6 +49,7 @@ namespace IASLib
         protected:
             CString                 m_strIdentifier;
             TASK_STATUS             m_currentStatus;
+            unsigned long long      m_ullCPUTime;
 
         public:
                                     CThreadTask( const char *strIdentifier )
@@ -59,6 +64,7 @@ namespace IASLib
                                         }
 
                                         m_currentStatus = PREQUEUE;
+                                        m_ullCPUTime = 0;
                                     };
             virtual                ~CThreadTask( void ) {}
 
@@ -69,6 +75,10 @@ namespace IASLib
 
             virtual CString         GetIdentifier( void ) { return m_strIdentifier; }
 
+                // The CPU time, in microseconds, the task took to run, once it
+                // has. Only of use with a pool that retains its tasks.
+            unsigned long long      GetCPUTime( void ) { return m_ullCPUTime; }
+
         private:
             friend class CThreadPool;
             friend class CRunThread;
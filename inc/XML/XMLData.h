@@ -30,7 +30,7 @@ namespace IASLib
                             CXMLData( const CString &strData );
             virtual        ~CXMLData( void );
 
-                            DECLARE_OBJECT(CXMLData,CXMLChunk);
+                            DECLARE_POOLED_OBJECT(CXMLData,CXMLChunk);
 
             virtual CString GetData( void ) { return m_strData; }
             virtual void    SetData( const CString &strData ) { m_strData = strData; }
@@ -11,6 +11,8 @@
  *		However, to retain compatibility, this class will actually load an
  * XML Index/Element/Property hierarchy as it runs. This should make any
  * conversion from the old system much simpler.
+ *		The elements, properties and data read are made in an arena that
+ * belongs to the document, and goes with it.
  *
  *	@author Jeffrey R. Naujok
  *  @date 02/10/2006
@@ -34,6 +36,9 @@ namespace IASLib
     class CXMLDocument : public CObject
     {
         protected:
+                // Declared first, so it goes last: the elements and
+                // properties read into the index are made in it.
+            CArena      m_arena;
             CXMLIndex   m_xiIndex;
             CStream    *m_pInput;
             CStack      m_stackTags;
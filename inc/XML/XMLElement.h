@@ -43,7 +43,7 @@ namespace IASLib
                                 CXMLElement( CString strTagName, CString strData );
             virtual            ~CXMLElement( void );
 
-                                DEFINE_OBJECT( CXMLElement )
+                                DEFINE_POOLED_OBJECT( CXMLElement )
 
             CXMLProperty       *GetProperty( size_t nIndex ) const;
             size_t              GetPropertyCount( void ) const { return m_aProperties.Length(); } 
@@ -31,7 +31,7 @@ namespace IASLib
                         CXMLProperty( const char *strName, const char *strValue );
             virtual    ~CXMLProperty( void );
 
-                        DEFINE_OBJECT( CXMLProperty )
+                        DEFINE_POOLED_OBJECT( CXMLProperty )
 
             const char *GetName( void ) const { return (const char *)m_strName; }
             const char *GetValue( void ) const { return (const char *)m_strValue; }
@@ -0,0 +1,276 @@
+/**
+ * CArena class
+ *
+ *      Bump allocation out of CObjectPool chunks, which are marked as the
+ * arena's so that a pooled object's delete can tell where it came from.
+ * A region is freed by whoever drops its last reference: the arena, when
+ * it's reset or destroyed, or the last of the region's objects.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "Arena.h"
+#include "String_.h"
+#include <new>
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CArena, CObject );
+
+#ifdef IASLIB_MULTI_THREADED__
+    #ifdef IASLIB_WIN32__
+    static __declspec( thread ) CArena *s_pCurrentArena = NULL;
+
+    static long AddReference( volatile long *pnReferences ) { return InterlockedIncrement( pnReferences ); }
+    static long DropReference( volatile long *pnReferences ) { return InterlockedDecrement( pnReferences ); }
+    #else
+    static __thread CArena *s_pCurrentArena = NULL;
+
+    static long AddReference( volatile long *pnReferences ) { return __sync_add_and_fetch( pnReferences, 1 ); }
+    static long DropReference( volatile long *pnReferences ) { return __sync_sub_and_fetch( pnReferences, 1 ); }
+    #endif
+#else
+    static CArena *s_pCurrentArena = NULL;
+
+    static long AddReference( volatile long *pnReferences ) { return ++(*pnReferences); }
+    static long DropReference( volatile long *pnReferences ) { return --(*pnReferences); }
+#endif
+
+    CArena::CArena( void )
+    {
+        m_pRegion = NULL;
+        m_pNext = NULL;
+        m_pEnd = NULL;
+        m_nBytesAllocated = 0;
+        m_nBytesReserved = 0;
+        m_ullObjects = 0;
+    }
+
+        // Objects still alive keep the region going without us.
+    CArena::~CArena( void )
+    {
+        if ( s_pCurrentArena == this )
+        {
+            s_pCurrentArena = NULL;
+        }
+
+        if ( ( m_pRegion ) && ( DropReference( &m_pRegion->m_nReferences ) == 0 ) )
+        {
+            ReleaseRegion( m_pRegion );
+        }
+    }
+
+    /**
+     * Allocate
+     *
+     *      Allocates nSize bytes, aligned on 16, that last until the arena
+     * is reset or destroyed. There's nothing to release.
+     *
+     * @return
+     *      The memory, or NULL if the system is out of it.
+     */
+    void *CArena::Allocate( size_t nSize )
+    {
+        nSize = ( nSize + 15 ) & ~(size_t)15;
+
+        if ( nSize > CObjectPool::CHUNK_BYTES - sizeof( CObjectPool::Chunk ) )
+        {
+                // A chunk of its own, which doesn't become the current one.
+            if ( ( m_pRegion == NULL ) && ( ! NewRegion() ) )
+            {
+                return NULL;
+            }
+
+            CObjectPool::Chunk *pChunk = CObjectPool::AllocateChunk( sizeof( CObjectPool::Chunk ) + nSize );
+            if ( pChunk == NULL )
+            {
+                return NULL;
+            }
+
+            pChunk->m_nMagic = CObjectPool::CHUNK_ARENA_MAGIC;
+            pChunk->m_pOwner = m_pRegion;
+            pChunk->m_pNext = m_pRegion->m_pChunks;
+            m_pRegion->m_pChunks = pChunk;
+            m_nBytesReserved += pChunk->m_nBytes;
+            m_nBytesAllocated += nSize;
+
+            return pChunk + 1;
+        }
+
+        return Carve( nSize );
+    }
+
+    /**
+     * AllocateObject
+     *
+     *      Allocates a pooled object's block, which keeps the arena's memory
+     * around until ReleaseObject() is called for it. Throws bad_alloc, as
+     * operator new does, if the system is out of memory.
+     */
+    void *CArena::AllocateObject( size_t nSize )
+    {
+        void *p = Carve( ( nSize + 15 ) & ~(size_t)15 );
+
+        if ( p == NULL )
+        {
+            throw std::bad_alloc();
+        }
+
+        AddReference( &m_pRegion->m_nReferences );
+        m_ullObjects++;
+
+        return p;
+    }
+
+    /**
+     * ReleaseObject
+     *
+     *      Called by a pooled object's delete for a block that came from an
+     * arena. The memory stays where it is; the region is freed if this
+     * was the last thing holding on to it.
+     */
+    void CArena::ReleaseObject( void *p )
+    {
+        Region *pRegion = (Region *)CObjectPool::GetChunk( p )->m_pOwner;
+
+        if ( DropReference( &pRegion->m_nReferences ) == 0 )
+        {
+            ReleaseRegion( pRegion );
+        }
+    }
+
+    /**
+     * Reset
+     *
+     *      Starts the arena over. If nothing made in it is still alive, the
+     * first chunk is kept for reuse and the rest are freed; otherwise the
+     * chunks are left to the objects, and freed along with the last one.
+     */
+    void CArena::Reset( void )
+    {
+        if ( m_pRegion == NULL )
+        {
+            return;
+        }
+
+        if ( m_pRegion->m_nReferences == 1 )
+        {
+            CObjectPool::Chunk *pKeep = m_pRegion->m_pChunks;
+
+                // The oldest chunk is at the end of the list; it's kept if
+                // it's a standard one, and not one made for a big Allocate().
+            while ( ( pKeep ) && ( ( pKeep->m_pNext ) || ( pKeep->m_nBytes != CObjectPool::CHUNK_BYTES ) ) )
+            {
+                CObjectPool::Chunk *pNext = pKeep->m_pNext;
+                m_pRegion->m_pChunks = pNext;
+                m_nBytesReserved -= pKeep->m_nBytes;
+                CObjectPool::ReleaseChunk( pKeep );
+                pKeep = pNext;
+            }
+
+            m_pNext = ( pKeep ) ? (char *)( pKeep + 1 ) : NULL;
+            m_pEnd = ( pKeep ) ? (char *)pKeep + CObjectPool::CHUNK_BYTES : NULL;
+        }
+        else
+        {
+            if ( DropReference( &m_pRegion->m_nReferences ) == 0 )
+            {
+                ReleaseRegion( m_pRegion );
+            }
+            m_pRegion = NULL;
+            m_pNext = NULL;
+            m_pEnd = NULL;
+            m_nBytesReserved = 0;
+        }
+
+        m_nBytesAllocated = 0;
+    }
+
+    size_t CArena::GetLiveObjects( void ) const
+    {
+        return ( m_pRegion ) ? (size_t)( m_pRegion->m_nReferences - 1 ) : 0;
+    }
+
+    CArena *CArena::GetCurrent( void )
+    {
+        return s_pCurrentArena;
+    }
+
+        // Returns the arena that was current before.
+    CArena *CArena::SetCurrent( CArena *pArena )
+    {
+        CArena *pPrevious = s_pCurrentArena;
+        s_pCurrentArena = pArena;
+        return pPrevious;
+    }
+
+    bool CArena::NewRegion( void )
+    {
+        m_pRegion = (Region *)malloc( sizeof( Region ) );
+        if ( m_pRegion == NULL )
+        {
+            return false;
+        }
+
+        m_pRegion->m_pChunks = NULL;
+        m_pRegion->m_nReferences = 1;
+        m_pNext = NULL;
+        m_pEnd = NULL;
+        m_nBytesReserved = 0;
+
+        return true;
+    }
+
+        // Takes nSize bytes (already rounded to 16, and no more than a
+        // chunk's worth) from the current chunk, starting a new one if it
+        // hasn't room.
+    void *CArena::Carve( size_t nSize )
+    {
+        if ( ( m_pNext == NULL ) || ( nSize > (size_t)( m_pEnd - m_pNext ) ) )
+        {
+            if ( ( m_pRegion == NULL ) && ( ! NewRegion() ) )
+            {
+                return NULL;
+            }
+
+            CObjectPool::Chunk *pChunk = CObjectPool::AllocateChunk( CObjectPool::CHUNK_BYTES );
+            if ( pChunk == NULL )
+            {
+                return NULL;
+            }
+
+            pChunk->m_nMagic = CObjectPool::CHUNK_ARENA_MAGIC;
+            pChunk->m_pOwner = m_pRegion;
+            pChunk->m_pNext = m_pRegion->m_pChunks;
+            m_pRegion->m_pChunks = pChunk;
+            m_nBytesReserved += pChunk->m_nBytes;
+
+            m_pNext = (char *)( pChunk + 1 );
+            m_pEnd = (char *)pChunk + CObjectPool::CHUNK_BYTES;
+        }
+
+        void *p = m_pNext;
+        m_pNext += nSize;
+        m_nBytesAllocated += nSize;
+
+        return p;
+    }
+
+    void CArena::ReleaseRegion( Region *pRegion )
+    {
+        CObjectPool::Chunk *pChunk = pRegion->m_pChunks;
+
+        while ( pChunk )
+        {
+            CObjectPool::Chunk *pNext = pChunk->m_pNext;
+            CObjectPool::ReleaseChunk( pChunk );
+            pChunk = pNext;
+        }
+
+        free( pRegion );
+    }
+} // End of Namespace IASLib
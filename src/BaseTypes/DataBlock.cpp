@@ -145,7 +145,17 @@ namespace IASLib
     {
         CheckGuardposts();
         if ( m_pBuffer )
-            delete m_pBuffer;
+        {
+#ifdef IASLIB_MEMORY_MANAGER__
+    #ifdef IASLIB_DEBUG__
+            CMemoryManager::GetNewAllocator()->ReleaseDebug( m_pBuffer, __FILE__, __LINE__ );
+    #else
+            CMemoryManager::GetNewAllocator()->Release( m_pBuffer );
+    #endif
+#else
+            free( m_pBuffer );
+#endif
+        }
         m_pBuffer = NULL;
         m_nSize = 0;
         m_nGuardpostSize = 0;
@@ -351,9 +361,9 @@ namespace IASLib
     {
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-        m_pBuffer = (unsigned char *)CMemoryManager::ReallocateDebug( m_pBuffer, nLength + (m_nGuarpostSize * 2), __FILE__, __LINE__ );
+        m_pBuffer = (unsigned char *)CMemoryManager::GetNewAllocator()->ReallocateDebug( m_pBuffer, nLength + (m_nGuardpostSize * 2), __FILE__, __LINE__ );
     #else
-        m_pBuffer = (unsigned char *)CMemoryManager::Reallocate( m_pBuffer, nLength + (m_nGuarpostSize * 2) );
+        m_pBuffer = (unsigned char *)CMemoryManager::GetNewAllocator()->Reallocate( m_pBuffer, nLength + (m_nGuardpostSize * 2) );
     #endif
 #else
         m_pBuffer = (unsigned char *)realloc( m_pBuffer, (size_t)(nLength  + (m_nGuardpostSize * 2)) );
@@ -18,6 +18,9 @@
 #ifdef IASLIB_MULTI_THREADED__
 #include "Mutex.h"
 #endif
+#ifdef IASLIB_MEMORY_MANAGER__
+#include "MemoryManager.h"
+#endif
 
 namespace IASLib
 {
@@ -82,7 +85,11 @@ namespace IASLib
         // Allocate an extra 32 bytes
         blocks += 3;
 
+#ifdef IASLIB_MEMORY_MANAGER__
+        void *p = CMemoryManager::GetNewAllocator()->Allocate( blocks * 16 );
+#else
         void *p = malloc( blocks * 16 );
+#endif
         // printf( "New: %u (%u)\n", (unsigned long)p, (unsigned long)size );
         // Pre-allocate the memory to zero.
         memset( p, 0, blocks * 16 );
@@ -158,6 +165,10 @@ namespace IASLib
         }
 
         // Release the memory
+#ifdef IASLIB_MEMORY_MANAGER__
+        CMemoryManager::GetNewAllocator()->Release( pBase );
+#else
         free( pBase );
+#endif
     }
 } // End of Namespace
@@ -0,0 +1,505 @@
+/**
+ * CObjectPool class
+ *
+ *      The pool behind the pooled classes' operator new and delete. A
+ * thread's list of blocks for each pool is kept in a thread-local array,
+ * indexed by the number the pool was given when it was made; the first
+ * MAX_CACHED_POOLS pools get one, and any after that take the pool's lock
+ * every time. When a thread ends, its lists go back to their pools.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "ObjectPool.h"
+#include "Arena.h"
+#include "String_.h"
+#include <new>
+#ifndef IASLIB_WIN32__
+#include <stdlib.h>
+#else
+#include <malloc.h>
+#endif
+
+#ifdef IASLIB_MULTI_THREADED__
+    #ifdef IASLIB_PTHREAD__
+        #include <pthread.h>
+        #define IASLIB_POOL_THREAD_CACHE__
+    #endif
+    #ifdef IASLIB_WIN32__
+        #define IASLIB_POOL_THREAD_CACHE__
+    #endif
+#else
+    #define IASLIB_POOL_THREAD_CACHE__
+#endif
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CObjectPool, CObject );
+
+    struct PoolCache
+    {
+        void       *m_pHead;
+        size_t      m_nCount;
+    };
+
+    static CObjectPool *s_apPools[ CObjectPool::MAX_CACHED_POOLS ];
+    static size_t s_nPools = 0;
+
+        // Pools can be made while statics are still being constructed, so
+        // the lock is made the first time it's wanted.
+    static CMutex &PoolsMutex( void )
+    {
+        static CMutex mutexPools;
+        return mutexPools;
+    }
+
+#ifdef IASLIB_POOL_THREAD_CACHE__
+    #ifdef IASLIB_MULTI_THREADED__
+        #ifdef IASLIB_PTHREAD__
+            // The lists are plain thread locals, for speed; the key is only
+            // there so they're given back when the thread ends.
+    static __thread PoolCache s_aPoolCaches[ CObjectPool::MAX_CACHED_POOLS ];
+    static __thread bool s_bPoolCachesInUse = false;
+    static __thread bool s_bPoolThreadEnded = false;
+    static pthread_key_t s_keyPoolCaches;
+    static pthread_once_t s_oncePoolCaches = PTHREAD_ONCE_INIT;
+
+    static void PoolCachesDestructor( void * )
+    {
+        CObjectPool::ReleaseThreadCaches();
+        s_bPoolThreadEnded = true;
+    }
+
+    static void CreatePoolCachesKey( void )
+    {
+        pthread_key_create( &s_keyPoolCaches, PoolCachesDestructor );
+    }
+
+    static void RegisterPoolCaches( void )
+    {
+        pthread_once( &s_oncePoolCaches, CreatePoolCachesKey );
+        pthread_setspecific( s_keyPoolCaches, s_aPoolCaches );
+    }
+        #else
+    static __declspec( thread ) PoolCache s_aPoolCaches[ CObjectPool::MAX_CACHED_POOLS ];
+    static __declspec( thread ) bool s_bPoolCachesInUse = false;
+    static __declspec( thread ) bool s_bPoolThreadEnded = false;
+    static DWORD s_dwPoolCachesIndex = FLS_OUT_OF_INDEXES;
+
+    static void WINAPI PoolCachesDestructor( void * )
+    {
+        CObjectPool::ReleaseThreadCaches();
+        s_bPoolThreadEnded = true;
+    }
+
+    static void RegisterPoolCaches( void )
+    {
+        if ( s_dwPoolCachesIndex == FLS_OUT_OF_INDEXES )
+        {
+            DWORD dwIndex = FlsAlloc( PoolCachesDestructor );
+            if ( InterlockedCompareExchange( (LONG volatile *)&s_dwPoolCachesIndex, (LONG)dwIndex, (LONG)FLS_OUT_OF_INDEXES ) != (LONG)FLS_OUT_OF_INDEXES )
+            {
+                FlsFree( dwIndex );
+            }
+        }
+        FlsSetValue( s_dwPoolCachesIndex, s_aPoolCaches );
+    }
+        #endif
+    #else
+            // Only the one thread, which never ends before the process does.
+    static PoolCache s_aPoolCaches[ CObjectPool::MAX_CACHED_POOLS ];
+    static bool s_bPoolCachesInUse = false;
+    static bool s_bPoolThreadEnded = false;
+
+    static void RegisterPoolCaches( void )
+    {
+    }
+    #endif
+
+        // The calling thread's list for a pool, or NULL if the pool doesn't
+        // have one or the thread is on its way out.
+    static PoolCache *GetPoolCache( size_t nIndex )
+    {
+        if ( ( nIndex >= CObjectPool::MAX_CACHED_POOLS ) || ( s_bPoolThreadEnded ) )
+        {
+            return NULL;
+        }
+
+        if ( ! s_bPoolCachesInUse )
+        {
+            s_bPoolCachesInUse = true;
+            RegisterPoolCaches();
+        }
+
+        return &s_aPoolCaches[ nIndex ];
+    }
+#endif
+
+    /**
+     * Constructor
+     *
+     *      Makes a pool for objects of the given size, which is rounded up
+     * to 16 bytes so the blocks are aligned as well as malloc()'s. The name
+     * is kept, not copied: it's meant to be the class name. A pool made
+     * with bUseArenas false ignores arena scopes, for objects that are
+     * often kept long after the scope they were made in.
+     */
+    CObjectPool::CObjectPool( size_t nObjectSize, const char *strName, bool bUseArenas )
+    {
+        m_strName = strName;
+        m_bUseArenas = bUseArenas;
+        m_nBlockSize = ( nObjectSize < 16 ) ? 16 : ( ( nObjectSize + 15 ) & ~(size_t)15 );
+        if ( m_nBlockSize > MAX_POOLED_BLOCK )
+        {
+                // Too big to be worth it: every object is oversize.
+            m_nBlockSize = 0;
+        }
+
+            // About 4K moves between a thread and the pool at a time.
+        m_nBatch = ( m_nBlockSize ) ? 4096 / m_nBlockSize : 4;
+        m_nBatch = ( m_nBatch < 4 ) ? 4 : ( ( m_nBatch > 32 ) ? 32 : m_nBatch );
+
+        m_pFree = NULL;
+        m_nFree = 0;
+        m_pChunks = NULL;
+        m_pUnused = NULL;
+        m_pUnusedEnd = NULL;
+        m_nChunks = 0;
+        m_nBlocksCarved = 0;
+        m_ullOversize = 0;
+
+        PoolsMutex().Lock();
+        m_nCacheIndex = NOT_FOUND;
+        if ( s_nPools < MAX_CACHED_POOLS )
+        {
+            m_nCacheIndex = s_nPools;
+            s_apPools[ s_nPools++ ] = this;
+        }
+        PoolsMutex().Unlock();
+    }
+
+        // Every block from the pool goes with it, so it must only be
+        // destroyed once they've all been released. The pools made by the
+        // pooled class macros never are.
+    CObjectPool::~CObjectPool( void )
+    {
+        PoolsMutex().Lock();
+        if ( m_nCacheIndex != NOT_FOUND )
+        {
+            s_apPools[ m_nCacheIndex ] = NULL;
+        }
+        PoolsMutex().Unlock();
+
+        while ( m_pChunks )
+        {
+            Chunk *pNext = m_pChunks->m_pNext;
+            ReleaseChunk( m_pChunks );
+            m_pChunks = pNext;
+        }
+    }
+
+    /**
+     * Create
+     *
+     *      Makes a pool for the pooled class macros. It's made here, rather
+     * than by the inline code the macros expand to, so that it's always
+     * made the size the library was built with.
+     */
+    CObjectPool *CObjectPool::Create( size_t nObjectSize, const char *strName, bool bUseArenas )
+    {
+        return new CObjectPool( nObjectSize, strName, bUseArenas );
+    }
+
+    void *CObjectPool::Allocate( size_t nSize )
+    {
+        if ( nSize > m_nBlockSize )
+        {
+            m_mutexPool.Lock();
+            m_ullOversize++;
+            m_mutexPool.Unlock();
+            return ::operator new( nSize );
+        }
+
+        if ( m_bUseArenas )
+        {
+            CArena *pArena = CArena::GetCurrent();
+            if ( pArena )
+            {
+                return pArena->AllocateObject( m_nBlockSize );
+            }
+        }
+
+#ifdef IASLIB_POOL_THREAD_CACHE__
+        PoolCache *pCache = GetPoolCache( m_nCacheIndex );
+        if ( pCache )
+        {
+            if ( pCache->m_pHead == NULL )
+            {
+                pCache->m_nCount = TakeBatch( &pCache->m_pHead );
+                if ( pCache->m_pHead == NULL )
+                {
+                    throw std::bad_alloc();
+                }
+            }
+
+            void *p = pCache->m_pHead;
+            pCache->m_pHead = *(void **)p;
+            pCache->m_nCount--;
+            return p;
+        }
+#endif
+
+        m_mutexPool.Lock();
+        void *p = TakeBlock();
+        m_mutexPool.Unlock();
+
+        if ( p == NULL )
+        {
+            throw std::bad_alloc();
+        }
+
+        return p;
+    }
+
+    void CObjectPool::Release( void *p, size_t nSize )
+    {
+        if ( p == NULL )
+        {
+            return;
+        }
+
+        if ( nSize > m_nBlockSize )
+        {
+            ::operator delete( p );
+            return;
+        }
+
+        if ( ( m_bUseArenas ) && ( GetChunk( p )->m_nMagic == CHUNK_ARENA_MAGIC ) )
+        {
+            CArena::ReleaseObject( p );
+            return;
+        }
+
+#ifdef IASLIB_POOL_THREAD_CACHE__
+        PoolCache *pCache = GetPoolCache( m_nCacheIndex );
+        if ( pCache )
+        {
+            *(void **)p = pCache->m_pHead;
+            pCache->m_pHead = p;
+            pCache->m_nCount++;
+
+                // Two batches is enough for anyone: give one back.
+            if ( pCache->m_nCount > m_nBatch * 2 )
+            {
+                void *pList = pCache->m_pHead;
+                void *pLast = pList;
+                for ( size_t nBlock = 1; nBlock < m_nBatch; nBlock++ )
+                {
+                    pLast = *(void **)pLast;
+                }
+                pCache->m_pHead = *(void **)pLast;
+                pCache->m_nCount -= m_nBatch;
+                *(void **)pLast = NULL;
+                GiveBatch( pList, m_nBatch );
+            }
+            return;
+        }
+#endif
+
+        GiveBatch( p, 1 );
+    }
+
+    /**
+     * TakeBatch
+     *
+     *      Takes up to a batch of blocks from the pool, as a list linked
+     * through their first words.
+     *
+     * @return
+     *      How many blocks are on the list, which is none only if the
+     *      system is out of memory.
+     */
+    size_t CObjectPool::TakeBatch( void **ppList )
+    {
+        void *pList = NULL;
+        size_t nTaken = 0;
+
+        m_mutexPool.Lock();
+        while ( nTaken < m_nBatch )
+        {
+            void *p = TakeBlock();
+            if ( p == NULL )
+            {
+                break;
+            }
+            *(void **)p = pList;
+            pList = p;
+            nTaken++;
+        }
+        m_mutexPool.Unlock();
+
+        *ppList = pList;
+        return nTaken;
+    }
+
+    /**
+     * GiveBatch
+     *
+     *      Puts a list of blocks back on the pool's free list. The list is
+     * linked through the blocks' first words; only the first nCount are
+     * taken, whatever the last of them points at.
+     */
+    void CObjectPool::GiveBatch( void *pList, size_t nCount )
+    {
+        if ( ( pList == NULL ) || ( nCount == 0 ) )
+        {
+            return;
+        }
+
+        void *pLast = pList;
+        for ( size_t nBlock = 1; nBlock < nCount; nBlock++ )
+        {
+            pLast = *(void **)pLast;
+        }
+
+        m_mutexPool.Lock();
+        *(void **)pLast = m_pFree;
+        m_pFree = pList;
+        m_nFree += nCount;
+        m_mutexPool.Unlock();
+    }
+
+        // Blocks held in threads' lists count as neither free nor in use;
+        // the counts are the pool's own.
+    void CObjectPool::GetStats( PoolStats &stats )
+    {
+        m_mutexPool.Lock();
+        stats.m_nBlockSize = m_nBlockSize;
+        stats.m_nChunks = m_nChunks;
+        stats.m_nBytesReserved = m_nChunks * CHUNK_BYTES;
+        stats.m_nBlocksCarved = m_nBlocksCarved;
+        stats.m_nFree = m_nFree;
+        stats.m_ullOversize = m_ullOversize;
+        m_mutexPool.Unlock();
+    }
+
+    /**
+     * ReleaseThreadCaches
+     *
+     *      Gives the calling thread's blocks back to every pool. Called by
+     * itself when a thread ends; a thread that's done with pooled objects
+     * for a good while can call it sooner.
+     */
+    void CObjectPool::ReleaseThreadCaches( void )
+    {
+#ifdef IASLIB_POOL_THREAD_CACHE__
+        if ( ! s_bPoolCachesInUse )
+        {
+            return;
+        }
+
+        PoolsMutex().Lock();
+        size_t nPools = s_nPools;
+        PoolsMutex().Unlock();
+
+        for ( size_t nIndex = 0; nIndex < nPools; nIndex++ )
+        {
+            PoolCache *pCache = &s_aPoolCaches[ nIndex ];
+
+            if ( ( pCache->m_pHead ) && ( s_apPools[ nIndex ] ) )
+            {
+                s_apPools[ nIndex ]->GiveBatch( pCache->m_pHead, pCache->m_nCount );
+            }
+            pCache->m_pHead = NULL;
+            pCache->m_nCount = 0;
+        }
+#endif
+    }
+
+        // Called with the pool locked. The free list comes first, then the
+        // part of the newest chunk not yet handed out.
+    void *CObjectPool::TakeBlock( void )
+    {
+        void *p = m_pFree;
+
+        if ( p )
+        {
+            m_pFree = *(void **)p;
+            m_nFree--;
+            return p;
+        }
+
+        if ( ( m_pUnused == NULL ) || ( m_nBlockSize > (size_t)( m_pUnusedEnd - m_pUnused ) ) )
+        {
+            Chunk *pChunk = AllocateChunk( CHUNK_BYTES );
+
+            if ( pChunk == NULL )
+            {
+                return NULL;
+            }
+
+            pChunk->m_nMagic = CHUNK_POOL_MAGIC;
+            pChunk->m_pOwner = this;
+            pChunk->m_pNext = m_pChunks;
+            m_pChunks = pChunk;
+            m_nChunks++;
+            m_pUnused = (char *)( pChunk + 1 );
+            m_pUnusedEnd = (char *)pChunk + CHUNK_BYTES;
+        }
+
+        p = m_pUnused;
+        m_pUnused += m_nBlockSize;
+        m_nBlocksCarved++;
+
+        return p;
+    }
+    /**
+     * AllocateChunk
+     *
+     *      Gets a chunk of at least nBytes from the system, aligned on
+     * CHUNK_BYTES so that GetChunk() can find it from any block in its
+     * first CHUNK_BYTES. The header is left for the caller to fill in.
+     */
+    CObjectPool::Chunk *CObjectPool::AllocateChunk( size_t nBytes )
+    {
+        void *p = NULL;
+
+        if ( nBytes < CHUNK_BYTES )
+        {
+            nBytes = CHUNK_BYTES;
+        }
+
+#ifdef IASLIB_WIN32__
+        p = _aligned_malloc( nBytes, CHUNK_BYTES );
+#else
+        if ( posix_memalign( &p, CHUNK_BYTES, nBytes ) != 0 )
+        {
+            p = NULL;
+        }
+#endif
+
+        if ( p )
+        {
+            ((Chunk *)p)->m_nBytes = nBytes;
+        }
+
+        return (Chunk *)p;
+    }
+
+    void CObjectPool::ReleaseChunk( Chunk *pChunk )
+    {
+        if ( pChunk )
+        {
+            pChunk->m_nMagic = 0;
+#ifdef IASLIB_WIN32__
+            _aligned_free( pChunk );
+#else
+            free( pChunk );
+#endif
+        }
+    }
+} // End of Namespace IASLib
@@ -0,0 +1,286 @@
+/*
+ * CStringBuilder Class
+ *
+ *      Builds a string a piece at a time in one growing buffer. Appending
+ * to a CString has to make sure the string's stub isn't shared first, and
+ * numbers and formatted text go through a temporary CString (and
+ * Format()'s shared buffer, under a global lock). The builder appends
+ * characters, strings, numbers and printf style formats straight into
+ * its own buffer, which grows geometrically, so building a string of N
+ * characters takes time linear in N. ToString() hands back the result.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "StringBuilder.h"
+#include "Exception.h"
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CStringBuilder, CObject );
+
+    CStringBuilder::CStringBuilder( size_t nCapacity )
+    {
+        m_strBuffer = NULL;
+        m_nLength = 0;
+        m_nCapacity = 0;
+
+        Reserve( nCapacity );
+    }
+
+    CStringBuilder::CStringBuilder( const CStringBuilder &oSource )
+    {
+        m_strBuffer = NULL;
+        m_nLength = 0;
+        m_nCapacity = 0;
+
+        Append( oSource.m_strBuffer, oSource.m_nLength );
+    }
+
+    CStringBuilder::~CStringBuilder( void )
+    {
+        free( m_strBuffer );
+        m_strBuffer = NULL;
+    }
+
+    CStringBuilder &CStringBuilder::operator =( const CStringBuilder &oSource )
+    {
+        if ( this != &oSource )
+        {
+            Truncate( 0 );
+            Append( oSource.m_strBuffer, oSource.m_nLength );
+        }
+
+        return *this;
+    }
+
+    CStringBuilder &CStringBuilder::Append( const IASLibChar__ *strSource )
+    {
+        if ( strSource )
+        {
+            Append( strSource, strlen( strSource ) );
+        }
+
+        return *this;
+    }
+
+    CStringBuilder &CStringBuilder::Append( const IASLibChar__ *strSource, size_t nLength )
+    {
+        if ( nLength )
+        {
+            memcpy( Extend( nLength ), strSource, nLength * sizeof( IASLibChar__ ) );
+        }
+
+        return *this;
+    }
+
+    CStringBuilder &CStringBuilder::Append( const CString &strSource )
+    {
+        return Append( (const IASLibChar__ *)strSource, strSource.GetLength() );
+    }
+
+    CStringBuilder &CStringBuilder::Append( IASLibChar__ chSource )
+    {
+        if ( m_nLength == m_nCapacity )
+        {
+            Reserve( m_nLength + 1 );
+        }
+
+        m_strBuffer[ m_nLength++ ] = chSource;
+        m_strBuffer[ m_nLength ] = 0;
+
+        return *this;
+    }
+
+    CStringBuilder &CStringBuilder::Append( IASLibChar__ chSource, size_t nCount )
+    {
+        if ( nCount )
+        {
+            memset( Extend( nCount ), chSource, nCount );
+        }
+
+        return *this;
+    }
+
+        // Integers are written out digit by digit, from the right, into a
+        // scratch buffer; that's a good deal quicker than going through
+        // printf.
+    CStringBuilder &CStringBuilder::AppendInt( long long nValue )
+    {
+        if ( nValue < 0 )
+        {
+            Append( '-' );
+            return AppendUnsigned( 0ULL - (unsigned long long)nValue );
+        }
+
+        return AppendUnsigned( (unsigned long long)nValue );
+    }
+
+    CStringBuilder &CStringBuilder::AppendUnsigned( unsigned long long nValue )
+    {
+        IASLibChar__ achDigits[24];
+        IASLibChar__ *pDigit = achDigits + sizeof( achDigits );
+
+        do
+        {
+            *--pDigit = (IASLibChar__)( '0' + ( nValue % 10 ) );
+            nValue /= 10;
+        } while ( nValue );
+
+        return Append( pDigit, (size_t)( achDigits + sizeof( achDigits ) - pDigit ) );
+    }
+
+    CStringBuilder &CStringBuilder::AppendHex( unsigned long long nValue, bool bUpperCase )
+    {
+        const IASLibChar__ *strDigits = ( bUpperCase ) ? "0123456789ABCDEF" : "0123456789abcdef";
+        IASLibChar__ achDigits[16];
+        IASLibChar__ *pDigit = achDigits + sizeof( achDigits );
+
+        do
+        {
+            *--pDigit = strDigits[ nValue & 0x0F ];
+            nValue >>= 4;
+        } while ( nValue );
+
+        return Append( pDigit, (size_t)( achDigits + sizeof( achDigits ) - pDigit ) );
+    }
+
+        // Appends a double with nPrecision digits after the decimal point
+        // (as "%.*f" would), or, if nPrecision is negative, in the shortest
+        // form that reads back as the same value.
+    CStringBuilder &CStringBuilder::AppendDouble( double dValue, int nPrecision )
+    {
+        if ( nPrecision < 0 )
+        {
+            return AppendFormat( "%.17g", dValue );
+        }
+
+        return AppendFormat( "%.*f", nPrecision, dValue );
+    }
+
+    CStringBuilder &CStringBuilder::AppendFormat( const IASLibChar__ *strFormat, ... )
+    {
+        va_list vaArgList;
+
+        va_start( vaArgList, strFormat );
+        AppendFormatV( strFormat, vaArgList );
+        va_end( vaArgList );
+
+        return *this;
+    }
+
+    /**
+     * AppendFormatV
+     *
+     *      Formats straight into the end of the buffer. If what's left of
+     * the buffer is too small, it's grown to fit and the format is run
+     * again; there's no limit on how long the result can be.
+     */
+    CStringBuilder &CStringBuilder::AppendFormatV( const IASLibChar__ *strFormat, va_list vaArgList )
+    {
+        va_list vaRetry;
+        int     nWritten;
+
+        if ( m_nCapacity - m_nLength < DEFAULT_CAPACITY )
+        {
+            Reserve( m_nLength + DEFAULT_CAPACITY );
+        }
+
+        va_copy( vaRetry, vaArgList );
+#ifdef IASLIB_WIN32__
+        nWritten = _vscprintf( strFormat, vaArgList );
+        if ( nWritten > 0 )
+        {
+            Reserve( m_nLength + (size_t)nWritten );
+            vsprintf_s( m_strBuffer + m_nLength, m_nCapacity - m_nLength + 1, strFormat, vaRetry );
+        }
+#else
+        nWritten = vsnprintf( m_strBuffer + m_nLength, m_nCapacity - m_nLength + 1, strFormat, vaArgList );
+        if ( ( nWritten > 0 ) && ( (size_t)nWritten > m_nCapacity - m_nLength ) )
+        {
+            Reserve( m_nLength + (size_t)nWritten );
+            vsnprintf( m_strBuffer + m_nLength, m_nCapacity - m_nLength + 1, strFormat, vaRetry );
+        }
+#endif
+        va_end( vaRetry );
+
+        if ( nWritten > 0 )
+        {
+            m_nLength += (size_t)nWritten;
+        }
+        m_strBuffer[ m_nLength ] = 0;
+
+        return *this;
+    }
+
+    /**
+     * Reserve
+     *
+     *      Makes room for nCapacity characters (plus the terminator). The
+     * buffer at least doubles each time it grows, so a run of appends
+     * copies each character a constant number of times on average.
+     */
+    void CStringBuilder::Reserve( size_t nCapacity )
+    {
+        if ( ( nCapacity <= m_nCapacity ) && ( m_strBuffer ) )
+        {
+            return;
+        }
+
+        size_t nNewCapacity = m_nCapacity * 2;
+
+        if ( nNewCapacity < nCapacity )
+        {
+            nNewCapacity = nCapacity;
+        }
+
+        IASLibChar__ *strBuffer = (IASLibChar__ *)realloc( m_strBuffer, ( nNewCapacity + 1 ) * sizeof( IASLibChar__ ) );
+
+        if ( strBuffer == NULL )
+        {
+            throw CException( "Out of memory while growing a string builder", CException::FATAL );
+        }
+
+        m_strBuffer = strBuffer;
+        m_strBuffer[ m_nLength ] = 0;
+        m_nCapacity = nNewCapacity;
+    }
+
+    void CStringBuilder::Truncate( size_t nLength )
+    {
+        if ( nLength < m_nLength )
+        {
+            m_nLength = nLength;
+            m_strBuffer[ m_nLength ] = 0;
+        }
+    }
+
+    CString CStringBuilder::ToString( void ) const
+    {
+        return CString( GetBuffer(), m_nLength );
+    }
+
+        // Makes room for nLength more characters and moves the end of the
+        // string past them, returning where they go.
+    IASLibChar__ *CStringBuilder::Extend( size_t nLength )
+    {
+        if ( m_nCapacity - m_nLength < nLength )
+        {
+            Reserve( m_nLength + nLength );
+        }
+
+        IASLibChar__ *pAppend = m_strBuffer + m_nLength;
+
+        m_nLength += nLength;
+        m_strBuffer[ m_nLength ] = 0;
+
+        return pAppend;
+    }
+} // namespace IASLib
@@ -0,0 +1,561 @@
+/*
+ * CStringSearch Class
+ *
+ *      The byte searching underneath CString: finding a character or a
+ * substring, with or without regard to case, and comparing without
+ * regard to case. Every search takes explicit lengths, so nothing has to
+ * be copied or lower-cased first, and embedded nulls are fine.
+ *      On x86 processors the searches run sixteen (SSE2) or thirty-two
+ * (AVX2) bytes at a time, picked when first used; substrings are found by
+ * looking for the needle's first and last bytes together, and only
+ * comparing the rest where both match. Elsewhere, or with acceleration
+ * turned off, plain byte loops do the same work.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include <string.h>
+#include "StringSearch.h"
+#include "Object.h"
+
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define IASLIB_SEARCH_X86__
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace IASLib
+{
+    CStringSearch::SearchLevel CStringSearch::s_eLevel = CStringSearch::LEVEL_UNSELECTED;
+
+        // ASCII lower case; other bytes are left alone, as ToLowerCase()
+        // does in the C locale.
+    const unsigned char CStringSearch::s_achLower[256] =
+                {
+                    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+                    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+                    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+                    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
+                    0x40, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f,
+                    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f,
+                    0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f,
+                    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x7b, 0x7c, 0x7d, 0x7e, 0x7f,
+                    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+                    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f,
+                    0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf,
+                    0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf,
+                    0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf,
+                    0xd0, 0xd1, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xdb, 0xdc, 0xdd, 0xde, 0xdf,
+                    0xe0, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xeb, 0xec, 0xed, 0xee, 0xef,
+                    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+                };
+
+        // The other case of an ASCII letter (or the character itself)
+    static inline char OtherCase( char chSource )
+    {
+        if ( ( chSource >= 'a' ) && ( chSource <= 'z' ) )
+        {
+            return (char)( chSource - 'a' + 'A' );
+        }
+        if ( ( chSource >= 'A' ) && ( chSource <= 'Z' ) )
+        {
+            return (char)( chSource - 'A' + 'a' );
+        }
+        return chSource;
+    }
+
+        // The C library's memchr() is already vectorized wherever it
+        // matters, so a plain character search goes straight to it.
+    size_t CStringSearch::FindChar( const char *pHaystack, size_t nLength, char chFind )
+    {
+        return FindCharScalar( pHaystack, nLength, chFind, chFind );
+    }
+
+    size_t CStringSearch::FindCharNoCase( const char *pHaystack, size_t nLength, char chFind )
+    {
+        char chOther = OtherCase( chFind );
+
+        switch ( GetLevel() )
+        {
+#ifdef IASLIB_SEARCH_X86__
+            case LEVEL_AVX2:
+                return FindCharAvx2( pHaystack, nLength, chFind, chOther );
+
+            case LEVEL_SSE2:
+                return FindCharSse2( pHaystack, nLength, chFind, chOther );
+#endif
+            default:
+                return FindCharScalar( pHaystack, nLength, chFind, chOther );
+        }
+    }
+
+    /**
+     * Find
+     *
+     *      Finds the first place pNeedle appears in pHaystack.
+     *
+     * @return
+     *      The needle's offset, or NOT_FOUND. An empty needle is found at
+     *      offset zero.
+     */
+    size_t CStringSearch::Find( const char *pHaystack, size_t nLength, const char *pNeedle, size_t nNeedle )
+    {
+        if ( nNeedle == 0 )
+        {
+            return 0;
+        }
+        if ( nNeedle > nLength )
+        {
+            return NOT_FOUND;
+        }
+        if ( nNeedle == 1 )
+        {
+            return FindChar( pHaystack, nLength, *pNeedle );
+        }
+
+        switch ( GetLevel() )
+        {
+#ifdef IASLIB_SEARCH_X86__
+            case LEVEL_AVX2:
+                return FindAvx2( pHaystack, nLength, pNeedle, nNeedle, false );
+
+            case LEVEL_SSE2:
+                return FindSse2( pHaystack, nLength, pNeedle, nNeedle, false );
+#endif
+            default:
+                return FindScalar( pHaystack, nLength, pNeedle, nNeedle, false );
+        }
+    }
+
+    size_t CStringSearch::FindNoCase( const char *pHaystack, size_t nLength, const char *pNeedle, size_t nNeedle )
+    {
+        if ( nNeedle == 0 )
+        {
+            return 0;
+        }
+        if ( nNeedle > nLength )
+        {
+            return NOT_FOUND;
+        }
+        if ( nNeedle == 1 )
+        {
+            return FindCharNoCase( pHaystack, nLength, *pNeedle );
+        }
+
+        switch ( GetLevel() )
+        {
+#ifdef IASLIB_SEARCH_X86__
+            case LEVEL_AVX2:
+                return FindAvx2( pHaystack, nLength, pNeedle, nNeedle, true );
+
+            case LEVEL_SSE2:
+                return FindSse2( pHaystack, nLength, pNeedle, nNeedle, true );
+#endif
+            default:
+                return FindScalar( pHaystack, nLength, pNeedle, nNeedle, true );
+        }
+    }
+
+    bool CStringSearch::EqualsNoCase( const char *pFirst, const char *pSecond, size_t nLength )
+    {
+#ifdef IASLIB_SEARCH_X86__
+        if ( ( nLength >= 16 ) && ( GetLevel() != LEVEL_SCALAR ) )
+        {
+            return EqualsNoCaseSse2( pFirst, pSecond, nLength );
+        }
+#endif
+        return EqualsNoCaseScalar( pFirst, pSecond, nLength );
+    }
+
+    /**
+     * SetAcceleration
+     *
+     *      Turns the vector searches on (the default, where the processor
+     * has them) or off.
+     */
+    void CStringSearch::SetAcceleration( bool bEnable )
+    {
+        SelectLevel( bEnable );
+    }
+
+    const char *CStringSearch::GetImplementation( void )
+    {
+        switch ( GetLevel() )
+        {
+            case LEVEL_AVX2:
+                return "avx2";
+
+            case LEVEL_SSE2:
+                return "sse2";
+
+            default:
+                return "scalar";
+        }
+    }
+
+    CStringSearch::SearchLevel CStringSearch::SelectLevel( bool bEnable )
+    {
+        SearchLevel eLevel = LEVEL_SCALAR;
+
+#ifdef IASLIB_SEARCH_X86__
+        unsigned int nEAX, nEBX, nECX, nEDX;
+
+        if ( ( bEnable ) && ( __get_cpuid( 1, &nEAX, &nEBX, &nECX, &nEDX ) ) )
+        {
+            bool bYmmSaved = false;
+
+            if ( nEDX & bit_SSE2 )
+            {
+                eLevel = LEVEL_SSE2;
+            }
+
+                // AVX2 also needs the OS to save the YMM registers
+            if ( nECX & bit_OSXSAVE )
+            {
+                unsigned int nXCR0Low, nXCR0High;
+                __asm__ ( "xgetbv" : "=a" ( nXCR0Low ), "=d" ( nXCR0High ) : "c" ( 0 ) );
+                bYmmSaved = ( ( nXCR0Low & 0x06 ) == 0x06 );
+            }
+
+            if ( ( bYmmSaved ) && ( __get_cpuid_count( 7, 0, &nEAX, &nEBX, &nECX, &nEDX ) ) && ( nEBX & bit_AVX2 ) )
+            {
+                eLevel = LEVEL_AVX2;
+            }
+        }
+#endif
+
+        s_eLevel = eLevel;
+        return eLevel;
+    }
+
+    size_t CStringSearch::FindCharScalar( const char *pHaystack, size_t nLength, char chFind, char chOther )
+    {
+        if ( chFind == chOther )
+        {
+            const char *pFound = (const char *)memchr( pHaystack, chFind, nLength );
+
+            return ( pFound ) ? (size_t)( pFound - pHaystack ) : NOT_FOUND;
+        }
+
+        for ( size_t nX = 0; nX < nLength; nX++ )
+        {
+            if ( ( pHaystack[nX] == chFind ) || ( pHaystack[nX] == chOther ) )
+            {
+                return nX;
+            }
+        }
+
+        return NOT_FOUND;
+    }
+
+        // Needles are at least two bytes, and no longer than the haystack
+    size_t CStringSearch::FindScalar( const char *pHaystack, size_t nLength, const char *pNeedle, size_t nNeedle, bool bNoCase )
+    {
+        size_t nLast = nLength - nNeedle;
+
+        if ( bNoCase )
+        {
+            unsigned char chFirst = s_achLower[ (unsigned char)pNeedle[0] ];
+
+            for ( size_t nX = 0; nX <= nLast; nX++ )
+            {
+                if ( ( s_achLower[ (unsigned char)pHaystack[nX] ] == chFirst ) && ( EqualsNoCaseScalar( pHaystack + nX + 1, pNeedle + 1, nNeedle - 1 ) ) )
+                {
+                    return nX;
+                }
+            }
+
+            return NOT_FOUND;
+        }
+
+#ifdef __GLIBC__
+        const char *pMatch = (const char *)memmem( pHaystack, nLength, pNeedle, nNeedle );
+
+        return ( pMatch ) ? (size_t)( pMatch - pHaystack ) : NOT_FOUND;
+#else
+        size_t nX = 0;
+
+        while ( nX <= nLast )
+        {
+            const char *pFound = (const char *)memchr( pHaystack + nX, pNeedle[0], nLast - nX + 1 );
+
+            if ( pFound == NULL )
+            {
+                break;
+            }
+
+            nX = (size_t)( pFound - pHaystack );
+            if ( ( pFound[ nNeedle - 1 ] == pNeedle[ nNeedle - 1 ] ) && ( memcmp( pFound + 1, pNeedle + 1, nNeedle - 2 ) == 0 ) )
+            {
+                return nX;
+            }
+            nX++;
+        }
+
+        return NOT_FOUND;
+#endif
+    }
+
+    bool CStringSearch::EqualsNoCaseScalar( const char *pFirst, const char *pSecond, size_t nLength )
+    {
+        for ( size_t nX = 0; nX < nLength; nX++ )
+        {
+            if ( s_achLower[ (unsigned char)pFirst[nX] ] != s_achLower[ (unsigned char)pSecond[nX] ] )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+#ifdef IASLIB_SEARCH_X86__
+    __attribute__(( target( "sse2" ) ))
+    size_t CStringSearch::FindCharSse2( const char *pHaystack, size_t nLength, char chFind, char chOther )
+    {
+        const __m128i vFind = _mm_set1_epi8( chFind );
+        const __m128i vOther = _mm_set1_epi8( chOther );
+        size_t nX = 0;
+
+        for ( ; nX + 16 <= nLength; nX += 16 )
+        {
+            __m128i vBlock = _mm_loadu_si128( (const __m128i *)( pHaystack + nX ) );
+            unsigned int nMask = (unsigned int)_mm_movemask_epi8( _mm_or_si128( _mm_cmpeq_epi8( vBlock, vFind ), _mm_cmpeq_epi8( vBlock, vOther ) ) );
+
+            if ( nMask )
+            {
+                return nX + (size_t)__builtin_ctz( nMask );
+            }
+        }
+
+        for ( ; nX < nLength; nX++ )
+        {
+            if ( ( pHaystack[nX] == chFind ) || ( pHaystack[nX] == chOther ) )
+            {
+                return nX;
+            }
+        }
+
+        return NOT_FOUND;
+    }
+
+    /**
+     * FindSse2
+     *
+     *      Compares sixteen candidate positions at a time: the block at the
+     * position against the needle's first byte, and the block needle-length
+     * further on against its last byte. Only positions where both match
+     * are compared in full.
+     */
+    __attribute__(( target( "sse2" ) ))
+    size_t CStringSearch::FindSse2( const char *pHaystack, size_t nLength, const char *pNeedle, size_t nNeedle, bool bNoCase )
+    {
+        char chFirst = pNeedle[0];
+        char chLast = pNeedle[ nNeedle - 1 ];
+        const __m128i vFirst = _mm_set1_epi8( chFirst );
+        const __m128i vFirstOther = _mm_set1_epi8( ( bNoCase ) ? OtherCase( chFirst ) : chFirst );
+        const __m128i vLast = _mm_set1_epi8( chLast );
+        const __m128i vLastOther = _mm_set1_epi8( ( bNoCase ) ? OtherCase( chLast ) : chLast );
+        size_t nX = 0;
+
+        if ( ! bNoCase )
+        {
+            for ( ; nX + nNeedle - 1 + 16 <= nLength; nX += 16 )
+            {
+                __m128i vStart = _mm_loadu_si128( (const __m128i *)( pHaystack + nX ) );
+                __m128i vEnd = _mm_loadu_si128( (const __m128i *)( pHaystack + nX + nNeedle - 1 ) );
+                unsigned int nMask = (unsigned int)_mm_movemask_epi8( _mm_and_si128( _mm_cmpeq_epi8( vStart, vFirst ), _mm_cmpeq_epi8( vEnd, vLast ) ) );
+
+                while ( nMask )
+                {
+                    size_t nCandidate = nX + (size_t)__builtin_ctz( nMask );
+
+                    if ( memcmp( pHaystack + nCandidate + 1, pNeedle + 1, nNeedle - 2 ) == 0 )
+                    {
+                        return nCandidate;
+                    }
+                    nMask &= nMask - 1;
+                }
+            }
+        }
+        else
+        {
+            for ( ; nX + nNeedle - 1 + 16 <= nLength; nX += 16 )
+            {
+                __m128i vStart = _mm_loadu_si128( (const __m128i *)( pHaystack + nX ) );
+                __m128i vEnd = _mm_loadu_si128( (const __m128i *)( pHaystack + nX + nNeedle - 1 ) );
+                __m128i vMatchFirst = _mm_or_si128( _mm_cmpeq_epi8( vStart, vFirst ), _mm_cmpeq_epi8( vStart, vFirstOther ) );
+                __m128i vMatchLast = _mm_or_si128( _mm_cmpeq_epi8( vEnd, vLast ), _mm_cmpeq_epi8( vEnd, vLastOther ) );
+                unsigned int nMask = (unsigned int)_mm_movemask_epi8( _mm_and_si128( vMatchFirst, vMatchLast ) );
+
+                while ( nMask )
+                {
+                    size_t nCandidate = nX + (size_t)__builtin_ctz( nMask );
+
+                    if ( EqualsNoCase( pHaystack + nCandidate + 1, pNeedle + 1, nNeedle - 2 ) )
+                    {
+                        return nCandidate;
+                    }
+                    nMask &= nMask - 1;
+                }
+            }
+        }
+
+        if ( nX + nNeedle > nLength )
+        {
+            return NOT_FOUND;
+        }
+
+        size_t nFound = FindScalar( pHaystack + nX, nLength - nX, pNeedle, nNeedle, bNoCase );
+
+        return ( nFound != NOT_FOUND ) ? nX + nFound : NOT_FOUND;
+    }
+
+        // Folds both sides to lower case, sixteen bytes at a time: bytes
+        // from 'A' to 'Z' get 0x20 added.
+    __attribute__(( target( "sse2" ) ))
+    bool CStringSearch::EqualsNoCaseSse2( const char *pFirst, const char *pSecond, size_t nLength )
+    {
+        const __m128i vBelowA = _mm_set1_epi8( 'A' - 1 );
+        const __m128i vAboveZ = _mm_set1_epi8( 'Z' + 1 );
+        const __m128i vCaseBit = _mm_set1_epi8( 0x20 );
+        size_t nX = 0;
+
+        for ( ; nX + 16 <= nLength; nX += 16 )
+        {
+            __m128i vFirst = _mm_loadu_si128( (const __m128i *)( pFirst + nX ) );
+            __m128i vSecond = _mm_loadu_si128( (const __m128i *)( pSecond + nX ) );
+            __m128i vFirstUpper = _mm_and_si128( _mm_cmpgt_epi8( vFirst, vBelowA ), _mm_cmplt_epi8( vFirst, vAboveZ ) );
+            __m128i vSecondUpper = _mm_and_si128( _mm_cmpgt_epi8( vSecond, vBelowA ), _mm_cmplt_epi8( vSecond, vAboveZ ) );
+
+            vFirst = _mm_or_si128( vFirst, _mm_and_si128( vFirstUpper, vCaseBit ) );
+            vSecond = _mm_or_si128( vSecond, _mm_and_si128( vSecondUpper, vCaseBit ) );
+            if ( _mm_movemask_epi8( _mm_cmpeq_epi8( vFirst, vSecond ) ) != 0xFFFF )
+            {
+                return false;
+            }
+        }
+
+        return EqualsNoCaseScalar( pFirst + nX, pSecond + nX, nLength - nX );
+    }
+
+    __attribute__(( target( "avx2" ) ))
+    size_t CStringSearch::FindCharAvx2( const char *pHaystack, size_t nLength, char chFind, char chOther )
+    {
+        const __m256i vFind = _mm256_set1_epi8( chFind );
+        const __m256i vOther = _mm256_set1_epi8( chOther );
+        size_t nX = 0;
+
+        for ( ; nX + 32 <= nLength; nX += 32 )
+        {
+            __m256i vBlock = _mm256_loadu_si256( (const __m256i *)( pHaystack + nX ) );
+            unsigned int nMask = (unsigned int)_mm256_movemask_epi8( _mm256_or_si256( _mm256_cmpeq_epi8( vBlock, vFind ), _mm256_cmpeq_epi8( vBlock, vOther ) ) );
+
+            if ( nMask )
+            {
+                return nX + (size_t)__builtin_ctz( nMask );
+            }
+        }
+
+        size_t nFound = FindCharSse2( pHaystack + nX, nLength - nX, chFind, chOther );
+
+        return ( nFound != NOT_FOUND ) ? nX + nFound : NOT_FOUND;
+    }
+
+    __attribute__(( target( "avx2" ) ))
+    size_t CStringSearch::FindAvx2( const char *pHaystack, size_t nLength, const char *pNeedle, size_t nNeedle, bool bNoCase )
+    {
+        char chFirst = pNeedle[0];
+        char chLast = pNeedle[ nNeedle - 1 ];
+        const __m256i vFirst = _mm256_set1_epi8( chFirst );
+        const __m256i vFirstOther = _mm256_set1_epi8( ( bNoCase ) ? OtherCase( chFirst ) : chFirst );
+        const __m256i vLast = _mm256_set1_epi8( chLast );
+        const __m256i vLastOther = _mm256_set1_epi8( ( bNoCase ) ? OtherCase( chLast ) : chLast );
+        size_t nX = 0;
+
+        if ( ! bNoCase )
+        {
+                // Two blocks a time, skipping both at once when neither has
+                // a candidate (which is nearly always)
+            for ( ; nX + nNeedle - 1 + 64 <= nLength; nX += 64 )
+            {
+                __m256i vMatch0 = _mm256_and_si256( _mm256_cmpeq_epi8( _mm256_loadu_si256( (const __m256i *)( pHaystack + nX ) ), vFirst ),
+                                                    _mm256_cmpeq_epi8( _mm256_loadu_si256( (const __m256i *)( pHaystack + nX + nNeedle - 1 ) ), vLast ) );
+                __m256i vMatch1 = _mm256_and_si256( _mm256_cmpeq_epi8( _mm256_loadu_si256( (const __m256i *)( pHaystack + nX + 32 ) ), vFirst ),
+                                                    _mm256_cmpeq_epi8( _mm256_loadu_si256( (const __m256i *)( pHaystack + nX + 32 + nNeedle - 1 ) ), vLast ) );
+
+                if ( _mm256_testz_si256( vMatch0, vMatch0 ) && _mm256_testz_si256( vMatch1, vMatch1 ) )
+                {
+                    continue;
+                }
+
+                unsigned long long nMask = (unsigned int)_mm256_movemask_epi8( vMatch0 ) | ( (unsigned long long)(unsigned int)_mm256_movemask_epi8( vMatch1 ) << 32 );
+
+                while ( nMask )
+                {
+                    size_t nCandidate = nX + (size_t)__builtin_ctzll( nMask );
+
+                    if ( memcmp( pHaystack + nCandidate + 1, pNeedle + 1, nNeedle - 2 ) == 0 )
+                    {
+                        return nCandidate;
+                    }
+                    nMask &= nMask - 1;
+                }
+            }
+
+            for ( ; nX + nNeedle - 1 + 32 <= nLength; nX += 32 )
+            {
+                __m256i vStart = _mm256_loadu_si256( (const __m256i *)( pHaystack + nX ) );
+                __m256i vEnd = _mm256_loadu_si256( (const __m256i *)( pHaystack + nX + nNeedle - 1 ) );
+                unsigned int nMask = (unsigned int)_mm256_movemask_epi8( _mm256_and_si256( _mm256_cmpeq_epi8( vStart, vFirst ), _mm256_cmpeq_epi8( vEnd, vLast ) ) );
+
+                while ( nMask )
+                {
+                    size_t nCandidate = nX + (size_t)__builtin_ctz( nMask );
+
+                    if ( memcmp( pHaystack + nCandidate + 1, pNeedle + 1, nNeedle - 2 ) == 0 )
+                    {
+                        return nCandidate;
+                    }
+                    nMask &= nMask - 1;
+                }
+            }
+        }
+        else
+        {
+            for ( ; nX + nNeedle - 1 + 32 <= nLength; nX += 32 )
+            {
+                __m256i vStart = _mm256_loadu_si256( (const __m256i *)( pHaystack + nX ) );
+                __m256i vEnd = _mm256_loadu_si256( (const __m256i *)( pHaystack + nX + nNeedle - 1 ) );
+                __m256i vMatchFirst = _mm256_or_si256( _mm256_cmpeq_epi8( vStart, vFirst ), _mm256_cmpeq_epi8( vStart, vFirstOther ) );
+                __m256i vMatchLast = _mm256_or_si256( _mm256_cmpeq_epi8( vEnd, vLast ), _mm256_cmpeq_epi8( vEnd, vLastOther ) );
+                unsigned int nMask = (unsigned int)_mm256_movemask_epi8( _mm256_and_si256( vMatchFirst, vMatchLast ) );
+
+                while ( nMask )
+                {
+                    size_t nCandidate = nX + (size_t)__builtin_ctz( nMask );
+
+                    if ( EqualsNoCase( pHaystack + nCandidate + 1, pNeedle + 1, nNeedle - 2 ) )
+                    {
+                        return nCandidate;
+                    }
+                    nMask &= nMask - 1;
+                }
+            }
+        }
+
+        if ( nX + nNeedle > nLength )
+        {
+            return NOT_FOUND;
+        }
+
+        size_t nFound = FindSse2( pHaystack + nX, nLength - nX, pNeedle, nNeedle, bNoCase );
+
+        return ( nFound != NOT_FOUND ) ? nX + nFound : NOT_FOUND;
+    }
+#endif // IASLIB_SEARCH_X86__
+} // namespace IASLib
@@ -33,6 +33,24 @@
 // using namespace IASLib
 namespace IASLib
 {
+#ifndef IASLIB_MEMORY_DEBUGGING__
+    static CObjectPool *GetStubPool( void )
+    {
+        static CObjectPool *s_pPool = CObjectPool::Create( sizeof( CStringStub ), "CStringStub", false );
+        return s_pPool;
+    }
+
+    void *CStringStub::operator new( size_t size )
+    {
+        return GetStubPool()->Allocate( size );
+    }
+
+    void CStringStub::operator delete( void *p, size_t size )
+    {
+        GetStubPool()->Release( p, size );
+    }
+#endif
+
     CStringStub::CStringStub( void )
     {
         m_bFixedStub = false;
@@ -55,11 +73,11 @@ namespace IASLib
 
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-        m_strData = (IASLibChar__ *)CMemoryManager::AllocateDebug( nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
+        m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->AllocateDebug( nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
     #else
-        m_strData = (IASLibChar__ *)CMemoryManager::Allocate( nLength * sizeof( IASLibChar__ ) + 1 );
+        m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->Allocate( nLength * sizeof( IASLibChar__ ) + 1 );
     #endif
-        m_nSize = CMemoryManager::GetBlockSize( m_strData );
+        m_nSize = CMemoryManager::GetNewAllocator()->GetBlockSize( m_strData );
 #else
         m_strData = (IASLibChar__ *)malloc( (size_t)(nLength * sizeof( IASLibChar__ ) + 1) );
         m_nSize = nLength * sizeof( IASLibChar__ ) + 1;
@@ -81,11 +99,11 @@ namespace IASLib
 
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-        m_strData = (IASLibChar__ *)CMemoryManager::AllocateDebug( nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
+        m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->AllocateDebug( nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
     #else
-        m_strData = (IASLibChar__ *)CMemoryManager::Allocate( nLength * sizeof( IASLibChar__ ) + 1 );
+        m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->Allocate( nLength * sizeof( IASLibChar__ ) + 1 );
     #endif
-        m_nSize = CMemoryManager::GetBlockSize( m_strData );
+        m_nSize = CMemoryManager::GetNewAllocator()->GetBlockSize( m_strData );
 #else
         m_strData = (IASLibChar__ *)malloc( (size_t)(nLength * sizeof( IASLibChar__ ) + 1) );
         m_nSize = nLength * sizeof( IASLibChar__ ) + 1;
@@ -107,11 +125,11 @@ namespace IASLib
             }
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-            m_strData = (IASLibChar__ *)CMemoryManager::AllocateDebug( nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
+            m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->AllocateDebug( nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
     #else
-            m_strData = (IASLibChar__ *)CMemoryManager::Allocate( nLength * sizeof( IASLibChar__ ) + 1 );
+            m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->Allocate( nLength * sizeof( IASLibChar__ ) + 1 );
     #endif
-            m_nSize = CMemoryManager::GetBlockSize( m_strData );
+            m_nSize = CMemoryManager::GetNewAllocator()->GetBlockSize( m_strData );
 #else
             m_strData = (IASLibChar__ *)::malloc( nLength * sizeof( IASLibChar__ ) + 1 );
             m_nSize = nLength * sizeof( IASLibChar__ ) + 1;
@@ -138,11 +156,11 @@ namespace IASLib
             m_nLength = 0;
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-            m_strData = (IASLibChar__ *)CMemoryManager::AllocateDebug( 1, __FILE__, __LINE__ );
+            m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->AllocateDebug( 1, __FILE__, __LINE__ );
     #else
-            m_strData = (IASLibChar__ *)CMemoryManager::Allocate( 1 );
+            m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->Allocate( 1 );
     #endif
-            m_nSize = CMemoryManager::GetBlockSize( m_strData );
+            m_nSize = CMemoryManager::GetNewAllocator()->GetBlockSize( m_strData );
 #else
             m_strData = (IASLibChar__ *)::malloc( 1 );
             m_nSize = 1;
@@ -160,11 +178,11 @@ namespace IASLib
         {
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-            m_strData = (IASLibChar__ *)CMemoryManager::AllocateDebug( nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
+            m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->AllocateDebug( nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
     #else
-            m_strData = (IASLibChar__ *)CMemoryManager::Allocate( nLength * sizeof( IASLibChar__ ) + 1 );
+            m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->Allocate( nLength * sizeof( IASLibChar__ ) + 1 );
     #endif
-            m_nSize = CMemoryManager::GetBlockSize( m_strData );
+            m_nSize = CMemoryManager::GetNewAllocator()->GetBlockSize( m_strData );
 #else
             m_strData = (IASLibChar__ *)::malloc( nLength * sizeof( IASLibChar__ ) + 1 );
             m_nSize = nLength * sizeof( IASLibChar__ ) + 1;
@@ -191,11 +209,11 @@ namespace IASLib
             m_nLength = 0;
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-            m_strData = (IASLibChar__ *)CMemoryManager::AllocateDebug( 1, __FILE__, __LINE__ );
+            m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->AllocateDebug( 1, __FILE__, __LINE__ );
     #else
-            m_strData = (IASLibChar__ *)CMemoryManager::Allocate( 1 );
+            m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->Allocate( 1 );
     #endif
-            m_nSize = CMemoryManager::GetBlockSize( m_strData );
+            m_nSize = CMemoryManager::GetNewAllocator()->GetBlockSize( m_strData );
 #else
             m_strData = (IASLibChar__ *)::malloc( 1 );
             m_nSize = 1;
@@ -235,11 +253,11 @@ namespace IASLib
         {
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-            m_strData = CMemoryManager::AllocateDebug( oSource.m_nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
+            m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->AllocateDebug( oSource.m_nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
     #else
-            m_strData = CMemoryManager::Allocate( oSource.m_nLength * sizeof( IASLibChar__ ) + 1 );
+            m_strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->Allocate( oSource.m_nLength * sizeof( IASLibChar__ ) + 1 );
     #endif
-            m_nSize = CMemoryManager::GetBlockSize( m_strData );
+            m_nSize = CMemoryManager::GetNewAllocator()->GetBlockSize( m_strData );
 #else
             m_strData = (IASLibChar__ *)malloc( oSource.m_nLength * sizeof( IASLibChar__ ) + 1 );
             m_nSize = oSource.m_nLength * sizeof( IASLibChar__ ) + 1;
@@ -277,9 +295,9 @@ namespace IASLib
         {
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-            CMemoryManager::ReleaseDebug( m_strData, __FILE__, __LINE__ );
+            CMemoryManager::GetNewAllocator()->ReleaseDebug( m_strData, __FILE__, __LINE__ );
     #else
-            CMemoryManager::Release( m_strData );
+            CMemoryManager::GetNewAllocator()->Release( m_strData );
     #endif
 #else
             free( m_strData );
@@ -334,20 +352,11 @@ namespace IASLib
 
     void CStringStub::ChangeSize( size_t nLength ) // throw (CStringException)
     {
-#ifdef IASLIB_MULTI_THREADED__
-        m_mutex.Lock();
-#endif
-        if ( ( m_nReferences > 1 ) && ( ! m_bFixedStub ) )
+        if ( m_bFixedStub )
         {
-            ERROR_LOG( "Cannot change size of String Stub with multiple references!" );
 #ifdef IASLIB_MULTI_THREADED__
-            m_mutex.Unlock();
+            m_mutex.Lock();
 #endif
-            throw CStringException( "Cannot change size of String Stub with multiple references!", CException::NORMAL );
-        }
-
-        if ( m_bFixedStub )
-        {
             if ( m_nLength <= m_nSize )
             {
                 if ( nLength < m_nLength )
@@ -361,71 +370,118 @@ namespace IASLib
             {
                 m_nLength = m_nSize;
             }
+#ifdef IASLIB_MULTI_THREADED__
+            m_mutex.Unlock();
+#endif
+            return;
         }
-        else
+
+            // A growable stub is only ever resized by the one string that
+            // holds it (CString::ChangeStub() sees to that), so there's
+            // nobody to lock out here.
+        if ( m_nReferences > 1 )
+        {
+            ERROR_LOG( "Cannot change size of String Stub with multiple references!" );
+            throw CStringException( "Cannot change size of String Stub with multiple references!", CException::NORMAL );
+        }
+
+        size_t nNeeded = nLength * sizeof( IASLibChar__ ) + 1;
+
+        if ( ( m_strData == NULL ) || ( ! m_bDeletable ) )
+        {
+            Reallocate( nNeeded );
+        }
+        else if ( nNeeded > m_nSize )
+        {
+                // Grow by at least half again, so a string built up a piece
+                // at a time is reallocated a logarithmic number of times.
+            size_t nGrow = m_nSize + ( m_nSize >> 1 );
+
+            Reallocate( ( nNeeded > nGrow ) ? nNeeded : nGrow );
+        }
+        else if ( ( m_nSize > SHRINK_THRESHOLD ) && ( nNeeded < ( m_nSize >> 2 ) ) )
+        {
+            Reallocate( nNeeded << 1 );
+        }
+
+        m_nLength = nLength;
+        m_strData[ m_nLength ] = 0;
+    }
+
+    /**
+     * Reserve
+     *
+     *      Makes room for a string of nCapacity characters, without changing
+     * the string, so it can grow that far without being reallocated.
+     */
+    void CStringStub::Reserve( size_t nCapacity )
+    {
+        size_t nNeeded = nCapacity * sizeof( IASLibChar__ ) + 1;
+
+        if ( ( ! m_bFixedStub ) && ( ( m_strData == NULL ) || ( ! m_bDeletable ) || ( nNeeded > m_nSize ) ) )
         {
-            if ( nLength == 0 )
+            if ( ( m_strData ) && ( m_bDeletable ) && ( nNeeded < m_nSize ) )
             {
-#ifdef IASLIB_MEMORY_MANAGER__
-    #ifdef IASLIB_DEBUG__
-                CMemoryManager::ReleaseDebug( m_strData, __FILE__, __LINE__ );
-    #else
-                CMemoryManager::Release( m_strData );
-    #endif
-                m_nSize = 0;
-#else
-                free( m_strData );
-                m_nSize = 0;
-#endif
-                m_bDeletable = false;
+                nNeeded = m_nSize;
             }
-            else
-            {
-                if ( m_strData )
-                {
+            Reallocate( nNeeded );
+            m_strData[ m_nLength ] = 0;
+        }
+    }
+
+    size_t CStringStub::GetCapacity( void ) const
+    {
+        return ( m_nSize ) ? ( m_nSize - 1 ) / sizeof( IASLibChar__ ) : 0;
+    }
+
+        // Moves the string into a buffer of nSize bytes (which is always
+        // big enough for the string).
+    void CStringStub::Reallocate( size_t nSize ) // throw (CException)
+    {
+        IASLibChar__ *strData;
+
+        if ( ( m_strData ) && ( m_bDeletable ) )
+        {
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-                    m_strData = (IASLibChar__ *)CMemoryManager::ReallocateDebug( m_strData, nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
+            strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->ReallocateDebug( m_strData, nSize, __FILE__, __LINE__ );
     #else
-                    m_strData = (IASLibChar__ *)CMemoryManager::Reallocate( m_strData, nLength * sizeof( IASLibChar__ ) + 1 );
+            strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->Reallocate( m_strData, nSize );
     #endif
-                    m_nSize = CMemoryManager::GetBlockSize( m_strData );
 #else
-                    m_strData = (IASLibChar__ *)realloc( m_strData, nLength * sizeof( IASLibChar__ ) + 1 );
-                    m_nSize = nLength * sizeof( IASLibChar__ ) + 1;
+            strData = (IASLibChar__ *)realloc( m_strData, nSize );
 #endif
-                    m_bDeletable = true;
-                }
-                else
-                {
+        }
+        else
+        {
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-                    m_strData = (IASLibChar__ *)CMemoryManager::AllocateDebug( nLength * sizeof( IASLibChar__ ) + 1, __FILE__, __LINE__ );
+            strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->AllocateDebug( nSize, __FILE__, __LINE__ );
     #else
-                    m_strData = (IASLibChar__ *)CMemoryManager::Allocate( nLength * sizeof( IASLibChar__ ) + 1 );
+            strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->Allocate( nSize );
     #endif
-                    m_nSize = CMemoryManager::GetBlockSize( m_strData );
 #else
-                    m_strData = (IASLibChar__ *)malloc( nLength * sizeof( IASLibChar__ ) + 1 );
-                    m_nSize = nLength * sizeof( IASLibChar__ ) + 1;
+            strData = (IASLibChar__ *)malloc( nSize );
 #endif
-                    m_bDeletable = true;
-                }
-                if ( ! m_strData )
-                {
-#ifdef IASLIB_MULTI_THREADED__
-                    m_mutex.Unlock();
-#endif
-                    ERROR_LOG( "Out of memory while allocating String Stub of length %d", nLength );
-                    throw CException( "Could not allocate memory for String Stub!", CException::FATAL );
-                }
+            if ( ( strData ) && ( m_strData ) )
+            {
+                memcpy( strData, m_strData, m_nLength * sizeof( IASLibChar__ ) + 1 );
             }
-            m_nLength = nLength;
-            m_strData[ m_nLength ] = 0;
         }
-#ifdef IASLIB_MULTI_THREADED__
-        m_mutex.Unlock();
+
+        if ( ! strData )
+        {
+            ERROR_LOG( "Out of memory while allocating String Stub of size %d", (int)nSize );
+            throw CException( "Could not allocate memory for String Stub!", CException::FATAL );
+        }
+
+        m_strData = strData;
+#ifdef IASLIB_MEMORY_MANAGER__
+        m_nSize = CMemoryManager::GetNewAllocator()->GetBlockSize( m_strData );
+#else
+        m_nSize = nSize;
 #endif
+        m_bDeletable = true;
     }
 
     int CStringStub::GetRefCount( void )
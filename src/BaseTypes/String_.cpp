@@ -30,6 +30,11 @@
 #endif
 
 #include "StringException.h"
+#include "StringSearch.h"
+
+#ifdef IASLIB_MEMORY_MANAGER__
+#include "MemoryManager.h"
+#endif
 
 #if ( _MSC_VER >= 1300 )
 #pragma warning( disable:4995 )
@@ -221,9 +226,9 @@ namespace IASLib
             IASLibChar__ *strData;
 #ifdef IASLIB_MEMORY_MANAGER__
     #ifdef IASLIB_DEBUG__
-            strData = (IASLibChar__ *)CMemoryManager::AllocateDebug( nSize + 1, __FILE__, __LINE__ );
+            strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->AllocateDebug( nSize + 1, __FILE__, __LINE__ );
     #else
-            strData = (IASLibChar__ *)CMemoryManager::Allocate( nSize + 1 );
+            strData = (IASLibChar__ *)CMemoryManager::GetNewAllocator()->Allocate( nSize + 1 );
     #endif
 #else
             strData = (IASLibChar__ *)malloc( nSize + 1 );
@@ -1410,75 +1415,68 @@ namespace IASLib
 
     size_t CString::IndexOf( const IASLibChar__ *strSearch, size_t nStart, bool bCaseInsensitive ) const
     {
-        size_t     nReturn = IASLib::NOT_FOUND;
+        if ( ( m_pStubData == NULL ) || ( m_pStubData->m_strData == NULL ) || ( strSearch == NULL ) )
+        {
+            return IASLib::NOT_FOUND;
+        }
 
-        if ( m_pStubData )
+        if ( nStart == IASLib::NOT_FOUND )
         {
-            if ( m_pStubData->m_strData )
-            {
-                if ( nStart == IASLib::NOT_FOUND )
-                {
-                    nStart = 0;
-                }
+            nStart = 0;
+        }
 
-                if ( nStart > m_pStubData->m_nLength )
-                {
-                    nStart = m_pStubData->m_nLength;
-                }
+        if ( nStart > m_pStubData->m_nLength )
+        {
+            nStart = m_pStubData->m_nLength;
+        }
 
-                IASLibChar__ *pFound;
+        const IASLibChar__ *pStart = m_pStubData->m_strData + nStart;
+        size_t nLength = m_pStubData->m_nLength - nStart;
+        size_t nFound;
 
-                if ( bCaseInsensitive )
-                {
-                    CString strCopy = m_pStubData->m_strData;
-                    CString strSearchCopy = strSearch;
-
-                    strCopy.ToLowerCase();
-                    strSearchCopy.ToLowerCase();
-                    pFound = strstr( &(strCopy.m_pStubData->m_strData[nStart] ), (const IASLibChar__ *)strSearchCopy );
-                    if ( pFound != NULL )
-                    {
-                        nReturn = (size_t)(pFound - strCopy.m_pStubData->m_strData);
-                    }
-                }
-                else
-                {
-                    pFound = strstr( &(m_pStubData->m_strData[nStart] ), strSearch );
-                    if ( pFound != NULL )
-                    {
-                        nReturn = (size_t)(pFound - m_pStubData->m_strData);
-                    }
-                }
-            }
+        if ( bCaseInsensitive )
+        {
+            nFound = CStringSearch::FindNoCase( pStart, nLength, strSearch, strlen( strSearch ) );
+        }
+        else
+        {
+            nFound = CStringSearch::Find( pStart, nLength, strSearch, strlen( strSearch ) );
         }
 
-        return nReturn;
+        return ( nFound != IASLib::NOT_FOUND ) ? nStart + nFound : IASLib::NOT_FOUND;
     }
 
     size_t CString::IndexOf( const IASLibChar__ chSearch, size_t nStart, bool bCaseInsensitive ) const
     {
-        size_t nCount = IASLib::NOT_FOUND;
-        IASLibChar__ chMatch;
+        if ( ( m_pStubData == NULL ) || ( m_pStubData->m_strData == NULL ) )
+        {
+            return IASLib::NOT_FOUND;
+        }
 
-        if ( m_pStubData )
+        if ( nStart == IASLib::NOT_FOUND )
         {
-            if ( nStart == IASLib::NOT_FOUND )
-                nStart = 0;
+            nStart = 0;
+        }
 
-            if ( bCaseInsensitive )
-            {
-                chMatch = (IASLibChar__)toupper( chSearch );
+        if ( nStart >= m_pStubData->m_nLength )
+        {
+            return IASLib::NOT_FOUND;
+        }
 
-                for ( nCount = nStart; ( nCount < m_pStubData->m_nLength ) && ( toupper( m_pStubData->m_strData[ nCount ] ) != chMatch ); nCount++ );
-            }
-            else
-            {
-                for ( nCount = nStart; ( nCount < m_pStubData->m_nLength ) && ( m_pStubData->m_strData[ nCount ] != chSearch ); nCount++ );
-            }
-            if ( nCount == m_pStubData->m_nLength )
-                nCount = IASLib::NOT_FOUND;
+        const IASLibChar__ *pStart = m_pStubData->m_strData + nStart;
+        size_t nLength = m_pStubData->m_nLength - nStart;
+        size_t nFound;
+
+        if ( bCaseInsensitive )
+        {
+            nFound = CStringSearch::FindCharNoCase( pStart, nLength, chSearch );
         }
-        return nCount;
+        else
+        {
+            nFound = CStringSearch::FindChar( pStart, nLength, chSearch );
+        }
+
+        return ( nFound != IASLib::NOT_FOUND ) ? nStart + nFound : IASLib::NOT_FOUND;
     }
 
     size_t CString::LastIndexOf( const CString &strSearch, size_t nStart, bool bCaseInsensitive ) const
@@ -1743,147 +1741,207 @@ namespace IASLib
         }
     }
 
+    /**
+     * Replace
+     *
+     *      Replaces every occurrence of strReplace with strTo, in one pass:
+     * occurrences are counted first, then the result is put together in a
+     * buffer of the right size (or in place, when it isn't growing).
+     * Replacements aren't searched again, so strTo may contain strReplace.
+     */
     void CString::Replace( const IASLibChar__ *strReplace, const IASLibChar__ *strTo )
     {
-        size_t nReplacePoint;
+        if ( ( m_pStubData == NULL ) || ( strReplace == NULL ) || ( *strReplace == 0 ) )
+        {
+            return;
+        }
+
+        if ( strTo == NULL )
+        {
+            strTo = "";
+        }
+
         size_t nReplaceLength = strlen( strReplace );
-        CString strTemp;
+        size_t nToLength = strlen( strTo );
+        size_t nLength = m_pStubData->m_nLength;
+        size_t nMatches = 0;
+        size_t nFirst = NOT_FOUND;
+        size_t nFound;
 
-        while ( ( nReplacePoint = IndexOf( strReplace ) ) != IASLib::NOT_FOUND )
+        for ( size_t nPos = 0; ( nFound = CStringSearch::Find( m_pStubData->m_strData + nPos, nLength - nPos, strReplace, nReplaceLength ) ) != NOT_FOUND; nPos += nFound + nReplaceLength )
         {
-            strTemp = Substring( 0, (int)nReplacePoint );
-            strTemp += strTo;
-            strTemp += Substring( nReplacePoint + nReplaceLength );
-            *this = strTemp;
+            if ( nMatches++ == 0 )
+            {
+                nFirst = nFound;
+            }
         }
-    }
 
-    void CString::Remove( const IASLibChar__ chRemove )
-    {
-        size_t nCount = 0;
-        size_t nInsert = 0;
-        CString strTemp;
+        if ( nMatches == 0 )
+        {
+            return;
+        }
 
-        if ( m_pStubData )
+        size_t nNewLength = nLength - ( nMatches * nReplaceLength ) + ( nMatches * nToLength );
+
+        if ( ( nToLength <= nReplaceLength ) && ( ! m_pStubData->m_bFixedStub ) )
         {
-            CStringStub *pTemp = new CStringStub( m_pStubData->m_nLength );
-            pTemp->AddRef();
-            while ( nCount < m_pStubData->m_nLength )
+                // Shrinking (or staying the same), so the result can be
+                // written over the string; writes never pass the reads.
+            ChangeStub();
+
+            IASLibChar__ *pData = m_pStubData->m_strData;
+            size_t nRead = nFirst;
+            size_t nWrite = nFirst;
+
+            while ( nRead < nLength )
             {
-                if ( m_pStubData->m_strData[ nCount ] != chRemove )
+                memcpy( pData + nWrite, strTo, nToLength );
+                nWrite += nToLength;
+                nRead += nReplaceLength;
+
+                nFound = CStringSearch::Find( pData + nRead, nLength - nRead, strReplace, nReplaceLength );
+                size_t nCopy = ( nFound != NOT_FOUND ) ? nFound : nLength - nRead;
+
+                memmove( pData + nWrite, pData + nRead, nCopy );
+                nWrite += nCopy;
+                nRead += nCopy;
+                if ( nFound == NOT_FOUND )
                 {
-                    pTemp->m_strData[ nInsert ] = m_pStubData->m_strData[ nCount ];
-                    nInsert++;
+                    break;
                 }
-                nCount++;
             }
 
-            m_pStubData->RemoveRef();
-            m_pStubData = pTemp;
+            m_pStubData->ChangeSize( nNewLength );
+            return;
+        }
+
+        CString strResult;
+
+        strResult.Reserve( nNewLength );
+        if ( strResult.m_pStubData )
+        {
+            const IASLibChar__ *pData = m_pStubData->m_strData;
+            IASLibChar__ *pWrite = strResult.m_pStubData->m_strData;
+            size_t nRead = 0;
+
+            while ( ( nFound = CStringSearch::Find( pData + nRead, nLength - nRead, strReplace, nReplaceLength ) ) != NOT_FOUND )
+            {
+                memcpy( pWrite, pData + nRead, nFound );
+                pWrite += nFound;
+                memcpy( pWrite, strTo, nToLength );
+                pWrite += nToLength;
+                nRead += nFound + nReplaceLength;
+            }
+            memcpy( pWrite, pData + nRead, nLength - nRead );
+            strResult.m_pStubData->ChangeSize( nNewLength );
         }
+
+        *this = strResult;
     }
 
-    void CString::Remove( const IASLibChar__ *strRemove )
+    void CString::Remove( const IASLibChar__ chRemove )
     {
-        size_t nRemovePoint;
-        size_t nRemoveLength = strlen( strRemove );
-        CString strTemp;
+        if ( ( m_pStubData == NULL ) || ( m_pStubData->m_nLength == 0 ) )
+        {
+            return;
+        }
 
-        while ( ( nRemovePoint = IndexOf( strRemove ) ) != IASLib::NOT_FOUND )
+        size_t nLength = m_pStubData->m_nLength;
+        size_t nFound = CStringSearch::FindChar( m_pStubData->m_strData, nLength, chRemove );
+
+        if ( nFound == NOT_FOUND )
         {
-            strTemp = Substring( 0, (int)nRemovePoint );
-            strTemp += Substring( nRemovePoint + nRemoveLength );
-            *this = strTemp;
+            return;
         }
+
+        ChangeStub();
+
+            // Slide each run between the removed characters down over them
+        IASLibChar__ *pData = m_pStubData->m_strData;
+        size_t nWrite = nFound;
+        size_t nRead = nFound + 1;
+
+        while ( nRead < nLength )
+        {
+            nFound = CStringSearch::FindChar( pData + nRead, nLength - nRead, chRemove );
+
+            size_t nCopy = ( nFound != NOT_FOUND ) ? nFound : nLength - nRead;
+
+            memmove( pData + nWrite, pData + nRead, nCopy );
+            nWrite += nCopy;
+            nRead += nCopy + 1;
+        }
+
+        m_pStubData->ChangeSize( nWrite );
     }
 
+    void CString::Remove( const IASLibChar__ *strRemove )
+    {
+        Replace( strRemove, "" );
+    }
 
+    /**
+     * WildcardCompare
+     *
+     *      Matches the string against a pattern where '*' stands for any
+     * run of characters (including none) and '?' for any one character.
+     * The pattern is walked once, going back only to just after the last
+     * '*' when a match fails, so nothing is copied and there's no
+     * recursion. An empty pattern matches anything.
+     */
     bool CString::WildcardCompare( const IASLibChar__ *strPattern, bool bCaseSensitive )
     {
         if ( strPattern == NULL )
             return false;
 
-        if ( strcmp( strPattern, "*" ) == 0 )
-            return true;
-
-        if ( strlen( strPattern ) == 0 )
+        if ( *strPattern == 0 )
             return true;
 
-        if ( m_pStubData == NULL )
-            return false;
-
-        size_t  nCount = 0;
-        int     nPattern = 0;
-        CString strSubString;
-        CString strSubPattern;
-        int     nTemp;
-        bool    bMatched;
-        size_t  nPatternSize;
-        int     nMinimumSize;
+        const IASLibChar__ *pText = ( m_pStubData ) ? m_pStubData->m_strData : "";
+        size_t nText = ( m_pStubData ) ? m_pStubData->m_nLength : 0;
+        size_t nPatternLength = strlen( strPattern );
+        size_t nCount = 0;
+        size_t nPattern = 0;
+        size_t nStarPattern = NOT_FOUND;
+        size_t nStarText = 0;
 
-        while ( ( nCount < m_pStubData->m_nLength ) && ( nPattern < (int)strlen( strPattern ) ) )
+        while ( nCount < nText )
         {
-            switch ( strPattern[nPattern] )
+            if ( nPattern < nPatternLength )
             {
-                case '*':
-                    nTemp = (int)nCount;
-                    bMatched = false;
+                IASLibChar__ chPattern = strPattern[ nPattern ];
 
-                    nPattern++;
-                    strSubPattern = strPattern;
-                    strSubPattern = strSubPattern.Substring( nPattern );
-                    nPatternSize = strlen( strPattern ) - nPattern;
-                    nMinimumSize = (int)(m_pStubData->m_nLength - nPatternSize);
-                    while ( nTemp <= nMinimumSize )
-                    {
-                        strSubString = Substring( nTemp );
-                        if ( strSubString.WildcardCompare( strSubPattern, bCaseSensitive ) )
-                        {
-                            bMatched = true;
-                            break;
-                        }
-                        nTemp++;
-                    }
-                    return bMatched;
-
-                case '?':
-                        // Skip the next character
-                    nCount++;
-                    nPattern++;
-                    break;
+                if ( chPattern == '*' )
+                {
+                    nStarPattern = ++nPattern;
+                    nStarText = nCount;
+                    continue;
+                }
 
-                default:
-                    if ( bCaseSensitive )
-                    {
-                        if ( m_pStubData->m_strData[ nCount ] != strPattern[ nPattern ] )
-                        {
-                            return false;
-                        }
-                    }
-                    else
-                    {
-                        if ( toupper( m_pStubData->m_strData[ nCount ] ) != toupper( strPattern[ nPattern ] ) )
-                        {
-                            return false;
-                        }
-                    }
+                if ( ( chPattern == '?' ) ||
+                     ( ( bCaseSensitive ) ? ( chPattern == pText[ nCount ] ) : ( CStringSearch::ToLower( chPattern ) == CStringSearch::ToLower( pText[ nCount ] ) ) ) )
+                {
                     nCount++;
                     nPattern++;
-                    break;
+                    continue;
+                }
             }
-        }
 
-        if ( ( nCount == m_pStubData->m_nLength ) && ( nPattern < (int)strlen( strPattern ) ) )
-        {
-            return false;
+                // No match here; let the last '*' take one more character
+            if ( nStarPattern == NOT_FOUND )
+            {
+                return false;
+            }
+            nPattern = nStarPattern;
+            nCount = ++nStarText;
         }
 
-        if ( nCount < m_pStubData->m_nLength )
+        while ( ( nPattern < nPatternLength ) && ( strPattern[ nPattern ] == '*' ) )
         {
-            return false;
+            nPattern++;
         }
 
-        return true;
+        return ( nPattern == nPatternLength );
     }
 
     void CString::OracleEscape( void )
@@ -2108,6 +2166,35 @@ namespace IASLib
         }
     }
 
+        // Makes room for the string to grow to nCapacity characters without
+        // being reallocated. Appending already grows the buffer
+        // geometrically; this saves even those steps when the final size
+        // is known (or can be guessed).
+    void CString::Reserve( size_t nCapacity )
+    {
+        if ( ! m_pStubData )
+        {
+            if ( nCapacity == 0 )
+            {
+                return;
+            }
+
+            m_pStubData = new CStringStub( "", (size_t)0 );
+            m_pStubData->AddRef();
+        }
+        else
+        {
+            ChangeStub();
+        }
+
+        m_pStubData->Reserve( nCapacity );
+    }
+
+    size_t CString::GetCapacity( void ) const
+    {
+        return ( m_pStubData ) ? m_pStubData->GetCapacity() : 0;
+    }
+
     void CString::ChangeStub( void )
     {
         CStringStub    *stubTemp;
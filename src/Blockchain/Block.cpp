@@ -1,4 +1,5 @@
 #include "Blockchain/Block.h"
+#include "Blockchain/BlockMiner.h"
 #include "Encryption/Sha256.h"
 
 namespace IASLib
@@ -8,29 +9,50 @@ namespace IASLib
         _nNonce = -1;
     }
 
+        // A block read back from a CBlockStore, already mined
+    CBlock::CBlock(uint32_t nIndexIn, const CString &sDataIn, const CDate &tTimeIn, int64_t nNonceIn, const CString &sPrevHashIn, const CString &sHashIn) : sPrevHash(sPrevHashIn), _nIndex(nIndexIn), _nNonce(nNonceIn), _sData(sDataIn), _sHash(sHashIn), _tTime(tTimeIn)
+    {
+    }
+
     CString CBlock::getHash() 
     {
         return _sHash;
     }
 
-    void CBlock::mineBlock(uint32_t nDifficulty) 
+    /**
+     * mineBlock
+     *
+     *      Finds a nonce that gives the block a hash starting with
+     * nDifficulty zeros. Everything hashed ahead of the nonce is the same
+     * for every try, so the miner hashes it once and carries on from there.
+     *
+     * @param nThreads
+     *      The number of threads to search with (0 for one per processor).
+     * @return
+     *      false if no nonce was found (the difficulty is more digits than
+     *      a hash has); the block's hash is left as it was.
+     */
+    bool CBlock::mineBlock(uint32_t nDifficulty, size_t nThreads) 
     {
-        char cstr[nDifficulty + 1];
-        for (uint32_t i = 0; i < nDifficulty; ++i) 
+        CString strPrefix;
+        strPrefix = _nIndex;
+        strPrefix += _tTime.FormatDate( CDate::DF_ISO_8601_MS_PACKED);
+        strPrefix += _sData;
+
+        CBlockMiner miner( strPrefix, sPrevHash, nDifficulty );
+
+        if ( ! miner.Mine( _nNonce + 1, nThreads ) )
         {
-            cstr[i] = '0';
+            return false;
         }
-        cstr[nDifficulty] = '\0';
 
-        CString str(cstr);
+        char strHash[2 * CSHA256::DIGEST_SIZE + 1];
 
-        do 
-        {
-            _nNonce++;
-            _sHash = calculateHash();
-        } while (_sHash.Substring(0, nDifficulty) != str);
+        _nNonce = miner.GetNonce();
+        CSHA256::HexDigest( miner.GetDigest(), strHash );
+        _sHash = strHash;
 
-        printf( "Block mined: %s\n", (const char *)_sHash );
+        return true;
     }
 
     CString CBlock::calculateHash() const 
@@ -0,0 +1,264 @@
+/**
+ *  Block Miner Class
+ *
+ *      Searches for a nonce that gives a block a hash with the required
+ * number of leading zero hex digits. The part of the block's text that
+ * comes before the nonce never changes, so it's hashed once and the
+ * SHA256 state saved; each try only hashes the rest. The nonce space is
+ * split across threads, which all stop as soon as one of them finds an
+ * answer, and the difficulty is checked on the raw digest bytes.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "Blockchain/BlockMiner.h"
+
+#ifndef IASLIB_WIN32__
+#include <unistd.h>
+#endif
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CBlockMiner, CObject );
+
+    /**
+     * Constructor
+     *
+     * @param strPrefix
+     *      The block's text before the nonce, hashed once up front.
+     * @param strSuffix
+     *      The block's text after the nonce.
+     * @param nDifficulty
+     *      The number of leading zero hex digits the hash needs.
+     */
+    CBlockMiner::CBlockMiner( const CString &strPrefix, const CString &strSuffix, uint32_t nDifficulty )
+    {
+        CString strCopy = strPrefix;
+
+        m_ctxPrefix.init();
+        m_ctxPrefix.update( strCopy.getBytes(), (uint32)strCopy.GetLength() );
+        m_strSuffix = strSuffix;
+        m_nDifficulty = nDifficulty;
+        m_bFound = false;
+        m_nNonce = -1;
+        memset( m_aDigest, 0, sizeof( m_aDigest ) );
+        m_ullHashes = 0;
+    }
+
+    CBlockMiner::~CBlockMiner( void )
+    {
+    }
+
+    /**
+     * Mine
+     *
+     *      Searches from nStartNonce up for a nonce that meets the
+     * difficulty. Each thread tries every nThreads'th nonce, so the first
+     * answer found is not always the lowest.
+     *
+     * @param nThreads
+     *      The number of threads to search with (0 for one per processor).
+     * @return
+     *      true if a nonce was found; GetNonce() and GetDigest() have it.
+     */
+    bool CBlockMiner::Mine( int64_t nStartNonce, size_t nThreads )
+    {
+        if ( m_nDifficulty > CSHA256::DIGEST_SIZE * 2 )
+        {
+            return false;
+        }
+
+        m_bFound = false;
+        m_ullHashes = 0;
+
+#ifdef IASLIB_MULTI_THREADED__
+        if ( nThreads == 0 )
+        {
+#ifdef IASLIB_WIN32__
+            SYSTEM_INFO sysInfo;
+            GetSystemInfo( &sysInfo );
+            nThreads = (size_t)sysInfo.dwNumberOfProcessors;
+#else
+            long nProcessors = sysconf( _SC_NPROCESSORS_ONLN );
+            nThreads = ( nProcessors > 0 ) ? (size_t)nProcessors : 1;
+#endif
+        }
+
+        if ( ( nThreads > 1 ) && ( CThread::IsAvailable() ) )
+        {
+            CBlockMinerThread **apThreads = new CBlockMinerThread *[ nThreads ];
+
+            for ( size_t nX = 0; nX < nThreads; nX++ )
+            {
+                apThreads[nX] = new CBlockMinerThread( this, nStartNonce + (int64_t)nX, (int64_t)nThreads );
+            }
+
+            for ( size_t nX = 0; nX < nThreads; nX++ )
+            {
+                apThreads[nX]->Join();
+                delete apThreads[nX];
+            }
+            delete [] apThreads;
+
+                // The threads only stop once one of them has an answer; if
+                // there isn't one, they never started, so search here.
+            if ( m_bFound )
+            {
+                return true;
+            }
+        }
+#endif
+
+        Search( nStartNonce, 1 );
+
+        return m_bFound;
+    }
+
+    /**
+     * Search
+     *
+     *      Tries nFirstNonce, nFirstNonce + nStride, and so on, until it
+     * finds an answer or another thread does.
+     */
+    void CBlockMiner::Search( int64_t nFirstNonce, int64_t nStride )
+    {
+        CSHA256 ctx;
+        char achNonce[24];
+        uint8 aDigest[CSHA256::DIGEST_SIZE];
+        const uint8 *pSuffix = m_strSuffix.getBytes();
+        uint32 nSuffix = (uint32)m_strSuffix.GetLength();
+        uint64 ullHashes = 0;
+
+        for ( int64_t nNonce = nFirstNonce; ; nNonce += nStride )
+        {
+            if ( ( ( ullHashes % CHECK_INTERVAL ) == 0 ) && ( IsFound() ) )
+            {
+                break;
+            }
+
+            ctx = m_ctxPrefix;
+            ctx.update( (const uint8 *)achNonce, (uint32)FormatNonce( nNonce, achNonce ) );
+            ctx.update( pSuffix, nSuffix );
+            ctx.final( aDigest );
+            ullHashes++;
+
+            if ( MeetsDifficulty( aDigest, m_nDifficulty ) )
+            {
+                Found( nNonce, aDigest, ullHashes );
+                return;
+            }
+        }
+
+        Searched( ullHashes );
+    }
+
+    /**
+     * MeetsDifficulty
+     *
+     *      Does the digest start with nDifficulty zero hex digits?
+     */
+    bool CBlockMiner::MeetsDifficulty( const uint8 *pDigest, uint32_t nDifficulty )
+    {
+        uint32_t nBytes = nDifficulty >> 1;
+
+        for ( uint32_t nX = 0; nX < nBytes; nX++ )
+        {
+            if ( pDigest[nX] )
+            {
+                return false;
+            }
+        }
+
+        return ( ( nDifficulty & 1 ) == 0 ) || ( ( pDigest[nBytes] & 0xF0 ) == 0 );
+    }
+
+    /**
+     * FormatNonce
+     *
+     *      Writes the nonce in decimal, the same way CString's += does.
+     *
+     * @return
+     *      The number of characters written (no terminator).
+     */
+    size_t CBlockMiner::FormatNonce( int64_t nNonce, char *strBuffer )
+    {
+        char achDigits[24];
+        size_t nDigits = 0;
+        size_t nLength = 0;
+        uint64 ullValue = ( nNonce < 0 ) ? ( 0 - (uint64)nNonce ) : (uint64)nNonce;
+
+        do
+        {
+            achDigits[nDigits++] = (char)( '0' + ( ullValue % 10 ) );
+            ullValue /= 10;
+        } while ( ullValue );
+
+        if ( nNonce < 0 )
+        {
+            strBuffer[nLength++] = '-';
+        }
+        while ( nDigits )
+        {
+            strBuffer[nLength++] = achDigits[--nDigits];
+        }
+
+        return nLength;
+    }
+
+    bool CBlockMiner::IsFound( void )
+    {
+        m_mutexResult.Lock();
+        bool bFound = m_bFound;
+        m_mutexResult.Unlock();
+
+        return bFound;
+    }
+
+    void CBlockMiner::Found( int64_t nNonce, const uint8 *pDigest, uint64 ullHashes )
+    {
+        m_mutexResult.Lock();
+        if ( ! m_bFound )
+        {
+            m_bFound = true;
+            m_nNonce = nNonce;
+            memcpy( m_aDigest, pDigest, CSHA256::DIGEST_SIZE );
+        }
+        m_ullHashes += ullHashes;
+        m_mutexResult.Unlock();
+    }
+
+    void CBlockMiner::Searched( uint64 ullHashes )
+    {
+        m_mutexResult.Lock();
+        m_ullHashes += ullHashes;
+        m_mutexResult.Unlock();
+    }
+
+#ifdef IASLIB_MULTI_THREADED__
+    IMPLEMENT_OBJECT( CBlockMinerThread, CThread );
+
+    CBlockMinerThread::CBlockMinerThread( CBlockMiner *pMiner, int64_t nFirstNonce, int64_t nStride ) : CThread( "BlockMiner", true, false, true )
+    {
+        m_pMiner = pMiner;
+        m_nFirstNonce = nFirstNonce;
+        m_nStride = nStride;
+
+        Resume();
+    }
+
+    CBlockMinerThread::~CBlockMinerThread( void )
+    {
+    }
+
+    void *CBlockMinerThread::Run( void )
+    {
+        m_pMiner->Search( m_nFirstNonce, m_nStride );
+
+        return NULL;
+    }
+#endif // IASLIB_MULTI_THREADED__
+} // namespace IASLib
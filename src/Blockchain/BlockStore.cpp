@@ -0,0 +1,851 @@
+/**
+ *  Block Store Class
+ *
+ *      Keeps a chain's blocks on disk, so a chain survives a restart
+ * without being mined again. Blocks are only ever appended, each one
+ * written as a length prefixed record to the end of the current segment
+ * file (blocks-00000.dat, blocks-00001.dat, ...); once a segment reaches
+ * its size limit, a new one is started.
+ *      Segments are read through memory maps. Two indexes are kept in
+ * memory: by height (the block's position in the chain), and by hash, an
+ * open addressed table of hash codes pointing into the height index, so a
+ * block can be found by either in constant time. Both are rebuilt when
+ * the store is opened, by scanning the segments; the scan also checks
+ * every block's hash, and runs on several threads, a segment at a time.
+ * A torn record at the end of the last segment (from a crash mid-write)
+ * is cut off; damage anywhere else fails the open.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "Blockchain/BlockStore.h"
+#include "Blockchain/BlockMiner.h"
+#include "Encryption/Sha256.h"
+
+#ifndef IASLIB_WIN32__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CBlockStore, CObject );
+
+    CBlockStore::CBlockStore( void )
+    {
+        m_nSegmentLimit = DEFAULT_SEGMENT_SIZE;
+        m_bSyncWrites = false;
+        m_bOpen = false;
+        m_aSegments = NULL;
+        m_nSegments = 0;
+        m_aHeights = NULL;
+        m_nHeights = 0;
+        m_nHeightCapacity = 0;
+        m_aHashSlots = NULL;
+        m_nHashSlots = 0;
+    }
+
+    CBlockStore::~CBlockStore( void )
+    {
+        Close();
+    }
+
+    /**
+     * Open
+     *
+     *      Opens (or creates) the store in a directory, scans its segments
+     * and rebuilds the indexes.
+     *
+     * @param nThreads
+     *      The most threads to scan with (0 for one per processor).
+     * @return
+     *      false if a segment couldn't be read, a block in it is bad, or
+     *      a scanning thread didn't finish;
+     *      GetLastError() says which.
+     */
+    bool CBlockStore::Open( const char *strDirectory, size_t nThreads )
+    {
+        Close();
+
+        m_strDirectory = strDirectory;
+        if ( ( mkdir( strDirectory, 0755 ) != 0 ) && ( errno != EEXIST ) )
+        {
+            m_strLastError.Format( "Can't create %s: %s", strDirectory, strerror( errno ) );
+            return false;
+        }
+
+            // Segments are numbered from zero with no gaps
+        size_t nFound = 0;
+        struct stat statSegment;
+        while ( stat( GetSegmentPath( nFound ), &statSegment ) == 0 )
+        {
+            nFound++;
+        }
+
+        m_aSegments = (Segment *)calloc( ( nFound ) ? nFound : 1, sizeof( Segment ) );
+        for ( size_t nX = 0; nX < nFound; nX++ )
+        {
+            m_aSegments[nX].m_hFile = -1;
+        }
+        m_nSegments = nFound;
+
+        for ( size_t nX = 0; nX < nFound; nX++ )
+        {
+            if ( ! OpenSegment( nX, false ) )
+            {
+                Close();
+                return false;
+            }
+        }
+
+            // The date tables are filled in on first use; do it before the
+            // scanning threads need them.
+        CDate dttInitialize;
+
+#ifdef IASLIB_MULTI_THREADED__
+        if ( nThreads == 0 )
+        {
+            long nProcessors = sysconf( _SC_NPROCESSORS_ONLN );
+            nThreads = ( nProcessors > 0 ) ? (size_t)nProcessors : 1;
+        }
+        if ( nThreads > nFound )
+        {
+            nThreads = nFound;
+        }
+
+        if ( ( nThreads > 1 ) && ( CThread::IsAvailable() ) )
+        {
+            CBlockStoreScanner **apScanners = new CBlockStoreScanner *[ nThreads ];
+            bool bFinished = true;
+
+            for ( size_t nX = 0; nX < nThreads; nX++ )
+            {
+                apScanners[nX] = new CBlockStoreScanner( this, nX, nFound, nThreads );
+            }
+            for ( size_t nX = 0; nX < nThreads; nX++ )
+            {
+                apScanners[nX]->Join();
+                if ( ! apScanners[nX]->IsFinished() )
+                {
+                    bFinished = false;
+                }
+                delete apScanners[nX];
+            }
+            delete [] apScanners;
+
+                // A scanner that never ran leaves its segments looking empty,
+                // which would quietly lose the chain.
+            if ( ! bFinished )
+            {
+                m_strLastError = "A segment scanning thread didn't finish";
+                Close();
+                return false;
+            }
+        }
+        else
+#endif
+        {
+            for ( size_t nX = 0; nX < nFound; nX++ )
+            {
+                ScanSegment( nX );
+            }
+        }
+
+            // Put the indexes together in chain order, checking each block
+            // points back at the one before it.
+        for ( size_t nX = 0; nX < nFound; nX++ )
+        {
+            Segment &segment = m_aSegments[nX];
+
+            if ( ( segment.m_bDamaged ) && ( nX + 1 < nFound ) )
+            {
+                m_strLastError.Format( "Segment %s is damaged at offset %lu", (const char *)GetSegmentPath( nX ), (unsigned long)segment.m_nGoodSize );
+                Close();
+                return false;
+            }
+
+            for ( size_t nRecord = 0; nRecord < segment.m_nRecords; nRecord++ )
+            {
+                Record record;
+
+                ParseRecord( segment.m_pMap + segment.m_anOffsets[nRecord], segment.m_nSize - segment.m_anOffsets[nRecord], record );
+                if ( m_nHeights )
+                {
+                    Record recordPrevious;
+
+                    ReadRecord( m_nHeights - 1, recordPrevious );
+                    if ( ( record.m_nPrevHash != recordPrevious.m_nHash ) || ( memcmp( record.m_pPrevHash, recordPrevious.m_pHash, record.m_nPrevHash ) != 0 ) )
+                    {
+                        m_strLastError.Format( "Block at height %lu doesn't follow the one before it", (unsigned long)m_nHeights );
+                        Close();
+                        return false;
+                    }
+                }
+                else if ( record.m_nPrevHash != 0 )
+                {
+                    m_strLastError = "The first block isn't a genesis block";
+                    Close();
+                    return false;
+                }
+
+                AddHash( record.m_pHash, record.m_nHash, m_nHeights );
+                AddHeight( (uint32_t)nX, segment.m_anOffsets[nRecord] );
+            }
+
+                // Cut off a torn write at the end of the last segment
+            if ( segment.m_bDamaged )
+            {
+                if ( ftruncate( segment.m_hFile, (off_t)segment.m_nGoodSize ) != 0 )
+                {
+                    m_strLastError.Format( "Can't truncate %s: %s", (const char *)GetSegmentPath( nX ), strerror( errno ) );
+                    Close();
+                    return false;
+                }
+                segment.m_nSize = segment.m_nGoodSize;
+                segment.m_bDamaged = false;
+            }
+
+            free( segment.m_anOffsets );
+            segment.m_anOffsets = NULL;
+            segment.m_nRecords = 0;
+            segment.m_nCapacity = 0;
+        }
+
+        if ( m_nSegments == 0 )
+        {
+            m_nSegments = 1;
+            m_aSegments[0].m_hFile = -1;
+            if ( ! OpenSegment( 0, true ) )
+            {
+                Close();
+                return false;
+            }
+        }
+
+        m_bOpen = true;
+        return true;
+    }
+
+    void CBlockStore::Close( void )
+    {
+        m_mutexStore.Lock();
+        for ( size_t nX = 0; nX < m_nSegments; nX++ )
+        {
+            CloseSegment( m_aSegments[nX] );
+            free( m_aSegments[nX].m_anOffsets );
+        }
+        free( m_aSegments );
+        m_aSegments = NULL;
+        m_nSegments = 0;
+
+        free( m_aHeights );
+        m_aHeights = NULL;
+        m_nHeights = 0;
+        m_nHeightCapacity = 0;
+
+        free( m_aHashSlots );
+        m_aHashSlots = NULL;
+        m_nHashSlots = 0;
+
+        m_bOpen = false;
+        m_mutexStore.Unlock();
+    }
+
+    /**
+     * Sync
+     *
+     *      Flushes the current segment to the disk.
+     */
+    bool CBlockStore::Sync( void )
+    {
+        m_mutexStore.Lock();
+        bool bSynced = ( m_bOpen ) && ( fsync( m_aSegments[m_nSegments - 1].m_hFile ) == 0 );
+        m_mutexStore.Unlock();
+
+        return bSynced;
+    }
+
+    /**
+     * Append
+     *
+     *      Writes a block to the end of the store. The block should already
+     * be mined, and follow the last block in the store.
+     *
+     * @return
+     *      false if the block couldn't be written.
+     */
+    bool CBlockStore::Append( CBlock *pBlock )
+    {
+        CString strPrevHash = pBlock->sPrevHash;
+        CString strHash = pBlock->_sHash;
+        CString strData = pBlock->_sData;
+        uint32_t nPrevHash = (uint32_t)strPrevHash.GetLength();
+        uint32_t nHash = (uint32_t)strHash.GetLength();
+        uint32_t nData = (uint32_t)strData.GetLength();
+        uint32_t nPayload = 4 + 8 + 4 + 4 + 4 + nPrevHash + 4 + nHash + 4 + nData;
+        size_t nRecord = RECORD_HEADER_SIZE + nPayload;
+        uint8_t *pRecord = (uint8_t *)malloc( nRecord );
+        uint8_t *pWrite = pRecord;
+        uint32_t nMagic = RECORD_MAGIC;
+        int32_t nEpochDay = (int32_t)pBlock->_tTime.GetEpochDay();
+        int32_t nMilliseconds = pBlock->_tTime.GetSOD() * 1000 + pBlock->_tTime.GetMillisecond();
+
+        memcpy( pWrite, &nMagic, 4 );                   pWrite += 4;
+        memcpy( pWrite, &nPayload, 4 );                 pWrite += 4;
+        memcpy( pWrite, &pBlock->_nIndex, 4 );          pWrite += 4;
+        memcpy( pWrite, &pBlock->_nNonce, 8 );          pWrite += 8;
+        memcpy( pWrite, &nEpochDay, 4 );                pWrite += 4;
+        memcpy( pWrite, &nMilliseconds, 4 );            pWrite += 4;
+        memcpy( pWrite, &nPrevHash, 4 );                pWrite += 4;
+        memcpy( pWrite, strPrevHash.getBytes(), nPrevHash ); pWrite += nPrevHash;
+        memcpy( pWrite, &nHash, 4 );                    pWrite += 4;
+        memcpy( pWrite, strHash.getBytes(), nHash );    pWrite += nHash;
+        memcpy( pWrite, &nData, 4 );                    pWrite += 4;
+        memcpy( pWrite, strData.getBytes(), nData );
+
+        m_mutexStore.Lock();
+        if ( ! m_bOpen )
+        {
+            m_mutexStore.Unlock();
+            free( pRecord );
+            m_strLastError = "The store isn't open";
+            return false;
+        }
+
+        if ( ( m_aSegments[m_nSegments - 1].m_nSize > 0 ) && ( m_aSegments[m_nSegments - 1].m_nSize + nRecord > m_nSegmentLimit ) )
+        {
+            Segment *aSegments = (Segment *)realloc( m_aSegments, ( m_nSegments + 1 ) * sizeof( Segment ) );
+
+            if ( aSegments == NULL )
+            {
+                m_mutexStore.Unlock();
+                free( pRecord );
+                m_strLastError = "Out of memory";
+                return false;
+            }
+            m_aSegments = aSegments;
+            memset( &m_aSegments[m_nSegments], 0, sizeof( Segment ) );
+            m_aSegments[m_nSegments].m_hFile = -1;
+            m_nSegments++;
+
+            if ( ! OpenSegment( m_nSegments - 1, true ) )
+            {
+                m_nSegments--;
+                m_mutexStore.Unlock();
+                free( pRecord );
+                return false;
+            }
+        }
+
+        Segment &segment = m_aSegments[m_nSegments - 1];
+        size_t nWritten = 0;
+
+        while ( nWritten < nRecord )
+        {
+            ssize_t nResult = pwrite( segment.m_hFile, pRecord + nWritten, nRecord - nWritten, (off_t)( segment.m_nSize + nWritten ) );
+
+            if ( nResult < 0 )
+            {
+                if ( errno == EINTR )
+                {
+                    continue;
+                }
+
+                m_strLastError.Format( "Can't write to %s: %s", (const char *)GetSegmentPath( m_nSegments - 1 ), strerror( errno ) );
+                if ( ftruncate( segment.m_hFile, (off_t)segment.m_nSize ) != 0 )
+                {
+                    m_strLastError += " (and the partial record is still there)";
+                }
+                m_mutexStore.Unlock();
+                free( pRecord );
+                return false;
+            }
+            nWritten += (size_t)nResult;
+        }
+        free( pRecord );
+
+        if ( m_bSyncWrites )
+        {
+            fdatasync( segment.m_hFile );
+        }
+
+        AddHash( strHash, nHash, m_nHeights );
+        AddHeight( (uint32_t)( m_nSegments - 1 ), segment.m_nSize );
+        segment.m_nSize += nRecord;
+        m_mutexStore.Unlock();
+
+        return true;
+    }
+
+    size_t CBlockStore::GetHeight( void )
+    {
+        m_mutexStore.Lock();
+        size_t nHeight = m_nHeights;
+        m_mutexStore.Unlock();
+
+        return nHeight;
+    }
+
+    /**
+     * GetBlock
+     *
+     *      Reads the block at a height (counting from zero, the genesis
+     * block).
+     *
+     * @return
+     *      A new block, which the caller deletes, or NULL if there's none.
+     */
+    CBlock *CBlockStore::GetBlock( size_t nHeight )
+    {
+        CBlock *pBlock = NULL;
+        Record record;
+
+        m_mutexStore.Lock();
+        if ( ReadRecord( nHeight, record ) )
+        {
+            pBlock = MakeBlock( record );
+        }
+        m_mutexStore.Unlock();
+
+        return pBlock;
+    }
+
+    /**
+     * FindBlock
+     *
+     *      Looks a block up by its hash.
+     *
+     * @return
+     *      A new block, which the caller deletes, or NULL if there's none.
+     */
+    CBlock *CBlockStore::FindBlock( const char *strHash )
+    {
+        CBlock *pBlock = NULL;
+        size_t nHeight;
+        Record record;
+
+        m_mutexStore.Lock();
+        if ( ( LookupHash( strHash, strlen( strHash ), nHeight ) ) && ( ReadRecord( nHeight, record ) ) )
+        {
+            pBlock = MakeBlock( record );
+        }
+        m_mutexStore.Unlock();
+
+        return pBlock;
+    }
+
+    bool CBlockStore::FindHeight( const char *strHash, size_t &nHeight )
+    {
+        m_mutexStore.Lock();
+        bool bFound = LookupHash( strHash, strlen( strHash ), nHeight );
+        m_mutexStore.Unlock();
+
+        return bFound;
+    }
+
+    /**
+     * ScanSegment
+     *
+     *      Walks a segment's records at open, noting where each one starts
+     * and checking its hash. Each segment is scanned on its own, so they
+     * can be scanned in parallel.
+     */
+    void CBlockStore::ScanSegment( size_t nSegment )
+    {
+        Segment &segment = m_aSegments[nSegment];
+        size_t nOffset = 0;
+
+        while ( nOffset < segment.m_nSize )
+        {
+            Record record;
+
+            if ( ! ParseRecord( segment.m_pMap + nOffset, segment.m_nSize - nOffset, record ) )
+            {
+                break;
+            }
+
+                // Only the genesis block goes unmined
+            if ( record.m_nHash == 0 )
+            {
+                if ( ( nSegment != 0 ) || ( nOffset != 0 ) )
+                {
+                    break;
+                }
+            }
+            else if ( ! CheckHash( record ) )
+            {
+                break;
+            }
+
+            if ( segment.m_nRecords == segment.m_nCapacity )
+            {
+                segment.m_nCapacity = ( segment.m_nCapacity ) ? segment.m_nCapacity * 2 : 1024;
+                segment.m_anOffsets = (uint64_t *)realloc( segment.m_anOffsets, segment.m_nCapacity * sizeof( uint64_t ) );
+            }
+            segment.m_anOffsets[segment.m_nRecords++] = nOffset;
+            nOffset += record.m_nRecordSize;
+        }
+
+        segment.m_nGoodSize = nOffset;
+        segment.m_bDamaged = ( nOffset != segment.m_nSize );
+    }
+
+    /**
+     * HashCode
+     *
+     *      FNV-1a over the hash text; never zero, which marks an empty slot.
+     */
+    uint64_t CBlockStore::HashCode( const char *pHash, size_t nLength )
+    {
+        uint64_t nCode = 14695981039346656037ULL;
+
+        for ( size_t nX = 0; nX < nLength; nX++ )
+        {
+            nCode ^= (uint8_t)pHash[nX];
+            nCode *= 1099511628211ULL;
+        }
+
+        return ( nCode ) ? nCode : 1;
+    }
+
+    bool CBlockStore::OpenSegment( size_t nSegment, bool bCreate )
+    {
+        Segment &segment = m_aSegments[nSegment];
+        struct stat statSegment;
+
+        CString strPath = GetSegmentPath( nSegment );
+
+        segment.m_hFile = open( strPath, O_RDWR | ( ( bCreate ) ? O_CREAT | O_EXCL : 0 ), 0644 );
+        if ( segment.m_hFile < 0 )
+        {
+            m_strLastError.Format( "Can't open %s: %s", (const char *)strPath, strerror( errno ) );
+            return false;
+        }
+
+        if ( fstat( segment.m_hFile, &statSegment ) != 0 )
+        {
+            m_strLastError.Format( "Can't stat %s: %s", (const char *)strPath, strerror( errno ) );
+            CloseSegment( segment );
+            return false;
+        }
+        segment.m_nSize = (size_t)statSegment.st_size;
+
+        return MapSegment( segment );
+    }
+
+    /**
+     * MapSegment
+     *
+     *      Maps a segment for reading. The current segment grows as blocks
+     * are added, so it's mapped up to its size limit; the pages past the
+     * end of the file are never touched.
+     */
+    bool CBlockStore::MapSegment( Segment &segment )
+    {
+        size_t nMap = ( segment.m_nSize > m_nSegmentLimit ) ? segment.m_nSize : m_nSegmentLimit;
+
+        if ( segment.m_pMap )
+        {
+            munmap( segment.m_pMap, segment.m_nMapped );
+            segment.m_pMap = NULL;
+            segment.m_nMapped = 0;
+        }
+
+        void *pMap = mmap( NULL, nMap, PROT_READ, MAP_SHARED, segment.m_hFile, 0 );
+        if ( pMap == MAP_FAILED )
+        {
+            m_strLastError.Format( "Can't map %s: %s", (const char *)GetSegmentPath( &segment - m_aSegments ), strerror( errno ) );
+            return false;
+        }
+
+        segment.m_pMap = (uint8_t *)pMap;
+        segment.m_nMapped = nMap;
+        return true;
+    }
+
+    void CBlockStore::CloseSegment( Segment &segment )
+    {
+        if ( segment.m_pMap )
+        {
+            munmap( segment.m_pMap, segment.m_nMapped );
+            segment.m_pMap = NULL;
+            segment.m_nMapped = 0;
+        }
+        if ( segment.m_hFile >= 0 )
+        {
+            close( segment.m_hFile );
+            segment.m_hFile = -1;
+        }
+    }
+
+    CString CBlockStore::GetSegmentPath( size_t nSegment )
+    {
+        CString strPath;
+
+        strPath.Format( "%s/blocks-%05lu.dat", (const char *)m_strDirectory, (unsigned long)nSegment );
+        return strPath;
+    }
+
+    bool CBlockStore::ReadRecord( size_t nHeight, Record &record )
+    {
+        if ( nHeight >= m_nHeights )
+        {
+            return false;
+        }
+
+        Location &location = m_aHeights[nHeight];
+        Segment &segment = m_aSegments[location.m_nSegment];
+
+            // A big record can run the current segment past the map
+        if ( ( segment.m_nSize > segment.m_nMapped ) && ( ! MapSegment( segment ) ) )
+        {
+            return false;
+        }
+
+        return ParseRecord( segment.m_pMap + location.m_nOffset, segment.m_nSize - location.m_nOffset, record );
+    }
+
+    /**
+     * ParseRecord
+     *
+     *      Reads a record's fields in place.
+     *
+     * @return
+     *      false if the record is cut short or isn't a record at all.
+     */
+    bool CBlockStore::ParseRecord( const uint8_t *pRecord, size_t nAvailable, Record &record )
+    {
+        uint32_t nMagic;
+        uint32_t nPayload;
+
+        if ( nAvailable < RECORD_HEADER_SIZE + 32 )
+        {
+            return false;
+        }
+
+        memcpy( &nMagic, pRecord, 4 );
+        memcpy( &nPayload, pRecord + 4, 4 );
+        if ( ( nMagic != RECORD_MAGIC ) || ( nPayload < 32 ) || ( nPayload > nAvailable - RECORD_HEADER_SIZE ) )
+        {
+            return false;
+        }
+
+        const uint8_t *pRead = pRecord + RECORD_HEADER_SIZE;
+        const uint8_t *pEnd = pRead + nPayload;
+
+        memcpy( &record.m_nIndex, pRead, 4 );           pRead += 4;
+        memcpy( &record.m_nNonce, pRead, 8 );           pRead += 8;
+        memcpy( &record.m_nEpochDay, pRead, 4 );        pRead += 4;
+        memcpy( &record.m_nMilliseconds, pRead, 4 );    pRead += 4;
+
+        memcpy( &record.m_nPrevHash, pRead, 4 );        pRead += 4;
+        if ( record.m_nPrevHash > (size_t)( pEnd - pRead ) )
+        {
+            return false;
+        }
+        record.m_pPrevHash = (const char *)pRead;       pRead += record.m_nPrevHash;
+
+        if ( (size_t)( pEnd - pRead ) < 4 )
+        {
+            return false;
+        }
+        memcpy( &record.m_nHash, pRead, 4 );            pRead += 4;
+        if ( record.m_nHash > (size_t)( pEnd - pRead ) )
+        {
+            return false;
+        }
+        record.m_pHash = (const char *)pRead;           pRead += record.m_nHash;
+
+        if ( (size_t)( pEnd - pRead ) < 4 )
+        {
+            return false;
+        }
+        memcpy( &record.m_nData, pRead, 4 );            pRead += 4;
+        if ( record.m_nData != (size_t)( pEnd - pRead ) )
+        {
+            return false;
+        }
+        record.m_pData = (const char *)pRead;
+
+        record.m_nRecordSize = RECORD_HEADER_SIZE + nPayload;
+        return true;
+    }
+
+    /**
+     * CheckHash
+     *
+     *      Hashes a record's fields the way CBlock::calculateHash() does,
+     * and compares the result with the stored hash.
+     */
+    bool CBlockStore::CheckHash( const Record &record )
+    {
+        if ( record.m_nHash != 2 * CSHA256::DIGEST_SIZE )
+        {
+            return false;
+        }
+
+        CSHA256 ctx;
+        char achNumber[24];
+        uint8 aDigest[CSHA256::DIGEST_SIZE];
+        char strHex[2 * CSHA256::DIGEST_SIZE + 1];
+        CDate dttTime( (long)record.m_nEpochDay, (long)record.m_nMilliseconds );
+        CString strTime = dttTime.FormatDate( CDate::DF_ISO_8601_MS_PACKED );
+
+        ctx.init();
+        ctx.update( (const uint8 *)achNumber, (uint32)CBlockMiner::FormatNonce( (int64_t)record.m_nIndex, achNumber ) );
+        ctx.update( strTime.getBytes(), (uint32)strTime.GetLength() );
+        ctx.update( (const uint8 *)record.m_pData, record.m_nData );
+        ctx.update( (const uint8 *)achNumber, (uint32)CBlockMiner::FormatNonce( record.m_nNonce, achNumber ) );
+        ctx.update( (const uint8 *)record.m_pPrevHash, record.m_nPrevHash );
+        ctx.final( aDigest );
+        CSHA256::HexDigest( aDigest, strHex );
+
+        return ( memcmp( strHex, record.m_pHash, record.m_nHash ) == 0 );
+    }
+
+    CBlock *CBlockStore::MakeBlock( const Record &record )
+    {
+        CString strData( record.m_pData, (size_t)record.m_nData );
+        CString strPrevHash( record.m_pPrevHash, (size_t)record.m_nPrevHash );
+        CString strHash( record.m_pHash, (size_t)record.m_nHash );
+
+        return new CBlock( record.m_nIndex, strData, CDate( (long)record.m_nEpochDay, (long)record.m_nMilliseconds ), record.m_nNonce, strPrevHash, strHash );
+    }
+
+    void CBlockStore::AddHeight( uint32_t nSegment, uint64_t nOffset )
+    {
+        if ( m_nHeights == m_nHeightCapacity )
+        {
+            m_nHeightCapacity = ( m_nHeightCapacity ) ? m_nHeightCapacity * 2 : 1024;
+            m_aHeights = (Location *)realloc( m_aHeights, m_nHeightCapacity * sizeof( Location ) );
+        }
+
+        m_aHeights[m_nHeights].m_nSegment = nSegment;
+        m_aHeights[m_nHeights].m_nOffset = nOffset;
+        m_nHeights++;
+    }
+
+    void CBlockStore::AddHash( const char *pHash, size_t nLength, size_t nHeight )
+    {
+            // Keep the table at most half full
+        if ( ( m_nHeights + 1 ) * 2 > m_nHashSlots )
+        {
+            GrowHashSlots();
+        }
+
+        uint64_t nCode = HashCode( pHash, nLength );
+        size_t nMask = m_nHashSlots - 1;
+        size_t nSlot = (size_t)nCode & nMask;
+
+        while ( m_aHashSlots[nSlot].m_nHashCode )
+        {
+            nSlot = ( nSlot + 1 ) & nMask;
+        }
+
+        m_aHashSlots[nSlot].m_nHashCode = nCode;
+        m_aHashSlots[nSlot].m_nHeight = nHeight;
+    }
+
+    /**
+     * LookupHash
+     *
+     *      Finds a hash's height. Slots only hold hash codes, so a matching
+     * code is confirmed against the record itself.
+     */
+    bool CBlockStore::LookupHash( const char *pHash, size_t nLength, size_t &nHeight )
+    {
+        if ( m_nHashSlots == 0 )
+        {
+            return false;
+        }
+
+        uint64_t nCode = HashCode( pHash, nLength );
+        size_t nMask = m_nHashSlots - 1;
+        size_t nSlot = (size_t)nCode & nMask;
+
+        while ( m_aHashSlots[nSlot].m_nHashCode )
+        {
+            if ( m_aHashSlots[nSlot].m_nHashCode == nCode )
+            {
+                Record record;
+
+                if ( ( ReadRecord( m_aHashSlots[nSlot].m_nHeight, record ) ) && ( record.m_nHash == nLength ) && ( memcmp( record.m_pHash, pHash, nLength ) == 0 ) )
+                {
+                    nHeight = m_aHashSlots[nSlot].m_nHeight;
+                    return true;
+                }
+            }
+            nSlot = ( nSlot + 1 ) & nMask;
+        }
+
+        return false;
+    }
+
+    void CBlockStore::GrowHashSlots( void )
+    {
+        size_t nOldSlots = m_nHashSlots;
+        HashSlot *aOldSlots = m_aHashSlots;
+
+        m_nHashSlots = ( nOldSlots ) ? nOldSlots * 2 : 2048;
+        m_aHashSlots = (HashSlot *)calloc( m_nHashSlots, sizeof( HashSlot ) );
+
+        size_t nMask = m_nHashSlots - 1;
+        for ( size_t nX = 0; nX < nOldSlots; nX++ )
+        {
+            if ( aOldSlots[nX].m_nHashCode )
+            {
+                size_t nSlot = (size_t)aOldSlots[nX].m_nHashCode & nMask;
+
+                while ( m_aHashSlots[nSlot].m_nHashCode )
+                {
+                    nSlot = ( nSlot + 1 ) & nMask;
+                }
+                m_aHashSlots[nSlot] = aOldSlots[nX];
+            }
+        }
+
+        free( aOldSlots );
+    }
+
+#ifdef IASLIB_MULTI_THREADED__
+    IMPLEMENT_OBJECT( CBlockStoreScanner, CThread );
+
+    CBlockStoreScanner::CBlockStoreScanner( CBlockStore *pStore, size_t nFirst, size_t nLast, size_t nStride ) : CThread( "BlockStoreScanner", true, false, true )
+    {
+        m_pStore = pStore;
+        m_nFirst = nFirst;
+        m_nLast = nLast;
+        m_nStride = nStride;
+        m_bFinished = false;
+
+        Resume();
+    }
+
+    CBlockStoreScanner::~CBlockStoreScanner( void )
+    {
+    }
+
+    void *CBlockStoreScanner::Run( void )
+    {
+        for ( size_t nSegment = m_nFirst; nSegment < m_nLast; nSegment += m_nStride )
+        {
+            m_pStore->ScanSegment( nSegment );
+        }
+
+        m_bFinished = true;
+        return NULL;
+    }
+#endif // IASLIB_MULTI_THREADED__
+} // namespace IASLib
+
+#endif // IASLIB_WIN32__
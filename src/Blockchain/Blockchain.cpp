@@ -26,23 +26,181 @@ namespace IASLib
     {
         m_aChain.Append( new CBlock(0, "Genesis Block"));
         m_nDifficulty = 6;
+#ifndef IASLIB_WIN32__
+        m_pStore = NULL;
+        m_pLastBlock = NULL;
+#endif
     }
 
     CBlockchain::CBlockchain( __uint32_t difficulty ) 
     {
         m_aChain.Append( new CBlock(0, "Genesis Block"));
         m_nDifficulty = difficulty;
+#ifndef IASLIB_WIN32__
+        m_pStore = NULL;
+        m_pLastBlock = NULL;
+#endif
     }
 
-    void CBlockchain::addBlock(CBlock *bNew) 
+#ifndef IASLIB_WIN32__
+        // A chain kept in a CBlockStore in strDirectory. The chain picks up
+        // where it left off; a new store starts with the genesis block. If
+        // the store can't be opened, the chain falls back to one kept in
+        // memory, isPersistent() is false, and getStoreError() says why.
+    CBlockchain::CBlockchain( const char *strDirectory, __uint32_t difficulty )
     {
-        bNew->setPreviousHash( getLastBlock()->getHash() );
-        bNew->mineBlock(m_nDifficulty);
+        m_nDifficulty = difficulty;
+        m_pLastBlock = NULL;
+        m_pStore = new CBlockStore();
+
+        if ( m_pStore->Open( strDirectory ) )
+        {
+            if ( m_pStore->GetHeight() == 0 )
+            {
+                CBlock *pGenesis = new CBlock(0, "Genesis Block");
+
+                if ( m_pStore->Append( pGenesis ) )
+                {
+                    m_pLastBlock = pGenesis;
+                }
+                else
+                {
+                    delete pGenesis;
+                }
+            }
+            else
+            {
+                m_pLastBlock = m_pStore->GetBlock( m_pStore->GetHeight() - 1 );
+            }
+        }
+
+        if ( m_pLastBlock == NULL )
+        {
+            m_strStoreError = m_pStore->GetLastError();
+            delete m_pStore;
+            m_pStore = NULL;
+            m_aChain.Append( new CBlock(0, "Genesis Block"));
+        }
+    }
+#endif
+
+    CBlockchain::~CBlockchain()
+    {
+        m_aChain.DeleteAll();
+#ifndef IASLIB_WIN32__
+        delete m_pLastBlock;
+        delete m_pStore;
+#endif
+    }
+
+        // Mines the block onto the end of the chain, which takes it over;
+        // if it can't be mined or stored, it's deleted and false returned.
+    bool CBlockchain::addBlock(CBlock *bNew) 
+    {
+        CBlock *pLastBlock = getLastBlock();
+
+        if ( pLastBlock == NULL )
+        {
+            delete bNew;
+            return false;
+        }
+
+        bNew->setPreviousHash( pLastBlock->getHash() );
+        if ( ! bNew->mineBlock(m_nDifficulty) )
+        {
+            delete bNew;
+            return false;
+        }
+#ifndef IASLIB_WIN32__
+        if ( m_pStore )
+        {
+            if ( m_pStore->Append( bNew ) )
+            {
+                delete m_pLastBlock;
+                m_pLastBlock = bNew;
+                return true;
+            }
+
+            delete bNew;
+            return false;
+        }
+#endif
         m_aChain.Append(bNew);
+        return true;
+    }
+
+    size_t CBlockchain::getLength()
+    {
+#ifndef IASLIB_WIN32__
+        if ( m_pStore )
+        {
+            return m_pStore->GetHeight();
+        }
+#endif
+        return m_aChain.GetLength();
+    }
+
+        // Returns a copy of the block at a height, which the caller deletes
+    CBlock *CBlockchain::getBlock( size_t nHeight )
+    {
+#ifndef IASLIB_WIN32__
+        if ( m_pStore )
+        {
+            return m_pStore->GetBlock( nHeight );
+        }
+#endif
+        if ( nHeight >= m_aChain.GetLength() )
+        {
+            return NULL;
+        }
+
+        CBlock *pBlock = (CBlock *)m_aChain[ nHeight ];
+        return new CBlock( *pBlock );
+    }
+
+        // Returns a copy of the block with a hash, which the caller deletes
+    CBlock *CBlockchain::findBlock( const char *strHash )
+    {
+#ifndef IASLIB_WIN32__
+        if ( m_pStore )
+        {
+            return m_pStore->FindBlock( strHash );
+        }
+#endif
+        for ( size_t nX = 0; nX < m_aChain.GetLength(); nX++ )
+        {
+            CBlock *pBlock = (CBlock *)m_aChain[ nX ];
+
+            if ( pBlock->getHash() == strHash )
+            {
+                return new CBlock( *pBlock );
+            }
+        }
+
+        return NULL;
+    }
+
+    bool CBlockchain::isPersistent() const
+    {
+#ifndef IASLIB_WIN32__
+        return ( m_pStore != NULL );
+#else
+        return false;
+#endif
     }
 
     CBlock *CBlockchain::getLastBlock() const 
     {
+#ifndef IASLIB_WIN32__
+        if ( m_pStore )
+        {
+            return m_pLastBlock;
+        }
+#endif
+        if ( m_aChain.GetLength() == 0 )
+        {
+            return NULL;
+        }
         return (CBlock *)m_aChain[ m_aChain.GetLength() - 1];
     }
 }
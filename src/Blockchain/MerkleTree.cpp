@@ -0,0 +1,608 @@
+/**
+ *  Merkle Tree Class
+ *
+ *      A Merkle tree of SHA256 hashes, kept level by level in flat arrays
+ * rather than as a tree of nodes: level zero holds the leaf hashes, and
+ * each level above holds the hashes of the pairs below it, so the root is
+ * the one hash on the top level. As with MerkleNode, a parent is the hash
+ * of its children's hashes concatenated, and an unpaired node at the end
+ * of a level is paired with itself.
+ *      Appending a leaf or changing one only rehashes the path from that
+ * leaf to the root. A whole batch of leaves can be built in one go, with
+ * each level's hashes split across threads. An inclusion proof is the
+ * sibling hash at each level, which is all a verifier needs (along with
+ * the leaf and the root) to check that the leaf is in the tree.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "Blockchain/MerkleTree.h"
+
+#include <stdlib.h>
+#include <string.h>
+#ifndef IASLIB_WIN32__
+#include <unistd.h>
+#endif
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CMerkleProof, CObject );
+
+    CMerkleProof::CMerkleProof( void )
+    {
+        m_nLeaf = 0;
+        m_nDepth = 0;
+    }
+
+    CMerkleProof::~CMerkleProof( void )
+    {
+    }
+
+    /**
+     * Verify
+     *
+     *      Works the leaf's hash up to the root with the sibling at each
+     * level, and checks it against the root.
+     *
+     * @return
+     *      true if the leaf is in the tree with that root, at this proof's
+     *      position.
+     */
+    bool CMerkleProof::Verify( const uint8 *pLeafHash, const uint8 *pRoot ) const
+    {
+        uint8 aHash[CSHA256::DIGEST_SIZE];
+        size_t nIndex = m_nLeaf;
+
+        memcpy( aHash, pLeafHash, CSHA256::DIGEST_SIZE );
+
+        for ( size_t nLevel = 0; nLevel < m_nDepth; nLevel++ )
+        {
+            if ( nIndex & 1 )
+            {
+                CMerkleTree::HashPair( m_aaSiblings[nLevel], aHash, aHash );
+            }
+            else
+            {
+                CMerkleTree::HashPair( aHash, m_aaSiblings[nLevel], aHash );
+            }
+            nIndex >>= 1;
+        }
+
+        return ( nIndex == 0 ) && ( memcmp( aHash, pRoot, CSHA256::DIGEST_SIZE ) == 0 );
+    }
+
+    /**
+     * Serialize
+     *
+     *      Writes the proof as the leaf index (eight bytes, big endian),
+     * the depth (one byte) and the siblings, bottom up.
+     *
+     * @param pBuffer
+     *      Where the proof goes; GetSerializedSize() bytes.
+     * @return
+     *      The number of bytes written.
+     */
+    size_t CMerkleProof::Serialize( uint8 *pBuffer ) const
+    {
+        uint64 ullLeaf = (uint64)m_nLeaf;
+
+        for ( int nByte = 7; nByte >= 0; nByte-- )
+        {
+            pBuffer[nByte] = (uint8)( ullLeaf & 0xFF );
+            ullLeaf >>= 8;
+        }
+        pBuffer[8] = (uint8)m_nDepth;
+        memcpy( pBuffer + 9, m_aaSiblings, m_nDepth * CSHA256::DIGEST_SIZE );
+
+        return GetSerializedSize();
+    }
+
+    bool CMerkleProof::Deserialize( const uint8 *pBuffer, size_t nLength )
+    {
+        if ( ( nLength < 9 ) || ( pBuffer[8] > MAX_DEPTH ) || ( nLength != 9 + (size_t)pBuffer[8] * CSHA256::DIGEST_SIZE ) )
+        {
+            return false;
+        }
+
+        uint64 ullLeaf = 0;
+        for ( int nByte = 0; nByte < 8; nByte++ )
+        {
+            ullLeaf = ( ullLeaf << 8 ) | pBuffer[nByte];
+        }
+        m_nLeaf = (size_t)ullLeaf;
+        m_nDepth = pBuffer[8];
+        memcpy( m_aaSiblings, pBuffer + 9, m_nDepth * CSHA256::DIGEST_SIZE );
+
+        return true;
+    }
+
+    IMPLEMENT_OBJECT( CMerkleTree, CObject );
+
+    CMerkleTree::CMerkleTree( void )
+    {
+        for ( size_t nLevel = 0; nLevel < MAX_LEVELS; nLevel++ )
+        {
+            m_aLevels[nLevel].m_pHashes = NULL;
+            m_aLevels[nLevel].m_nCount = 0;
+            m_aLevels[nLevel].m_nCapacity = 0;
+        }
+        m_nLevels = 0;
+    }
+
+    CMerkleTree::~CMerkleTree( void )
+    {
+        for ( size_t nLevel = 0; nLevel < MAX_LEVELS; nLevel++ )
+        {
+            free( m_aLevels[nLevel].m_pHashes );
+        }
+    }
+
+    /**
+     * Clear
+     *
+     *      Empties the tree, keeping the level arrays for reuse.
+     */
+    void CMerkleTree::Clear( void )
+    {
+        for ( size_t nLevel = 0; nLevel < MAX_LEVELS; nLevel++ )
+        {
+            m_aLevels[nLevel].m_nCount = 0;
+        }
+        m_nLevels = 0;
+    }
+
+    /**
+     * Append
+     *
+     *      Adds a leaf to the end of the tree and rehashes its path.
+     *
+     * @return
+     *      The new leaf's index.
+     */
+    size_t CMerkleTree::Append( const void *pData, size_t nLength )
+    {
+        uint8 aHash[CSHA256::DIGEST_SIZE];
+
+        CSHA256::Digest( pData, nLength, aHash );
+
+        return AppendHash( aHash );
+    }
+
+    size_t CMerkleTree::AppendHash( const uint8 *pLeafHash )
+    {
+        size_t nLeaf = m_aLevels[0].m_nCount;
+
+        Reserve( 0, nLeaf + 1 );
+        memcpy( m_aLevels[0].m_pHashes + nLeaf * CSHA256::DIGEST_SIZE, pLeafHash, CSHA256::DIGEST_SIZE );
+        m_aLevels[0].m_nCount++;
+        RehashPath( nLeaf );
+
+        return nLeaf;
+    }
+
+    /**
+     * Update
+     *
+     *      Replaces a leaf and rehashes its path.
+     *
+     * @return
+     *      false if there's no such leaf.
+     */
+    bool CMerkleTree::Update( size_t nLeaf, const void *pData, size_t nLength )
+    {
+        uint8 aHash[CSHA256::DIGEST_SIZE];
+
+        CSHA256::Digest( pData, nLength, aHash );
+
+        return UpdateHash( nLeaf, aHash );
+    }
+
+    bool CMerkleTree::UpdateHash( size_t nLeaf, const uint8 *pLeafHash )
+    {
+        if ( nLeaf >= GetLeafCount() )
+        {
+            return false;
+        }
+
+        memcpy( m_aLevels[0].m_pHashes + nLeaf * CSHA256::DIGEST_SIZE, pLeafHash, CSHA256::DIGEST_SIZE );
+        RehashPath( nLeaf );
+
+        return true;
+    }
+
+    /**
+     * Build
+     *
+     *      Replaces the tree with one built from a batch of leaves. The
+     * leaves are hashed several at a time (see CSHA256::DigestMany), and
+     * large levels are split across threads.
+     *
+     * @param nThreads
+     *      The most threads to use (0 for one per processor).
+     */
+    void CMerkleTree::Build( const uint8 * const *apData, const size_t *anLengths, size_t nLeaves, size_t nThreads )
+    {
+        Clear();
+        Reserve( 0, nLeaves );
+        m_aLevels[0].m_nCount = nLeaves;
+
+        uint8 *pLeafHashes = m_aLevels[0].m_pHashes;
+        size_t nWorkers = GetThreadCount( nThreads, nLeaves );
+
+#ifdef IASLIB_MULTI_THREADED__
+        if ( nWorkers > 1 )
+        {
+            CMerkleHashThread **apThreads = new CMerkleHashThread *[ nWorkers ];
+
+            for ( size_t nX = 0; nX < nWorkers; nX++ )
+            {
+                apThreads[nX] = new CMerkleHashThread( apData, anLengths, pLeafHashes, nLeaves * nX / nWorkers, nLeaves * ( nX + 1 ) / nWorkers );
+            }
+            for ( size_t nX = 0; nX < nWorkers; nX++ )
+            {
+                apThreads[nX]->Join();
+                apThreads[nX]->Finish();
+                delete apThreads[nX];
+            }
+            delete [] apThreads;
+        }
+        else
+#endif
+        {
+            CSHA256::DigestMany( apData, anLengths, pLeafHashes, nLeaves );
+        }
+
+        BuildLevels( nThreads );
+    }
+
+    void CMerkleTree::BuildFromHashes( const uint8 *pLeafHashes, size_t nLeaves, size_t nThreads )
+    {
+        Clear();
+        Reserve( 0, nLeaves );
+        if ( nLeaves )
+        {
+            memcpy( m_aLevels[0].m_pHashes, pLeafHashes, nLeaves * CSHA256::DIGEST_SIZE );
+        }
+        m_aLevels[0].m_nCount = nLeaves;
+
+        BuildLevels( nThreads );
+    }
+
+    const uint8 *CMerkleTree::GetLeafHash( size_t nLeaf ) const
+    {
+        if ( nLeaf >= GetLeafCount() )
+        {
+            return NULL;
+        }
+
+        return m_aLevels[0].m_pHashes + nLeaf * CSHA256::DIGEST_SIZE;
+    }
+
+    /**
+     * GetRoot
+     *
+     * @return
+     *      false if the tree is empty.
+     */
+    bool CMerkleTree::GetRoot( uint8 *pRoot ) const
+    {
+        if ( m_nLevels == 0 )
+        {
+            return false;
+        }
+
+        memcpy( pRoot, m_aLevels[m_nLevels - 1].m_pHashes, CSHA256::DIGEST_SIZE );
+        return true;
+    }
+
+    /**
+     * GetProof
+     *
+     *      Collects the sibling of the leaf's path at each level.
+     *
+     * @return
+     *      false if there's no such leaf.
+     */
+    bool CMerkleTree::GetProof( size_t nLeaf, CMerkleProof &proof ) const
+    {
+        if ( nLeaf >= GetLeafCount() )
+        {
+            return false;
+        }
+
+        size_t nIndex = nLeaf;
+
+        proof.m_nLeaf = nLeaf;
+        proof.m_nDepth = m_nLevels - 1;
+        for ( size_t nLevel = 0; nLevel + 1 < m_nLevels; nLevel++ )
+        {
+            size_t nSibling = nIndex ^ 1;
+
+                // An unpaired node is its own sibling
+            if ( nSibling >= m_aLevels[nLevel].m_nCount )
+            {
+                nSibling = nIndex;
+            }
+
+            memcpy( proof.m_aaSiblings[nLevel], m_aLevels[nLevel].m_pHashes + nSibling * CSHA256::DIGEST_SIZE, CSHA256::DIGEST_SIZE );
+            nIndex >>= 1;
+        }
+
+        return true;
+    }
+
+    /**
+     * GetProofs
+     *
+     *      Fills in a proof for each of a batch of leaves.
+     *
+     * @return
+     *      The number of proofs filled in; it stops at the first leaf that
+     *      isn't in the tree.
+     */
+    size_t CMerkleTree::GetProofs( const size_t *anLeaves, size_t nCount, CMerkleProof *aProofs ) const
+    {
+        for ( size_t nX = 0; nX < nCount; nX++ )
+        {
+            if ( ! GetProof( anLeaves[nX], aProofs[nX] ) )
+            {
+                return nX;
+            }
+        }
+
+        return nCount;
+    }
+
+    void CMerkleTree::HashPair( const uint8 *pLeft, const uint8 *pRight, uint8 *pParent )
+    {
+        uint8 aPair[2 * CSHA256::DIGEST_SIZE];
+
+        memcpy( aPair, pLeft, CSHA256::DIGEST_SIZE );
+        memcpy( aPair + CSHA256::DIGEST_SIZE, pRight, CSHA256::DIGEST_SIZE );
+        CSHA256::Digest( aPair, sizeof( aPair ), pParent );
+    }
+
+    /**
+     * HashLevel
+     *
+     *      Hashes parents nFirst up to (not including) nLast from the level
+     * below. Paired children sit next to each other, so each pair is
+     * hashed straight out of the level's array, a batch at a time.
+     */
+    void CMerkleTree::HashLevel( const uint8 *pChildren, size_t nChildren, uint8 *pParents, size_t nFirst, size_t nLast )
+    {
+        enum { BATCH_SIZE = 32 };
+
+        const uint8 *apPairs[BATCH_SIZE];
+        size_t anLengths[BATCH_SIZE];
+        uint8 aLast[2 * CSHA256::DIGEST_SIZE];
+
+        for ( size_t nX = 0; nX < BATCH_SIZE; nX++ )
+        {
+            anLengths[nX] = 2 * CSHA256::DIGEST_SIZE;
+        }
+
+        for ( size_t nBatch = nFirst; nBatch < nLast; nBatch += BATCH_SIZE )
+        {
+            size_t nCount = ( nLast - nBatch < (size_t)BATCH_SIZE ) ? nLast - nBatch : (size_t)BATCH_SIZE;
+
+            for ( size_t nX = 0; nX < nCount; nX++ )
+            {
+                size_t nLeft = ( nBatch + nX ) << 1;
+                const uint8 *pLeft = pChildren + nLeft * CSHA256::DIGEST_SIZE;
+
+                if ( nLeft + 1 < nChildren )
+                {
+                    apPairs[nX] = pLeft;
+                }
+                else
+                {
+                    memcpy( aLast, pLeft, CSHA256::DIGEST_SIZE );
+                    memcpy( aLast + CSHA256::DIGEST_SIZE, pLeft, CSHA256::DIGEST_SIZE );
+                    apPairs[nX] = aLast;
+                }
+            }
+
+            CSHA256::DigestMany( apPairs, anLengths, pParents + nBatch * CSHA256::DIGEST_SIZE, nCount );
+        }
+    }
+
+    void CMerkleTree::Reserve( size_t nLevel, size_t nCount )
+    {
+        Level &level = m_aLevels[nLevel];
+
+        if ( nCount > level.m_nCapacity )
+        {
+            size_t nCapacity = ( level.m_nCapacity < 16 ) ? 16 : level.m_nCapacity * 2;
+
+            if ( nCapacity < nCount )
+            {
+                nCapacity = nCount;
+            }
+
+            level.m_pHashes = (uint8 *)realloc( level.m_pHashes, nCapacity * CSHA256::DIGEST_SIZE );
+            level.m_nCapacity = nCapacity;
+        }
+    }
+
+    /**
+     * RehashPath
+     *
+     *      Rehashes the parents of a leaf that was added or changed, up to
+     * the root. Adding a leaf can add a node to the end of each level, and
+     * a new level at the top.
+     */
+    void CMerkleTree::RehashPath( size_t nLeaf )
+    {
+        size_t nLevel = 0;
+        size_t nIndex = nLeaf;
+
+        while ( m_aLevels[nLevel].m_nCount > 1 )
+        {
+            size_t nChildren = m_aLevels[nLevel].m_nCount;
+            size_t nParents = ( nChildren + 1 ) >> 1;
+            size_t nLeft = nIndex & ~(size_t)1;
+            const uint8 *pLeft = m_aLevels[nLevel].m_pHashes + nLeft * CSHA256::DIGEST_SIZE;
+            const uint8 *pRight = ( nLeft + 1 < nChildren ) ? pLeft + CSHA256::DIGEST_SIZE : pLeft;
+
+            Reserve( nLevel + 1, nParents );
+            m_aLevels[nLevel + 1].m_nCount = nParents;
+
+            nIndex >>= 1;
+            HashPair( pLeft, pRight, m_aLevels[nLevel + 1].m_pHashes + nIndex * CSHA256::DIGEST_SIZE );
+            nLevel++;
+        }
+
+        m_nLevels = nLevel + 1;
+    }
+
+    void CMerkleTree::BuildLevels( size_t nThreads )
+    {
+        size_t nLevel = 0;
+
+        if ( m_aLevels[0].m_nCount == 0 )
+        {
+            m_nLevels = 0;
+            return;
+        }
+
+        while ( m_aLevels[nLevel].m_nCount > 1 )
+        {
+            size_t nChildren = m_aLevels[nLevel].m_nCount;
+            size_t nParents = ( nChildren + 1 ) >> 1;
+
+            Reserve( nLevel + 1, nParents );
+            m_aLevels[nLevel + 1].m_nCount = nParents;
+
+            const uint8 *pChildren = m_aLevels[nLevel].m_pHashes;
+            uint8 *pParents = m_aLevels[nLevel + 1].m_pHashes;
+            size_t nWorkers = GetThreadCount( nThreads, nParents );
+
+#ifdef IASLIB_MULTI_THREADED__
+            if ( nWorkers > 1 )
+            {
+                CMerkleHashThread **apThreads = new CMerkleHashThread *[ nWorkers ];
+
+                for ( size_t nX = 0; nX < nWorkers; nX++ )
+                {
+                    apThreads[nX] = new CMerkleHashThread( pChildren, nChildren, pParents, nParents * nX / nWorkers, nParents * ( nX + 1 ) / nWorkers );
+                }
+                for ( size_t nX = 0; nX < nWorkers; nX++ )
+                {
+                    apThreads[nX]->Join();
+                    apThreads[nX]->Finish();
+                    delete apThreads[nX];
+                }
+                delete [] apThreads;
+            }
+            else
+#endif
+            {
+                HashLevel( pChildren, nChildren, pParents, 0, nParents );
+            }
+
+            nLevel++;
+        }
+
+        m_nLevels = nLevel + 1;
+    }
+
+    /**
+     * GetThreadCount
+     *
+     *      How many threads to split nItems hashes over: none extra for a
+     * small level, otherwise up to nThreads (or one per processor).
+     */
+    size_t CMerkleTree::GetThreadCount( size_t nThreads, size_t nItems )
+    {
+#ifdef IASLIB_MULTI_THREADED__
+        if ( ( nItems < PARALLEL_THRESHOLD ) || ( ! CThread::IsAvailable() ) )
+        {
+            return 1;
+        }
+
+        if ( nThreads == 0 )
+        {
+#ifdef IASLIB_WIN32__
+            SYSTEM_INFO sysInfo;
+            GetSystemInfo( &sysInfo );
+            nThreads = (size_t)sysInfo.dwNumberOfProcessors;
+#else
+            long nProcessors = sysconf( _SC_NPROCESSORS_ONLN );
+            nThreads = ( nProcessors > 0 ) ? (size_t)nProcessors : 1;
+#endif
+        }
+
+            // Keep each slice big enough to be worth a thread
+        size_t nMost = nItems / ( PARALLEL_THRESHOLD / 4 );
+        return ( nThreads < nMost ) ? nThreads : nMost;
+#else
+        return 1;
+#endif
+    }
+
+#ifdef IASLIB_MULTI_THREADED__
+    IMPLEMENT_OBJECT( CMerkleHashThread, CThread );
+
+    CMerkleHashThread::CMerkleHashThread( const uint8 * const *apData, const size_t *anLengths, uint8 *pLeafHashes, size_t nFirst, size_t nLast ) : CThread( "MerkleHash", true, false, true )
+    {
+        m_apData = apData;
+        m_anLengths = anLengths;
+        m_pChildren = NULL;
+        m_nChildren = 0;
+        m_pHashes = pLeafHashes;
+        m_nFirst = nFirst;
+        m_nLast = nLast;
+        m_bFinished = false;
+
+        Resume();
+    }
+
+    CMerkleHashThread::CMerkleHashThread( const uint8 *pChildren, size_t nChildren, uint8 *pParents, size_t nFirst, size_t nLast ) : CThread( "MerkleHash", true, false, true )
+    {
+        m_apData = NULL;
+        m_anLengths = NULL;
+        m_pChildren = pChildren;
+        m_nChildren = nChildren;
+        m_pHashes = pParents;
+        m_nFirst = nFirst;
+        m_nLast = nLast;
+        m_bFinished = false;
+
+        Resume();
+    }
+
+    CMerkleHashThread::~CMerkleHashThread( void )
+    {
+    }
+
+    void *CMerkleHashThread::Run( void )
+    {
+        if ( m_apData )
+        {
+            CSHA256::DigestMany( m_apData + m_nFirst, m_anLengths + m_nFirst, m_pHashes + m_nFirst * CSHA256::DIGEST_SIZE, m_nLast - m_nFirst );
+        }
+        else
+        {
+            CMerkleTree::HashLevel( m_pChildren, m_nChildren, m_pHashes, m_nFirst, m_nLast );
+        }
+
+        m_bFinished = true;
+        return NULL;
+    }
+
+        // Called after Join(): if the thread never got to run (it couldn't
+        // be started), its slice is hashed here instead.
+    void CMerkleHashThread::Finish( void )
+    {
+        if ( ! m_bFinished )
+        {
+            CMerkleHashThread::Run();
+        }
+    }
+#endif // IASLIB_MULTI_THREADED__
+} // namespace IASLib
@@ -15,11 +15,27 @@
  */
 
 #include "Cache.h"
+#include "../Stats/Metrics.h"
 
 namespace IASLib
 {
     IMPLEMENT_OBJECT( CCache, CCollection );
 
+#ifdef IASLIB_STATS__
+        // These are for all of the process' caches together.
+    static CCounter *CacheHits( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_cache_hits_total", "Cache lookups that found a live item." );
+        return s_pCounter;
+    }
+
+    static CCounter *CacheMisses( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_cache_misses_total", "Cache lookups that found nothing, or an expired item." );
+        return s_pCounter;
+    }
+#endif
+
 	CCache::CCache( size_t nMaxEntries, bool bUseExpiration )
 		: m_hashEntries( CHash::LARGE )
 	{
@@ -115,6 +131,16 @@ namespace IASLib
 
 #ifdef IASLIB_MULTI_THREADED__
         cacheMutex.Unlock();
+#endif
+#ifdef IASLIB_STATS__
+        if ( pRetVal )
+        {
+            CacheHits()->Add();
+        }
+        else
+        {
+            CacheMisses()->Add();
+        }
 #endif
         return pRetVal;
     }
@@ -746,12 +746,16 @@ namespace IASLib
 
         CObject *pRetVal = m_aHashTable[nKey]->Remove( strKey );
 
+        if ( pRetVal )
+        {
+            m_nElements--;
+        }
+
             // If the removal results in an empty bucket, delete the bucket.
         if ( pRetVal && m_aHashTable[ nKey ]->GetLength() == 0  )
         {
             delete m_aHashTable[ nKey ];
             m_aHashTable[ nKey ] = NULL;
-            m_nElements--;
         }
 #ifdef IASLIB_MULTI_THREADED__
         m_mutexProtect.Unlock();
@@ -785,12 +789,16 @@ namespace IASLib
 
         CObject *pRetVal = m_aHashTable[nKey]->Remove( nSaveKey );
 
+        if ( pRetVal )
+        {
+            m_nElements--;
+        }
+
             // If the removal results in an empty bucket, delete the bucket.
         if ( pRetVal && m_aHashTable[ nKey ]->GetLength() == 0  )
         {
             delete m_aHashTable[ nKey ];
             m_aHashTable[ nKey ] = NULL;
-            m_nElements--;
         }
 #ifdef IASLIB_MULTI_THREADED__
         m_mutexProtect.Unlock();
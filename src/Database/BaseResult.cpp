@@ -18,6 +18,9 @@
  */
 
 #include "BaseResult.h"
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
 
 #ifdef IASLIB_DATABASE__
 
@@ -33,11 +36,14 @@ namespace IASLib
         m_aastrData = NULL;
         m_nCurrentRow = 0;
         m_bValid = false;
+        m_aLookups = NULL;
+        m_nLookups = 0;
+        m_nNextLookup = 0;
     }
 
     CBaseResult::~CBaseResult( void )
     {
-        // Nothing to do here.
+        ResetColumnIndex();
     }
 
     const char *CBaseResult::ColumnName( size_t nColumn )
@@ -71,24 +77,14 @@ namespace IASLib
 
     CString CBaseResult::GetColumn( const char *pszColumn )
     {
-        CString strCompare;
-        CString strColumn = pszColumn;
+        size_t nColumn = FindColumn( pszColumn );
 
-        strColumn.ToUpperCase();
-
-        for ( size_t nCount = 0; nCount < m_nColumns; nCount ++ )
+        if ( nColumn == NOT_FOUND )
         {
-            strCompare = m_astrHeaders[ nCount ];
-            strCompare.ToUpperCase();
-
-            if ( strCompare == strColumn )
-            {
-                CStringArray *pArray = m_aastrData[m_nCurrentRow];
-                return pArray->Get( nCount );
-            }
+            return CString( "" );
         }
 
-        return CString( "" );
+        return GetColumn( nColumn );
     }
 
     CString CBaseResult::GetColumn( size_t nColumn )
@@ -110,21 +106,172 @@ namespace IASLib
 
     bool CBaseResult::IsColumn( const char *pszColumn )
     {
-        CString strCompare;
-        CString strColumn = pszColumn;
+        return ( FindColumn( pszColumn ) != NOT_FOUND );
+    }
 
-        strColumn.ToUpperCase();
+    /**
+     * FindColumn
+     *
+     *      Returns the index of a column by name (ignoring case), or
+     * NOT_FOUND. Each spelling of a name is only searched for among the
+     * headers once per result, and remembered. Since callers tend to ask
+     * for the same columns in the same order on every row, the spelling
+     * after the last one found is tried first, so looking a column up by
+     * name is usually a single string compare.
+     */
+    size_t CBaseResult::FindColumn( const char *pszColumn )
+    {
+        if ( pszColumn == NULL )
+        {
+            return NOT_FOUND;
+        }
+
+        for ( size_t nCount = 0; nCount < m_nLookups; nCount++ )
+        {
+            size_t nLookup = ( m_nNextLookup + nCount ) % m_nLookups;
+
+            if ( strcmp( (const char *)m_aLookups[ nLookup ].m_strName, pszColumn ) == 0 )
+            {
+                m_nNextLookup = nLookup + 1;
+                return m_aLookups[ nLookup ].m_nIndex;
+            }
+        }
 
         for ( size_t nCount = 0; nCount < m_nColumns; nCount ++ )
         {
-            strCompare = m_astrHeaders[ nCount ];
-            strCompare.ToUpperCase();
+            if ( strcasecmp( (const char *)m_astrHeaders[ nCount ], pszColumn ) == 0 )
+            {
+                    // Grows one at a time, but only once per spelling.
+                ColumnLookup *aLookups = new ColumnLookup[ m_nLookups + 1 ];
+                for ( size_t nLookup = 0; nLookup < m_nLookups; nLookup++ )
+                {
+                    aLookups[ nLookup ] = m_aLookups[ nLookup ];
+                }
+                aLookups[ m_nLookups ].m_strName = pszColumn;
+                aLookups[ m_nLookups ].m_nIndex = nCount;
+
+                delete [] m_aLookups;
+                m_aLookups = aLookups;
+                m_nLookups++;
+                m_nNextLookup = m_nLookups;
 
-            if ( strCompare == strColumn )
-                return true;
+                return nCount;
+            }
         }
 
-        return false;
+        return NOT_FOUND;
+    }
+
+    /**
+     * ResetColumnIndex
+     *
+     *      Forgets the resolved column names, for results whose columns
+     * change.
+     */
+    void CBaseResult::ResetColumnIndex( void )
+    {
+        delete [] m_aLookups;
+        m_aLookups = NULL;
+        m_nLookups = 0;
+        m_nNextLookup = 0;
+    }
+
+    /*
+     * The typed accessors below work on results that hold every value as
+     * text, and convert it. Results that keep native values override them.
+     */
+
+    CBaseResult::ColumnType CBaseResult::GetColumnType( size_t nColumn )
+    {
+        return ( nColumn < m_nColumns ) ? COLUMN_TEXT : COLUMN_NULL;
+    }
+
+    bool CBaseResult::IsNull( size_t nColumn )
+    {
+        return ( GetColumnType( nColumn ) == COLUMN_NULL );
+    }
+
+    long long CBaseResult::GetInt64( size_t nColumn )
+    {
+        if ( nColumn >= m_nColumns )
+        {
+            return 0;
+        }
+
+        CString strValue = GetColumn( nColumn );
+        return strtoll( (const char *)strValue, NULL, 10 );
+    }
+
+    double CBaseResult::GetDouble( size_t nColumn )
+    {
+        if ( nColumn >= m_nColumns )
+        {
+            return 0.0;
+        }
+
+        CString strValue = GetColumn( nColumn );
+        return strtod( (const char *)strValue, NULL );
+    }
+
+    CDate CBaseResult::GetDate( size_t nColumn )
+    {
+        if ( nColumn >= m_nColumns )
+        {
+            return CDate( 0L, -1L );
+        }
+
+        CString strValue = GetColumn( nColumn );
+        return ParseDate( (const char *)strValue );
+    }
+
+    /**
+     * GetBlob
+     *
+     *      Returns the raw bytes of a column of the current row, which
+     * belong to the result, and are good until it moves to another row.
+     *
+     * @param nLength
+     *      [out] The number of bytes.
+     */
+    const void *CBaseResult::GetBlob( size_t nColumn, size_t &nLength )
+    {
+        nLength = 0;
+
+        if ( ( ! m_bValid ) || ( nColumn >= m_nColumns ) || ( m_aastrData == NULL ) || ( m_nCurrentRow >= m_nRows ) )
+        {
+            return NULL;
+        }
+
+        CString &strValue = (*m_aastrData[ m_nCurrentRow ])[ nColumn ];
+        nLength = strValue.GetLength();
+
+        return (const char *)strValue;
+    }
+
+    /**
+     * ParseDate
+     *
+     *      Converts a date as the databases write it. ISO 8601 dates
+     * ("YYYY-MM-DD HH:MM:SS[.SSS]", with a space or a T) are picked apart
+     * directly, anything else goes through CDate's own parser.
+     */
+    CDate CBaseResult::ParseDate( const char *strValue )
+    {
+        int nYear = 0, nMonth = 0, nDay = 0, nHour = 0, nMinute = 0, nSecond = 0, nMillisecond = 0;
+        char chSeparator = ' ';
+
+        if ( ( strValue == NULL ) || ( *strValue == '\0' ) )
+        {
+            return CDate( 0L, -1L );
+        }
+
+        int nFields = sscanf( strValue, "%4d-%2d-%2d%c%2d:%2d:%2d.%3d", &nYear, &nMonth, &nDay, &chSeparator, &nHour, &nMinute, &nSecond, &nMillisecond );
+        if ( ( nFields == 3 ) || ( ( nFields >= 6 ) && ( ( chSeparator == ' ' ) || ( chSeparator == 'T' ) ) ) )
+        {
+            return CDate( nDay, nMonth, nYear, nHour, nMinute, nSecond, nMillisecond );
+        }
+
+        return CDate::Parse( strValue );
     }
 
     bool CBaseResult::SetRow( size_t nRow )
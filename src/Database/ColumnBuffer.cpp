@@ -0,0 +1,238 @@
+/*
+ *  Column Buffer Class
+ *
+ *  Holds one column of a result set, every row's value in its native
+ * type. Numbers are kept as numbers, in one array of fixed size slots,
+ * and text and blobs are packed end to end in a single growing block of
+ * characters, so a result of any size costs a handful of allocations per
+ * column, instead of an object per value.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_DATABASE__
+
+#include "ColumnBuffer.h"
+#include <string.h>
+
+#define COLUMN_GROW_BY      128
+#define COLUMN_DATA_GROW_BY 4096
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CColumnBuffer, CObject );
+
+    CColumnBuffer::CColumnBuffer( void )
+    {
+        m_anTypes = NULL;
+        m_aSlots = NULL;
+        m_nRows = 0;
+        m_nCapacity = 0;
+        m_pchData = NULL;
+        m_nDataLength = 0;
+        m_nDataCapacity = 0;
+    }
+
+    CColumnBuffer::~CColumnBuffer( void )
+    {
+        Clear();
+    }
+
+    void CColumnBuffer::Clear( void )
+    {
+        delete [] m_anTypes;
+        delete [] m_aSlots;
+        delete [] m_pchData;
+
+        m_anTypes = NULL;
+        m_aSlots = NULL;
+        m_nRows = 0;
+        m_nCapacity = 0;
+        m_pchData = NULL;
+        m_nDataLength = 0;
+        m_nDataCapacity = 0;
+    }
+
+    void CColumnBuffer::AppendNull( void )
+    {
+        Slot &oSlot = NewSlot( CBaseResult::COLUMN_NULL );
+        oSlot.m_nInteger = 0;
+    }
+
+    void CColumnBuffer::AppendInt64( long long nValue )
+    {
+        Slot &oSlot = NewSlot( CBaseResult::COLUMN_INTEGER );
+        oSlot.m_nInteger = nValue;
+    }
+
+    void CColumnBuffer::AppendDouble( double dValue )
+    {
+        Slot &oSlot = NewSlot( CBaseResult::COLUMN_FLOAT );
+        oSlot.m_dFloat = dValue;
+    }
+
+    void CColumnBuffer::AppendText( const char *pchValue, size_t nLength )
+    {
+        size_t nOffset = AppendData( pchValue, nLength );
+        Slot &oSlot = NewSlot( CBaseResult::COLUMN_TEXT );
+        oSlot.m_nOffset = nOffset;
+        oSlot.m_nLength = nLength;
+    }
+
+    void CColumnBuffer::AppendBlob( const void *pData, size_t nLength )
+    {
+        size_t nOffset = AppendData( pData, nLength );
+        Slot &oSlot = NewSlot( CBaseResult::COLUMN_BLOB );
+        oSlot.m_nOffset = nOffset;
+        oSlot.m_nLength = nLength;
+    }
+
+    CBaseResult::ColumnType CColumnBuffer::GetType( size_t nRow )
+    {
+        if ( nRow >= m_nRows )
+        {
+            return CBaseResult::COLUMN_NULL;
+        }
+
+        return (CBaseResult::ColumnType)m_anTypes[ nRow ];
+    }
+
+    /**
+     * GetInt64
+     *
+     *      Returns a value as an integer. Floats are truncated, and text
+     * is converted, the same as SQL does.
+     */
+    long long CColumnBuffer::GetInt64( size_t nRow )
+    {
+        switch ( GetType( nRow ) )
+        {
+            case CBaseResult::COLUMN_INTEGER:
+                return m_aSlots[ nRow ].m_nInteger;
+
+            case CBaseResult::COLUMN_FLOAT:
+                return (long long)m_aSlots[ nRow ].m_dFloat;
+
+            case CBaseResult::COLUMN_TEXT:
+                return strtoll( m_pchData + m_aSlots[ nRow ].m_nOffset, NULL, 10 );
+
+            default:
+                return 0;
+        }
+    }
+
+    double CColumnBuffer::GetDouble( size_t nRow )
+    {
+        switch ( GetType( nRow ) )
+        {
+            case CBaseResult::COLUMN_INTEGER:
+                return (double)m_aSlots[ nRow ].m_nInteger;
+
+            case CBaseResult::COLUMN_FLOAT:
+                return m_aSlots[ nRow ].m_dFloat;
+
+            case CBaseResult::COLUMN_TEXT:
+                return strtod( m_pchData + m_aSlots[ nRow ].m_nOffset, NULL );
+
+            default:
+                return 0.0;
+        }
+    }
+
+    /**
+     * GetText
+     *
+     *      Returns the bytes of a text or blob value, which are always
+     * followed by a NUL, so text can be used as a C string. The pointer
+     * belongs to the buffer. Numbers and NULLs return NULL.
+     *
+     * @param nLength
+     *      [out] The number of bytes, not counting the NUL.
+     */
+    const char *CColumnBuffer::GetText( size_t nRow, size_t &nLength )
+    {
+        CBaseResult::ColumnType eType = GetType( nRow );
+
+        if ( ( eType != CBaseResult::COLUMN_TEXT ) && ( eType != CBaseResult::COLUMN_BLOB ) )
+        {
+            nLength = 0;
+            return NULL;
+        }
+
+        nLength = m_aSlots[ nRow ].m_nLength;
+        return m_pchData + m_aSlots[ nRow ].m_nOffset;
+    }
+
+    CColumnBuffer::Slot &CColumnBuffer::NewSlot( CBaseResult::ColumnType eType )
+    {
+        if ( m_nRows == m_nCapacity )
+        {
+            size_t          nCapacity = ( m_nCapacity ) ? m_nCapacity * 2 : COLUMN_GROW_BY;
+            unsigned char  *anTypes = new unsigned char[ nCapacity ];
+            Slot           *aSlots = new Slot[ nCapacity ];
+
+            if ( m_nRows )
+            {
+                memcpy( anTypes, m_anTypes, m_nRows );
+                memcpy( aSlots, m_aSlots, m_nRows * sizeof( Slot ) );
+            }
+
+            delete [] m_anTypes;
+            delete [] m_aSlots;
+            m_anTypes = anTypes;
+            m_aSlots = aSlots;
+            m_nCapacity = nCapacity;
+        }
+
+        m_anTypes[ m_nRows ] = (unsigned char)eType;
+        m_aSlots[ m_nRows ].m_nLength = 0;
+
+        return m_aSlots[ m_nRows++ ];
+    }
+
+    /**
+     * AppendData
+     *
+     *      Copies bytes, and a terminating NUL, to the end of the character
+     * block, and returns where they start. Offsets, not pointers, are kept,
+     * since the block moves as it grows.
+     */
+    size_t CColumnBuffer::AppendData( const void *pData, size_t nLength )
+    {
+        if ( m_nDataLength + nLength + 1 > m_nDataCapacity )
+        {
+            size_t nCapacity = ( m_nDataCapacity ) ? m_nDataCapacity * 2 : COLUMN_DATA_GROW_BY;
+            while ( nCapacity < m_nDataLength + nLength + 1 )
+            {
+                nCapacity *= 2;
+            }
+
+            char *pchData = new char[ nCapacity ];
+            if ( m_nDataLength )
+            {
+                memcpy( pchData, m_pchData, m_nDataLength );
+            }
+
+            delete [] m_pchData;
+            m_pchData = pchData;
+            m_nDataCapacity = nCapacity;
+        }
+
+        size_t nOffset = m_nDataLength;
+
+        if ( nLength )
+        {
+            memcpy( m_pchData + nOffset, pData, nLength );
+        }
+        m_pchData[ nOffset + nLength ] = '\0';
+        m_nDataLength += nLength + 1;
+
+        return nOffset;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_DATABASE__
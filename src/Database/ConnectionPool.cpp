@@ -0,0 +1,518 @@
+/*
+ *  Connection Pool Class
+ *
+ *  Keeps a bounded set of open connections to one database that threads
+ * borrow with Acquire() and hand back with Return(), instead of opening
+ * and releasing a connection for every piece of work. The pool opens
+ * connections as they're needed, up to its maximum size, after which
+ * Acquire() waits (forever, for a while, or not at all) for another
+ * thread to return one.
+ *  Connections are checked with IsDead() when they're borrowed, and dead
+ * ones are closed and replaced. Connections that sit idle for longer than
+ * the idle timeout are closed, down to the pool's minimum size. The most
+ * recently returned connection is always lent out first, so the cold ones
+ * are the ones that age out.
+ *  A borrowed connection belongs to the pool: hand it back with Return()
+ * (passing bDiscard if it's no longer usable), never Release() it.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "ConnectionPool.h"
+#include "Database.h"
+#include "../Stats/Metrics.h"
+#include "../Threading/Thread.h"
+#include <string.h>
+#include <time.h>
+
+#ifdef IASLIB_DATABASE__
+#ifdef IASLIB_MULTI_THREADED__
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CConnectionPool, CObject );
+
+#ifdef IASLIB_STATS__
+        // For all of the process' pools together; each pool's own numbers
+        // are in its GetStats().
+    static CCounter *PoolAcquires( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_db_pool_acquires_total", "Connections lent out by database pools." );
+        return s_pCounter;
+    }
+
+    static CCounter *PoolTimeouts( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_db_pool_timeouts_total", "Acquires that found no connection free in time." );
+        return s_pCounter;
+    }
+
+    static CSummary *PoolWaits( void )
+    {
+        static CSummary *s_pSummary = CMetricsRegistry::GetInstance()->GetSummary( "iaslib_db_pool_acquire_wait_seconds", "Time spent waiting for a pooled database connection." );
+        return s_pSummary;
+    }
+#endif
+
+    /**
+     * Constructor
+     *
+     *      Sets up the pool, without opening any connections. Call Fill()
+     * to open the minimum number up front.
+     *
+     * @param pDatabase
+     *      The database the connections are opened on.
+     * @param nMinSize
+     *      The number of connections kept open, even when idle.
+     * @param nMaxSize
+     *      The most connections that can be open at once.
+     * @param ulIdleTimeout
+     *      How long, in milliseconds, a connection can sit idle before it's
+     *      closed (0 to never close them).
+     */
+    CConnectionPool::CConnectionPool( CDatabase *pDatabase, const char *strDBName, const char *strUserName, const char *strPassword, const char *strApplication, const char *strName, size_t nMinSize, size_t nMaxSize, unsigned long ulIdleTimeout )
+        : m_semSlots( (unsigned int)( ( nMaxSize > 0 ) ? nMaxSize : 1 ) )
+    {
+        m_pDatabase = pDatabase;
+        m_strDBName = strDBName;
+        m_strUserName = strUserName;
+        m_strPassword = strPassword;
+        m_strApplication = strApplication;
+        m_strName = strName;
+
+        m_nMaxSize = ( nMaxSize > 0 ) ? nMaxSize : 1;
+        m_nMinSize = ( nMinSize > m_nMaxSize ) ? m_nMaxSize : nMinSize;
+        m_ulIdleTimeout = ulIdleTimeout;
+
+        m_aIdle = new IdleConnection[ m_nMaxSize ];
+        m_nIdle = 0;
+        m_nOpen = 0;
+
+        memset( &m_stats, 0, sizeof( m_stats ) );
+    }
+
+    /**
+     * Destructor
+     *
+     *      Closes the idle connections. Connections still borrowed are left
+     * to the database, which closes them when it disconnects.
+     */
+    CConnectionPool::~CConnectionPool( void )
+    {
+        m_mutexPool.Lock();
+        size_t nIdle = m_nIdle;
+        m_nIdle = 0;
+        m_nOpen -= nIdle;
+        m_mutexPool.Unlock();
+
+        for ( size_t nCount = 0; nCount < nIdle; nCount++ )
+        {
+            Close( m_aIdle[ nCount ].m_pConnection );
+        }
+
+        delete [] m_aIdle;
+    }
+
+    /**
+     * Fill
+     *
+     *      Opens connections until the pool has its minimum number.
+     *
+     * @return
+     *      false if a connection couldn't be opened.
+     */
+    bool CConnectionPool::Fill( void )
+    {
+        while ( true )
+        {
+            m_mutexPool.Lock();
+            if ( m_nOpen >= m_nMinSize )
+            {
+                m_mutexPool.Unlock();
+                return true;
+            }
+            m_nOpen++;
+            m_mutexPool.Unlock();
+
+            CConnection *pConnection = Open();
+
+            m_mutexPool.Lock();
+            if ( pConnection == NULL )
+            {
+                m_nOpen--;
+                m_mutexPool.Unlock();
+                return false;
+            }
+            m_aIdle[ m_nIdle ].m_pConnection = pConnection;
+            m_aIdle[ m_nIdle ].m_ullReturned = GetMicroseconds();
+            m_nIdle++;
+            m_mutexPool.Unlock();
+        }
+    }
+
+    /**
+     * Acquire
+     *
+     *      Borrows a connection. An idle connection is lent out if there is
+     * one, otherwise a new one is opened, unless the pool is at its
+     * maximum size, in which case this waits for one to be returned.
+     *
+     * @param lTimeout
+     *      How long to wait, in milliseconds: -1 waits as long as it takes,
+     *      0 doesn't wait at all.
+     * @return
+     *      The connection, or NULL if none was free in time, or a new one
+     *      couldn't be opened.
+     */
+    CConnection *CConnectionPool::Acquire( long lTimeout )
+    {
+        unsigned long long ullStart = GetMicroseconds();
+        bool bGotSlot;
+        bool bWaited = false;
+
+        if ( ! CThread::IsAvailable() )
+        {
+                // No semaphore to wait on, and nobody else to return one,
+                // so there's a slot only if the pool isn't already full.
+            bGotSlot = ( GetInUseCount() < m_nMaxSize );
+        }
+        else if ( m_semSlots.TryWait() )
+        {
+            bGotSlot = true;
+        }
+        else if ( lTimeout < 0 )
+        {
+            m_semSlots.Wait();
+            bGotSlot = true;
+            bWaited = true;
+        }
+        else if ( lTimeout == 0 )
+        {
+            bGotSlot = false;
+        }
+        else
+        {
+            bGotSlot = m_semSlots.TimedWait( (unsigned long)lTimeout );
+            bWaited = true;
+        }
+
+        unsigned long long ullWaited = GetMicroseconds() - ullStart;
+
+#ifdef IASLIB_STATS__
+        if ( bGotSlot )
+        {
+            PoolAcquires()->Add();
+        }
+        else
+        {
+            PoolTimeouts()->Add();
+        }
+        PoolWaits()->Record( ullWaited );
+#endif
+
+        m_mutexPool.Lock();
+        if ( ! bGotSlot )
+        {
+            m_stats.m_ullTimeouts++;
+            m_mutexPool.Unlock();
+            return NULL;
+        }
+
+        m_stats.m_ullAcquires++;
+        if ( bWaited )
+        {
+            m_stats.m_ullWaits++;
+            m_stats.m_ullTotalWaitMicros += ullWaited;
+            if ( ullWaited > m_stats.m_ullMaxWaitMicros )
+            {
+                m_stats.m_ullMaxWaitMicros = ullWaited;
+            }
+        }
+
+        while ( m_nIdle > 0 )
+        {
+            m_nIdle--;
+            CConnection *pConnection = m_aIdle[ m_nIdle ].m_pConnection;
+            m_mutexPool.Unlock();
+
+            if ( ! pConnection->IsDead() )
+            {
+                return pConnection;
+            }
+
+            Close( pConnection );
+
+            m_mutexPool.Lock();
+            m_nOpen--;
+            m_stats.m_ullDiscarded++;
+        }
+
+            // Nothing idle, and holding a slot means there's room for one more.
+        m_nOpen++;
+        m_mutexPool.Unlock();
+
+        CConnection *pConnection = Open();
+        if ( pConnection == NULL )
+        {
+            m_mutexPool.Lock();
+            m_nOpen--;
+            m_mutexPool.Unlock();
+            m_semSlots.Post();
+        }
+
+        return pConnection;
+    }
+
+    /**
+     * Return
+     *
+     *      Hands a borrowed connection back to the pool, and closes any
+     * connections that have been idle too long.
+     *
+     * @param bDiscard
+     *      Close the connection instead of keeping it, for connections
+     *      left in a bad state.
+     */
+    bool CConnectionPool::Return( CConnection *pConnection, bool bDiscard )
+    {
+        if ( pConnection == NULL )
+        {
+            return false;
+        }
+
+        CConnection      **apEvicted = new CConnection *[ m_nMaxSize ];
+        size_t             nEvicted = 0;
+        unsigned long long ullNow = GetMicroseconds();
+
+        if ( ( ! bDiscard ) && ( pConnection->IsDead() ) )
+        {
+            bDiscard = true;
+        }
+
+        m_mutexPool.Lock();
+        if ( ! IsBorrowedLocked( pConnection ) )
+        {
+                // Returned twice, or nothing is borrowed at all
+            m_mutexPool.Unlock();
+            delete [] apEvicted;
+            return false;
+        }
+
+        if ( bDiscard )
+        {
+            m_nOpen--;
+            m_stats.m_ullDiscarded++;
+        }
+        else
+        {
+            m_aIdle[ m_nIdle ].m_pConnection = pConnection;
+            m_aIdle[ m_nIdle ].m_ullReturned = ullNow;
+            m_nIdle++;
+        }
+
+        nEvicted = EvictLocked( ullNow, apEvicted );
+        m_mutexPool.Unlock();
+
+        m_semSlots.Post();
+
+        if ( bDiscard )
+        {
+            Close( pConnection );
+        }
+
+        for ( size_t nCount = 0; nCount < nEvicted; nCount++ )
+        {
+            Close( apEvicted[ nCount ] );
+        }
+        delete [] apEvicted;
+
+        return true;
+    }
+
+    /**
+     * EvictIdle
+     *
+     *      Closes the connections that have been idle longer than the idle
+     * timeout, keeping at least the minimum number open. Returning a
+     * connection does this too, so this is only needed for pools that go
+     * quiet.
+     *
+     * @return
+     *      The number of connections closed.
+     */
+    size_t CConnectionPool::EvictIdle( void )
+    {
+        CConnection **apEvicted = new CConnection *[ m_nMaxSize ];
+
+        m_mutexPool.Lock();
+        size_t nEvicted = EvictLocked( GetMicroseconds(), apEvicted );
+        m_mutexPool.Unlock();
+
+        for ( size_t nCount = 0; nCount < nEvicted; nCount++ )
+        {
+            Close( apEvicted[ nCount ] );
+        }
+        delete [] apEvicted;
+
+        return nEvicted;
+    }
+
+    size_t CConnectionPool::GetOpenCount( void )
+    {
+        m_mutexPool.Lock();
+        size_t nOpen = m_nOpen;
+        m_mutexPool.Unlock();
+        return nOpen;
+    }
+
+    size_t CConnectionPool::GetIdleCount( void )
+    {
+        m_mutexPool.Lock();
+        size_t nIdle = m_nIdle;
+        m_mutexPool.Unlock();
+        return nIdle;
+    }
+
+    size_t CConnectionPool::GetInUseCount( void )
+    {
+        m_mutexPool.Lock();
+        size_t nInUse = m_nOpen - m_nIdle;
+        m_mutexPool.Unlock();
+        return nInUse;
+    }
+
+    CConnectionPool::PoolStats CConnectionPool::GetStats( void )
+    {
+        m_mutexPool.Lock();
+        PoolStats stats = m_stats;
+        m_mutexPool.Unlock();
+        return stats;
+    }
+
+    void CConnectionPool::ResetStats( void )
+    {
+        m_mutexPool.Lock();
+        memset( &m_stats, 0, sizeof( m_stats ) );
+        m_mutexPool.Unlock();
+    }
+
+    /**
+     * GetMicroseconds
+     *
+     *      Returns a monotonic clock reading in microseconds. Only the
+     * differences between readings are meaningful.
+     */
+    unsigned long long CConnectionPool::GetMicroseconds( void )
+    {
+#ifdef IASLIB_WIN32__
+        return (unsigned long long)GetTickCount64() * 1000ULL;
+#else
+        struct timespec ts;
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+        return ( (unsigned long long)ts.tv_sec * 1000000ULL ) + (unsigned long long)( ts.tv_nsec / 1000L );
+#endif
+    }
+
+    /**
+     * Open
+     *
+     *      Opens a new connection. The database's connection list isn't
+     * thread safe, so opening and closing are serialized, but without
+     * holding up threads borrowing idle connections.
+     */
+    CConnection *CConnectionPool::Open( void )
+    {
+        m_mutexConnect.Lock();
+        CConnection *pConnection = m_pDatabase->Connection( m_strDBName, m_strUserName, m_strPassword, m_strApplication, m_strName );
+        m_mutexConnect.Unlock();
+
+        if ( ( pConnection ) && ( ! pConnection->Connected() ) )
+        {
+            delete pConnection;
+            pConnection = NULL;
+        }
+
+        if ( pConnection )
+        {
+            m_mutexPool.Lock();
+            m_stats.m_ullCreated++;
+            m_mutexPool.Unlock();
+        }
+
+        return pConnection;
+    }
+
+    void CConnectionPool::Close( CConnection *pConnection )
+    {
+        m_mutexConnect.Lock();
+        pConnection->Release();
+        delete pConnection;
+        m_mutexConnect.Unlock();
+    }
+
+    /**
+     * IsBorrowedLocked
+     *
+     *      Checks, with the pool locked, that a connection being returned
+     * could be out on loan: something is borrowed, and it isn't already
+     * sitting in the idle list. A connection that was never the pool's
+     * can't be told apart from a borrowed one, so that's on the caller.
+     */
+    bool CConnectionPool::IsBorrowedLocked( CConnection *pConnection )
+    {
+        if ( m_nOpen <= m_nIdle )
+        {
+            return false;
+        }
+
+        for ( size_t nCount = 0; nCount < m_nIdle; nCount++ )
+        {
+            if ( m_aIdle[ nCount ].m_pConnection == pConnection )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * EvictLocked
+     *
+     *      Takes the expired connections out of the idle list, oldest
+     * first, for the caller to close once the pool is unlocked.
+     */
+    size_t CConnectionPool::EvictLocked( unsigned long long ullNow, CConnection **apEvicted )
+    {
+        if ( m_ulIdleTimeout == 0 )
+        {
+            return 0;
+        }
+
+        unsigned long long ullTimeout = (unsigned long long)m_ulIdleTimeout * 1000ULL;
+        size_t nEvicted = 0;
+
+        while ( ( nEvicted < m_nIdle ) && ( m_nOpen - nEvicted > m_nMinSize ) && ( ullNow - m_aIdle[ nEvicted ].m_ullReturned > ullTimeout ) )
+        {
+            apEvicted[ nEvicted ] = m_aIdle[ nEvicted ].m_pConnection;
+            nEvicted++;
+        }
+
+        if ( nEvicted )
+        {
+            memmove( m_aIdle, m_aIdle + nEvicted, ( m_nIdle - nEvicted ) * sizeof( IdleConnection ) );
+            m_nIdle -= nEvicted;
+            m_nOpen -= nEvicted;
+            m_stats.m_ullEvicted += nEvicted;
+        }
+
+        return nEvicted;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_MULTI_THREADED__
+#endif // IASLIB_DATABASE__
@@ -26,6 +26,9 @@ namespace IASLib
         m_bConnected = 0;
         m_nConnections = 0;
         m_strVendor = "";
+#ifdef IASLIB_MULTI_THREADED__
+        m_pPool = NULL;
+#endif
     }
 
     CDatabase::CDatabase( const char *strVendor )
@@ -33,6 +36,16 @@ namespace IASLib
         m_bConnected = false;
         m_nConnections = 0;
         m_strVendor = strVendor;
+#ifdef IASLIB_MULTI_THREADED__
+        m_pPool = NULL;
+#endif
+    }
+
+    CDatabase::~CDatabase( void )
+    {
+#ifdef IASLIB_MULTI_THREADED__
+        ClosePool();
+#endif
     }
 
     bool CDatabase::Connect( const char *strVendor )
@@ -45,6 +58,82 @@ namespace IASLib
 
         return m_bConnected;
     }
+
+#ifdef IASLIB_MULTI_THREADED__
+    /**
+     * CreatePool
+     *
+     *      Sets up a pool of connections on this database, and opens its
+     * minimum number of connections. Threads then borrow connections with
+     * AcquireConnection() and hand them back with ReturnConnection(). A
+     * database has one pool; creating another closes the first.
+     *
+     * @param nMinSize
+     *      The number of connections kept open, even when idle.
+     * @param nMaxSize
+     *      The most connections the pool will open at once.
+     * @param ulIdleTimeout
+     *      How long, in milliseconds, a connection above the minimum can
+     *      sit idle before it's closed.
+     * @return
+     *      false if the minimum number of connections couldn't be opened.
+     */
+    bool CDatabase::CreatePool( const char *strDBName, const char *strUserName, const char *strPassword, size_t nMinSize, size_t nMaxSize, unsigned long ulIdleTimeout, const char *strApplication, const char *strName )
+    {
+        ClosePool();
+
+        m_pPool = new CConnectionPool( this, strDBName, strUserName, strPassword, strApplication, strName, nMinSize, nMaxSize, ulIdleTimeout );
+
+        return m_pPool->Fill();
+    }
+
+    /**
+     * AcquireConnection
+     *
+     *      Borrows a connection from the pool.
+     *
+     * @param lTimeout
+     *      How long to wait for one, in milliseconds (-1 for as long as it
+     *      takes, 0 not at all).
+     * @return
+     *      The connection, or NULL if there's no pool, or none came free.
+     */
+    CConnection *CDatabase::AcquireConnection( long lTimeout )
+    {
+        if ( m_pPool == NULL )
+        {
+            return NULL;
+        }
+
+        return m_pPool->Acquire( lTimeout );
+    }
+
+    bool CDatabase::ReturnConnection( CConnection *pCon, bool bDiscard )
+    {
+        if ( m_pPool == NULL )
+        {
+            return false;
+        }
+
+        return m_pPool->Return( pCon, bDiscard );
+    }
+
+    /**
+     * ClosePool
+     *
+     *      Closes the pool's idle connections and removes the pool.
+     * Connections still borrowed stay open until the database disconnects.
+     * The vendor classes call this before they disconnect.
+     */
+    void CDatabase::ClosePool( void )
+    {
+        if ( m_pPool )
+        {
+            delete m_pPool;
+            m_pPool = NULL;
+        }
+    }
+#endif
 } // namespace IASLib
 
 #endif // IASLIB_DATABASE__
@@ -236,6 +236,9 @@ namespace IASLib
 
     int COracleDatabase::Disconnect( void )
     {
+#ifdef IASLIB_MULTI_THREADED__
+        ClosePool();
+#endif
         m_aConnections.DeleteAll();
         m_nConnections = 0;
 	    return 0;
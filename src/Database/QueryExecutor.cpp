@@ -0,0 +1,520 @@
+/*
+ *  Query Executor Class
+ *
+ *  Runs queries on a connection from a thread of its own, so the threads
+ * that ask for them don't have to sit and wait on the database. Each call
+ * to Cursor(), Execute() or StoredProc() queues the query and returns at
+ * once with a CAsyncQuery, which the caller can Wait() on when it
+ * actually needs the result, poll, or leave to a callback. Queued queries
+ * are run back to back, in the order they were submitted.
+ *  The executor owns its connection while it runs: nothing else may use
+ * the connection until the executor has been shut down. Work that needs
+ * more than one statement (prepared statements, transactions) is done by
+ * subclassing CAsyncQuery and overriding Perform(), which is called on
+ * the executor's thread with the connection.
+ *  Where threads aren't available, queries are run as they're submitted,
+ * so the handle comes back already done.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "QueryExecutor.h"
+#include "Database.h"
+
+#ifdef IASLIB_DATABASE__
+#ifdef IASLIB_MULTI_THREADED__
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CAsyncQuery, CObject );
+
+    /**
+     * Constructor
+     *
+     *      Creates a query with one reference, which belongs to whoever
+     * created it. The parameter list is only used by stored procedures.
+     */
+    CAsyncQuery::CAsyncQuery( const char *strSQL, QueryType eType, const char *strParamList ) : m_semDone( 0 )
+    {
+        m_eType = eType;
+        m_eStatus = STATUS_QUEUED;
+        m_strSQL = strSQL;
+        m_strParamList = strParamList;
+        m_pCursor = NULL;
+        m_pStoredProc = NULL;
+        m_nErrorCode = 0;
+        m_pfnCallback = NULL;
+        m_pUserData = NULL;
+        m_nReferences = 1;
+    }
+
+    CAsyncQuery::~CAsyncQuery( void )
+    {
+        if ( m_pCursor )
+        {
+            delete m_pCursor;
+            m_pCursor = NULL;
+        }
+
+        if ( m_pStoredProc )
+        {
+            delete m_pStoredProc;
+            m_pStoredProc = NULL;
+        }
+    }
+
+    void CAsyncQuery::AddRef( void )
+    {
+        m_mutexState.Lock();
+        m_nReferences++;
+        m_mutexState.Unlock();
+    }
+
+    void CAsyncQuery::Release( void )
+    {
+        m_mutexState.Lock();
+        m_nReferences--;
+        bool bDelete = ( m_nReferences == 0 );
+        m_mutexState.Unlock();
+
+        if ( bDelete )
+        {
+            delete this;
+        }
+    }
+
+    /**
+     * Wait
+     *
+     *      Waits for the query to finish (or be cancelled).
+     *
+     * @param lTimeout
+     *      How long to wait, in milliseconds (-1 for as long as it takes).
+     * @return
+     *      true if the query is done.
+     */
+    bool CAsyncQuery::Wait( long lTimeout )
+    {
+        bool bDone;
+
+            // Without threads the query ran when it was submitted, and the
+            // semaphore can't be waited on.
+        if ( ! CThread::IsAvailable() )
+        {
+            return IsDone();
+        }
+
+        if ( lTimeout < 0 )
+        {
+            m_semDone.Wait();
+            bDone = true;
+        }
+        else if ( lTimeout == 0 )
+        {
+            bDone = m_semDone.TryWait();
+        }
+        else
+        {
+            bDone = m_semDone.TimedWait( (unsigned long)lTimeout );
+        }
+
+            // Leave the semaphore signalled for anyone else waiting
+        if ( bDone )
+        {
+            m_semDone.Post();
+        }
+
+        return bDone;
+    }
+
+    /**
+     * Cancel
+     *
+     *      Cancels the query if it hasn't started running yet.
+     *
+     * @return
+     *      true if the query was cancelled, false if it has already run (or
+     *      is running).
+     */
+    bool CAsyncQuery::Cancel( void )
+    {
+        m_mutexState.Lock();
+        bool bCancelled = ( m_eStatus == STATUS_QUEUED );
+        if ( bCancelled )
+        {
+            m_eStatus = STATUS_CANCELLED;
+        }
+        m_mutexState.Unlock();
+
+        return bCancelled;
+    }
+
+    CAsyncQuery::QueryStatus CAsyncQuery::GetStatus( void )
+    {
+        m_mutexState.Lock();
+        QueryStatus eStatus = m_eStatus;
+        m_mutexState.Unlock();
+
+        return eStatus;
+    }
+
+    bool CAsyncQuery::IsDone( void )
+    {
+        QueryStatus eStatus = GetStatus();
+
+        return ( ( eStatus != STATUS_QUEUED ) && ( eStatus != STATUS_RUNNING ) );
+    }
+
+    /**
+     * TakeCursor
+     *
+     *      Hands the cursor over to the caller, who deletes it. Otherwise
+     * the cursor goes with the query.
+     */
+    CCursor *CAsyncQuery::TakeCursor( void )
+    {
+        CCursor *pCursor = m_pCursor;
+        m_pCursor = NULL;
+        return pCursor;
+    }
+
+    /**
+     * TakeStoredProc
+     *
+     *      Hands the stored procedure (and its results) over to the caller,
+     * who deletes it. Otherwise it goes with the query.
+     */
+    CStoredProc *CAsyncQuery::TakeStoredProc( void )
+    {
+        CStoredProc *pStoredProc = m_pStoredProc;
+        m_pStoredProc = NULL;
+        return pStoredProc;
+    }
+
+    /**
+     * Perform
+     *
+     *      Runs the query on the executor's thread. Subclasses override
+     * this to do other work with the connection; the cursor, if any, goes
+     * in m_pCursor, and the stored procedure in m_pStoredProc.
+     *
+     * @return
+     *      true if the query succeeded.
+     */
+    bool CAsyncQuery::Perform( CConnection *pConnection )
+    {
+        switch ( m_eType )
+        {
+            case QUERY_CURSOR:
+                m_pCursor = pConnection->Cursor( m_strSQL );
+                return ( m_pCursor != NULL );
+
+            case QUERY_FORWARD_CURSOR:
+                m_pCursor = pConnection->ForwardCursor( m_strSQL );
+                return ( m_pCursor != NULL );
+
+            case QUERY_EXECUTE:
+                return pConnection->Execute( m_strSQL );
+
+            case QUERY_STORED_PROC:
+                m_pStoredProc = pConnection->StoredProc( m_strSQL, ( m_strParamList.GetLength() ) ? (const char *)m_strParamList : NULL );
+                return ( m_pStoredProc != NULL );
+
+            default:
+                return false;
+        }
+    }
+
+    bool CAsyncQuery::Start( void )
+    {
+        m_mutexState.Lock();
+        bool bStart = ( m_eStatus == STATUS_QUEUED );
+        if ( bStart )
+        {
+            m_eStatus = STATUS_RUNNING;
+        }
+        m_mutexState.Unlock();
+
+        return bStart;
+    }
+
+    void CAsyncQuery::Finish( bool bSucceeded, CConnection *pConnection )
+    {
+        if ( ! bSucceeded )
+        {
+            m_nErrorCode = pConnection->MajorErrorCode();
+            m_strError = pConnection->MajorErrorMessage();
+        }
+
+        m_mutexState.Lock();
+        m_eStatus = ( bSucceeded ) ? STATUS_COMPLETE : STATUS_FAILED;
+        m_mutexState.Unlock();
+
+        if ( m_pfnCallback )
+        {
+            (*m_pfnCallback)( this, m_pUserData );
+        }
+
+        m_semDone.Post();
+    }
+
+    void CAsyncQuery::Cancelled( void )
+    {
+        m_mutexState.Lock();
+        m_eStatus = STATUS_CANCELLED;
+        m_mutexState.Unlock();
+
+        if ( m_pfnCallback )
+        {
+            (*m_pfnCallback)( this, m_pUserData );
+        }
+
+        m_semDone.Post();
+    }
+
+    IMPLEMENT_OBJECT( CQueryExecutor, CThread );
+
+    /**
+     * Constructor
+     *
+     *      Starts the executor's thread, if there is one to start.
+     *
+     * @param pConnection
+     *      The connection the queries run on. Nothing else may use it until
+     *      the executor is shut down.
+     * @param bOwnsConnection
+     *      Should the executor release and delete the connection when it's
+     *      destroyed?
+     */
+    CQueryExecutor::CQueryExecutor( CConnection *pConnection, bool bOwnsConnection ) : CThread( "QueryExecutor", true, false, true ),
+        m_semAvailable( 0 )
+    {
+        m_pConnection = pConnection;
+        m_bOwnsConnection = bOwnsConnection;
+        m_nCompleted = 0;
+        m_nFailed = 0;
+        m_nPeakQueue = 0;
+        m_bShutdown = false;
+
+        m_bInline = ( ! CThread::IsAvailable() ) || ( ! IsContained() );
+        if ( ! m_bInline )
+        {
+            Resume();
+        }
+    }
+
+    CQueryExecutor::~CQueryExecutor( void )
+    {
+        Shutdown();
+
+        if ( ( m_bOwnsConnection ) && ( m_pConnection ) )
+        {
+            m_pConnection->Release();
+            delete m_pConnection;
+        }
+        m_pConnection = NULL;
+    }
+
+    /**
+     * Run
+     *
+     *      Runs the queued queries until shut down. Queries still waiting
+     * at shutdown are cancelled, so nobody waits on them forever.
+     */
+    void *CQueryExecutor::Run( void )
+    {
+        while ( true )
+        {
+            m_semAvailable.Wait();
+
+            RunQueued();
+
+            if ( m_bShutdown )
+            {
+                break;
+            }
+        }
+
+        return NULL;
+    }
+
+    /**
+     * Cursor
+     *
+     *      Queues a query for a buffered cursor.
+     *
+     * @return
+     *      The query's handle, which the caller releases, or NULL if the
+     *      executor has been shut down.
+     */
+    CAsyncQuery *CQueryExecutor::Cursor( const char *strQuery, AsyncQueryCallback pfnCallback, void *pUserData )
+    {
+        return Queue( new CAsyncQuery( strQuery, CAsyncQuery::QUERY_CURSOR ), pfnCallback, pUserData );
+    }
+
+    CAsyncQuery *CQueryExecutor::ForwardCursor( const char *strQuery, AsyncQueryCallback pfnCallback, void *pUserData )
+    {
+        return Queue( new CAsyncQuery( strQuery, CAsyncQuery::QUERY_FORWARD_CURSOR ), pfnCallback, pUserData );
+    }
+
+    CAsyncQuery *CQueryExecutor::Execute( const char *strQuery, AsyncQueryCallback pfnCallback, void *pUserData )
+    {
+        return Queue( new CAsyncQuery( strQuery, CAsyncQuery::QUERY_EXECUTE ), pfnCallback, pUserData );
+    }
+
+    /**
+     * StoredProc
+     *
+     *      Queues a stored procedure call. Once it has run, the procedure's
+     * return value, out parameters and result set are on the query's
+     * GetStoredProc().
+     *
+     * @return
+     *      The query's handle, which the caller releases, or NULL if the
+     *      executor has been shut down.
+     */
+    CAsyncQuery *CQueryExecutor::StoredProc( const char *strProcCall, const char *strParamList, AsyncQueryCallback pfnCallback, void *pUserData )
+    {
+        return Queue( new CAsyncQuery( strProcCall, CAsyncQuery::QUERY_STORED_PROC, strParamList ), pfnCallback, pUserData );
+    }
+
+    /**
+     * Submit
+     *
+     *      Queues a query built by the caller (usually a subclass of
+     * CAsyncQuery). The executor takes its own reference; the caller keeps
+     * theirs.
+     *
+     * @return
+     *      false if the executor has been shut down.
+     */
+    bool CQueryExecutor::Submit( CAsyncQuery *pQuery )
+    {
+        m_mutexQueue.Lock();
+        if ( m_bShutdown )
+        {
+            m_mutexQueue.Unlock();
+            return false;
+        }
+
+        pQuery->AddRef();
+        m_aQueue.Push( pQuery );
+        if ( m_aQueue.Length() > m_nPeakQueue )
+        {
+            m_nPeakQueue = m_aQueue.Length();
+        }
+        m_mutexQueue.Unlock();
+
+        if ( m_bInline )
+        {
+            RunQueued();
+        }
+        else
+        {
+            m_semAvailable.Post();
+        }
+        return true;
+    }
+
+    /**
+     * Shutdown
+     *
+     *      Stops taking queries, cancels the ones still queued, and waits
+     * for the one running (if any) to finish.
+     */
+    void CQueryExecutor::Shutdown( void )
+    {
+        m_mutexQueue.Lock();
+        bool bRunning = ! m_bShutdown;
+        RequestShutdown();
+        m_mutexQueue.Unlock();
+
+        if ( bRunning )
+        {
+            m_semAvailable.Post();
+            Join();
+        }
+    }
+
+    size_t CQueryExecutor::GetQueueSize( void )
+    {
+        m_mutexQueue.Lock();
+        size_t nSize = m_aQueue.Length();
+        m_mutexQueue.Unlock();
+
+        return nSize;
+    }
+
+    CAsyncQuery *CQueryExecutor::Queue( CAsyncQuery *pQuery, AsyncQueryCallback pfnCallback, void *pUserData )
+    {
+        pQuery->SetCallback( pfnCallback, pUserData );
+
+        if ( ! Submit( pQuery ) )
+        {
+            pQuery->Release();
+            return NULL;
+        }
+
+        return pQuery;
+    }
+
+    /**
+     * RunQueued
+     *
+     *      Runs the queries in the queue, oldest first, on the executor's
+     * thread, or on the submitting thread when there isn't one.
+     */
+    void CQueryExecutor::RunQueued( void )
+    {
+        CAsyncQuery *pQuery = Next();
+        while ( pQuery )
+        {
+            if ( m_bShutdown )
+            {
+                pQuery->Cancelled();
+            }
+            else if ( pQuery->Start() )
+            {
+                bool bSucceeded = pQuery->Perform( m_pConnection );
+
+                if ( bSucceeded )
+                {
+                    m_nCompleted++;
+                }
+                else
+                {
+                    m_nFailed++;
+                }
+                pQuery->Finish( bSucceeded, m_pConnection );
+            }
+            else
+            {
+                pQuery->Cancelled();
+            }
+
+            pQuery->Release();
+            pQuery = Next();
+        }
+    }
+
+    CAsyncQuery *CQueryExecutor::Next( void )
+    {
+        CAsyncQuery *pQuery = NULL;
+
+        m_mutexQueue.Lock();
+        if ( m_aQueue.Length() )
+        {
+            pQuery = (CAsyncQuery *)m_aQueue.Remove( 0 );
+        }
+        m_mutexQueue.Unlock();
+
+        return pQuery;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_MULTI_THREADED__
+#endif // IASLIB_DATABASE__
@@ -0,0 +1,433 @@
+/*
+ *  SQL Lite Bulk Copy Connection
+ *
+ *      Bulk loading for SQLite, with the same interface as the Sybase
+ * bulk copy: pick the table with SetTable(), bind a buffer to each column
+ * with BindColumn(), then fill the buffers and call SendRow() once per
+ * row, and Flush() at the end.
+ *      Underneath, every row runs the same prepared INSERT, and the rows
+ * are committed in batches (by default, all of them in one transaction)
+ * rather than each in its own implicit transaction, which is what makes
+ * row by row inserts into SQLite slow. The journal mode and synchronous
+ * setting can be relaxed for the load as well.
+ *      The connection has its own SQLite connection to the database file,
+ * which isn't shared with (or counted among) the database's connections.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_DATABASE__
+#ifdef IASLIB_DB_SQLITE__
+
+#include "sqlite3.h"
+#include "Sqlt_BulkCopyConnection.h"
+#include "Sqlt_Connection.h"
+#include "Sqlt_Statement.h"
+#include "Database.h"
+#include "Date.h"
+#include <ctype.h>
+#include <string.h>
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CSQLiteBulkCopyConnection, CBulkCopyConnection );
+
+    CSQLiteBulkCopyConnection::CSQLiteBulkCopyConnection( const char *strDBName, const char *strName )
+        : CBulkCopyConnection( strName )
+    {
+        m_pConnection = new CSQLiteConnection( strDBName, strName, NULL );
+        m_pInsert = NULL;
+        m_aBindings = NULL;
+        m_nBindings = 0;
+        m_nBatchSize = 0;
+        m_nBatchRows = 0;
+        m_nRowsSent = 0;
+        m_bBatchOpen = false;
+        m_bConnected = m_pConnection->Connected();
+    }
+
+    CSQLiteBulkCopyConnection::~CSQLiteBulkCopyConnection( void )
+    {
+        Release();
+    }
+
+    /**
+     * Release
+     *
+     *      Commits any rows still waiting, and closes the connection.
+     */
+    bool CSQLiteBulkCopyConnection::Release( void )
+    {
+        bool bRetVal = true;
+
+        if ( m_pConnection )
+        {
+            bRetVal = Flush();
+            CloseInsert();
+
+            m_pConnection->Release();
+            delete m_pConnection;
+            m_pConnection = NULL;
+        }
+
+        delete [] m_aBindings;
+        m_aBindings = NULL;
+        m_nBindings = 0;
+        m_bConnected = false;
+
+        return bRetVal;
+    }
+
+    bool CSQLiteBulkCopyConnection::IsDead( void )
+    {
+        return ( ( m_pConnection == NULL ) || ( m_pConnection->IsDead() ) );
+    }
+
+    /**
+     * SetTable
+     *
+     *      Picks the table to load, and looks up its columns. Rows still
+     * waiting for the previous table are committed first, and the column
+     * bindings are cleared.
+     */
+    bool CSQLiteBulkCopyConnection::SetTable( const char *strTableName )
+    {
+        if ( ( IsDead() ) || ( ! Flush() ) )
+        {
+            return false;
+        }
+
+        CloseInsert();
+        delete [] m_aBindings;
+        m_aBindings = NULL;
+        m_nBindings = 0;
+        m_astrColumns.DeleteAll();
+        m_strTable = strTableName;
+
+        CString strQuery;
+        strQuery.Format( "SELECT * FROM %s LIMIT 0", strTableName );
+
+        CCursor *pCursor = m_pConnection->ForwardCursor( strQuery );
+        if ( pCursor == NULL )
+        {
+            return false;
+        }
+
+        for ( size_t nColumn = 0; nColumn < pCursor->Columns(); nColumn++ )
+        {
+            m_astrColumns.Push( pCursor->ColumnName( nColumn ) );
+        }
+        delete pCursor;
+
+        m_nBindings = m_astrColumns.Length();
+        m_aBindings = new ColumnBinding[ ( m_nBindings > 0 ) ? m_nBindings : 1 ];
+        memset( m_aBindings, 0, sizeof( ColumnBinding ) * ( ( m_nBindings > 0 ) ? m_nBindings : 1 ) );
+
+        return ( m_nBindings > 0 );
+    }
+
+    /**
+     * BindColumn
+     *
+     *      Binds a buffer to a column of the table. Every SendRow() reads
+     * the row's values from the bound buffers, so they must stay put until
+     * the load is flushed. Columns that are never bound are left out of
+     * the INSERT, and get their defaults.
+     *
+     * @param nColumnNumber
+     *      The column, numbered from 1 in the table's order.
+     * @param nDataType
+     *      What the buffer holds: BULK_TYPE_INT (an int), BULK_TYPE_INT64
+     *      (a long long), BULK_TYPE_FLOAT (a double), BULK_TYPE_CHAR or
+     *      BULK_TYPE_VARCHAR (characters, up to a NUL or nBufferLength),
+     *      or BULK_TYPE_DATE (a CDate, invalid dates load as NULL).
+     * @param pDataBuffer
+     *      The buffer, or NULL to load NULL into the column.
+     */
+    bool CSQLiteBulkCopyConnection::BindColumn( int nColumnNumber, int nDataType, void *pDataBuffer, int nBufferLength )
+    {
+        if ( ( nColumnNumber < 1 ) || ( (size_t)nColumnNumber > m_nBindings ) )
+        {
+            return false;
+        }
+
+        switch ( nDataType )
+        {
+            case BULK_TYPE_INT:
+            case BULK_TYPE_INT64:
+            case BULK_TYPE_FLOAT:
+            case BULK_TYPE_CHAR:
+            case BULK_TYPE_DATE:
+            case BULK_TYPE_VARCHAR:
+                break;
+
+            default:
+                return false;
+        }
+
+            // A new set of columns needs a new INSERT
+        if ( m_aBindings[ nColumnNumber - 1 ].m_nDataType == 0 )
+        {
+            CloseInsert();
+        }
+
+        m_aBindings[ nColumnNumber - 1 ].m_nDataType = nDataType;
+        m_aBindings[ nColumnNumber - 1 ].m_pDataBuffer = pDataBuffer;
+        m_aBindings[ nColumnNumber - 1 ].m_nBufferLength = nBufferLength;
+
+        return true;
+    }
+
+    /**
+     * SendRow
+     *
+     *      Inserts a row from the bound buffers. The first row of a batch
+     * starts its transaction, and the row that fills it commits it.
+     */
+    bool CSQLiteBulkCopyConnection::SendRow( void )
+    {
+        if ( ( IsDead() ) || ( ( m_pInsert == NULL ) && ( ! PrepareInsert() ) ) )
+        {
+            return false;
+        }
+
+        if ( ! m_bBatchOpen )
+        {
+            m_pConnection->BeginTransaction();
+            m_bBatchOpen = true;
+            m_nBatchRows = 0;
+        }
+
+        if ( ( ! BindRow() ) || ( ! m_pInsert->Execute() ) )
+        {
+            return false;
+        }
+
+        m_nBatchRows++;
+        m_nRowsSent++;
+
+        if ( ( m_nBatchSize > 0 ) && ( m_nBatchRows >= m_nBatchSize ) )
+        {
+            return Flush();
+        }
+
+        return true;
+    }
+
+    /**
+     * Flush
+     *
+     *      Commits the rows sent since the last commit.
+     */
+    bool CSQLiteBulkCopyConnection::Flush( void )
+    {
+        if ( ! m_bBatchOpen )
+        {
+            return true;
+        }
+
+        m_bBatchOpen = false;
+        m_nBatchRows = 0;
+
+        return m_pConnection->CommitTransaction();
+    }
+
+    /**
+     * SetJournalMode
+     *
+     *      Sets SQLite's journal mode ("WAL", "DELETE", "MEMORY", "OFF"...)
+     * for the database file. Unlike the other settings, this one sticks to
+     * the file after the connection is closed.
+     */
+    bool CSQLiteBulkCopyConnection::SetJournalMode( const char *strMode )
+    {
+        return Pragma( "journal_mode", strMode );
+    }
+
+    /**
+     * SetSynchronous
+     *
+     *      Sets how hard SQLite works to get each commit onto the disk
+     * ("FULL", "NORMAL" or "OFF") on this connection. With WAL, NORMAL is
+     * still safe from corruption, and only risks the last commits on a
+     * power failure.
+     */
+    bool CSQLiteBulkCopyConnection::SetSynchronous( const char *strSetting )
+    {
+        return Pragma( "synchronous", strSetting );
+    }
+
+    int CSQLiteBulkCopyConnection::MajorErrorCode( void )
+    {
+        return ( m_pConnection ) ? m_pConnection->MajorErrorCode() : IASLIB_DB_ERROR_CONNECTION_DEAD;
+    }
+
+    const char *CSQLiteBulkCopyConnection::MajorErrorMessage( void )
+    {
+        return ( m_pConnection ) ? m_pConnection->MajorErrorMessage() : "The connection has been released.";
+    }
+
+    /**
+     * PrepareInsert
+     *
+     *      Builds and prepares the INSERT for the bound columns.
+     */
+    bool CSQLiteBulkCopyConnection::PrepareInsert( void )
+    {
+        CString strColumns;
+        CString strValues;
+
+        for ( size_t nColumn = 0; nColumn < m_nBindings; nColumn++ )
+        {
+            if ( m_aBindings[ nColumn ].m_nDataType == 0 )
+            {
+                continue;
+            }
+
+            if ( strColumns.GetLength() )
+            {
+                strColumns += ", ";
+                strValues += ", ";
+            }
+            strColumns += "\"";
+            strColumns += m_astrColumns[ nColumn ];
+            strColumns += "\"";
+            strValues += "?";
+        }
+
+        if ( strColumns.GetLength() == 0 )
+        {
+            return false;
+        }
+
+        CString strInsert;
+        strInsert.Format( "INSERT INTO %s (%s) VALUES (%s)", (const char *)m_strTable, (const char *)strColumns, (const char *)strValues );
+
+        m_pInsert = m_pConnection->Prepare( strInsert );
+
+        return ( m_pInsert != NULL );
+    }
+
+    /**
+     * BindRow
+     *
+     *      Binds the values in the column buffers to the INSERT.
+     */
+    bool CSQLiteBulkCopyConnection::BindRow( void )
+    {
+        size_t nParam = 1;
+
+        for ( size_t nColumn = 0; nColumn < m_nBindings; nColumn++ )
+        {
+            ColumnBinding  *pBinding = &m_aBindings[ nColumn ];
+            bool            bBound;
+
+            if ( pBinding->m_nDataType == 0 )
+            {
+                continue;
+            }
+
+            if ( pBinding->m_pDataBuffer == NULL )
+            {
+                bBound = m_pInsert->BindNull( nParam );
+            }
+            else
+            {
+                switch ( pBinding->m_nDataType )
+                {
+                    case BULK_TYPE_INT:
+                        bBound = m_pInsert->Bind( nParam, *(int *)pBinding->m_pDataBuffer );
+                        break;
+
+                    case BULK_TYPE_INT64:
+                        bBound = m_pInsert->Bind( nParam, *(long long *)pBinding->m_pDataBuffer );
+                        break;
+
+                    case BULK_TYPE_FLOAT:
+                        bBound = m_pInsert->Bind( nParam, *(double *)pBinding->m_pDataBuffer );
+                        break;
+
+                    case BULK_TYPE_DATE:
+                        {
+                            CDate *pDate = (CDate *)pBinding->m_pDataBuffer;
+                            if ( pDate->IsValid() )
+                            {
+                                char strDate[ 32 ];
+                                sprintf( strDate, "%04d-%02d-%02d %02d:%02d:%02d", pDate->GetYear(), pDate->GetMonth(), pDate->GetDay(), pDate->GetHour(), pDate->GetMinute(), pDate->GetSecond() );
+                                bBound = m_pInsert->Bind( nParam, (const char *)strDate );
+                            }
+                            else
+                            {
+                                bBound = m_pInsert->BindNull( nParam );
+                            }
+                        }
+                        break;
+
+                    default:
+                        {
+                            const char *pchValue = (const char *)pBinding->m_pDataBuffer;
+                            size_t      nLength = 0;
+
+                            while ( ( nLength < (size_t)pBinding->m_nBufferLength ) && ( pchValue[ nLength ] ) )
+                            {
+                                nLength++;
+                            }
+                            bBound = m_pInsert->Bind( nParam, pchValue, nLength );
+                        }
+                        break;
+                }
+            }
+
+            if ( ! bBound )
+            {
+                return false;
+            }
+            nParam++;
+        }
+
+        return true;
+    }
+
+    void CSQLiteBulkCopyConnection::CloseInsert( void )
+    {
+        if ( m_pInsert )
+        {
+            m_pInsert->Close();
+            m_pInsert = NULL;
+        }
+    }
+
+    /**
+     * Pragma
+     *
+     *      Runs a pragma, outside of any batch. Values are only ever plain
+     * keywords, so anything else is refused rather than escaped.
+     */
+    bool CSQLiteBulkCopyConnection::Pragma( const char *strName, const char *strValue )
+    {
+        if ( ( IsDead() ) || ( strValue == NULL ) || ( *strValue == '\0' ) || ( ! Flush() ) )
+        {
+            return false;
+        }
+
+        for ( const char *pchScan = strValue; *pchScan; pchScan++ )
+        {
+            if ( ( ! isalnum( (unsigned char)*pchScan ) ) && ( *pchScan != '_' ) )
+            {
+                return false;
+            }
+        }
+
+        CString strPragma;
+        strPragma.Format( "PRAGMA %s = %s;", strName, strValue );
+
+        return m_pConnection->Execute( strPragma );
+    }
+} // namespace IASLib
+
+#endif // IASLIB_DB_SQLITE__
+#endif // IASLIB_DATABASE__
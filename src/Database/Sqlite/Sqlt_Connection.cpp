@@ -21,6 +21,8 @@
 #include "Sqlt_Connection.h"
 #include "Sqlt_Cursor.h"
 #include "Sqlt_Database.h"
+#include "Sqlt_Statement.h"
+#include "Sqlt_ForwardCursor.h"
 #include "Database.h"
 #include "sqlite3.h"
 
@@ -30,7 +32,7 @@ namespace IASLib
 
 
     CSQLiteConnection::CSQLiteConnection( const char *strDBName, const char *strName, CSQLiteDatabase *pDatabase )
-        : CConnection( strName )
+        : CConnection( strName ), m_hashStatements( CHash::SMALL )
     {
         m_fnSqlOpen     = (open_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_open" );
 #ifdef IASLIB_LINUX__
@@ -43,8 +45,39 @@ namespace IASLib
         m_fnSqlErrMsg   = (error_msg_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_errmsg" );
         m_fnSqlExec     = (exec_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_exec" );
 
+        m_fnSqlPrepare          = (prepare_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_prepare_v2" );
+        m_fnSqlStep             = (stmt_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_step" );
+        m_fnSqlReset            = (stmt_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_reset" );
+        m_fnSqlFinalize         = (stmt_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_finalize" );
+        m_fnSqlClearBindings    = (stmt_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_clear_bindings" );
+        m_fnSqlColumnCount      = (stmt_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_column_count" );
+        m_fnSqlParamCount       = (stmt_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_bind_parameter_count" );
+        m_fnSqlBindNull         = (bind_null_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_bind_null" );
+        m_fnSqlBindInt64        = (bind_int64_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_bind_int64" );
+        m_fnSqlBindDouble       = (bind_double_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_bind_double" );
+        m_fnSqlBindText         = (bind_text_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_bind_text" );
+        m_fnSqlBindBlob         = (bind_blob_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_bind_blob" );
+        m_fnSqlParamIndex       = (bind_index_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_bind_parameter_index" );
+        m_fnSqlColumnName       = (column_name_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_column_name" );
+        m_fnSqlColumnText       = (column_text_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_column_text" );
+        m_fnSqlColumnBytes      = (column_int_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_column_bytes" );
+        m_fnSqlColumnType       = (column_int_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_column_type" );
+        m_fnSqlColumnInt64      = (column_int64_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_column_int64" );
+        m_fnSqlColumnDouble     = (column_double_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_column_double" );
+        m_fnSqlColumnBlob       = (column_blob_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_column_blob" );
+        m_fnSqlChanges          = (changes_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_changes" );
+        m_fnSqlLastRowId        = (last_rowid_func_type *)CSQLiteDatabase::GetFunction( "sqlite3_last_insert_rowid" );
+
+        m_pLruHead = NULL;
+        m_pLruTail = NULL;
+        m_nCachedStatements = 0;
+        m_nStatementCacheSize = DEFAULT_STATEMENT_CACHE_SIZE;
+        m_nStatementCacheHits = 0;
+        m_nStatementCacheMisses = 0;
+
         m_bConnected = false;
         m_bValid = false;
+        m_bTransactionOpen = false;
         m_nLastErrorCode = 0;
         m_pDatabase = pDatabase;
 
@@ -56,6 +89,7 @@ namespace IASLib
             m_nLastErrorCode = IASLIB_DB_ERROR_BAD_DATABASE;
             m_strLastErrorCode = (*m_fnSqlErrMsg)( m_pSLDatabase );
             (*m_fnSqlClose)( m_pSLDatabase );
+            m_pSLDatabase = NULL;
         }
         else
         {
@@ -67,6 +101,8 @@ namespace IASLib
 
     CSQLiteConnection::~CSQLiteConnection( void )
     {
+        ClearStatementCache();
+
         if ( m_pSLDatabase )
         {
             (*m_fnSqlClose)( m_pSLDatabase );
@@ -95,6 +131,7 @@ namespace IASLib
             return false;
         }
         m_bInTransaction = false;
+        m_bTransactionOpen = false;
         m_strTransactionBuffer += "END;";
         return Execute( m_strTransactionBuffer );
     }
@@ -103,6 +140,47 @@ namespace IASLib
     {
         m_strTransactionBuffer = "";
         m_bInTransaction = false;
+
+            // Once a prepared statement has run, the transaction is real and
+            // has to be rolled back in the database.
+        if ( m_bTransactionOpen )
+        {
+            m_bTransactionOpen = false;
+            return Execute( "ROLLBACK;" );
+        }
+        return true;
+    }
+
+    /**
+     * OpenTransaction
+     *
+     *      Prepared statements can't be buffered as text like Execute()
+     * does, since their values are bound. So the first one run inside a
+     * transaction sends the buffer so far (starting with the BEGIN), and
+     * from then on the transaction is open in the database. The commit
+     * still sends whatever has been buffered since, and the END.
+     */
+    bool CSQLiteConnection::OpenTransaction( void )
+    {
+        if ( ( ! m_bInTransaction ) || ( m_strTransactionBuffer.GetLength() == 0 ) )
+        {
+            return true;
+        }
+
+        m_nLastErrorCode = (*m_fnSqlExec)( m_pSLDatabase, m_strTransactionBuffer, NULL, NULL, &m_pstrErrorStorage );
+        m_strTransactionBuffer = "";
+
+        if ( m_nLastErrorCode != SQLITE_OK )
+        {
+            if ( m_pstrErrorStorage != NULL )
+            {
+                m_strLastErrorCode = m_pstrErrorStorage;
+                (*m_fnSqlFree)( m_pstrErrorStorage );
+            }
+            return false;
+        }
+
+        m_bTransactionOpen = true;
         return true;
     }
 
@@ -137,6 +215,21 @@ namespace IASLib
             strConQuery += ';';
         }
 
+            // A single SELECT runs through the statement cache, so running
+            // the same query again doesn't compile it again.
+        if ( strConQuery.IndexOf( ';' ) == strConQuery.GetLength() - 1 )
+        {
+            CPreparedStatement *pStatement = Prepare( strConQuery );
+            if ( pStatement == NULL )
+            {
+                return NULL;
+            }
+
+            CCursor *pCursor = pStatement->Cursor( bUpdatable );
+            pStatement->Close();
+            return pCursor;
+        }
+
         pNewCursor = new CSQLiteCursor( this, bUpdatable );
 
         m_nLastErrorCode = (*m_fnSqlExec)( m_pSLDatabase, strConQuery, CursorCallback, pNewCursor, &m_pstrErrorStorage );
@@ -159,6 +252,51 @@ namespace IASLib
         return pNewCursor;
     }
 
+    /**
+     * ForwardCursor
+     *
+     *      Runs a SELECT and returns a forward-only cursor over it, which
+     * reads each row from the database as Next() reaches it instead of
+     * collecting the whole result first. The statement comes from (and
+     * goes back to) the statement cache.
+     *
+     * @param strQueryString
+     *      The query.
+     * @return
+     *      The cursor (the caller deletes it), or NULL on an error.
+     */
+    CCursor *CSQLiteConnection::ForwardCursor( const char *strQueryString )
+    {
+        CString strConQuery = strQueryString;
+
+        strConQuery.Trim();
+
+        CString strStart = strConQuery.Substring( 0, 6 );
+        strStart.ToUpperCase();
+
+        if ( strStart != "SELECT" )
+        {
+            m_strLastErrorCode = "Cursor query was not a SELECT statement.";
+            m_nLastErrorCode = IASLIB_DB_ERROR_BAD_QUERY;
+            return NULL;
+        }
+
+        CSQLiteStatement *pStatement = (CSQLiteStatement *)Prepare( strConQuery );
+        if ( pStatement == NULL )
+        {
+            return NULL;
+        }
+
+        CSQLiteForwardCursor *pCursor = new CSQLiteForwardCursor( pStatement, true );
+        if ( ! pCursor->IsValid() )
+        {
+            delete pCursor;
+            return NULL;
+        }
+
+        return pCursor;
+    }
+
     bool CSQLiteConnection::Execute( const char *strExecString )
     {
         CString         strConQuery = strExecString;
@@ -186,7 +324,8 @@ namespace IASLib
             return true;
         }
 
-        m_nLastErrorCode = (*m_fnSqlExec)( m_pSLDatabase, strConQuery, CursorCallback, NULL, &m_pstrErrorStorage );
+            // Any rows the statement returns (as from some PRAGMAs) are ignored
+        m_nLastErrorCode = (*m_fnSqlExec)( m_pSLDatabase, strConQuery, NULL, NULL, &m_pstrErrorStorage );
 
         if ( m_nLastErrorCode != SQLITE_OK )
         {
@@ -230,6 +369,8 @@ namespace IASLib
                 m_pDatabase->ReleaseConnection( this );
             }
 
+            ClearStatementCache();
+
             if ( m_pSLDatabase )
             {
                 (*m_fnSqlClose)( m_pSLDatabase );
@@ -275,6 +416,183 @@ namespace IASLib
     {
         (*m_fnSqlBusyTime)( m_pSLDatabase, nTimeMS );
     }
+
+    /**
+     * Prepare
+     *
+     *      Returns a compiled statement for the SQL. An idle statement with
+     * exactly the same text is taken from the cache, otherwise the SQL is
+     * compiled. Only the first statement in the text is compiled.
+     *
+     * @param strSQL
+     *      The SQL, with ? (or ?NNN, :name, @name or $name) placeholders.
+     * @return
+     *      The statement, which the caller hands back with Close(), or NULL
+     *      if the SQL doesn't compile.
+     */
+    CPreparedStatement *CSQLiteConnection::Prepare( const char *strSQL )
+    {
+	    if ( !m_bConnected )
+        {
+            m_strLastErrorCode = "This connection has been marked dead.";
+            m_nLastErrorCode = IASLIB_DB_ERROR_CONNECTION_DEAD;
+		    return NULL;
+	    }
+
+        CSQLiteStatement *pStatement = (CSQLiteStatement *)m_hashStatements.Remove( strSQL );
+        if ( pStatement )
+        {
+            if ( pStatement->m_pLruPrev )
+            {
+                pStatement->m_pLruPrev->m_pLruNext = pStatement->m_pLruNext;
+            }
+            else
+            {
+                m_pLruHead = pStatement->m_pLruNext;
+            }
+
+            if ( pStatement->m_pLruNext )
+            {
+                pStatement->m_pLruNext->m_pLruPrev = pStatement->m_pLruPrev;
+            }
+            else
+            {
+                m_pLruTail = pStatement->m_pLruPrev;
+            }
+
+            pStatement->m_pLruNext = NULL;
+            pStatement->m_pLruPrev = NULL;
+            m_nCachedStatements--;
+            m_nStatementCacheHits++;
+
+            return pStatement;
+        }
+
+        m_nStatementCacheMisses++;
+
+        sqlite3_stmt *pHandle = NULL;
+        const char   *pchTail = NULL;
+
+        m_nLastErrorCode = (*m_fnSqlPrepare)( m_pSLDatabase, strSQL, -1, &pHandle, &pchTail );
+
+        if ( m_nLastErrorCode != SQLITE_OK )
+        {
+            m_strLastErrorCode = (*m_fnSqlErrMsg)( m_pSLDatabase );
+            if ( pHandle )
+            {
+                (*m_fnSqlFinalize)( pHandle );
+            }
+            return NULL;
+        }
+
+        if ( pHandle == NULL )
+        {
+                // Nothing but whitespace or comments
+            m_nLastErrorCode = IASLIB_DB_ERROR_BAD_QUERY;
+            m_strLastErrorCode = "The statement is empty.";
+            return NULL;
+        }
+
+        return new CSQLiteStatement( this, strSQL, pHandle );
+    }
+
+    /**
+     * ReturnStatement
+     *
+     *      Takes back a closed statement. It is reset and cached as the
+     * most recently used, and the least recently used statements are
+     * finalized if that puts the cache over its size.
+     */
+    void CSQLiteConnection::ReturnStatement( CSQLiteStatement *pStatement )
+    {
+        pStatement->Reset();
+        pStatement->ClearBindings();
+
+            // A second copy of a statement that was in use at the same time
+            // as the cached one isn't worth keeping.
+        if ( ( ! m_bConnected ) || ( m_nStatementCacheSize == 0 ) || ( m_hashStatements.HasKey( pStatement->GetSQL() ) ) )
+        {
+            delete pStatement;
+            return;
+        }
+
+        m_hashStatements.Push( pStatement->GetSQL(), pStatement );
+
+        pStatement->m_pLruPrev = NULL;
+        pStatement->m_pLruNext = m_pLruHead;
+        if ( m_pLruHead )
+        {
+            m_pLruHead->m_pLruPrev = pStatement;
+        }
+        else
+        {
+            m_pLruTail = pStatement;
+        }
+        m_pLruHead = pStatement;
+        m_nCachedStatements++;
+
+        TrimStatementCache();
+    }
+
+    /**
+     * SetStatementCacheSize
+     *
+     *      Sets how many idle statements the connection keeps compiled. A
+     * size of zero turns the cache off.
+     */
+    void CSQLiteConnection::SetStatementCacheSize( size_t nStatements )
+    {
+        m_nStatementCacheSize = nStatements;
+        TrimStatementCache();
+    }
+
+    void CSQLiteConnection::TrimStatementCache( void )
+    {
+        while ( m_nCachedStatements > m_nStatementCacheSize )
+        {
+            CSQLiteStatement *pOldest = m_pLruTail;
+
+            m_pLruTail = pOldest->m_pLruPrev;
+            if ( m_pLruTail )
+            {
+                m_pLruTail->m_pLruNext = NULL;
+            }
+            else
+            {
+                m_pLruHead = NULL;
+            }
+            m_hashStatements.Remove( pOldest->GetSQL() );
+            m_nCachedStatements--;
+
+            delete pOldest;
+        }
+    }
+
+    /**
+     * ClearStatementCache
+     *
+     *      Finalizes every idle statement. This has to happen before the
+     * database is closed.
+     */
+    void CSQLiteConnection::ClearStatementCache( void )
+    {
+        m_hashStatements.EmptyAll();
+
+        while ( m_pLruHead )
+        {
+            CSQLiteStatement *pStatement = m_pLruHead;
+            m_pLruHead = pStatement->m_pLruNext;
+            delete pStatement;
+        }
+
+        m_pLruTail = NULL;
+        m_nCachedStatements = 0;
+    }
+
+    void CSQLiteConnection::SetStatementError( void )
+    {
+        m_strLastErrorCode = (*m_fnSqlErrMsg)( m_pSLDatabase );
+    }
 } // namespace IASLib
 
 #endif // IASLIB_DB_SQLITE__
@@ -22,6 +22,7 @@
 #include "Sqlt_Cursor.h"
 #include "Sqlt_Connection.h"
 #include "Database.h"
+#include <stdio.h>
 
 #define GROW_BY 128
 
@@ -34,6 +35,7 @@ namespace IASLib
         m_pConnection = pConnection;
         m_bUpdatable = bUpdatable;
         m_bValid = false;
+        m_apColumns = NULL;
     }
 
     CSQLiteCursor::~CSQLiteCursor( void )
@@ -43,14 +45,27 @@ namespace IASLib
 
     int CSQLiteCursor::Close( void )
     {
-        for ( size_t nStep = 0; nStep < m_nRows ; nStep++ )
+        if ( m_aastrData )
         {
-            m_aastrData[nStep]->DeleteAll();
-            delete m_aastrData[ nStep ];
+            for ( size_t nStep = 0; nStep < m_nRows ; nStep++ )
+            {
+                m_aastrData[nStep]->DeleteAll();
+                delete m_aastrData[ nStep ];
+            }
+            delete [] m_aastrData;
         }
-        delete [] m_aastrData;
         while ( m_nRows % GROW_BY ) m_nRows++;
 
+        if ( m_apColumns )
+        {
+            for ( size_t nColumn = 0; nColumn < m_nColumns; nColumn++ )
+            {
+                delete m_apColumns[ nColumn ];
+            }
+            delete [] m_apColumns;
+            m_apColumns = NULL;
+        }
+
         m_nRows = 0;
         m_aastrData = NULL;
         m_bValid = false;
@@ -96,6 +111,137 @@ namespace IASLib
         return false;
     }
 
+    /**
+     * GetColumn
+     *
+     *      Returns a column of the current row as text. Columnar cursors
+     * format their numbers on the way out, and return NULLs as empty.
+     */
+    CString CSQLiteCursor::GetColumn( size_t nColumn )
+    {
+        if ( m_apColumns == NULL )
+        {
+            return CBaseResult::GetColumn( nColumn );
+        }
+
+        if ( ( ! m_bValid ) || ( nColumn >= m_nColumns ) || ( m_nCurrentRow >= m_nRows ) )
+        {
+            return CString( "" );
+        }
+
+        CColumnBuffer  *pColumn = m_apColumns[ nColumn ];
+        CString         strValue;
+        size_t          nLength;
+        const char     *pchText;
+
+        switch ( pColumn->GetType( m_nCurrentRow ) )
+        {
+            case COLUMN_INTEGER:
+                strValue.Format( "%lld", pColumn->GetInt64( m_nCurrentRow ) );
+                break;
+
+            case COLUMN_FLOAT:
+                strValue.Format( "%.15g", pColumn->GetDouble( m_nCurrentRow ) );
+                break;
+
+            case COLUMN_TEXT:
+            case COLUMN_BLOB:
+                pchText = pColumn->GetText( m_nCurrentRow, nLength );
+                strValue = CString( pchText, nLength );
+                break;
+
+            default:
+                break;
+        }
+
+        return strValue;
+    }
+
+    CBaseResult::ColumnType CSQLiteCursor::GetColumnType( size_t nColumn )
+    {
+        if ( m_apColumns == NULL )
+        {
+            return CBaseResult::GetColumnType( nColumn );
+        }
+
+        if ( ( ! m_bValid ) || ( nColumn >= m_nColumns ) )
+        {
+            return COLUMN_NULL;
+        }
+
+        return m_apColumns[ nColumn ]->GetType( m_nCurrentRow );
+    }
+
+    long long CSQLiteCursor::GetInt64( size_t nColumn )
+    {
+        if ( m_apColumns == NULL )
+        {
+            return CBaseResult::GetInt64( nColumn );
+        }
+
+        if ( ( ! m_bValid ) || ( nColumn >= m_nColumns ) )
+        {
+            return 0;
+        }
+
+        return m_apColumns[ nColumn ]->GetInt64( m_nCurrentRow );
+    }
+
+    double CSQLiteCursor::GetDouble( size_t nColumn )
+    {
+        if ( m_apColumns == NULL )
+        {
+            return CBaseResult::GetDouble( nColumn );
+        }
+
+        if ( ( ! m_bValid ) || ( nColumn >= m_nColumns ) )
+        {
+            return 0.0;
+        }
+
+        return m_apColumns[ nColumn ]->GetDouble( m_nCurrentRow );
+    }
+
+    const void *CSQLiteCursor::GetBlob( size_t nColumn, size_t &nLength )
+    {
+        if ( m_apColumns == NULL )
+        {
+            return CBaseResult::GetBlob( nColumn, nLength );
+        }
+
+        if ( ( ! m_bValid ) || ( nColumn >= m_nColumns ) )
+        {
+            nLength = 0;
+            return NULL;
+        }
+
+        return m_apColumns[ nColumn ]->GetText( m_nCurrentRow, nLength );
+    }
+
+    /**
+     * ColumnHeader
+     *
+     *      Turns a column name, as SQLite reports it, into the header the
+     * cursors use: without any table prefix or parentheses, and in upper
+     * case.
+     */
+    CString CSQLiteCursor::ColumnHeader( const char *strName )
+    {
+        CString strTemp = strName;
+
+        if ( strTemp.IndexOf( '.' ) != NOT_FOUND )
+            strTemp = strTemp.Substring( strTemp.IndexOf( '.' ) + 1 );
+
+        if ( ( strTemp.IndexOf( '(' ) != NOT_FOUND ) || ( strTemp.IndexOf( ')' ) != NOT_FOUND ) )
+        {
+            strTemp.Replace( '(', ' ' );
+            strTemp.Replace( ')', ' ' );
+            strTemp = strTemp.Trim();
+        }
+        strTemp.ToUpperCase();
+
+        return strTemp;
+    }
 
     int CursorCallback( void *pCursorA, int nColumns, char **astrValues, char **astrHeaders )
     {
@@ -107,20 +253,7 @@ namespace IASLib
         {
             for ( nCount = 0; nCount < nColumns; nCount++ )
             {
-                strTemp = astrHeaders[ nCount ];
-
-                if ( strTemp.IndexOf( '.' ) != NOT_FOUND )
-                    strTemp = strTemp.Substring( strTemp.IndexOf( '.' ) + 1 );
-
-                if ( ( strTemp.IndexOf( '(' ) != NOT_FOUND ) || ( strTemp.IndexOf( ')' ) != NOT_FOUND ) )
-                {
-                    strTemp.Replace( '(', ' ' );
-                    strTemp.Replace( ')', ' ' );
-                    strTemp = strTemp.Trim();
-                }
-                strTemp.ToUpperCase();
-
-                pCursor->m_astrHeaders.Push( strTemp );
+                pCursor->m_astrHeaders.Push( CSQLiteCursor::ColumnHeader( astrHeaders[ nCount ] ) );
             }
         }
 
@@ -22,6 +22,7 @@
 #include "sqlite3.h"
 #include "Sqlt_Database.h"
 #include "Sqlt_Connection.h"
+#include "Sqlt_BulkCopyConnection.h"
 
 namespace IASLib
 {
@@ -83,20 +84,28 @@ namespace IASLib
 	    return pNewCon;
     }
 
+    /**
+     * BulkCopyConnection
+     *
+     *      Opens a connection for bulk loading the database file. It isn't
+     * one of the database's connections; the caller deletes it when the
+     * load is done.
+     */
     CBulkCopyConnection *CSQLiteDatabase::BulkCopyConnection( const char *strDBName, const char *strUserName, const char *strPassword, const char *strApplication, const char *strName )
     {
 #ifndef IASLIB_NO_LINT__
-        strName = strName;
         strApplication = strApplication;
         strPassword = strPassword;
         strUserName = strUserName;
-        strDBName = strDBName;
 #endif
-	    return NULL;
+        return new CSQLiteBulkCopyConnection( strDBName, strName );
     }
 
     int CSQLiteDatabase::Disconnect( void )
     {
+#ifdef IASLIB_MULTI_THREADED__
+        ClosePool();
+#endif
         m_aConnections.DeleteAll();
         m_nConnections = 0;
 	    return IASLIB_DB_ERROR_OK;
@@ -0,0 +1,295 @@
+/*
+ *  SQL Lite Forward Cursor
+ *
+ *      Forward-only cursor class for SQLite. Unlike CSQLiteCursor, which
+ * collects every row of the result before the caller sees the first, this
+ * cursor steps the underlying statement once per Next(), and only ever
+ * holds the current row, which lives in SQLite's own buffers. Scanning a
+ * table of any size takes the same memory as scanning one row.
+ *      The price is that the cursor can't go back: Prev() and SetRow()
+ * always fail, and Rows() only counts the rows seen so far. Values from
+ * GetText() point into SQLite and are only good until the next Next().
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_DATABASE__
+#ifdef IASLIB_DB_SQLITE__
+
+#include "sqlite3.h"
+#include "Sqlt_ForwardCursor.h"
+#include "Sqlt_Connection.h"
+#include "Sqlt_Statement.h"
+#include "Sqlt_Cursor.h"
+#include "Database.h"
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CSQLiteForwardCursor, CCursor );
+
+    /**
+     * Constructor
+     *
+     *      Runs the statement and moves to the first row, so that, just as
+     * with a buffered cursor, the first row is current straight away.
+     *
+     * @param pStatement
+     *      The statement, with its parameters bound.
+     * @param bOwnsStatement
+     *      Should the cursor close the statement (handing it back to the
+     *      cache) when it's done, or only reset it?
+     */
+    CSQLiteForwardCursor::CSQLiteForwardCursor( CSQLiteStatement *pStatement, bool bOwnsStatement )
+    {
+        m_pStatement = pStatement;
+        m_pConnection = pStatement->m_pConnection;
+        m_bOwnsStatement = bOwnsStatement;
+        m_bHasRow = false;
+        m_bUpdatable = false;
+
+        sqlite3_stmt *pHandle = m_pStatement->GetHandle();
+
+        m_nColumns = (size_t)(*m_pConnection->m_fnSqlColumnCount)( pHandle );
+        for ( size_t nColumn = 0; nColumn < m_nColumns; nColumn++ )
+        {
+            m_astrHeaders.Push( CSQLiteCursor::ColumnHeader( (*m_pConnection->m_fnSqlColumnName)( pHandle, (int)nColumn ) ) );
+        }
+
+        m_bValid = true;
+        if ( Step() )
+        {
+            m_nCurrentRow = 0;
+        }
+    }
+
+    CSQLiteForwardCursor::~CSQLiteForwardCursor( void )
+    {
+        Close();
+    }
+
+    int CSQLiteForwardCursor::Close( void )
+    {
+        if ( m_pStatement )
+        {
+            if ( m_bOwnsStatement )
+            {
+                m_pStatement->Close();
+            }
+            else
+            {
+                m_pStatement->Reset();
+            }
+            m_pStatement = NULL;
+        }
+
+        m_bHasRow = false;
+        m_bValid = false;
+        return 0;
+    }
+
+    int CSQLiteForwardCursor::DeleteRow( const char *strTable )
+    {
+        strTable = strTable; // avoids warnings.
+        return IASLIB_DB_ERROR_UNSUPPORTED;
+    }
+
+    int CSQLiteForwardCursor::InsertRow( const char *strTable )
+    {
+        strTable = strTable; // avoids warnings.
+        return IASLIB_DB_ERROR_UNSUPPORTED;
+    }
+
+    int CSQLiteForwardCursor::UpdateRow( const char *strTable )
+    {
+        strTable = strTable; // avoids warnings.
+        return IASLIB_DB_ERROR_UNSUPPORTED;
+    }
+
+    bool CSQLiteForwardCursor::Next( void )
+    {
+        if ( ! m_bHasRow )
+        {
+            return false;
+        }
+
+        if ( Step() )
+        {
+            m_nCurrentRow++;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * SetRow
+     *
+     *      Only the current row can be "moved" to.
+     */
+    bool CSQLiteForwardCursor::SetRow( size_t nRow )
+    {
+        return ( ( m_bHasRow ) && ( nRow == m_nCurrentRow ) );
+    }
+
+    CString CSQLiteForwardCursor::GetColumn( const char *pszColumn )
+    {
+        size_t nColumn = FindColumn( pszColumn );
+
+        if ( nColumn == NOT_FOUND )
+        {
+            return CString( "" );
+        }
+
+        return GetColumn( nColumn );
+    }
+
+    CString CSQLiteForwardCursor::GetColumn( size_t nColumn )
+    {
+        const char *pchText = GetText( nColumn );
+
+        if ( pchText == NULL )
+        {
+            return CString( "" );
+        }
+
+        return CString( pchText, GetLength( nColumn ) );
+    }
+
+    /**
+     * GetText
+     *
+     *      Returns a column of the current row without copying it. The
+     * pointer belongs to SQLite, and is only good until the next call to
+     * Next(). NULL values (and columns out of range) return NULL.
+     */
+    const char *CSQLiteForwardCursor::GetText( size_t nColumn )
+    {
+        if ( ( ! m_bHasRow ) || ( nColumn >= m_nColumns ) )
+        {
+            return NULL;
+        }
+
+        return (const char *)(*m_pConnection->m_fnSqlColumnText)( m_pStatement->GetHandle(), (int)nColumn );
+    }
+
+    /**
+     * GetLength
+     *
+     *      Returns the length, in bytes, of a column of the current row.
+     * Call this after GetText(), since asking for the text can change it.
+     */
+    size_t CSQLiteForwardCursor::GetLength( size_t nColumn )
+    {
+        if ( ( ! m_bHasRow ) || ( nColumn >= m_nColumns ) )
+        {
+            return 0;
+        }
+
+        return (size_t)(*m_pConnection->m_fnSqlColumnBytes)( m_pStatement->GetHandle(), (int)nColumn );
+    }
+
+    CBaseResult::ColumnType CSQLiteForwardCursor::GetColumnType( size_t nColumn )
+    {
+        if ( ( ! m_bHasRow ) || ( nColumn >= m_nColumns ) )
+        {
+            return COLUMN_NULL;
+        }
+
+        switch ( (*m_pConnection->m_fnSqlColumnType)( m_pStatement->GetHandle(), (int)nColumn ) )
+        {
+            case SQLITE_INTEGER:
+                return COLUMN_INTEGER;
+
+            case SQLITE_FLOAT:
+                return COLUMN_FLOAT;
+
+            case SQLITE_TEXT:
+                return COLUMN_TEXT;
+
+            case SQLITE_BLOB:
+                return COLUMN_BLOB;
+
+            default:
+                return COLUMN_NULL;
+        }
+    }
+
+    long long CSQLiteForwardCursor::GetInt64( size_t nColumn )
+    {
+        if ( ( ! m_bHasRow ) || ( nColumn >= m_nColumns ) )
+        {
+            return 0;
+        }
+
+        return (long long)(*m_pConnection->m_fnSqlColumnInt64)( m_pStatement->GetHandle(), (int)nColumn );
+    }
+
+    double CSQLiteForwardCursor::GetDouble( size_t nColumn )
+    {
+        if ( ( ! m_bHasRow ) || ( nColumn >= m_nColumns ) )
+        {
+            return 0.0;
+        }
+
+        return (*m_pConnection->m_fnSqlColumnDouble)( m_pStatement->GetHandle(), (int)nColumn );
+    }
+
+    /**
+     * GetBlob
+     *
+     *      Returns the raw bytes of a column of the current row. Like
+     * GetText(), the pointer belongs to SQLite.
+     */
+    const void *CSQLiteForwardCursor::GetBlob( size_t nColumn, size_t &nLength )
+    {
+        nLength = 0;
+
+        if ( ( ! m_bHasRow ) || ( nColumn >= m_nColumns ) )
+        {
+            return NULL;
+        }
+
+        const void *pData = (*m_pConnection->m_fnSqlColumnBlob)( m_pStatement->GetHandle(), (int)nColumn );
+        nLength = (size_t)(*m_pConnection->m_fnSqlColumnBytes)( m_pStatement->GetHandle(), (int)nColumn );
+
+        return pData;
+    }
+
+    /**
+     * Step
+     *
+     *      Reads the next row from the database. At the end of the rows, or
+     * on an error, the statement is reset so that it lets go of its locks
+     * without waiting for the cursor to be closed.
+     */
+    bool CSQLiteForwardCursor::Step( void )
+    {
+        int nResult = (*m_pConnection->m_fnSqlStep)( m_pStatement->GetHandle() );
+
+        if ( nResult == SQLITE_ROW )
+        {
+            m_bHasRow = true;
+            m_nRows++;
+            return true;
+        }
+
+        m_bHasRow = false;
+
+        if ( nResult != SQLITE_DONE )
+        {
+            m_pConnection->m_nLastErrorCode = nResult;
+            m_pConnection->SetStatementError();
+            m_bValid = false;
+        }
+
+        m_pStatement->Reset();
+        return false;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_DB_SQLITE__
+#endif // IASLIB_DATABASE__
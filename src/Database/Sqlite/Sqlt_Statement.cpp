@@ -0,0 +1,295 @@
+/*
+ *  SQL Lite Statement
+ *
+ *      Prepared statement class for SQLite. The statement is compiled
+ * once with sqlite3_prepare_v2, and then bound, stepped and reset as
+ * many times as needed. Closing the statement hands it back to its
+ * connection's statement cache, still compiled, for the next caller
+ * that prepares the same SQL.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_DATABASE__
+#ifdef IASLIB_DB_SQLITE__
+
+#include "sqlite3.h"
+#include "Sqlt_Statement.h"
+#include "Sqlt_Connection.h"
+#include "Sqlt_Cursor.h"
+#include "Sqlt_ForwardCursor.h"
+#include "Database.h"
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CSQLiteStatement, CPreparedStatement );
+
+    CSQLiteStatement::CSQLiteStatement( CSQLiteConnection *pConnection, const char *strSQL, sqlite3_stmt *pStatement )
+    {
+        m_pConnection = pConnection;
+        m_pStatement = pStatement;
+        m_strSQL = strSQL;
+        m_nRowsAffected = 0;
+        m_pLruNext = NULL;
+        m_pLruPrev = NULL;
+    }
+
+    CSQLiteStatement::~CSQLiteStatement( void )
+    {
+        if ( m_pStatement )
+        {
+            (*m_pConnection->m_fnSqlFinalize)( m_pStatement );
+            m_pStatement = NULL;
+        }
+    }
+
+    size_t CSQLiteStatement::ParameterCount( void )
+    {
+        return (size_t)(*m_pConnection->m_fnSqlParamCount)( m_pStatement );
+    }
+
+    /**
+     * ParameterIndex
+     *
+     *      Returns the number of a named parameter (including its prefix,
+     * as in ":name"), or 0 if the statement has no such parameter.
+     */
+    size_t CSQLiteStatement::ParameterIndex( const char *strName )
+    {
+        return (size_t)(*m_pConnection->m_fnSqlParamIndex)( m_pStatement, strName );
+    }
+
+    bool CSQLiteStatement::BindNull( size_t nParam )
+    {
+        return CheckBind( (*m_pConnection->m_fnSqlBindNull)( m_pStatement, (int)nParam ) );
+    }
+
+    bool CSQLiteStatement::Bind( size_t nParam, int nValue )
+    {
+        return CheckBind( (*m_pConnection->m_fnSqlBindInt64)( m_pStatement, (int)nParam, (sqlite3_int64)nValue ) );
+    }
+
+    bool CSQLiteStatement::Bind( size_t nParam, long long nValue )
+    {
+        return CheckBind( (*m_pConnection->m_fnSqlBindInt64)( m_pStatement, (int)nParam, (sqlite3_int64)nValue ) );
+    }
+
+    bool CSQLiteStatement::Bind( size_t nParam, double dValue )
+    {
+        return CheckBind( (*m_pConnection->m_fnSqlBindDouble)( m_pStatement, (int)nParam, dValue ) );
+    }
+
+    /**
+     * Bind
+     *
+     *      Binds a string. SQLite takes its own copy, so the value doesn't
+     * have to outlive the call. A NULL pointer binds an SQL NULL.
+     */
+    bool CSQLiteStatement::Bind( size_t nParam, const char *strValue )
+    {
+        if ( strValue == NULL )
+        {
+            return BindNull( nParam );
+        }
+
+        return CheckBind( (*m_pConnection->m_fnSqlBindText)( m_pStatement, (int)nParam, strValue, -1, SQLITE_TRANSIENT ) );
+    }
+
+    bool CSQLiteStatement::Bind( size_t nParam, const char *pchValue, size_t nLength )
+    {
+        return CheckBind( (*m_pConnection->m_fnSqlBindText)( m_pStatement, (int)nParam, pchValue, (int)nLength, SQLITE_TRANSIENT ) );
+    }
+
+    bool CSQLiteStatement::BindBlob( size_t nParam, const void *pData, size_t nLength )
+    {
+        return CheckBind( (*m_pConnection->m_fnSqlBindBlob)( m_pStatement, (int)nParam, pData, (int)nLength, SQLITE_TRANSIENT ) );
+    }
+
+    bool CSQLiteStatement::ClearBindings( void )
+    {
+        return ( (*m_pConnection->m_fnSqlClearBindings)( m_pStatement ) == SQLITE_OK );
+    }
+
+    /**
+     * Execute
+     *
+     *      Runs the statement to completion with the current bindings, and
+     * resets it so it can be run again. Any rows it returns are ignored.
+     * The bindings are kept, so only the values that change need to be
+     * bound for the next run.
+     *
+     * @return
+     *      true if the statement ran.
+     */
+    bool CSQLiteStatement::Execute( void )
+    {
+        m_nRowsAffected = 0;
+
+        if ( ! m_pConnection->OpenTransaction() )
+        {
+            return false;
+        }
+
+        int nResult;
+        do
+        {
+            nResult = (*m_pConnection->m_fnSqlStep)( m_pStatement );
+        } while ( nResult == SQLITE_ROW );
+
+        if ( nResult != SQLITE_DONE )
+        {
+            m_pConnection->m_nLastErrorCode = nResult;
+            m_pConnection->SetStatementError();
+            (*m_pConnection->m_fnSqlReset)( m_pStatement );
+            return false;
+        }
+
+        m_nRowsAffected = (size_t)(*m_pConnection->m_fnSqlChanges)( m_pConnection->m_pSLDatabase );
+        (*m_pConnection->m_fnSqlReset)( m_pStatement );
+        m_pConnection->m_nLastErrorCode = SQLITE_OK;
+
+        return true;
+    }
+
+    /**
+     * Cursor
+     *
+     *      Runs the statement as a query with the current bindings, and
+     * returns all of its rows in a cursor. The values are kept in their
+     * native types, one CColumnBuffer per column, so integers, floats and
+     * blobs come back from the typed getters without being turned into
+     * text and back. The statement is reset afterwards.
+     *
+     * @return
+     *      The cursor (the caller deletes it), or NULL on an error.
+     */
+    CCursor *CSQLiteStatement::Cursor( bool bUpdatable )
+    {
+        CSQLiteCursor  *pCursor = new CSQLiteCursor( m_pConnection, bUpdatable );
+        size_t          nColumns = (size_t)(*m_pConnection->m_fnSqlColumnCount)( m_pStatement );
+
+        pCursor->m_nColumns = nColumns;
+        pCursor->m_apColumns = new CColumnBuffer *[ ( nColumns > 0 ) ? nColumns : 1 ];
+        for ( size_t nColumn = 0; nColumn < nColumns; nColumn++ )
+        {
+            pCursor->m_astrHeaders.Push( CSQLiteCursor::ColumnHeader( (*m_pConnection->m_fnSqlColumnName)( m_pStatement, (int)nColumn ) ) );
+            pCursor->m_apColumns[ nColumn ] = new CColumnBuffer;
+        }
+
+        int nResult;
+        while ( ( nResult = (*m_pConnection->m_fnSqlStep)( m_pStatement ) ) == SQLITE_ROW )
+        {
+            for ( size_t nColumn = 0; nColumn < nColumns; nColumn++ )
+            {
+                CColumnBuffer  *pColumn = pCursor->m_apColumns[ nColumn ];
+                const void     *pData;
+
+                switch ( (*m_pConnection->m_fnSqlColumnType)( m_pStatement, (int)nColumn ) )
+                {
+                    case SQLITE_INTEGER:
+                        pColumn->AppendInt64( (long long)(*m_pConnection->m_fnSqlColumnInt64)( m_pStatement, (int)nColumn ) );
+                        break;
+
+                    case SQLITE_FLOAT:
+                        pColumn->AppendDouble( (*m_pConnection->m_fnSqlColumnDouble)( m_pStatement, (int)nColumn ) );
+                        break;
+
+                    case SQLITE_BLOB:
+                        pData = (*m_pConnection->m_fnSqlColumnBlob)( m_pStatement, (int)nColumn );
+                        pColumn->AppendBlob( pData, (size_t)(*m_pConnection->m_fnSqlColumnBytes)( m_pStatement, (int)nColumn ) );
+                        break;
+
+                    case SQLITE_TEXT:
+                        pData = (*m_pConnection->m_fnSqlColumnText)( m_pStatement, (int)nColumn );
+                        pColumn->AppendText( (const char *)pData, (size_t)(*m_pConnection->m_fnSqlColumnBytes)( m_pStatement, (int)nColumn ) );
+                        break;
+
+                    default:
+                        pColumn->AppendNull();
+                        break;
+                }
+            }
+
+            pCursor->m_nRows++;
+        }
+
+        if ( nResult != SQLITE_DONE )
+        {
+            m_pConnection->m_nLastErrorCode = nResult;
+            m_pConnection->SetStatementError();
+            (*m_pConnection->m_fnSqlReset)( m_pStatement );
+            delete pCursor;
+            return NULL;
+        }
+
+        (*m_pConnection->m_fnSqlReset)( m_pStatement );
+        m_pConnection->m_nLastErrorCode = SQLITE_OK;
+        pCursor->SetValid();
+
+        return pCursor;
+    }
+
+    /**
+     * ForwardCursor
+     *
+     *      Runs the statement as a query with the current bindings, and
+     * returns a forward-only cursor that steps through the rows as they're
+     * read. The statement belongs to the cursor until the cursor is closed
+     * (or deleted), which resets it.
+     *
+     * @return
+     *      The cursor (the caller deletes it), or NULL on an error.
+     */
+    CCursor *CSQLiteStatement::ForwardCursor( void )
+    {
+        CSQLiteForwardCursor *pCursor = new CSQLiteForwardCursor( this, false );
+        if ( ! pCursor->IsValid() )
+        {
+            delete pCursor;
+            return NULL;
+        }
+
+        return pCursor;
+    }
+
+    bool CSQLiteStatement::Reset( void )
+    {
+        m_nRowsAffected = 0;
+        return ( (*m_pConnection->m_fnSqlReset)( m_pStatement ) == SQLITE_OK );
+    }
+
+    long long CSQLiteStatement::LastInsertId( void )
+    {
+        return (long long)(*m_pConnection->m_fnSqlLastRowId)( m_pConnection->m_pSLDatabase );
+    }
+
+    /**
+     * Close
+     *
+     *      Hands the statement back to the connection's cache. The pointer
+     * must not be used again afterwards.
+     */
+    bool CSQLiteStatement::Close( void )
+    {
+        m_pConnection->ReturnStatement( this );
+        return true;
+    }
+
+    bool CSQLiteStatement::CheckBind( int nResult )
+    {
+        if ( nResult != SQLITE_OK )
+        {
+            m_pConnection->m_nLastErrorCode = nResult;
+            m_pConnection->SetStatementError();
+            return false;
+        }
+        return true;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_DB_SQLITE__
+#endif // IASLIB_DATABASE__
@@ -116,6 +116,9 @@ int CSybaseDatabase::ReleaseConnection( CConnection *pCon )
 
 int CSybaseDatabase::Disconnect( void )
 {
+#ifdef IASLIB_MULTI_THREADED__
+    ClosePool();
+#endif
     m_aConnections.DeleteAll();
     m_nConnections = 0;
 	return 0;
@@ -3,6 +3,12 @@
 
 #include "Encryption/Sha256.h"
 
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define IASLIB_SHA256_X86__
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 namespace IASLib
 {
     const uint32 CSHA256::sha256_k[64] = 
@@ -24,51 +30,380 @@ namespace IASLib
                     0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
                     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
                 };
-    
+
+    CSHA256::TransformFunc CSHA256::s_pfnTransform = CSHA256::TransformDispatch;
+    bool CSHA256::s_bMultiBuffer = false;
+
     void CSHA256::transform(const unsigned char *message, unsigned int block_nb)
     {
-        uint32 w[64];
-        uint32 wv[8];
+        (*s_pfnTransform)( m_h, message, block_nb );
+    }
+
+    #define SHA256_ROUND( a, b, c, d, e, f, g, h, i, w )                     \
+    {                                                                       \
+        t1 = h + SHA256_F2( e ) + SHA2_CH( e, f, g ) + sha256_k[i] + (w);   \
+        t2 = SHA256_F1( a ) + SHA2_MAJ( a, b, c );                          \
+        d += t1;                                                            \
+        h = t1 + t2;                                                        \
+    }
+
+    #define SHA256_SCHEDULE( i )                                            \
+        ( w[(i) & 15] += SHA256_F4( w[((i) - 2) & 15] ) + w[((i) - 7) & 15] \
+                         + SHA256_F3( w[((i) - 15) & 15] ) )
+
+    /**
+     * TransformScalar
+     *
+     *      The portable compression function. The working variables stay
+     * in locals and the message schedule in a rolling window of sixteen
+     * words, rather than being copied through arrays for every block.
+     */
+    void CSHA256::TransformScalar( uint32 *pState, const uint8 *pBlocks, size_t nBlocks )
+    {
+        uint32 w[16];
         uint32 t1, t2;
-        const unsigned char *sub_block;
-        int i;
-        int j;
-        for (i = 0; i < (int) block_nb; i++) 
+
+        while ( nBlocks-- )
         {
-            sub_block = message + (i << 6);
-            for (j = 0; j < 16; j++) 
+            uint32 a = pState[0];
+            uint32 b = pState[1];
+            uint32 c = pState[2];
+            uint32 d = pState[3];
+            uint32 e = pState[4];
+            uint32 f = pState[5];
+            uint32 g = pState[6];
+            uint32 h = pState[7];
+
+            for ( int j = 0; j < 16; j++ )
+            {
+                SHA2_PACK32( &pBlocks[j << 2], &w[j] );
+            }
+
+            for ( int i = 0; i < 16; i += 8 )
+            {
+                SHA256_ROUND( a, b, c, d, e, f, g, h, i + 0, w[i + 0] );
+                SHA256_ROUND( h, a, b, c, d, e, f, g, i + 1, w[i + 1] );
+                SHA256_ROUND( g, h, a, b, c, d, e, f, i + 2, w[i + 2] );
+                SHA256_ROUND( f, g, h, a, b, c, d, e, i + 3, w[i + 3] );
+                SHA256_ROUND( e, f, g, h, a, b, c, d, i + 4, w[i + 4] );
+                SHA256_ROUND( d, e, f, g, h, a, b, c, i + 5, w[i + 5] );
+                SHA256_ROUND( c, d, e, f, g, h, a, b, i + 6, w[i + 6] );
+                SHA256_ROUND( b, c, d, e, f, g, h, a, i + 7, w[i + 7] );
+            }
+
+            for ( int i = 16; i < 64; i += 8 )
             {
-                SHA2_PACK32(&sub_block[j << 2], &w[j]);
+                SHA256_ROUND( a, b, c, d, e, f, g, h, i + 0, SHA256_SCHEDULE( i + 0 ) );
+                SHA256_ROUND( h, a, b, c, d, e, f, g, i + 1, SHA256_SCHEDULE( i + 1 ) );
+                SHA256_ROUND( g, h, a, b, c, d, e, f, i + 2, SHA256_SCHEDULE( i + 2 ) );
+                SHA256_ROUND( f, g, h, a, b, c, d, e, i + 3, SHA256_SCHEDULE( i + 3 ) );
+                SHA256_ROUND( e, f, g, h, a, b, c, d, i + 4, SHA256_SCHEDULE( i + 4 ) );
+                SHA256_ROUND( d, e, f, g, h, a, b, c, i + 5, SHA256_SCHEDULE( i + 5 ) );
+                SHA256_ROUND( c, d, e, f, g, h, a, b, i + 6, SHA256_SCHEDULE( i + 6 ) );
+                SHA256_ROUND( b, c, d, e, f, g, h, a, i + 7, SHA256_SCHEDULE( i + 7 ) );
             }
-            for (j = 16; j < 64; j++) 
+
+            pState[0] += a;
+            pState[1] += b;
+            pState[2] += c;
+            pState[3] += d;
+            pState[4] += e;
+            pState[5] += f;
+            pState[6] += g;
+            pState[7] += h;
+
+            pBlocks += SHA224_256_BLOCK_SIZE;
+        }
+    }
+
+#ifdef IASLIB_SHA256_X86__
+        // Four rounds of the SHA extensions' compression, with the message
+        // schedule for later rounds worked out alongside. The sixteen
+        // schedule words in use live in four registers, reused round robin.
+    #define SHA256_NI_ROUNDS( n )                                                           \
+    {                                                                                       \
+        msg = _mm_add_epi32( amsg[(n) & 3], _mm_loadu_si128( (const __m128i *)&sha256_k[(n) * 4] ) ); \
+        state1 = _mm_sha256rnds2_epu32( state1, state0, msg );                             \
+        if ( ( (n) >= 3 ) && ( (n) <= 14 ) )                                                \
+        {                                                                                   \
+            tmp = _mm_alignr_epi8( amsg[(n) & 3], amsg[((n) + 3) & 3], 4 );                 \
+            amsg[((n) + 1) & 3] = _mm_sha256msg2_epu32( _mm_add_epi32( amsg[((n) + 1) & 3], tmp ), amsg[(n) & 3] ); \
+        }                                                                                   \
+        msg = _mm_shuffle_epi32( msg, 0x0E );                                               \
+        state0 = _mm_sha256rnds2_epu32( state0, state1, msg );                             \
+        if ( ( (n) >= 1 ) && ( (n) <= 12 ) )                                                \
+        {                                                                                   \
+            amsg[((n) + 3) & 3] = _mm_sha256msg1_epu32( amsg[((n) + 3) & 3], amsg[(n) & 3] ); \
+        }                                                                                   \
+    }
+
+    /**
+     * TransformShaNi
+     *
+     *      The compression function on the x86 SHA extensions. The
+     * instructions keep the state as ABEF/CDGH pairs, so it's shuffled in
+     * and out of that order around the blocks.
+     */
+    __attribute__(( target( "sha,sse4.1,ssse3" ) ))
+    void CSHA256::TransformShaNi( uint32 *pState, const uint8 *pBlocks, size_t nBlocks )
+    {
+        const __m128i mask = _mm_set_epi64x( 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL );
+        __m128i state0, state1, msg, tmp, save0, save1;
+        __m128i amsg[4];
+
+        tmp = _mm_shuffle_epi32( _mm_loadu_si128( (const __m128i *)&pState[0] ), 0xB1 );
+        state1 = _mm_shuffle_epi32( _mm_loadu_si128( (const __m128i *)&pState[4] ), 0x1B );
+        state0 = _mm_alignr_epi8( tmp, state1, 8 );
+        state1 = _mm_blend_epi16( state1, tmp, 0xF0 );
+
+        while ( nBlocks-- )
+        {
+            save0 = state0;
+            save1 = state1;
+
+            for ( int j = 0; j < 4; j++ )
             {
-                w[j] =  SHA256_F4(w[j -  2]) + w[j -  7] + SHA256_F3(w[j - 15]) + w[j - 16];
+                amsg[j] = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *)( pBlocks + ( j << 4 ) ) ), mask );
             }
-            for (j = 0; j < 8; j++) 
+
+            SHA256_NI_ROUNDS( 0 );
+            SHA256_NI_ROUNDS( 1 );
+            SHA256_NI_ROUNDS( 2 );
+            SHA256_NI_ROUNDS( 3 );
+            SHA256_NI_ROUNDS( 4 );
+            SHA256_NI_ROUNDS( 5 );
+            SHA256_NI_ROUNDS( 6 );
+            SHA256_NI_ROUNDS( 7 );
+            SHA256_NI_ROUNDS( 8 );
+            SHA256_NI_ROUNDS( 9 );
+            SHA256_NI_ROUNDS( 10 );
+            SHA256_NI_ROUNDS( 11 );
+            SHA256_NI_ROUNDS( 12 );
+            SHA256_NI_ROUNDS( 13 );
+            SHA256_NI_ROUNDS( 14 );
+            SHA256_NI_ROUNDS( 15 );
+
+            state0 = _mm_add_epi32( state0, save0 );
+            state1 = _mm_add_epi32( state1, save1 );
+
+            pBlocks += SHA224_256_BLOCK_SIZE;
+        }
+
+        tmp = _mm_shuffle_epi32( state0, 0x1B );
+        state1 = _mm_shuffle_epi32( state1, 0xB1 );
+        state0 = _mm_blend_epi16( tmp, state1, 0xF0 );
+        state1 = _mm_alignr_epi8( state1, tmp, 8 );
+
+        _mm_storeu_si128( (__m128i *)&pState[0], state0 );
+        _mm_storeu_si128( (__m128i *)&pState[4], state1 );
+    }
+
+    #define SHA256_X8_ROTR( x, n )  _mm256_or_si256( _mm256_srli_epi32( x, n ), _mm256_slli_epi32( x, 32 - ( n ) ) )
+    #define SHA256_X8_XOR3( x, y, z ) _mm256_xor_si256( _mm256_xor_si256( x, y ), z )
+    #define SHA256_X8_F1( x )       SHA256_X8_XOR3( SHA256_X8_ROTR( x, 2 ), SHA256_X8_ROTR( x, 13 ), SHA256_X8_ROTR( x, 22 ) )
+    #define SHA256_X8_F2( x )       SHA256_X8_XOR3( SHA256_X8_ROTR( x, 6 ), SHA256_X8_ROTR( x, 11 ), SHA256_X8_ROTR( x, 25 ) )
+    #define SHA256_X8_F3( x )       SHA256_X8_XOR3( SHA256_X8_ROTR( x, 7 ), SHA256_X8_ROTR( x, 18 ), _mm256_srli_epi32( x, 3 ) )
+    #define SHA256_X8_F4( x )       SHA256_X8_XOR3( SHA256_X8_ROTR( x, 17 ), SHA256_X8_ROTR( x, 19 ), _mm256_srli_epi32( x, 10 ) )
+    #define SHA256_X8_CH( x, y, z ) _mm256_xor_si256( _mm256_and_si256( x, y ), _mm256_andnot_si256( x, z ) )
+    #define SHA256_X8_MAJ( x, y, z ) _mm256_or_si256( _mm256_and_si256( x, y ), _mm256_and_si256( z, _mm256_or_si256( x, y ) ) )
+    #define SHA256_X8_ADD( x, y )   _mm256_add_epi32( x, y )
+
+    #define SHA256_X8_ROUND( a, b, c, d, e, f, g, h, i, wi )                                   \
+    {                                                                                       \
+        t1 = SHA256_X8_ADD( SHA256_X8_ADD( h, SHA256_X8_F2( e ) ),                          \
+                            SHA256_X8_ADD( SHA256_X8_CH( e, f, g ),                         \
+                                           SHA256_X8_ADD( _mm256_set1_epi32( (int)sha256_k[i] ), wi ) ) ); \
+        t2 = SHA256_X8_ADD( SHA256_X8_F1( a ), SHA256_X8_MAJ( a, b, c ) );                  \
+        d = SHA256_X8_ADD( d, t1 );                                                         \
+        h = SHA256_X8_ADD( t1, t2 );                                                        \
+    }
+
+    #define SHA256_X8_SCHEDULE( i )                                                         \
+        ( w[(i) & 15] = SHA256_X8_ADD( SHA256_X8_ADD( w[(i) & 15], SHA256_X8_F4( w[((i) - 2) & 15] ) ), \
+                                       SHA256_X8_ADD( w[((i) - 7) & 15], SHA256_X8_F3( w[((i) - 15) & 15] ) ) ) )
+
+    /**
+     * TransformAvx2x8
+     *
+     *      Runs one block of each of eight messages through the compression
+     * function at once, one message per AVX2 lane.
+     *
+     * @param pStates
+     *      The eight states, word by word: the first word of all eight
+     *      messages, then the second, and so on.
+     * @param apBlocks
+     *      The block for each of the eight messages.
+     */
+    __attribute__(( target( "avx2" ) ))
+    void CSHA256::TransformAvx2x8( uint32 *pStates, const uint8 * const *apBlocks )
+    {
+        const __m256i mask = _mm256_set_epi64x( 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL );
+        __m256i w[16];
+        __m256i t1, t2;
+
+            // Each message's half block is one row; transposing the rows
+            // gives one register per schedule word, across the messages.
+        for ( int nHalf = 0; nHalf < 2; nHalf++ )
+        {
+            __m256i r[8];
+            __m256i t[8];
+            __m256i u[8];
+
+            for ( int j = 0; j < 8; j++ )
             {
-                wv[j] = m_h[j];
+                r[j] = _mm256_shuffle_epi8( _mm256_loadu_si256( (const __m256i *)( apBlocks[j] + ( nHalf << 5 ) ) ), mask );
             }
-            for (j = 0; j < 64; j++) 
+            for ( int j = 0; j < 8; j += 4 )
             {
-                t1 = wv[7] + SHA256_F2(wv[4]) + SHA2_CH(wv[4], wv[5], wv[6])
-                    + sha256_k[j] + w[j];
-                t2 = SHA256_F1(wv[0]) + SHA2_MAJ(wv[0], wv[1], wv[2]);
-                wv[7] = wv[6];
-                wv[6] = wv[5];
-                wv[5] = wv[4];
-                wv[4] = wv[3] + t1;
-                wv[3] = wv[2];
-                wv[2] = wv[1];
-                wv[1] = wv[0];
-                wv[0] = t1 + t2;
+                t[j + 0] = _mm256_unpacklo_epi32( r[j + 0], r[j + 1] );
+                t[j + 1] = _mm256_unpackhi_epi32( r[j + 0], r[j + 1] );
+                t[j + 2] = _mm256_unpacklo_epi32( r[j + 2], r[j + 3] );
+                t[j + 3] = _mm256_unpackhi_epi32( r[j + 2], r[j + 3] );
+                u[j + 0] = _mm256_unpacklo_epi64( t[j + 0], t[j + 2] );
+                u[j + 1] = _mm256_unpackhi_epi64( t[j + 0], t[j + 2] );
+                u[j + 2] = _mm256_unpacklo_epi64( t[j + 1], t[j + 3] );
+                u[j + 3] = _mm256_unpackhi_epi64( t[j + 1], t[j + 3] );
             }
-            for (j = 0; j < 8; j++) 
+            for ( int j = 0; j < 4; j++ )
             {
-                m_h[j] += wv[j];
+                w[( nHalf << 3 ) + j] = _mm256_permute2x128_si256( u[j], u[j + 4], 0x20 );
+                w[( nHalf << 3 ) + j + 4] = _mm256_permute2x128_si256( u[j], u[j + 4], 0x31 );
             }
         }
+
+        __m256i a = _mm256_loadu_si256( (const __m256i *)&pStates[0] );
+        __m256i b = _mm256_loadu_si256( (const __m256i *)&pStates[8] );
+        __m256i c = _mm256_loadu_si256( (const __m256i *)&pStates[16] );
+        __m256i d = _mm256_loadu_si256( (const __m256i *)&pStates[24] );
+        __m256i e = _mm256_loadu_si256( (const __m256i *)&pStates[32] );
+        __m256i f = _mm256_loadu_si256( (const __m256i *)&pStates[40] );
+        __m256i g = _mm256_loadu_si256( (const __m256i *)&pStates[48] );
+        __m256i h = _mm256_loadu_si256( (const __m256i *)&pStates[56] );
+
+        for ( int i = 0; i < 16; i += 8 )
+        {
+            SHA256_X8_ROUND( a, b, c, d, e, f, g, h, i + 0, w[i + 0] );
+            SHA256_X8_ROUND( h, a, b, c, d, e, f, g, i + 1, w[i + 1] );
+            SHA256_X8_ROUND( g, h, a, b, c, d, e, f, i + 2, w[i + 2] );
+            SHA256_X8_ROUND( f, g, h, a, b, c, d, e, i + 3, w[i + 3] );
+            SHA256_X8_ROUND( e, f, g, h, a, b, c, d, i + 4, w[i + 4] );
+            SHA256_X8_ROUND( d, e, f, g, h, a, b, c, i + 5, w[i + 5] );
+            SHA256_X8_ROUND( c, d, e, f, g, h, a, b, i + 6, w[i + 6] );
+            SHA256_X8_ROUND( b, c, d, e, f, g, h, a, i + 7, w[i + 7] );
+        }
+
+        for ( int i = 16; i < 64; i += 8 )
+        {
+            SHA256_X8_ROUND( a, b, c, d, e, f, g, h, i + 0, SHA256_X8_SCHEDULE( i + 0 ) );
+            SHA256_X8_ROUND( h, a, b, c, d, e, f, g, i + 1, SHA256_X8_SCHEDULE( i + 1 ) );
+            SHA256_X8_ROUND( g, h, a, b, c, d, e, f, i + 2, SHA256_X8_SCHEDULE( i + 2 ) );
+            SHA256_X8_ROUND( f, g, h, a, b, c, d, e, i + 3, SHA256_X8_SCHEDULE( i + 3 ) );
+            SHA256_X8_ROUND( e, f, g, h, a, b, c, d, i + 4, SHA256_X8_SCHEDULE( i + 4 ) );
+            SHA256_X8_ROUND( d, e, f, g, h, a, b, c, i + 5, SHA256_X8_SCHEDULE( i + 5 ) );
+            SHA256_X8_ROUND( c, d, e, f, g, h, a, b, i + 6, SHA256_X8_SCHEDULE( i + 6 ) );
+            SHA256_X8_ROUND( b, c, d, e, f, g, h, a, i + 7, SHA256_X8_SCHEDULE( i + 7 ) );
+        }
+
+        _mm256_storeu_si256( (__m256i *)&pStates[0], SHA256_X8_ADD( a, _mm256_loadu_si256( (const __m256i *)&pStates[0] ) ) );
+        _mm256_storeu_si256( (__m256i *)&pStates[8], SHA256_X8_ADD( b, _mm256_loadu_si256( (const __m256i *)&pStates[8] ) ) );
+        _mm256_storeu_si256( (__m256i *)&pStates[16], SHA256_X8_ADD( c, _mm256_loadu_si256( (const __m256i *)&pStates[16] ) ) );
+        _mm256_storeu_si256( (__m256i *)&pStates[24], SHA256_X8_ADD( d, _mm256_loadu_si256( (const __m256i *)&pStates[24] ) ) );
+        _mm256_storeu_si256( (__m256i *)&pStates[32], SHA256_X8_ADD( e, _mm256_loadu_si256( (const __m256i *)&pStates[32] ) ) );
+        _mm256_storeu_si256( (__m256i *)&pStates[40], SHA256_X8_ADD( f, _mm256_loadu_si256( (const __m256i *)&pStates[40] ) ) );
+        _mm256_storeu_si256( (__m256i *)&pStates[48], SHA256_X8_ADD( g, _mm256_loadu_si256( (const __m256i *)&pStates[48] ) ) );
+        _mm256_storeu_si256( (__m256i *)&pStates[56], SHA256_X8_ADD( h, _mm256_loadu_si256( (const __m256i *)&pStates[56] ) ) );
     }
-    
+#else
+    void CSHA256::TransformShaNi( uint32 *pState, const uint8 *pBlocks, size_t nBlocks )
+    {
+        TransformScalar( pState, pBlocks, nBlocks );
+    }
+
+        // Never selected without the x86 intrinsics.
+    void CSHA256::TransformAvx2x8( uint32 *, const uint8 * const * )
+    {
+    }
+#endif // IASLIB_SHA256_X86__
+
+    /**
+     * SelectTransform
+     *
+     *      Picks the compression functions for this processor.
+     *
+     * @param bEnable
+     *      false to use the portable code whatever the processor has.
+     */
+    void CSHA256::SelectTransform( bool bEnable )
+    {
+        bool bShaNi = false;
+        bool bAvx2 = false;
+
+#ifdef IASLIB_SHA256_X86__
+        unsigned int nEAX, nEBX, nECX, nEDX;
+
+        if ( ( bEnable ) && ( __get_cpuid( 1, &nEAX, &nEBX, &nECX, &nEDX ) ) )
+        {
+            bool bSse41 = ( ( nECX & bit_SSE4_1 ) != 0 );
+            bool bSsse3 = ( ( nECX & bit_SSSE3 ) != 0 );
+            bool bYmmSaved = false;
+
+                // AVX2 also needs the OS to save the YMM registers
+            if ( nECX & bit_OSXSAVE )
+            {
+                unsigned int nXCR0Low, nXCR0High;
+                __asm__ ( "xgetbv" : "=a" ( nXCR0Low ), "=d" ( nXCR0High ) : "c" ( 0 ) );
+                bYmmSaved = ( ( nXCR0Low & 0x06 ) == 0x06 );
+            }
+
+            if ( __get_cpuid_count( 7, 0, &nEAX, &nEBX, &nECX, &nEDX ) )
+            {
+                bShaNi = ( ( nEBX & bit_SHA ) != 0 ) && bSse41 && bSsse3;
+                bAvx2 = ( ( nEBX & bit_AVX2 ) != 0 ) && bYmmSaved;
+            }
+        }
+#else
+        bEnable = bEnable; // Only the x86 build has kernels to choose from
+#endif
+
+        s_pfnTransform = ( bShaNi ) ? TransformShaNi : TransformScalar;
+
+            // With the SHA extensions, one message at a time is already
+            // faster than eight at once on the vector units.
+        s_bMultiBuffer = ( bAvx2 && ! bShaNi );
+    }
+
+    void CSHA256::TransformDispatch( uint32 *pState, const uint8 *pBlocks, size_t nBlocks )
+    {
+        SelectTransform( true );
+        (*s_pfnTransform)( pState, pBlocks, nBlocks );
+    }
+
+    /**
+     * SetAcceleration
+     *
+     *      Turns the hardware compression functions on (the default, where
+     * the processor has them) or off.
+     */
+    void CSHA256::SetAcceleration( bool bEnable )
+    {
+        SelectTransform( bEnable );
+    }
+
+    const char *CSHA256::GetImplementation( void )
+    {
+        if ( s_pfnTransform == TransformDispatch )
+        {
+            SelectTransform( true );
+        }
+
+        if ( s_pfnTransform == TransformShaNi )
+        {
+            return "sha-ni";
+        }
+
+        return ( s_bMultiBuffer ) ? "scalar+avx2" : "scalar";
+    }
+
     void CSHA256::init()
     {
         m_h[0] = 0x6a09e667;
@@ -103,14 +438,14 @@ namespace IASLib
         rem_len = new_len % SHA224_256_BLOCK_SIZE;
         memcpy(m_block, &shifted_message[block_nb << 6], rem_len);
         m_len = rem_len;
-        m_tot_len += (block_nb + 1) << 6;
+        m_tot_len += (uint64)(block_nb + 1) << 6;
     }
     
     void CSHA256::final(unsigned char *digest)
     {
         unsigned int block_nb;
         unsigned int pm_len;
-        unsigned int len_b;
+        uint64 len_b;
         int i;
         block_nb = (1 + ((SHA224_256_BLOCK_SIZE - 9)
                         < (m_len % SHA224_256_BLOCK_SIZE)));
@@ -118,7 +453,8 @@ namespace IASLib
         pm_len = block_nb << 6;
         memset(m_block + m_len, 0, pm_len - m_len);
         m_block[m_len] = 0x80;
-        SHA2_UNPACK32(len_b, m_block + pm_len - 4);
+        SHA2_UNPACK32((uint32)(len_b >> 32), m_block + pm_len - 8);
+        SHA2_UNPACK32((uint32)len_b, m_block + pm_len - 4);
         transform(m_block, block_nb);
         for (i = 0 ; i < 8; i++) {
             SHA2_UNPACK32(m_h[i], &digest[i << 2]);
@@ -128,18 +464,200 @@ namespace IASLib
     CString CSHA256::StringDigest(CString &input)
     {
         unsigned char digest[CSHA256::DIGEST_SIZE];
-        memset(digest,0,CSHA256::DIGEST_SIZE);
-    
-        CSHA256 ctx = CSHA256();
-        ctx.init();
-        ctx.update( (unsigned char*)input.getBytes(), input.Length());
-        ctx.final(digest);
-    
         char buf[2*CSHA256::DIGEST_SIZE+1];
-        buf[2*CSHA256::DIGEST_SIZE] = 0;
-        for (uint32 i = 0; i < CSHA256::DIGEST_SIZE; i++)
-            sprintf(buf+i*2, "%02x", digest[i]);
+
+        Digest( input.getBytes(), input.Length(), digest );
+        HexDigest( digest, buf );
         return CString(buf);
     }
 
+    /**
+     * PadTail
+     *
+     *      Builds the last block (or two) of a message: whatever is left
+     * over after the whole blocks, the padding, and the length in bits.
+     *
+     * @param pTail
+     *      Where the blocks go; room for two blocks.
+     * @return
+     *      The number of blocks in the tail.
+     */
+    size_t CSHA256::PadTail( const uint8 *pRemainder, size_t nRemaining, uint64 ullTotal, uint8 *pTail )
+    {
+        size_t nBlocks = ( nRemaining + 9 > SHA224_256_BLOCK_SIZE ) ? 2 : 1;
+        size_t nLength = nBlocks * SHA224_256_BLOCK_SIZE;
+        uint64 ullBits = ullTotal << 3;
+
+        memcpy( pTail, pRemainder, nRemaining );
+        memset( pTail + nRemaining, 0, nLength - nRemaining );
+        pTail[nRemaining] = 0x80;
+        SHA2_UNPACK32( (uint32)( ullBits >> 32 ), pTail + nLength - 8 );
+        SHA2_UNPACK32( (uint32)ullBits, pTail + nLength - 4 );
+
+        return nBlocks;
+    }
+
+    /**
+     * Digest
+     *
+     *      Hashes a whole message in one call.
+     *
+     * @param pDigest
+     *      Where the DIGEST_SIZE bytes of the digest go.
+     */
+    void CSHA256::Digest( const void *pData, size_t nLength, uint8 *pDigest )
+    {
+        const uint8 *pBytes = (const uint8 *)pData;
+        size_t nFull = nLength / SHA224_256_BLOCK_SIZE;
+        uint8 aTail[2 * SHA224_256_BLOCK_SIZE];
+        uint32 aState[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                             0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+        if ( nFull )
+        {
+            (*s_pfnTransform)( aState, pBytes, nFull );
+        }
+
+        size_t nDone = nFull * SHA224_256_BLOCK_SIZE;
+        size_t nTail = PadTail( pBytes + nDone, nLength - nDone, nLength, aTail );
+        (*s_pfnTransform)( aState, aTail, nTail );
+
+        for ( int i = 0; i < 8; i++ )
+        {
+            SHA2_UNPACK32( aState[i], &pDigest[i << 2] );
+        }
+    }
+
+    /**
+     * DigestMany
+     *
+     *      Hashes a batch of independent messages. Where the multi-buffer
+     * code is in use, the messages go through eight at a time, for as many
+     * blocks as all eight have; each one's remaining blocks are finished on
+     * its own.
+     *
+     * @param apData
+     *      The messages.
+     * @param anLengths
+     *      Their lengths, in bytes.
+     * @param pDigests
+     *      Where the digests go, DIGEST_SIZE bytes each, in order.
+     * @param nCount
+     *      The number of messages.
+     */
+    void CSHA256::DigestMany( const uint8 * const *apData, const size_t *anLengths, uint8 *pDigests, size_t nCount )
+    {
+        if ( s_pfnTransform == TransformDispatch )
+        {
+            SelectTransform( true );
+        }
+
+        size_t nMessage = 0;
+
+        if ( s_bMultiBuffer )
+        {
+            uint32 aStates[64];
+            uint8 aaTails[8][2 * SHA224_256_BLOCK_SIZE];
+            size_t anFull[8];
+            size_t anBlocks[8];
+            const uint8 *apBlocks[8];
+
+            while ( nCount - nMessage >= 2 )
+            {
+                size_t nLanes = ( nCount - nMessage < 8 ) ? ( nCount - nMessage ) : 8;
+                size_t nCommon = (size_t)-1;
+
+                for ( size_t nLane = 0; nLane < 8; nLane++ )
+                {
+                        // Spare lanes just repeat the first message
+                    size_t nSource = nMessage + ( ( nLane < nLanes ) ? nLane : 0 );
+                    size_t nLength = anLengths[nSource];
+
+                    anFull[nLane] = nLength / SHA224_256_BLOCK_SIZE;
+                    size_t nDone = anFull[nLane] * SHA224_256_BLOCK_SIZE;
+                    anBlocks[nLane] = anFull[nLane] + PadTail( apData[nSource] + nDone, nLength - nDone, nLength, aaTails[nLane] );
+                    if ( anBlocks[nLane] < nCommon )
+                    {
+                        nCommon = anBlocks[nLane];
+                    }
+                }
+
+                aStates[0] = 0x6a09e667;
+                aStates[8] = 0xbb67ae85;
+                aStates[16] = 0x3c6ef372;
+                aStates[24] = 0xa54ff53a;
+                aStates[32] = 0x510e527f;
+                aStates[40] = 0x9b05688c;
+                aStates[48] = 0x1f83d9ab;
+                aStates[56] = 0x5be0cd19;
+                for ( int nWord = 0; nWord < 64; nWord += 8 )
+                {
+                    for ( int nLane = 1; nLane < 8; nLane++ )
+                    {
+                        aStates[nWord + nLane] = aStates[nWord];
+                    }
+                }
+
+                for ( size_t nBlock = 0; nBlock < nCommon; nBlock++ )
+                {
+                    for ( size_t nLane = 0; nLane < 8; nLane++ )
+                    {
+                        size_t nSource = nMessage + ( ( nLane < nLanes ) ? nLane : 0 );
+                        apBlocks[nLane] = ( nBlock < anFull[nLane] ) ? apData[nSource] + nBlock * SHA224_256_BLOCK_SIZE : aaTails[nLane] + ( nBlock - anFull[nLane] ) * SHA224_256_BLOCK_SIZE;
+                    }
+                    TransformAvx2x8( aStates, apBlocks );
+                }
+
+                for ( size_t nLane = 0; nLane < nLanes; nLane++ )
+                {
+                    uint32 aState[8];
+                    uint8 *pDigest = pDigests + ( nMessage + nLane ) * DIGEST_SIZE;
+
+                    for ( int nWord = 0; nWord < 8; nWord++ )
+                    {
+                        aState[nWord] = aStates[( nWord << 3 ) + nLane];
+                    }
+
+                    for ( size_t nBlock = nCommon; nBlock < anBlocks[nLane]; nBlock++ )
+                    {
+                        const uint8 *pBlock = ( nBlock < anFull[nLane] ) ? apData[nMessage + nLane] + nBlock * SHA224_256_BLOCK_SIZE : aaTails[nLane] + ( nBlock - anFull[nLane] ) * SHA224_256_BLOCK_SIZE;
+                        (*s_pfnTransform)( aState, pBlock, 1 );
+                    }
+
+                    for ( int nWord = 0; nWord < 8; nWord++ )
+                    {
+                        SHA2_UNPACK32( aState[nWord], &pDigest[nWord << 2] );
+                    }
+                }
+
+                nMessage += nLanes;
+            }
+        }
+
+        for ( ; nMessage < nCount; nMessage++ )
+        {
+            Digest( apData[nMessage], anLengths[nMessage], pDigests + nMessage * DIGEST_SIZE );
+        }
+    }
+
+    /**
+     * HexDigest
+     *
+     *      Formats a digest as lower case hex.
+     *
+     * @param strHex
+     *      Where the text goes; room for 2 * DIGEST_SIZE + 1 characters.
+     */
+    void CSHA256::HexDigest( const uint8 *pDigest, char *strHex )
+    {
+        static const char achHex[] = "0123456789abcdef";
+
+        for ( uint32 i = 0; i < DIGEST_SIZE; i++ )
+        {
+            strHex[i << 1] = achHex[pDigest[i] >> 4];
+            strHex[( i << 1 ) + 1] = achHex[pDigest[i] & 0x0F];
+        }
+        strHex[DIGEST_SIZE << 1] = 0;
+    }
+
 }; // namespace IASLib
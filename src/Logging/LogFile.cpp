@@ -17,6 +17,7 @@
 
 
 #include "LogFile.h"
+#include <string.h>
 #ifndef IASLIB_WIN32__
 #include <stdarg.h>
 #else
@@ -54,19 +55,22 @@ namespace IASLib
 
     bool CLogFile::writeLine( const char *message )
     {
+        bool bRetVal = false;
+
         if ( m_fileOutputFile )
         {
+            int nLength = (int)strlen( message );
 #ifdef IASLIB_MULTI_THREADED__            
             m_mutexProtect.Lock();
 #endif
-            m_fileOutputFile->WriteString( message );
-            m_fileOutputFile->WriteString( "\n" );
+            bRetVal = ( m_fileOutputFile->Write( message, nLength ) == nLength );
+            bRetVal = ( m_fileOutputFile->Write( "\n", 1 ) == 1 ) && bRetVal;
 #ifdef IASLIB_MULTI_THREADED__            
             m_mutexProtect.Unlock();
 #endif
         }
 
-        return true;
+        return bRetVal;
     }
    
 } // namespace IASLib
@@ -15,6 +15,7 @@
 ***********************************************************************/
 
 #include "LogSink.h"
+#include "../Stats/Metrics.h"
 
 #ifndef IASLIB_WIN32__
 #include <stdarg.h>
@@ -29,6 +30,20 @@ namespace IASLib
 
     CLogSink *CLogSink::m_instance = NULL;
 
+#ifdef IASLIB_STATS__
+    static CCounter *LinesWritten( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_log_lines_total", "Log lines written." );
+        return s_pCounter;
+    }
+
+    static CCounter *LinesDropped( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_log_dropped_lines_total", "Log lines that couldn't be written." );
+        return s_pCounter;
+    }
+#endif
+
     CLogSink *CLogSink::getInstance( void )
     {
         return m_instance;
@@ -67,7 +82,18 @@ namespace IASLib
             CDate   now;
             CString workString;
             workString.Format( "%s: [%s] - %s:%d - %s", (const char *)now.FormatDate( CDate::DF_ISO_8601_MS ), logLevelToString( logLevel ), (const char *)filename, nLineNum, szBuffer );
+#ifdef IASLIB_STATS__
+            if ( ! writeLine( workString ) )
+            {
+                LinesDropped()->Add();
+                return false;
+            }
+
+            LinesWritten()->Add();
+            return true;
+#else
             return writeLine( workString );
+#endif
         }
         return false;
     }
@@ -3,10 +3,16 @@
 **
 **  Description:
 **      This class defines a log file that can be written to for
-** tracking data. After a set interval, the log file will roll-over to a
-** new log file. The log file format uses a template for the log name
-** which can contain a {date} field that will be filled with an ISO-9601 
-** date value. 
+** tracking data. After a set interval, or once it grows past a set size,
+** the log file will roll-over to a new log file. The log file format
+** uses a template for the log name which can contain a {date}, {time} or
+** {datetime} field; each new file is named from the template as it's
+** opened. A template with none of them names the live file itself, and
+** a finished file is renamed to the template with "_{datetime}" added
+** before the extension.
+**      Finished files are found again by the template, with its fields
+** (or the added "_{datetime}") as wildcards, so the ones left behind by
+** an earlier run are compressed and pruned as well.
 **
 **  Author: Jeffrey R. Naujok
 **  Created: September 10, 2019
@@ -16,59 +22,148 @@
 ***********************************************************************/
 
 #include "RotatingLogFile.h"
+#include "../Files/Directory.h"
+#include <string.h>
+#include <sys/stat.h>
+#ifdef IASLIB_WIN32__
+#include <io.h>
+#include <sys/utime.h>
+#else
+#include <unistd.h>
+#include <utime.h>
+#endif
+#ifdef IASLIB_ZLIB__
+#include <zlib.h>
+#endif
 
 namespace IASLib
-{ 
+{
 
 IMPLEMENT_OBJECT( CRotatingLogFile, CLogSink );
 
-CRotatingLogFile::CRotatingLogFile( Level level, const char *strFileNameTemplate, Interval rotationInterval, int nFilesToKeep, bool bAutoFlush ) : CLogSink( level )
-#ifdef IASLIB_MULTI_THREADED__            
-        , m_mutexProtect()
+    // Where the file name starts in a path.
+static size_t FileNameStart( const CString &strPath )
+{
+    size_t nSlash = strPath.LastIndexOf( '/' );
+#ifdef IASLIB_WIN32__
+    size_t nBackslash = strPath.LastIndexOf( '\\' );
+    if ( ( nBackslash != NOT_FOUND ) && ( ( nSlash == NOT_FOUND ) || ( nBackslash > nSlash ) ) )
+    {
+        nSlash = nBackslash;
+    }
 #endif
+    return ( nSlash == NOT_FOUND ) ? 0 : nSlash + 1;
+}
+
+    // Where the extension (with its dot) starts in a path, or its length
+    // if the file name hasn't one.
+static size_t ExtensionStart( const CString &strPath )
 {
-    m_lastChanged = CDate::ParseGMT( "1970-01-01 00:00:00" );
-    m_nFilesToKeep = nFilesToKeep;
+    size_t nDot = strPath.LastIndexOf( '.' );
+    if ( ( nDot == NOT_FOUND ) || ( nDot < FileNameStart( strPath ) ) )
+    {
+        return strPath.GetLength();
+    }
+    return nDot;
+}
+
+static bool FileExists( const char *strFileName )
+{
+#ifdef IASLIB_WIN32__
+    return ( _access( strFileName, 0 ) == 0 );
+#else
+    return ( access( strFileName, F_OK ) == 0 );
+#endif
+}
+
+CRotatingLogFile::CRotatingLogFile( Level level, const char *strFileNameTemplate, Interval rotationInterval, int nFilesToKeep, bool bAutoFlush, size_t nMaxFileBytes ) : CLogSink( level )
+#ifdef IASLIB_MULTI_THREADED__
+        , m_mutexProtect(), m_semRotate( 0 )
+#endif
+{
+    m_fileOutputFile = NULL;
+    m_nFilesToKeep = ( nFilesToKeep > 0 ) ? (size_t)nFilesToKeep : 0;
+    m_nMaxFileBytes = nMaxFileBytes;
+    m_nBytesWritten = 0;
+    m_ullMaxTotalBytes = 0;
+    m_tNextRotation = 0;
     m_bAutoFlush = bAutoFlush;
+    m_bCompress = true;
+    m_bRotateRequested = false;
+    m_bCleanupPending = true;
     m_rotationInterval = rotationInterval;
-    m_nCurrentDay = -1;
-    m_nCurrentDOW = -1;
-    m_nCurrentHour = -1;
-    m_nCurrentMonth = -1;
-    switch ( rotationInterval )
-    {
-        case HOURLY:
-            m_nInterval = 3600;
-            break;
 
-        case DAILY:
-        case WEEKLY:
-        case MONTHLY:
-            m_nInterval = 86400;
-            break;
+    m_strFileNameTemplate = strFileNameTemplate;
+    m_bFixedName = ( ! m_strFileNameTemplate.Contains( "{date}" ) ) &&
+                   ( ! m_strFileNameTemplate.Contains( "{time}" ) ) &&
+                   ( ! m_strFileNameTemplate.Contains( "{datetime}" ) );
 
-        default:
-            m_nInterval = 86400;
-            break;
+        // The finished files, with anything after them (the ".gz", or a
+        // "_1" to tell apart two made in the same second).
+    size_t nNameStart = FileNameStart( m_strFileNameTemplate );
+    if ( m_bFixedName )
+    {
+        size_t nExtension = ExtensionStart( m_strFileNameTemplate );
+        m_strSegmentFilter = m_strFileNameTemplate.Substring( nNameStart, (int)( nExtension - nNameStart ) );
+        m_strSegmentFilter += "_*";
+        m_strSegmentFilter += m_strFileNameTemplate.Substring( nExtension );
+    }
+    else
+    {
+        m_strSegmentFilter = m_strFileNameTemplate.Substring( nNameStart );
+        m_strSegmentFilter.Replace( "{datetime}", "*" );
+        m_strSegmentFilter.Replace( "{date}", "*" );
+        m_strSegmentFilter.Replace( "{time}", "*" );
     }
+    m_strSegmentFilter += "*";
 
-    m_strFileNameTemplate = strFileNameTemplate;
     rotateLog();
+
+#ifdef IASLIB_MULTI_THREADED__
+    m_pRotator = NULL;
+    if ( CThread::IsAvailable() )
+    {
+        m_pRotator = new CLogRotator( this );
+        if ( ! m_pRotator->IsContained() )
+        {
+            delete m_pRotator;
+            m_pRotator = NULL;
+        }
+    }
+
+    if ( m_pRotator == NULL )
+    {
+        housekeeping();
+    }
+#else
+    housekeeping();
+#endif
 }
 
 CRotatingLogFile::~CRotatingLogFile( void )
 {
-    if ( m_fileOutputFile ) 
+#ifdef IASLIB_MULTI_THREADED__
+    if ( m_pRotator )
+    {
+        m_pRotator->RequestShutdown();
+        m_semRotate.Post();
+        m_pRotator->Join();
+        delete m_pRotator;
+        m_pRotator = NULL;
+    }
+#endif
+
+    if ( m_fileOutputFile )
     {
 #ifdef IASLIB_MULTI_THREADED__
         m_mutexProtect.Lock();
-#endif        
+#endif
         m_fileOutputFile->Close();
         delete m_fileOutputFile;
         m_fileOutputFile = NULL;
 #ifdef IASLIB_MULTI_THREADED__
         m_mutexProtect.Unlock();
-#endif        
+#endif
     }
 }
 
@@ -77,154 +172,447 @@ void CRotatingLogFile::setAutoFlush( bool bAutoFlush )
     m_bAutoFlush = bAutoFlush;
 }
 
+CString CRotatingLogFile::getCurrentFileName( void )
+{
+#ifdef IASLIB_MULTI_THREADED__
+    m_mutexProtect.Lock();
+#endif
+    CString strRetVal = m_strCurrentName;
+#ifdef IASLIB_MULTI_THREADED__
+    m_mutexProtect.Unlock();
+#endif
+    return strRetVal;
+}
+
+    // With a rotator thread, nothing here but the write: a file that's
+    // grown too big is only noted, and the thread woken to deal with it.
+    // Without one, the write that finds rotation due does it.
 bool CRotatingLogFile::writeLine( const char *message )
 {
-    rotateLog();
+    size_t nLength = strlen( message );
+    bool bRotate = false;
+    bool bRetVal = false;
+
+#ifdef IASLIB_MULTI_THREADED__
+    m_mutexProtect.Lock();
+#endif
     if ( m_fileOutputFile )
     {
+        bRetVal = ( m_fileOutputFile->Write( message, (int)nLength ) == (int)nLength );
+        bRetVal = ( m_fileOutputFile->Write( "\n", 1 ) == 1 ) && bRetVal;
+        m_nBytesWritten += nLength + 1;
+        if ( m_bAutoFlush )
+        {
+            m_fileOutputFile->Flush();
+        }
+
+        if ( ( m_nMaxFileBytes ) && ( m_nBytesWritten >= m_nMaxFileBytes ) && ( ! m_bRotateRequested ) )
+        {
+            m_bRotateRequested = true;
+            bRotate = true;
+        }
+    }
 #ifdef IASLIB_MULTI_THREADED__
-        m_mutexProtect.Lock();
-#endif        
-        m_fileOutputFile->WriteString( message );
-        m_fileOutputFile->WriteString( "\n" );
-        m_fileOutputFile->Flush();
+    m_mutexProtect.Unlock();
+
+    if ( m_pRotator )
+    {
+        if ( bRotate )
+        {
+            m_semRotate.Post();
+        }
+    }
+    else if ( ( bRotate ) || ( rotationDue() ) )
+    {
+        m_mutexHousekeeping.Lock();
+        housekeeping();
+        m_mutexHousekeeping.Unlock();
+    }
+#else
+    if ( ( bRotate ) || ( rotationDue() ) )
+    {
+        housekeeping();
+    }
+#endif
+
+    return bRetVal;
+}
+
+    // Whatever's due: rotating, flushing what the writers left in the
+    // buffer, and compressing and pruning the finished files.
+void CRotatingLogFile::housekeeping( void )
+{
+    if ( rotationDue() )
+    {
+        rotateLog();
+    }
+
 #ifdef IASLIB_MULTI_THREADED__
+    if ( ! m_bAutoFlush )
+    {
+        m_mutexProtect.Lock();
+        if ( m_fileOutputFile )
+        {
+            m_fileOutputFile->Flush();
+        }
         m_mutexProtect.Unlock();
-#endif        
     }
+#endif
 
-    return true;
+    if ( m_bCleanupPending )
+    {
+        m_bCleanupPending = false;
+        cleanUp();
+    }
+}
+
+bool CRotatingLogFile::rotationDue( void )
+{
+    return ( m_bRotateRequested ) || ( ( m_tNextRotation != 0 ) && ( time( NULL ) >= m_tNextRotation ) );
 }
 
-bool CRotatingLogFile::isPastRotation( void )
+    // Opens the next file and swaps it in; the first time, just opens the
+    // file. Only the swap is done under the writers' lock. If the new file
+    // can't be opened, the old one is kept and it's tried again later.
+bool CRotatingLogFile::rotateLog( void )
 {
     CDate now;
-    bool retVal = false;
+    CString strNewName;
 
-    switch( m_rotationInterval )
+    if ( m_fileOutputFile == NULL )
     {
-        case HOURLY:
-            if ( m_nCurrentHour != now.GetHour() )
-                retVal = true;
-            break;
+        strNewName = nextFileName( now );
+    }
+    else if ( m_bFixedName )
+    {
+            // Writers carry on into the renamed file until the swap.
+        CString strSegment = uniqueFileName( segmentFileName( m_dttOpened ) );
+        if ( ( ! CFile::Rename( m_strCurrentName, strSegment ) ) && ( FileExists( m_strCurrentName ) ) )
+        {
+            return false;
+        }
+        strNewName = m_strFileNameTemplate;
+    }
+    else
+    {
+        strNewName = uniqueFileName( nextFileName( now ) );
+    }
 
-        case DAILY:
-            if ( m_nCurrentDay != now.GetDay() )
-                retVal = true;
-            break;
+    CFile *pNewFile = new CFile( (const char *)strNewName, CFile::APPEND );
+    if ( ! pNewFile->IsOpen() )
+    {
+        delete pNewFile;
+        return false;
+    }
 
-        case WEEKLY:
-            if ( ( m_nCurrentDOW != now.GetDOW() ) && ( now.GetDOW() == 0 ) )
-            {
-                retVal = true;
-            }
-            else
-            {
-                m_nCurrentDOW = now.GetDOW();
-                // Don't bother checking again until tomorrow
-                m_lastChanged.SetToCurrent();
-                m_lastChanged.StartOfDay();
-            }
-            break;
+    long lSize = pNewFile->GetSize();
 
-        case MONTHLY:
-            if ( m_nCurrentMonth != now.GetMonth() )
-                retVal = true;
-            else
-            {
-                // No point checking again until tomorrow
-                m_lastChanged.SetToCurrent();
-                m_lastChanged.StartOfDay();
-            }
-            break;
+#ifdef IASLIB_MULTI_THREADED__
+    m_mutexProtect.Lock();
+#endif
+    CFile *pOldFile = m_fileOutputFile;
+    m_fileOutputFile = pNewFile;
+    m_strCurrentName = strNewName;
+    m_nBytesWritten = ( lSize > 0 ) ? (size_t)lSize : 0;
+    m_bRotateRequested = false;
+#ifdef IASLIB_MULTI_THREADED__
+    m_mutexProtect.Unlock();
+#endif
 
-        default:
-            break;
+    m_dttOpened = now;
+    m_tNextRotation = nextRotation( time( NULL ) );
+
+    if ( pOldFile )
+    {
+        pOldFile->Close();
+        delete pOldFile;
+        m_bCleanupPending = true;
     }
-    return retVal;
+
+    return true;
 }
 
-void CRotatingLogFile::rotateLog( void )
+    // Compresses the finished files that aren't yet, then deletes the
+    // oldest until no more than m_nFilesToKeep (and m_ullMaxTotalBytes, if
+    // it's set) are left.
+void CRotatingLogFile::cleanUp( void )
 {
-    CDate now;
-    now.SetToCurrent();
-    CDate temp = m_lastChanged;
-    temp.Add( 0, 0, m_nInterval );
-    
-    if ( ( m_fileOutputFile == NULL ) 
-         || 
-         ( 
-            ( now >= temp ) 
-               && 
-            isPastRotation() 
-         ) 
-       )
+    size_t nNameStart = FileNameStart( m_strFileNameTemplate );
+    CString strDirectory = ( nNameStart > 0 ) ? m_strFileNameTemplate.Substring( 0, (int)( nNameStart - 1 ) ) : CString( "." );
+    CString strCurrent = m_strCurrentName.Substring( FileNameStart( m_strCurrentName ) );
+
+#ifdef IASLIB_ZLIB__
+    if ( m_bCompress )
     {
-#ifdef IASLIB_MULTI_THREADED__
-        m_mutexProtect.Lock();
-#endif        
-        // Time to rotate logs
-        if ( m_fileOutputFile )   
+        CDirectory dirSegments( strDirectory, m_strSegmentFilter );
+
+        for ( size_t nX = 0; nX < dirSegments.GetEntryCount(); nX++ )
         {
-            m_fileOutputFile->Close();
-            delete m_fileOutputFile;
-            m_fileOutputFile = NULL;
+            CDirectoryEntry *pEntry = dirSegments.GetEntry( nX );
+            if ( ( pEntry->m_bIsDir ) || ( pEntry->m_strFileName == strCurrent ) )
+            {
+                continue;
+            }
+
+            size_t nLength = pEntry->m_strFileName.GetLength();
+            if ( ( ( nLength > 3 ) && ( pEntry->m_strFileName.Substring( nLength - 3 ) == ".gz" ) ) ||
+                 ( ( nLength > 4 ) && ( pEntry->m_strFileName.Substring( nLength - 4 ) == ".tmp" ) ) )
+            {
+                continue;
+            }
+
+            compressFile( pEntry->m_strEntryName );
         }
+    }
+#endif
+
+        // A rotation may have been done while compressing.
+    strCurrent = m_strCurrentName.Substring( FileNameStart( m_strCurrentName ) );
 
-        CString filename( m_strFileNameTemplate );
-        CDate now;
+    CDirectory dirSegments( strDirectory, m_strSegmentFilter );
+    size_t nSegments = dirSegments.GetEntryCount();
+    CDirectoryEntry **apSegments = new CDirectoryEntry *[ nSegments + 1 ];
+    size_t nFound = 0;
+    unsigned long long ullTotalBytes = 0;
 
-        bool found = false;
-        if ( filename.Contains( "{date}" ) )
+        // Oldest first, by the time they were last written to.
+    for ( size_t nX = 0; nX < nSegments; nX++ )
+    {
+        CDirectoryEntry *pEntry = dirSegments.GetEntry( nX );
+        if ( ( pEntry->m_bIsDir ) || ( pEntry->m_strFileName == strCurrent ) )
         {
-            filename.Replace( "{date}", now.FormatDate( CDate::DF_YYYYMMDD ) );
-            found = true;
+            continue;
         }
-        if ( filename.Contains( "{time}" ) )
+
+        size_t nInsert = nFound;
+        while ( ( nInsert > 0 ) && ( pEntry->m_dttLastModified < apSegments[ nInsert - 1 ]->m_dttLastModified ) )
         {
-            filename.Replace( "{time}", now.FormatDate( CDate::DF_HHMMSS ) );
-            found = true;
+            apSegments[ nInsert ] = apSegments[ nInsert - 1 ];
+            nInsert--;
         }
-        if ( filename.Contains( "{datetime}" ) )
+        apSegments[ nInsert ] = pEntry;
+        nFound++;
+        ullTotalBytes += ( pEntry->m_lSize > 0 ) ? (unsigned long long)pEntry->m_lSize : 0;
+    }
+
+    for ( size_t nX = 0; nX < nFound; nX++ )
+    {
+        if ( ( nFound - nX <= m_nFilesToKeep ) && ( ( m_ullMaxTotalBytes == 0 ) || ( ullTotalBytes <= m_ullMaxTotalBytes ) ) )
         {
-            filename.Replace( "{datetime}", now.FormatDate( CDate::DF_YYYYMMDD ) + now.FormatDate( CDate::DF_HHMMSS ) );
-            found = true;
+            break;
         }
-        if ( ! found )
+
+        CFile::Delete( apSegments[ nX ]->m_strEntryName );
+        ullTotalBytes -= ( apSegments[ nX ]->m_lSize > 0 ) ? (unsigned long long)apSegments[ nX ]->m_lSize : 0;
+    }
+
+    delete [] apSegments;
+}
+
+    // Gzips the file into strFileName.gz, by way of a temporary file so a
+    // half-written one is never mistaken for the real thing, and keeps the
+    // original's time so the files stay in order for pruning. Memory used
+    // is the one buffer, and zlib's state, however big the file. A rotation
+    // that comes due meanwhile is done between buffers, so compressing a
+    // big file doesn't let the live one grow past its limit.
+bool CRotatingLogFile::compressFile( const CString &strFileName )
+{
+#ifdef IASLIB_ZLIB__
+    CString strTarget = strFileName + ".gz";
+    CString strTemp = strTarget + ".tmp";
+    char achBuffer[ 65536 ];
+    bool bSuccess = true;
+
+    FILE *fpSource = fopen( strFileName, "rb" );
+    if ( fpSource == NULL )
+    {
+        return false;
+    }
+
+    gzFile gzTarget = gzopen( strTemp, "wb6" );
+    if ( gzTarget == NULL )
+    {
+        fclose( fpSource );
+        return false;
+    }
+
+    size_t nRead;
+    while ( ( nRead = fread( achBuffer, 1, sizeof( achBuffer ), fpSource ) ) > 0 )
+    {
+        if ( gzwrite( gzTarget, achBuffer, (unsigned)nRead ) != (int)nRead )
         {
-            CString fileExt = "";
+            bSuccess = false;
+            break;
+        }
 
-            if ( filename.Contains( "." ) )
-            {
-                size_t last = filename.LastIndexOf( '.' );
-                fileExt = filename.Substring( last );
-                filename = filename.Substring( 0, last );
-            }
-            filename += "_";
-            filename += now.FormatDate( CDate::DF_YYYYMMDD ) + now.FormatDate( CDate::DF_HHMMSS );
-            filename += fileExt;
+        if ( rotationDue() )
+        {
+            rotateLog();
         }
+    }
 
-        m_fileOutputFile = new CFile( (const char *)filename, CFile::APPEND );
+    if ( ferror( fpSource ) )
+    {
+        bSuccess = false;
+    }
+    fclose( fpSource );
+
+    if ( ( gzclose( gzTarget ) != Z_OK ) || ( ! bSuccess ) || ( ! CFile::Rename( strTemp, strTarget ) ) )
+    {
+        CFile::Delete( strTemp );
+        return false;
+    }
+
+    struct stat statSource;
+    if ( stat( strFileName, &statSource ) == 0 )
+    {
+        struct utimbuf utTimes;
+        utTimes.actime = statSource.st_atime;
+        utTimes.modtime = statSource.st_mtime;
+        utime( strTarget, &utTimes );
+    }
+
+    return CFile::Delete( strFileName );
+#else
+    return false;
+#endif
+}
+
+    // The name of the live file opened at the given time.
+CString CRotatingLogFile::nextFileName( const CDate &when )
+{
+    CString filename( m_strFileNameTemplate );
+
+    if ( m_bFixedName )
+    {
+        return filename;
+    }
 
-        switch ( m_rotationInterval )
+    if ( filename.Contains( "{datetime}" ) )
+    {
+        filename.Replace( "{datetime}", when.FormatDate( CDate::DF_YYYYMMDD ) + when.FormatDate( CDate::DF_HHMMSS ) );
+    }
+    if ( filename.Contains( "{date}" ) )
+    {
+        filename.Replace( "{date}", when.FormatDate( CDate::DF_YYYYMMDD ) );
+    }
+    if ( filename.Contains( "{time}" ) )
+    {
+        filename.Replace( "{time}", when.FormatDate( CDate::DF_HHMMSS ) );
+    }
+
+    return filename;
+}
+
+    // The name a finished file of a fixed-name log is renamed to, from when
+    // it was opened.
+CString CRotatingLogFile::segmentFileName( const CDate &when )
+{
+    size_t nExtension = ExtensionStart( m_strFileNameTemplate );
+    CString filename = m_strFileNameTemplate.Substring( 0, (int)nExtension );
+
+    filename += "_";
+    filename += when.FormatDate( CDate::DF_YYYYMMDD ) + when.FormatDate( CDate::DF_HHMMSS );
+    filename += m_strFileNameTemplate.Substring( nExtension );
+
+    return filename;
+}
+
+    // The name, or the name with "_1", "_2" and so on before the extension,
+    // whichever is first to be free, compressed or not.
+CString CRotatingLogFile::uniqueFileName( const CString &strFileName )
+{
+    CString strRetVal = strFileName;
+    size_t nExtension = ExtensionStart( strFileName );
+    int nSuffix = 1;
+
+    while ( ( FileExists( strRetVal ) ) || ( FileExists( strRetVal + ".gz" ) ) )
+    {
+        strRetVal = strFileName.Substring( 0, (int)nExtension );
+        strRetVal += "_";
+        strRetVal += CString::FormatString( "%d", nSuffix++ );
+        strRetVal += strFileName.Substring( nExtension );
+    }
+
+    return strRetVal;
+}
+
+    // The local time at which the interval after tNow starts, or 0 if the
+    // log only rotates by size.
+time_t CRotatingLogFile::nextRotation( time_t tNow )
+{
+    struct tm tmNext;
+
+    if ( m_rotationInterval == NEVER )
+    {
+        return 0;
+    }
+
+#ifdef IASLIB_WIN32__
+    localtime_s( &tmNext, &tNow );
+#else
+    localtime_r( &tNow, &tmNext );
+#endif
+
+    tmNext.tm_sec = 0;
+    tmNext.tm_min = 0;
+
+    switch ( m_rotationInterval )
+    {
+        case HOURLY:
+            tmNext.tm_hour++;
+            break;
+
+        case WEEKLY:
+            tmNext.tm_hour = 0;
+            tmNext.tm_mday += 7 - tmNext.tm_wday;
+            break;
+
+        case MONTHLY:
+            tmNext.tm_hour = 0;
+            tmNext.tm_mday = 1;
+            tmNext.tm_mon++;
+            break;
+
+        case DAILY:
+        default:
+            tmNext.tm_hour = 0;
+            tmNext.tm_mday++;
+            break;
+    }
+
+    tmNext.tm_isdst = -1;
+    return mktime( &tmNext );
+}
+
+#ifdef IASLIB_MULTI_THREADED__
+IMPLEMENT_OBJECT( CLogRotator, CThread );
+
+CLogRotator::CLogRotator( CRotatingLogFile *pLog ) : CThread( "LogRotator", true, false, true )
+{
+    m_pLog = pLog;
+
+    Resume();
+}
+
+CLogRotator::~CLogRotator( void )
+{
+}
+
+void *CLogRotator::Run( void )
+{
+    while ( ! IsShutdown() )
+    {
+        m_pLog->m_semRotate.TimedWait( 1000 );
+
+        if ( ! IsShutdown() )
         {
-            case DAILY:
-            case WEEKLY:
-            case MONTHLY:
-                m_lastChanged.SetToCurrent();
-                m_lastChanged.StartOfDay();
-                break;
-
-            case HOURLY:
-                m_lastChanged.SetToCurrent();
-                m_lastChanged.StartOfHour();
-                break;
+            m_pLog->housekeeping();
         }
-#ifdef IASLIB_MULTI_THREADED__
-        m_mutexProtect.Unlock();
-#endif        
     }
+
+    return NULL;
 }
+#endif // IASLIB_MULTI_THREADED__
 
-}; // namespace IASLib
\ No newline at end of file
+}; // namespace IASLib
@@ -0,0 +1,124 @@
+/*
+ *  Memory Block Class
+ *
+ *      Takes pages from the operating system, and gives them back. A run
+ * that has to be aligned on more than a page is mapped with enough slack
+ * to find an aligned start inside it, and the slack on either side is
+ * unmapped again.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "MemoryBlock.h"
+
+#ifdef IASLIB_MEMORY_MANAGER__
+
+#ifdef IASLIB_WIN32__
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+namespace IASLib
+{
+    /**
+     * AllocatePages
+     *
+     *      Maps a run of pages, zero filled.
+     *
+     * @param nPages
+     *      How many pages the run needs.
+     * @param nAlignment
+     *      The boundary the run has to start on (a power of two, and at
+     *      least a page).
+     * @return
+     *      The first page of the run, or NULL if the system is out of
+     *      memory.
+     */
+    CMemoryBlock *CMemoryBlock::AllocatePages( size_t nPages, size_t nAlignment )
+    {
+        size_t nBytes = nPages * PAGE_BYTES;
+
+        if ( nAlignment < PAGE_BYTES )
+        {
+            nAlignment = PAGE_BYTES;
+        }
+
+        size_t nMapped = nBytes + nAlignment - PAGE_BYTES;
+
+#ifdef IASLIB_WIN32__
+            // Windows can't release part of a reservation, so reserve the
+            // slack to find an aligned address, then let go of it and map
+            // just the run there. Another thread can take the address in
+            // between, so try again if it does.
+        for ( int nTry = 0; nTry < 8; nTry++ )
+        {
+            char *pReserved = (char *)VirtualAlloc( NULL, nMapped, MEM_RESERVE, PAGE_NOACCESS );
+            if ( pReserved == NULL )
+            {
+                return NULL;
+            }
+
+            char *pAligned = (char *)( ( (size_t)pReserved + nAlignment - 1 ) & ~( nAlignment - 1 ) );
+            VirtualFree( pReserved, 0, MEM_RELEASE );
+
+            char *pPages = (char *)VirtualAlloc( pAligned, nBytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+            if ( pPages )
+            {
+                return (CMemoryBlock *)pPages;
+            }
+        }
+
+        return NULL;
+#else
+        char *pMapped = (char *)mmap( NULL, nMapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        if ( pMapped == (char *)MAP_FAILED )
+        {
+            return NULL;
+        }
+
+        char *pAligned = (char *)( ( (size_t)pMapped + nAlignment - 1 ) & ~( nAlignment - 1 ) );
+        char *pEnd = pAligned + nBytes;
+
+        if ( pAligned > pMapped )
+        {
+            munmap( pMapped, (size_t)( pAligned - pMapped ) );
+        }
+
+        if ( pMapped + nMapped > pEnd )
+        {
+            munmap( pEnd, (size_t)( ( pMapped + nMapped ) - pEnd ) );
+        }
+
+        return (CMemoryBlock *)pAligned;
+#endif
+    }
+
+    /**
+     * ReleasePages
+     *
+     *      Gives a run from AllocatePages() back to the system.
+     */
+    void CMemoryBlock::ReleasePages( CMemoryBlock *pPages, size_t nPages )
+    {
+        if ( pPages )
+        {
+#ifdef IASLIB_WIN32__
+            nPages = nPages;
+            VirtualFree( pPages, 0, MEM_RELEASE );
+#else
+            munmap( pPages, nPages * PAGE_BYTES );
+#endif
+        }
+    }
+} // namespace IASLib
+
+#endif // IASLIB_MEMORY_MANAGER__
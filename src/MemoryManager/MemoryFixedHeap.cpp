@@ -0,0 +1,341 @@
+/*
+ *  Memory Fixed Heap Class
+ *
+ *      A heap of blocks that are all the same size, carved out of slabs
+ * of CMemoryBlock pages. Slabs are kept on two lists: the ones with room
+ * left (partial) and the ones without (full). A slab's blocks are handed
+ * out from its free list first, then from the part of the slab that has
+ * never been used, so a new slab doesn't have to be threaded onto a free
+ * list up front.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "MemoryFixedHeap.h"
+#include "String_.h"
+
+#ifdef IASLIB_MEMORY_MANAGER__
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CMemoryFixedHeap, CMemoryHeap );
+
+    CMemoryFixedHeap::CMemoryFixedHeap( void )
+    {
+        m_pPartial = NULL;
+        m_pFull = NULL;
+        m_nSlabs = 0;
+        m_nEmptySlabs = 0;
+        m_nInUse = 0;
+        m_ullAllocations = 0;
+        m_ullReleases = 0;
+        SetBlockSize( 16 );
+    }
+
+    CMemoryFixedHeap::CMemoryFixedHeap( size_t nBlockSize )
+    {
+        m_pPartial = NULL;
+        m_pFull = NULL;
+        m_nSlabs = 0;
+        m_nEmptySlabs = 0;
+        m_nInUse = 0;
+        m_ullAllocations = 0;
+        m_ullReleases = 0;
+        SetBlockSize( nBlockSize );
+    }
+
+        // Slabs still holding blocks are left alone: whoever has the
+        // blocks may still be using them.
+    CMemoryFixedHeap::~CMemoryFixedHeap( void )
+    {
+        Compact();
+    }
+
+    /**
+     * SetBlockSize
+     *
+     *      Sets the size of the heap's blocks, which is rounded up to a
+     * multiple of 16 bytes. Only to be used before anything has been
+     * allocated.
+     */
+    void CMemoryFixedHeap::SetBlockSize( size_t nBlockSize )
+    {
+        if ( nBlockSize < 16 )
+        {
+            nBlockSize = 16;
+        }
+
+        m_nBlockSize = ( nBlockSize + 15 ) & ~(size_t)15;
+        m_nBlocksPerSlab = ( SLAB_BYTES - SLAB_HEADER_BYTES ) / m_nBlockSize;
+    }
+
+    void *CMemoryFixedHeap::Allocate( size_t nSize )
+    {
+        if ( nSize > m_nBlockSize )
+        {
+            return NULL;
+        }
+
+        m_mutexHeap.Lock();
+        void *p = TakeBlock();
+        if ( p )
+        {
+            m_ullAllocations++;
+        }
+        m_mutexHeap.Unlock();
+
+        return p;
+    }
+
+    void CMemoryFixedHeap::Release( void *p )
+    {
+        if ( p )
+        {
+            m_mutexHeap.Lock();
+            PutBlock( p );
+            m_ullReleases++;
+            m_mutexHeap.Unlock();
+        }
+    }
+
+    /**
+     * AllocateBatch
+     *
+     *      Takes a number of blocks in one go, for a thread cache to hand
+     * out one at a time.
+     *
+     * @param ppList
+     *      Set to the blocks, as a list linked through their first words.
+     * @param nCount
+     *      How many blocks are wanted.
+     * @return
+     *      How many blocks are on the list, which is fewer than asked for
+     *      only if the system ran out of memory.
+     */
+    size_t CMemoryFixedHeap::AllocateBatch( void **ppList, size_t nCount )
+    {
+        void *pList = NULL;
+        size_t nTaken = 0;
+
+        m_mutexHeap.Lock();
+        while ( nTaken < nCount )
+        {
+            void *p = TakeBlock();
+            if ( p == NULL )
+            {
+                break;
+            }
+
+            *(void **)p = pList;
+            pList = p;
+            nTaken++;
+        }
+        m_mutexHeap.Unlock();
+
+        *ppList = pList;
+        return nTaken;
+    }
+
+    /**
+     * ReleaseBatch
+     *
+     *      Gives back a list of blocks, linked through their first words
+     * and ending in NULL.
+     */
+    void CMemoryFixedHeap::ReleaseBatch( void *pList )
+    {
+        m_mutexHeap.Lock();
+        while ( pList )
+        {
+            void *pNext = *(void **)pList;
+            PutBlock( pList );
+            pList = pNext;
+        }
+        m_mutexHeap.Unlock();
+    }
+
+    void CMemoryFixedHeap::AddCounts( unsigned long long ullAllocations, unsigned long long ullReleases )
+    {
+        m_mutexHeap.Lock();
+        m_ullAllocations += ullAllocations;
+        m_ullReleases += ullReleases;
+        m_mutexHeap.Unlock();
+    }
+
+    /**
+     * Compact
+     *
+     *      Gives every slab with no blocks in use back to the system.
+     *
+     * @return
+     *      The number of bytes released.
+     */
+    size_t CMemoryFixedHeap::Compact( void )
+    {
+        size_t nReleased = 0;
+
+        m_mutexHeap.Lock();
+        Slab *pSlab = m_pPartial;
+        while ( pSlab )
+        {
+            Slab *pNext = pSlab->m_pNext;
+
+            if ( pSlab->m_nInUse == 0 )
+            {
+                Unlink( pSlab, &m_pPartial );
+                pSlab->m_nMagic = 0;
+                CMemoryBlock::ReleasePages( (CMemoryBlock *)pSlab, SLAB_PAGES );
+                m_nSlabs--;
+                m_nEmptySlabs--;
+                nReleased += SLAB_BYTES;
+            }
+
+            pSlab = pNext;
+        }
+        m_mutexHeap.Unlock();
+
+        return nReleased;
+    }
+
+    void CMemoryFixedHeap::GetStats( HeapStats &stats )
+    {
+        m_mutexHeap.Lock();
+        stats.m_nBlockSize = m_nBlockSize;
+        stats.m_nSlabs = m_nSlabs;
+        stats.m_nEmptySlabs = m_nEmptySlabs;
+        stats.m_nBytesReserved = m_nSlabs * SLAB_BYTES;
+        stats.m_nInUse = m_nInUse;
+        stats.m_nCached = 0;
+        stats.m_ullAllocations = m_ullAllocations;
+        stats.m_ullReleases = m_ullReleases;
+        m_mutexHeap.Unlock();
+    }
+
+    CMemoryFixedHeap::Slab *CMemoryFixedHeap::NewSlab( void )
+    {
+        Slab *pSlab = (Slab *)CMemoryBlock::AllocatePages( SLAB_PAGES, SLAB_BYTES );
+
+        if ( pSlab )
+        {
+            pSlab->m_nMagic = SLAB_MAGIC;
+            pSlab->m_pHeap = this;
+            pSlab->m_nBlockSize = m_nBlockSize;
+            pSlab->m_nPages = SLAB_PAGES;
+            pSlab->m_pData = (char *)pSlab + SLAB_HEADER_BYTES;
+            pSlab->m_pUnused = pSlab->m_pData;
+            pSlab->m_pEnd = pSlab->m_pData + ( m_nBlocksPerSlab * m_nBlockSize );
+            pSlab->m_pFree = NULL;
+            pSlab->m_nInUse = 0;
+            pSlab->m_bFull = false;
+            pSlab->m_pNext = NULL;
+            pSlab->m_pPrev = NULL;
+
+            Link( pSlab, &m_pPartial );
+            m_nSlabs++;
+            m_nEmptySlabs++;
+        }
+
+        return pSlab;
+    }
+
+        // Both of these are called with the heap locked.
+    void *CMemoryFixedHeap::TakeBlock( void )
+    {
+        Slab *pSlab = m_pPartial;
+
+        if ( pSlab == NULL )
+        {
+            pSlab = NewSlab();
+            if ( pSlab == NULL )
+            {
+                return NULL;
+            }
+        }
+
+        void *p = pSlab->m_pFree;
+        if ( p )
+        {
+            pSlab->m_pFree = *(void **)p;
+        }
+        else
+        {
+            p = pSlab->m_pUnused;
+            pSlab->m_pUnused += m_nBlockSize;
+        }
+
+        if ( pSlab->m_nInUse == 0 )
+        {
+            m_nEmptySlabs--;
+        }
+        pSlab->m_nInUse++;
+        m_nInUse++;
+
+        if ( ( pSlab->m_pFree == NULL ) && ( pSlab->m_pUnused >= pSlab->m_pEnd ) )
+        {
+            Unlink( pSlab, &m_pPartial );
+            Link( pSlab, &m_pFull );
+            pSlab->m_bFull = true;
+        }
+
+        return p;
+    }
+
+    void CMemoryFixedHeap::PutBlock( void *p )
+    {
+        Slab *pSlab = GetSlab( p );
+
+        *(void **)p = pSlab->m_pFree;
+        pSlab->m_pFree = p;
+
+        if ( pSlab->m_bFull )
+        {
+            Unlink( pSlab, &m_pFull );
+            Link( pSlab, &m_pPartial );
+            pSlab->m_bFull = false;
+        }
+
+        pSlab->m_nInUse--;
+        m_nInUse--;
+        if ( pSlab->m_nInUse == 0 )
+        {
+            m_nEmptySlabs++;
+        }
+    }
+
+    void CMemoryFixedHeap::Unlink( Slab *pSlab, Slab **ppList )
+    {
+        if ( pSlab->m_pPrev )
+        {
+            pSlab->m_pPrev->m_pNext = pSlab->m_pNext;
+        }
+        else
+        {
+            *ppList = pSlab->m_pNext;
+        }
+
+        if ( pSlab->m_pNext )
+        {
+            pSlab->m_pNext->m_pPrev = pSlab->m_pPrev;
+        }
+
+        pSlab->m_pNext = NULL;
+        pSlab->m_pPrev = NULL;
+    }
+
+    void CMemoryFixedHeap::Link( Slab *pSlab, Slab **ppList )
+    {
+        pSlab->m_pPrev = NULL;
+        pSlab->m_pNext = *ppList;
+        if ( *ppList )
+        {
+            (*ppList)->m_pPrev = pSlab;
+        }
+        *ppList = pSlab;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_MEMORY_MANAGER__
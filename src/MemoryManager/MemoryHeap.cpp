@@ -0,0 +1,23 @@
+/*
+ *  Memory Heap Class
+ *
+ *      The base class for the memory heaps; see MemoryHeap.h.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "MemoryHeap.h"
+#include "String_.h"
+
+#ifdef IASLIB_MEMORY_MANAGER__
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CMemoryHeap, CObject );
+} // namespace IASLib
+
+#endif // IASLIB_MEMORY_MANAGER__
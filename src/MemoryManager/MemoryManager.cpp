@@ -0,0 +1,964 @@
+/*
+ *  Memory Manager Class
+ *
+ *      The fixed-block memory manager: a CMemoryFixedHeap for each size
+ * class, with a cache of blocks in front of them for every thread, and
+ * pages straight from the system for anything bigger than the largest
+ * class.
+ *      A thread's cache holds a list of free blocks for each size class.
+ * Allocations pop from the list, refilling it from the heap a batch at a
+ * time when it runs dry; releases push onto it, and once it holds two
+ * batches, one is given back to the heap. The heap's lock is only taken
+ * for the batches. When a thread ends, its cache goes back to the heaps.
+ * Blocks can be released on any thread: they find their way home through
+ * their slab's header.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "MemoryManager.h"
+#include "String_.h"
+
+#ifdef IASLIB_MEMORY_MANAGER__
+
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef IASLIB_MULTI_THREADED__
+    #ifdef IASLIB_PTHREAD__
+        #include <pthread.h>
+        #define IASLIB_MEMORY_THREAD_CACHE__
+    #endif
+    #ifdef IASLIB_WIN32__
+        #include <windows.h>
+        #define IASLIB_MEMORY_THREAD_CACHE__
+    #endif
+#else
+    #define IASLIB_MEMORY_THREAD_CACHE__
+#endif
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CMemoryManager, CObject );
+
+    CMemoryManager *CMemoryManager::m_pNewAllocator = NULL;
+
+    static const size_t DEBUG_ALIVE = 0xA110CA7E;
+    static const size_t DEBUG_FREED = 0xDEADB10C;
+    static const size_t DEBUG_GUARD_BYTES = 16;
+    static const unsigned char DEBUG_GUARD_FILL = 0xFD;
+    static const unsigned char DEBUG_NEW_FILL = 0xCD;
+    static const unsigned char DEBUG_FREED_FILL = 0xDD;
+
+    static const char *DebugFile( const char *strFile )
+    {
+        return ( strFile ) ? strFile : "(unknown)";
+    }
+
+#ifdef IASLIB_MEMORY_THREAD_CACHE__
+    #ifdef IASLIB_MULTI_THREADED__
+        #ifdef IASLIB_PTHREAD__
+            // The cache pointer is a plain thread local, for speed; the key
+            // is only there so the cache is given back when the thread ends.
+    static __thread CMemoryManager::ThreadCache *s_pThreadCache = NULL;
+    static __thread bool s_bThreadEnded = false;
+    static pthread_key_t s_keyThreadCache;
+    static pthread_once_t s_onceThreadCache = PTHREAD_ONCE_INIT;
+
+    static void ThreadCacheDestructor( void *pCache )
+    {
+        s_pThreadCache = NULL;
+        s_bThreadEnded = true;
+        CMemoryManager::ReleaseThreadCache( (CMemoryManager::ThreadCache *)pCache );
+    }
+
+    static void CreateThreadCacheKey( void )
+    {
+        pthread_key_create( &s_keyThreadCache, ThreadCacheDestructor );
+    }
+
+    static void RegisterThreadCache( CMemoryManager::ThreadCache *pCache )
+    {
+        pthread_once( &s_onceThreadCache, CreateThreadCacheKey );
+        pthread_setspecific( s_keyThreadCache, pCache );
+    }
+        #else
+    static __declspec( thread ) CMemoryManager::ThreadCache *s_pThreadCache = NULL;
+    static __declspec( thread ) bool s_bThreadEnded = false;
+    static DWORD s_dwThreadCacheIndex = FLS_OUT_OF_INDEXES;
+
+    static void WINAPI ThreadCacheDestructor( void *pCache )
+    {
+        s_pThreadCache = NULL;
+        s_bThreadEnded = true;
+        CMemoryManager::ReleaseThreadCache( (CMemoryManager::ThreadCache *)pCache );
+    }
+
+    static void RegisterThreadCache( CMemoryManager::ThreadCache *pCache )
+    {
+        if ( s_dwThreadCacheIndex == FLS_OUT_OF_INDEXES )
+        {
+            DWORD dwIndex = FlsAlloc( ThreadCacheDestructor );
+            if ( InterlockedCompareExchange( (LONG volatile *)&s_dwThreadCacheIndex, (LONG)dwIndex, (LONG)FLS_OUT_OF_INDEXES ) != (LONG)FLS_OUT_OF_INDEXES )
+            {
+                FlsFree( dwIndex );
+            }
+        }
+        FlsSetValue( s_dwThreadCacheIndex, pCache );
+    }
+        #endif
+    #else
+            // Only the one thread, which never ends before the process does.
+    static CMemoryManager::ThreadCache *s_pThreadCache = NULL;
+    static bool s_bThreadEnded = false;
+
+    static void RegisterThreadCache( CMemoryManager::ThreadCache *pCache )
+    {
+        pCache = pCache;
+    }
+    #endif
+#endif
+
+    /**
+     * Constructor
+     *
+     *      Sets up the size classes: 16 byte steps up to 128 bytes, then
+     * four to every doubling, up to MAX_SMALL_BLOCK. A thread moves blocks
+     * to and from a heap about 8K at a time (between 4 and 64 blocks).
+     */
+    CMemoryManager::CMemoryManager( void )
+    {
+        size_t anSizes[ SIZE_CLASSES ];
+        size_t nClass = 0;
+
+        while ( nClass < 8 )
+        {
+            anSizes[ nClass ] = ( nClass + 1 ) * 16;
+            nClass++;
+        }
+
+        size_t nBase = 128;
+        while ( nClass < SIZE_CLASSES )
+        {
+            for ( size_t nStep = 1; ( nStep <= 4 ) && ( nClass < SIZE_CLASSES ); nStep++ )
+            {
+                anSizes[ nClass ] = nBase + ( nStep * nBase / 4 );
+                nClass++;
+            }
+            nBase *= 2;
+        }
+
+        for ( nClass = 0; nClass < SIZE_CLASSES; nClass++ )
+        {
+            m_aHeaps[ nClass ].SetBlockSize( anSizes[ nClass ] );
+
+            size_t nBatch = 8192 / anSizes[ nClass ];
+            m_anBatch[ nClass ] = ( nBatch < 4 ) ? 4 : ( ( nBatch > 64 ) ? 64 : nBatch );
+        }
+
+        nClass = 0;
+        for ( size_t nIndex = 0; nIndex <= MAX_SMALL_BLOCK / 16; nIndex++ )
+        {
+            while ( anSizes[ nClass ] < nIndex * 16 )
+            {
+                nClass++;
+            }
+            m_achClass[ nIndex ] = (unsigned char)nClass;
+        }
+
+        m_nLargeBlocks = 0;
+        m_nLargeBytes = 0;
+        m_ullLargeAllocations = 0;
+        m_ullLargeReleases = 0;
+        m_pLargeCache = NULL;
+        m_nLargeCached = 0;
+        m_nLargeCachedBytes = 0;
+        m_pCaches = NULL;
+        m_pDebugBlocks = NULL;
+        m_nDebugBlocks = 0;
+    }
+
+        // Blocks still out are left where they are. Threads still holding
+        // a cache for this manager are cut loose from it; the cache goes to
+        // the next manager the thread uses.
+    CMemoryManager::~CMemoryManager( void )
+    {
+        m_mutexCaches.Lock();
+        while ( m_pCaches )
+        {
+            ThreadCache *pCache = m_pCaches;
+            m_pCaches = pCache->m_pNext;
+
+            for ( size_t nClass = 0; nClass < SIZE_CLASSES; nClass++ )
+            {
+                FlushBin( &pCache->m_aBins[ nClass ], 0 );
+                pCache->m_aBins[ nClass ].m_ullAllocations = 0;
+                pCache->m_aBins[ nClass ].m_ullReleases = 0;
+            }
+            pCache->m_pNext = NULL;
+            pCache->m_pPrev = NULL;
+            pCache->m_pOwner = NULL;
+        }
+        m_mutexCaches.Unlock();
+
+        if ( m_pNewAllocator == this )
+        {
+            m_pNewAllocator = NULL;
+        }
+    }
+
+    /**
+     * Allocate
+     *
+     *      Allocates a block of at least size bytes. The block isn't
+     * cleared.
+     *
+     * @return
+     *      The block, or NULL if the system is out of memory.
+     */
+    void *CMemoryManager::Allocate( size_t size )
+    {
+        if ( size > MAX_SMALL_BLOCK )
+        {
+            return AllocateLarge( size );
+        }
+
+        size_t nClass = GetClass( size );
+        ThreadCache *pCache = GetThreadCache();
+
+        if ( pCache == NULL )
+        {
+            return m_aHeaps[ nClass ].Allocate( size );
+        }
+
+        CacheBin *pBin = &pCache->m_aBins[ nClass ];
+        if ( pBin->m_pHead == NULL )
+        {
+            pBin->m_nCount = m_aHeaps[ nClass ].AllocateBatch( &pBin->m_pHead, m_anBatch[ nClass ] );
+            if ( pBin->m_pHead == NULL )
+            {
+                return NULL;
+            }
+        }
+
+        void *p = pBin->m_pHead;
+        pBin->m_pHead = *(void **)p;
+        pBin->m_nCount--;
+        pBin->m_ullAllocations++;
+
+        return p;
+    }
+
+    /**
+     * Reallocate
+     *
+     *      Resizes a block, like realloc(). The block stays where it is if
+     * the new size still fits and uses more than half of it; otherwise
+     * it's moved to a block of the right size.
+     */
+    void *CMemoryManager::Reallocate( void *p, size_t size )
+    {
+        if ( p == NULL )
+        {
+            return Allocate( size );
+        }
+
+        if ( size == 0 )
+        {
+            Release( p );
+            return NULL;
+        }
+
+        CMemoryFixedHeap::Slab *pSlab = CMemoryFixedHeap::GetSlab( p );
+        if ( pSlab->m_nMagic != CMemoryFixedHeap::SLAB_MAGIC )
+        {
+            fprintf( stderr, "Memory Manager: reallocating a block (%p) that it didn't allocate\n", p );
+            return NULL;
+        }
+
+        size_t nCapacity = pSlab->m_nBlockSize;
+        if ( ( size <= nCapacity ) && ( ( size > nCapacity / 2 ) || ( nCapacity <= 16 ) ) )
+        {
+            return p;
+        }
+
+            // Large blocks come from the system every time, so one that's
+            // growing is given room to keep growing for a while.
+        size_t nAllocate = size;
+        if ( ( size > nCapacity ) && ( size > MAX_SMALL_BLOCK ) && ( size < (size_t)-1 / 2 ) )
+        {
+            nAllocate = size + size / 2;
+        }
+
+        void *pNew = Allocate( nAllocate );
+        if ( pNew )
+        {
+            memcpy( pNew, p, ( size < nCapacity ) ? size : nCapacity );
+            Release( p );
+        }
+
+        return pNew;
+    }
+
+    /**
+     * Release
+     *
+     *      Gives a block back. Blocks from any fixed-block manager can be
+     * released here, but those from another manager skip the thread cache.
+     */
+    void CMemoryManager::Release( void *p )
+    {
+        if ( p == NULL )
+        {
+            return;
+        }
+
+        CMemoryFixedHeap::Slab *pSlab = CMemoryFixedHeap::GetSlab( p );
+        if ( pSlab->m_nMagic != CMemoryFixedHeap::SLAB_MAGIC )
+        {
+            fprintf( stderr, "Memory Manager: releasing a block (%p) that it didn't allocate\n", p );
+            return;
+        }
+
+        CMemoryFixedHeap *pHeap = pSlab->m_pHeap;
+        if ( pHeap == NULL )
+        {
+            ReleaseLarge( pSlab );
+            return;
+        }
+
+        ThreadCache *pCache = ( IsOwnHeap( pHeap ) ) ? GetThreadCache() : NULL;
+        if ( pCache == NULL )
+        {
+            pHeap->Release( p );
+            return;
+        }
+
+        size_t nClass = (size_t)( pHeap - m_aHeaps );
+        CacheBin *pBin = &pCache->m_aBins[ nClass ];
+
+        *(void **)p = pBin->m_pHead;
+        pBin->m_pHead = p;
+        pBin->m_nCount++;
+        pBin->m_ullReleases++;
+
+        if ( pBin->m_nCount > m_anBatch[ nClass ] * 2 )
+        {
+            FlushBin( pBin, m_anBatch[ nClass ] );
+        }
+    }
+
+    /**
+     * GetBlockSize
+     *
+     *      Returns how much of a block the caller may use: the size of its
+     * size class (or, for a large block, the rest of its last page), or for
+     * a block from AllocateDebug(), exactly what was asked for.
+     */
+    size_t CMemoryManager::GetBlockSize( void *p )
+    {
+        if ( p == NULL )
+        {
+            return 0;
+        }
+
+        if ( m_nDebugBlocks )
+        {
+            DebugHeader *pHeader = GetDebugHeader( p );
+            if ( ( pHeader ) && ( pHeader->m_nMagic == DEBUG_ALIVE ) )
+            {
+                return pHeader->m_nSize;
+            }
+        }
+
+        return CMemoryFixedHeap::GetSlab( p )->m_nBlockSize;
+    }
+
+    /**
+     * AllocateDebug
+     *
+     *      Allocates a block that remembers where it was allocated, and is
+     * fenced on both sides with guard bytes. New blocks are filled with
+     * 0xCD, so that reading one before writing it stands out.
+     */
+    void *CMemoryManager::AllocateDebug( size_t size, const char *strFile, int nLine )
+    {
+        if ( size > (size_t)-1 - sizeof( DebugHeader ) - DEBUG_GUARD_BYTES )
+        {
+            return NULL;
+        }
+
+        DebugHeader *pHeader = (DebugHeader *)Allocate( sizeof( DebugHeader ) + size + DEBUG_GUARD_BYTES );
+        if ( pHeader == NULL )
+        {
+            return NULL;
+        }
+
+        unsigned char *pData = (unsigned char *)( pHeader + 1 );
+
+        pHeader->m_nMagic = DEBUG_ALIVE;
+        pHeader->m_nSize = size;
+        pHeader->m_strFile = strFile;
+        pHeader->m_nLine = (size_t)nLine;
+        memset( pHeader->m_achGuard, DEBUG_GUARD_FILL, DEBUG_GUARD_BYTES );
+        memset( pData, DEBUG_NEW_FILL, size );
+        memset( pData + size, DEBUG_GUARD_FILL, DEBUG_GUARD_BYTES );
+
+        m_mutexDebug.Lock();
+        pHeader->m_pPrev = NULL;
+        pHeader->m_pNext = m_pDebugBlocks;
+        if ( m_pDebugBlocks )
+        {
+            m_pDebugBlocks->m_pPrev = pHeader;
+        }
+        m_pDebugBlocks = pHeader;
+        m_nDebugBlocks++;
+        m_mutexDebug.Unlock();
+
+        return pData;
+    }
+
+    /**
+     * ReallocateDebug
+     *
+     *      Resizes a block from AllocateDebug(). The block always moves, so
+     * that anything still pointing at the old one finds freed memory, and
+     * it's then recorded as allocated here.
+     */
+    void *CMemoryManager::ReallocateDebug( void *p, size_t size, const char *strFile, int nLine )
+    {
+        if ( p == NULL )
+        {
+            return AllocateDebug( size, strFile, nLine );
+        }
+
+        if ( size == 0 )
+        {
+            ReleaseDebug( p, strFile, nLine );
+            return NULL;
+        }
+
+        DebugHeader *pHeader = GetDebugHeader( p );
+        if ( ( pHeader == NULL ) || ( pHeader->m_nMagic != DEBUG_ALIVE ) )
+        {
+            fprintf( stderr, "Memory Manager: %s:%d reallocated a block (%p) that isn't allocated\n", DebugFile( strFile ), nLine, p );
+            return NULL;
+        }
+
+        void *pNew = AllocateDebug( size, strFile, nLine );
+        if ( pNew )
+        {
+            memcpy( pNew, p, ( size < pHeader->m_nSize ) ? size : pHeader->m_nSize );
+            ReleaseDebug( p, strFile, nLine );
+        }
+
+        return pNew;
+    }
+
+    /**
+     * ReleaseDebug
+     *
+     *      Releases a block from AllocateDebug(), reporting (on stderr) a
+     * block that's already been released, or one whose guard bytes have
+     * been written over. The block is filled with 0xDD.
+     *
+     * @param strFile
+     * @param nLine
+     *      Where the block is being released from, for the reports.
+     */
+    void CMemoryManager::ReleaseDebug( void *p, const char *strFile, int nLine )
+    {
+        if ( p == NULL )
+        {
+            return;
+        }
+
+        DebugHeader *pHeader = GetDebugHeader( p );
+        if ( pHeader == NULL )
+        {
+            fprintf( stderr, "Memory Manager: %s:%d released a block (%p) that didn't come from AllocateDebug()\n", DebugFile( strFile ), nLine, p );
+            return;
+        }
+
+        if ( pHeader->m_nMagic == DEBUG_FREED )
+        {
+            fprintf( stderr, "Memory Manager: %s:%d released a block of %lu bytes, allocated at %s:%lu, that was already released\n",
+                     DebugFile( strFile ), nLine, (unsigned long)pHeader->m_nSize, DebugFile( pHeader->m_strFile ), (unsigned long)pHeader->m_nLine );
+            return;
+        }
+
+        CheckGuards( pHeader, strFile, nLine );
+
+        m_mutexDebug.Lock();
+        if ( pHeader->m_pPrev )
+        {
+            pHeader->m_pPrev->m_pNext = pHeader->m_pNext;
+        }
+        else
+        {
+            m_pDebugBlocks = pHeader->m_pNext;
+        }
+        if ( pHeader->m_pNext )
+        {
+            pHeader->m_pNext->m_pPrev = pHeader->m_pPrev;
+        }
+        m_nDebugBlocks--;
+        m_mutexDebug.Unlock();
+
+        pHeader->m_nMagic = DEBUG_FREED;
+        memset( p, DEBUG_FREED_FILL, pHeader->m_nSize );
+
+        Release( pHeader );
+    }
+
+    /**
+     * ReportLeaks
+     *
+     *      Lists (on stderr) every block from AllocateDebug() that hasn't
+     * been released, with where it was allocated.
+     *
+     * @return
+     *      The number of blocks listed.
+     */
+    size_t CMemoryManager::ReportLeaks( void )
+    {
+        size_t nLeaks = 0;
+
+        m_mutexDebug.Lock();
+        for ( DebugHeader *pHeader = m_pDebugBlocks; pHeader; pHeader = pHeader->m_pNext )
+        {
+            fprintf( stderr, "Memory Manager: %lu bytes allocated at %s:%lu were never released\n",
+                     (unsigned long)pHeader->m_nSize, DebugFile( pHeader->m_strFile ), (unsigned long)pHeader->m_nLine );
+            nLeaks++;
+        }
+        m_mutexDebug.Unlock();
+
+        return nLeaks;
+    }
+
+    /**
+     * Compact
+     *
+     *      Gives every slab with nothing allocated from it, and every large
+     * run kept back for reuse, to the system. Blocks sitting in a thread's cache count as allocated; a
+     * thread can hand its back first with Collect().
+     *
+     * @return
+     *      The number of bytes released.
+     */
+    size_t CMemoryManager::Compact( void )
+    {
+        size_t nReleased = 0;
+
+        for ( size_t nClass = 0; nClass < SIZE_CLASSES; nClass++ )
+        {
+            nReleased += m_aHeaps[ nClass ].Compact();
+        }
+
+        m_mutexLarge.Lock();
+        CMemoryFixedHeap::Slab *pRun = m_pLargeCache;
+        m_pLargeCache = NULL;
+        nReleased += m_nLargeCachedBytes;
+        m_nLargeCached = 0;
+        m_nLargeCachedBytes = 0;
+        m_mutexLarge.Unlock();
+
+        while ( pRun )
+        {
+            CMemoryFixedHeap::Slab *pNext = pRun->m_pNext;
+            CMemoryBlock::ReleasePages( (CMemoryBlock *)pRun, pRun->m_nPages );
+            pRun = pNext;
+        }
+
+        return nReleased;
+    }
+
+    /**
+     * Collect
+     *
+     *      Gives every block in the calling thread's cache back to the
+     * heaps.
+     */
+    void CMemoryManager::Collect( void )
+    {
+        ThreadCache *pCache = GetThreadCache();
+
+        if ( pCache )
+        {
+            for ( size_t nClass = 0; nClass < SIZE_CLASSES; nClass++ )
+            {
+                FlushBin( &pCache->m_aBins[ nClass ], 0 );
+            }
+        }
+    }
+
+    /**
+     * GetClassStats
+     *
+     *      Gets the counters for one size class, with the blocks in (and
+     * the counts kept by) every thread's cache added in. The counts from
+     * other threads' caches are read while those threads carry on, so
+     * they're only as good as a snapshot can be.
+     *
+     * @return
+     *      false if there's no such class.
+     */
+    bool CMemoryManager::GetClassStats( size_t nClass, HeapStats &stats )
+    {
+        if ( nClass >= SIZE_CLASSES )
+        {
+            return false;
+        }
+
+        m_aHeaps[ nClass ].GetStats( stats );
+
+        m_mutexCaches.Lock();
+        for ( ThreadCache *pCache = m_pCaches; pCache; pCache = pCache->m_pNext )
+        {
+            CacheBin *pBin = &pCache->m_aBins[ nClass ];
+            stats.m_nCached += pBin->m_nCount;
+            stats.m_ullAllocations += pBin->m_ullAllocations;
+            stats.m_ullReleases += pBin->m_ullReleases;
+        }
+        m_mutexCaches.Unlock();
+
+        stats.m_nInUse = ( stats.m_nInUse > stats.m_nCached ) ? stats.m_nInUse - stats.m_nCached : 0;
+
+        return true;
+    }
+
+        // Large blocks each have a "slab" to themselves, and no block size
+        // of their own. The runs kept back count as empty slabs.
+    void CMemoryManager::GetLargeStats( HeapStats &stats )
+    {
+        m_mutexLarge.Lock();
+        stats.m_nBlockSize = 0;
+        stats.m_nSlabs = m_nLargeBlocks + m_nLargeCached;
+        stats.m_nEmptySlabs = m_nLargeCached;
+        stats.m_nBytesReserved = m_nLargeBytes + m_nLargeCachedBytes;
+        stats.m_nInUse = m_nLargeBlocks;
+        stats.m_nCached = 0;
+        stats.m_ullAllocations = m_ullLargeAllocations;
+        stats.m_ullReleases = m_ullLargeReleases;
+        m_mutexLarge.Unlock();
+    }
+
+    /**
+     * GetDefaultAllocator
+     *
+     *      Returns the manager used until SetNewAllocator() says otherwise.
+     * It's built in static storage and never destroyed: strings held by
+     * static objects are released by destructors that may well run after
+     * its own would have.
+     */
+    CMemoryManager *CMemoryManager::GetDefaultAllocator( void )
+    {
+        static union
+        {
+            char                m_achStorage[ sizeof( CMemoryManager ) ];
+            double              m_dAlign;
+            long long           m_llAlign;
+            void               *m_pAlign;
+        } s_storage;
+        static CMemoryManager *s_pDefault = ::new ( (void *)&s_storage ) CMemoryManager();
+
+        if ( m_pNewAllocator == NULL )
+        {
+            m_pNewAllocator = s_pDefault;
+        }
+
+        return s_pDefault;
+    }
+
+    /**
+     * SetNewAllocator
+     *
+     *      Sets the manager that GetNewAllocator() returns (NULL for the
+     * default one). Blocks have to be released to a manager that can take
+     * them back, so a manager that isn't a fixed-block one should be set
+     * before anything is allocated, and the old manager has to outlive the
+     * blocks it handed out.
+     */
+    void CMemoryManager::SetNewAllocator( CMemoryManager *pNewAllocator )
+    {
+        m_pNewAllocator = pNewAllocator;
+    }
+
+        // Called when a thread ends, with its cache.
+    void CMemoryManager::ReleaseThreadCache( ThreadCache *pCache )
+    {
+        if ( pCache->m_pOwner )
+        {
+            pCache->m_pOwner->DestroyCache( pCache );
+        }
+        else
+        {
+            free( pCache );
+        }
+    }
+
+        // Returns the calling thread's cache for this manager, making it
+        // if it doesn't have one yet; or NULL if the thread's cache belongs
+        // to another manager, or the thread is on its way out.
+    CMemoryManager::ThreadCache *CMemoryManager::GetThreadCache( void )
+    {
+#ifdef IASLIB_MEMORY_THREAD_CACHE__
+        ThreadCache *pCache = s_pThreadCache;
+
+        if ( ( pCache ) && ( pCache->m_pOwner == this ) )
+        {
+            return pCache;
+        }
+
+        if ( pCache == NULL )
+        {
+            if ( s_bThreadEnded )
+            {
+                return NULL;
+            }
+
+            pCache = (ThreadCache *)calloc( 1, sizeof( ThreadCache ) );
+            if ( pCache == NULL )
+            {
+                return NULL;
+            }
+
+            RegisterThreadCache( pCache );
+            s_pThreadCache = pCache;
+        }
+        else if ( pCache->m_pOwner != NULL )
+        {
+            return NULL;
+        }
+
+        m_mutexCaches.Lock();
+        pCache->m_pOwner = this;
+        pCache->m_pPrev = NULL;
+        pCache->m_pNext = m_pCaches;
+        if ( m_pCaches )
+        {
+            m_pCaches->m_pPrev = pCache;
+        }
+        m_pCaches = pCache;
+        m_mutexCaches.Unlock();
+
+        return pCache;
+#else
+        return NULL;
+#endif
+    }
+
+        // Gives all but the first nKeep blocks of a bin back to their heap.
+    void CMemoryManager::FlushBin( CacheBin *pBin, size_t nKeep )
+    {
+        if ( pBin->m_nCount <= nKeep )
+        {
+            return;
+        }
+
+        void *pList = pBin->m_pHead;
+
+        if ( nKeep )
+        {
+            void *pLast = pList;
+            for ( size_t nBlock = 1; nBlock < nKeep; nBlock++ )
+            {
+                pLast = *(void **)pLast;
+            }
+            pList = *(void **)pLast;
+            *(void **)pLast = NULL;
+        }
+        else
+        {
+            pBin->m_pHead = NULL;
+        }
+
+        pBin->m_nCount = nKeep;
+        CMemoryFixedHeap::GetSlab( pList )->m_pHeap->ReleaseBatch( pList );
+    }
+
+    void CMemoryManager::DestroyCache( ThreadCache *pCache )
+    {
+        m_mutexCaches.Lock();
+        for ( size_t nClass = 0; nClass < SIZE_CLASSES; nClass++ )
+        {
+            CacheBin *pBin = &pCache->m_aBins[ nClass ];
+
+            FlushBin( pBin, 0 );
+            m_aHeaps[ nClass ].AddCounts( pBin->m_ullAllocations, pBin->m_ullReleases );
+        }
+
+        if ( pCache->m_pPrev )
+        {
+            pCache->m_pPrev->m_pNext = pCache->m_pNext;
+        }
+        else
+        {
+            m_pCaches = pCache->m_pNext;
+        }
+        if ( pCache->m_pNext )
+        {
+            pCache->m_pNext->m_pPrev = pCache->m_pPrev;
+        }
+        m_mutexCaches.Unlock();
+
+        free( pCache );
+    }
+
+        // A large block's pages start on a slab boundary, with a slab
+        // header that has no heap, so Release() can tell it apart.
+    void *CMemoryManager::AllocateLarge( size_t nSize )
+    {
+        if ( nSize > (size_t)-1 - CMemoryFixedHeap::SLAB_BYTES )
+        {
+            return NULL;
+        }
+
+        size_t nPages = ( CMemoryFixedHeap::SLAB_HEADER_BYTES + nSize + CMemoryBlock::PAGE_BYTES - 1 ) / CMemoryBlock::PAGE_BYTES;
+        CMemoryFixedHeap::Slab *pSlab = NULL;
+
+            // A run kept back will do if it isn't more than twice the size.
+        m_mutexLarge.Lock();
+        CMemoryFixedHeap::Slab **ppRun = &m_pLargeCache;
+        while ( *ppRun )
+        {
+            if ( ( (*ppRun)->m_nPages >= nPages ) && ( (*ppRun)->m_nPages <= nPages * 2 ) )
+            {
+                pSlab = *ppRun;
+                *ppRun = pSlab->m_pNext;
+                m_nLargeCached--;
+                m_nLargeCachedBytes -= pSlab->m_nPages * CMemoryBlock::PAGE_BYTES;
+                nPages = pSlab->m_nPages;
+                break;
+            }
+            ppRun = &(*ppRun)->m_pNext;
+        }
+        m_mutexLarge.Unlock();
+
+        if ( pSlab == NULL )
+        {
+            pSlab = (CMemoryFixedHeap::Slab *)CMemoryBlock::AllocatePages( nPages, CMemoryFixedHeap::SLAB_BYTES );
+            if ( pSlab == NULL )
+            {
+                return NULL;
+            }
+        }
+
+        pSlab->m_nMagic = CMemoryFixedHeap::SLAB_MAGIC;
+        pSlab->m_pHeap = NULL;
+        pSlab->m_nPages = nPages;
+        pSlab->m_pData = (char *)pSlab + CMemoryFixedHeap::SLAB_HEADER_BYTES;
+        pSlab->m_nBlockSize = ( nPages * CMemoryBlock::PAGE_BYTES ) - CMemoryFixedHeap::SLAB_HEADER_BYTES;
+        pSlab->m_pEnd = pSlab->m_pData + pSlab->m_nBlockSize;
+        pSlab->m_pUnused = pSlab->m_pEnd;
+        pSlab->m_pFree = NULL;
+        pSlab->m_nInUse = 1;
+        pSlab->m_bFull = true;
+        pSlab->m_pNext = NULL;
+        pSlab->m_pPrev = NULL;
+
+        m_mutexLarge.Lock();
+        m_nLargeBlocks++;
+        m_nLargeBytes += nPages * CMemoryBlock::PAGE_BYTES;
+        m_ullLargeAllocations++;
+        m_mutexLarge.Unlock();
+
+        return pSlab->m_pData;
+    }
+
+    void CMemoryManager::ReleaseLarge( CMemoryFixedHeap::Slab *pSlab )
+    {
+        size_t nPages = pSlab->m_nPages;
+
+        pSlab->m_nMagic = 0;
+
+        m_mutexLarge.Lock();
+        m_nLargeBlocks--;
+        m_nLargeBytes -= nPages * CMemoryBlock::PAGE_BYTES;
+        m_ullLargeReleases++;
+
+        if ( ( nPages <= LARGE_CACHE_PAGES ) && ( m_nLargeCached < LARGE_CACHE_RUNS ) )
+        {
+            pSlab->m_pNext = m_pLargeCache;
+            m_pLargeCache = pSlab;
+            m_nLargeCached++;
+            m_nLargeCachedBytes += nPages * CMemoryBlock::PAGE_BYTES;
+            pSlab = NULL;
+        }
+        m_mutexLarge.Unlock();
+
+        if ( pSlab )
+        {
+            CMemoryBlock::ReleasePages( (CMemoryBlock *)pSlab, nPages );
+        }
+    }
+
+        // Finds the header of a block from AllocateDebug(), from the
+        // address it handed out: one header past the start of a block.
+    CMemoryManager::DebugHeader *CMemoryManager::GetDebugHeader( void *p )
+    {
+        CMemoryFixedHeap::Slab *pSlab = CMemoryFixedHeap::GetSlab( p );
+
+        if ( ( pSlab->m_nMagic != CMemoryFixedHeap::SLAB_MAGIC ) || ( (char *)p < pSlab->m_pData ) )
+        {
+            return NULL;
+        }
+
+        char *pBlock = pSlab->m_pData;
+        if ( pSlab->m_pHeap )
+        {
+            pBlock += ( ( (char *)p - pSlab->m_pData ) / pSlab->m_nBlockSize ) * pSlab->m_nBlockSize;
+        }
+
+        if ( (char *)p != pBlock + sizeof( DebugHeader ) )
+        {
+            return NULL;
+        }
+
+        DebugHeader *pHeader = (DebugHeader *)pBlock;
+        if ( ( pHeader->m_nMagic != DEBUG_ALIVE ) && ( pHeader->m_nMagic != DEBUG_FREED ) )
+        {
+            return NULL;
+        }
+
+        return pHeader;
+    }
+
+    bool CMemoryManager::CheckGuards( DebugHeader *pHeader, const char *strFile, int nLine )
+    {
+        bool bIntact = true;
+        unsigned char *pData = (unsigned char *)( pHeader + 1 );
+
+        for ( size_t nByte = 0; nByte < DEBUG_GUARD_BYTES; nByte++ )
+        {
+            if ( pHeader->m_achGuard[ nByte ] != DEBUG_GUARD_FILL )
+            {
+                fprintf( stderr, "Memory Manager: %s:%d released a block of %lu bytes, allocated at %s:%lu, that was written over at the front\n",
+                         DebugFile( strFile ), nLine, (unsigned long)pHeader->m_nSize, DebugFile( pHeader->m_strFile ), (unsigned long)pHeader->m_nLine );
+                bIntact = false;
+                break;
+            }
+        }
+
+        for ( size_t nByte = 0; nByte < DEBUG_GUARD_BYTES; nByte++ )
+        {
+            if ( pData[ pHeader->m_nSize + nByte ] != DEBUG_GUARD_FILL )
+            {
+                fprintf( stderr, "Memory Manager: %s:%d released a block of %lu bytes, allocated at %s:%lu, that was written past its end\n",
+                         DebugFile( strFile ), nLine, (unsigned long)pHeader->m_nSize, DebugFile( pHeader->m_strFile ), (unsigned long)pHeader->m_nLine );
+                bIntact = false;
+                break;
+            }
+        }
+
+        return bIntact;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_MEMORY_MANAGER__
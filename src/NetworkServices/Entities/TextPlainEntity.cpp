@@ -31,6 +31,11 @@ namespace IASLib
         delete [] achBuffer;
     }
 
+    CTextPlainEntity::CTextPlainEntity( const CString &strBody ) : m_strBody( strBody )
+    {
+
+    }
+
     CTextPlainEntity::~CTextPlainEntity( void )
     {
 
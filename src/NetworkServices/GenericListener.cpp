@@ -39,6 +39,7 @@ namespace IASLib
 
     CGenericListener::CGenericListener( const char *strName, CUDPSocket *pSocket, CInternetAddress &internetAddress, CString incomingData ) : CThreadTask( strName ), m_internetAddress( internetAddress ), m_pSocket( pSocket )
     {
+        m_pClientSocket = NULL;
         m_pInStream = new CStringStream( incomingData );
         m_pOutStream = new CStringStream(); // Output only String Stream
     }
@@ -51,7 +52,7 @@ namespace IASLib
         }
         else
         {
-            if ( m_internetAddress.isValid() )
+            if ( ( m_pSocket ) && ( m_internetAddress.isValid() ) )
             {
                 CStringStream *pOut = (CStringStream *)m_pOutStream;
                 CString data = pOut->GetString();
@@ -63,6 +64,16 @@ namespace IASLib
             delete m_pOutStream;
         }
     }
+
+    CString CGenericListener::getOutput( void )
+    {
+        if ( m_pInStream != m_pOutStream )
+        {
+            return ((CStringStream *)m_pOutStream)->GetString();
+        }
+
+        return CString();
+    }
 } // namespace IASLib
 
 #endif
\ No newline at end of file
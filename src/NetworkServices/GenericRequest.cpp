@@ -24,6 +24,10 @@ namespace IASLib
 
     CGenericRequest::CGenericRequest( CInternetAddress &internetAddress ) : m_InternetAddress( internetAddress )
     {
+        m_bIsValid = false;
+        m_bInbound = true;
+        m_pHeaders = NULL;
+        m_bodyEntity = NULL;
     }
 
     bool CGenericRequest::parse( CStream &requestStream )
@@ -111,6 +115,8 @@ namespace IASLib
     {
         m_bIsValid = true;
         m_bInbound = false;
+        m_pHeaders = NULL;
+        m_bodyEntity = NULL;
     }
 
     CGenericRequest::~CGenericRequest( void )
@@ -140,30 +146,48 @@ namespace IASLib
 
     CString CGenericRequest::getHeaderValue( const char *headerName )
     {
-
+        if ( m_pHeaders )
+        {
+            return m_pHeaders->firstValue( headerName );
+        }
+        return CString();
     }
+
     void CGenericRequest::setHeaderValue( const char *headerName, const char *headerValue )
     {
-
+        if ( m_pHeaders )
+        {
+            m_pHeaders->removeHeader( headerName );
+            m_pHeaders->addHeader( headerName, headerValue );
+        }
     }
 
     CStringArray CGenericRequest::getHeaderValues( const char *headerName )
     {
-
+        if ( m_pHeaders )
+        {
+            return m_pHeaders->allValues( headerName );
+        }
+        return CStringArray();
     }
+
     void CGenericRequest::setHeaderValues( const char *headerName, CStringArray headerValues )
     {
-
+        if ( m_pHeaders )
+        {
+            m_pHeaders->removeHeader( headerName );
+            m_pHeaders->addHeader( headerName, headerValues );
+        }
     }
 
     CString CGenericRequest::getHeaderValue( CString name )
     {
-
+        return getHeaderValue( (const char *)name );
     }
 
     CStringArray CGenericRequest::getHeaderValues( CString name )
     {
-
+        return getHeaderValues( (const char *)name );
     }
 }; // namespace IASLib
 
@@ -26,19 +26,28 @@ namespace IASLib
 
     CGenericServer::CGenericServer( void )
     {
-            CSocket            *m_pSocket;
-            CUDPSocket         *m_pUdpSocket;
-            CInternetAddress      m_localAddress;
+        m_pSocket = NULL;
+        m_pUdpSocket = NULL;
     }
 
-    CGenericServer::CGenericServer( CSocket *pSocket )
+        // Servers that have to finish building their transport before the
+        // Run loop can start should start suspended and Resume() when ready.
+    CGenericServer::CGenericServer( const char *strServerName, bool bStartSuspended ) : CThread( strServerName, bStartSuspended )
     {
+        m_pSocket = NULL;
+        m_pUdpSocket = NULL;
+    }
 
+    CGenericServer::CGenericServer( CSocket *pSocket )
+    {
+        m_pSocket = pSocket;
+        m_pUdpSocket = NULL;
     }
 
     CGenericServer::CGenericServer( CUDPSocket *pUdpSocket )
     {
-
+        m_pSocket = NULL;
+        m_pUdpSocket = pUdpSocket;
     }
 
     CGenericServer::~CGenericServer( void )
@@ -0,0 +1,75 @@
+/**
+ * HTTP Metrics Handler class
+ *
+ * This class answers GET /metrics with the metrics registry, in the
+ * Prometheus text format.
+ *
+ * Author: Jeffrey R. Naujok
+ * Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_NETWORKING__
+#ifdef IASLIB_STATS__
+
+#include "NetworkServices/Entities/TextPlainEntity.h"
+#include "NetworkServices/HTTP/Handlers/HttpMetricsHandler.h"
+#include "Stats/Metrics.h"
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CHttpMetricsHandler, CHttpGetHandler );
+
+    CHttpMetricsHandler::CHttpMetricsHandler( CString uri, CString version ) : CHttpGetHandler( uri, version )
+    {
+
+    }
+
+    CHttpMetricsHandler::~CHttpMetricsHandler( void )
+    {
+
+    }
+
+    bool CHttpMetricsHandler::process( CHttpRequest *request, CHttpResponse *response )
+    {
+        if ( ! isMetricsUri( request->getUri() ) )
+        {
+            return CHttpGetHandler::process( request, response );
+        }
+
+        serveMetrics( response );
+
+        return true;
+    }
+
+        // Scrapers may add a query string; it's ignored.
+    bool CHttpMetricsHandler::isMetricsUri( const CString &uri )
+    {
+        CString strPath = uri;
+        size_t nQuery = strPath.IndexOf( '?' );
+
+        if ( nQuery != NOT_FOUND )
+        {
+            strPath = strPath.Substring( 0, (int)nQuery );
+        }
+
+        return ( strPath == "/metrics" );
+    }
+
+    void CHttpMetricsHandler::serveMetrics( CHttpResponse *response )
+    {
+        CString strBody = CMetricsRegistry::GetInstance()->Format();
+        CDate now;
+
+        response->addHeader( "Date", now.FormatDate( CDate::DF_RFC7231 ) );
+        response->addHeader( "Content-Type", "text/plain; version=0.0.4; charset=utf-8" );
+        response->addHeader( "Content-Length", (size_t)strBody.GetLength() );
+        response->setStatus( 200, "OK" );
+        response->SetEntity( new CTextPlainEntity( strBody ) );
+    }
+}
+
+#endif // IASLIB_STATS__
+#endif // IASLIB_NETWORKING__
@@ -17,17 +17,36 @@
 #include "NetworkServices/HTTP/HttpServer.h"
 #include "NetworkServices/HTTP/HttpRequest.h"
 #include "NetworkServices/HTTP/HttpResponse.h"
+#include "Stats/Metrics.h"
 
 namespace IASLib
 {
     IMPLEMENT_OBJECT( CHttpListener, CGenericListener );
 
+#ifdef IASLIB_STATS__
+        // For every server in the process; each server also keeps its own
+        // latencies, in GetLatencyHistogram().
+    static CSummary *HandlerLatency( void )
+    {
+        static CSummary *s_pSummary = CMetricsRegistry::GetInstance()->GetSummary( "iaslib_http_handler_seconds", "Time spent in HTTP handlers." );
+        return s_pSummary;
+    }
+
+    static CCounter *BadRequests( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_http_unhandled_requests_total", "HTTP requests with no handler for their method." );
+        return s_pCounter;
+    }
+#endif
+
     CHttpListener::CHttpListener( CHttpServer *server, CClientSocket *pSocket ) : CGenericListener( "HttpListener", pSocket )
     {
+        m_pParentServer = server;
     }
 
     CHttpListener::CHttpListener( CHttpServer *server, CUDPSocket *pSocket, CInternetAddress &internetAddress, CString incomingData ) : CGenericListener( "HttpUDPListener", pSocket, internetAddress, incomingData )
     {
+        m_pParentServer = server;
     }
 
     CHttpListener::~CHttpListener( void )
@@ -37,8 +56,17 @@ namespace IASLib
     IASLib::CObject *CHttpListener::Run( void )
     {
         CUUID erid;
-        CHttpRequest *httpRequest = new CHttpRequest( m_internetAddress );
-        httpRequest->parse( *m_pInStream );
+        CArena requestArena;
+        CHttpRequest *httpRequest;
+
+            // The request and everything parsed into it (headers, their
+            // lists and hash slats) is made in one arena and let go of in
+            // one go. The response is left out: it outlives this method.
+        {
+            CArenaScope scope( requestArena );
+            httpRequest = new CHttpRequest( m_internetAddress );
+            httpRequest->parse( *m_pInStream );
+        }
         CHttpResponse *httpResponse = new CHttpResponse( *m_pOutStream, m_internetAddress );
 
         addResponseHeaders( httpResponse );
@@ -46,10 +74,19 @@ namespace IASLib
         CHttpHandler *httpHandler = m_pParentServer->GetHandler( httpRequest, erid );
         if ( httpHandler )
         {
+#ifdef IASLIB_STATS__
+            unsigned long long ullStart = CLatencyHistogram::Now();
+            httpHandler->process( httpRequest, httpResponse  );
+            unsigned long long ullElapsed = CLatencyHistogram::Now() - ullStart;
+            m_pParentServer->GetLatencyHistogram().Record( ullElapsed );
+            HandlerLatency()->Record( ullElapsed );
+            int elapsed = (int)( ullElapsed / 1000 );
+#else
             CDate start;
             httpHandler->process( httpRequest, httpResponse  );
             CDate end;
             int elapsed = end.Elapsed( start );
+#endif
             INFO_LOG( "f=%s cip=%s erid=%s uri=%s from=\"%s\" to=\"%s\" rtt=%d sc=%d", 
                 (const char *)httpHandler->getMethod(), 
                 (const char *)httpRequest->getInternetAddress().toStringWithPort(), 
@@ -63,6 +100,9 @@ namespace IASLib
         else
         {
             httpResponse->setStatus( 400, "Bad Request" );
+#ifdef IASLIB_STATS__
+            BadRequests()->Add();
+#endif
         }
         
         httpResponse->toStream( m_pOutStream );
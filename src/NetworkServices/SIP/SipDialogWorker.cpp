@@ -0,0 +1,394 @@
+/**
+ * SIP Dialog Worker class
+ *
+ *      This class provides one of the fixed set of worker threads that
+ * process SIP messages for a CSipServer. The server hashes the Call-ID
+ * of every inbound message onto a worker, so every message belonging to
+ * a dialog is processed, in order, by the same thread. Since a dialog is
+ * never touched by more than one worker, handlers do not need to lock any
+ * per-dialog state.
+ *      Responses to datagram requests are gathered by the worker and sent
+ * as a batch once its queue has been drained.
+ *      Each worker also owns the SIP transactions for its dialogs, and
+ * drives their retransmission timers between batches of messages.
+ *
+ * Author: Jeffrey R. Naujok
+ * Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_NETWORKING__
+#ifdef IASLIB_MULTI_THREADED__
+
+#include "NetworkServices/SIP/SipDialogWorker.h"
+#include "NetworkServices/SIP/SipListener.h"
+#include "NetworkServices/SIP/SipServer.h"
+#include "Sockets/InternetAddress.h"
+#include "NetworkServices/SIP/SipTransaction.h"
+#include "Exceptions/SocketException.h"
+#include "Logging/LogSink.h"
+#include <errno.h>
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CSipTcpConnection, CObject );
+
+    CSipTcpConnection::CSipTcpConnection( CSocket *pSocket )
+    {
+        m_pSocket = pSocket;
+        m_nReferences = 1;
+        m_bClosed = false;
+
+        memset( &m_stPeer, 0, sizeof( m_stPeer ) );
+        m_nPeerLength = sizeof( m_stPeer );
+        if ( getpeername( m_pSocket->GetHandle(), (struct sockaddr *)&m_stPeer, &m_nPeerLength ) != 0 )
+        {
+            m_nPeerLength = 0;
+        }
+    }
+
+    CSipTcpConnection::~CSipTcpConnection( void )
+    {
+        delete m_pSocket;
+        m_pSocket = NULL;
+    }
+
+    void CSipTcpConnection::AddRef( void )
+    {
+        m_mutexRefs.Lock();
+        m_nReferences++;
+        m_mutexRefs.Unlock();
+    }
+
+    void CSipTcpConnection::Release( void )
+    {
+        m_mutexRefs.Lock();
+        m_nReferences--;
+        bool bDelete = ( m_nReferences == 0 );
+        m_mutexRefs.Unlock();
+
+        if ( bDelete )
+        {
+            delete this;
+        }
+    }
+
+    /**
+     * Close
+     *
+     *      Marks the connection as closed. The socket itself is only closed
+     * once the last reference has been released, so a descriptor is never
+     * handed out again while a worker still holds it.
+     */
+    void CSipTcpConnection::Close( void )
+    {
+        m_mutexSend.Lock();
+        m_bClosed = true;
+        m_mutexSend.Unlock();
+    }
+
+    int CSipTcpConnection::Send( const CString &strData )
+    {
+        int nRetVal = 0;
+
+        m_mutexSend.Lock();
+        if ( ! m_bClosed )
+        {
+            try
+            {
+                nRetVal = m_pSocket->Send( (const char *)strData, (int)strData.GetLength() );
+            }
+            catch ( CSocketException *pE )
+            {
+                m_bClosed = true;
+                delete pE;
+            }
+        }
+        m_mutexSend.Unlock();
+
+        return nRetVal;
+    }
+
+    IMPLEMENT_OBJECT( CSipInboundMessage, CObject );
+
+    CSipInboundMessage::CSipInboundMessage( const char *pchData, size_t nLength, const struct sockaddr *pAddress, socklen_t nAddressLength ) : m_strData( pchData, nLength )
+    {
+        m_pConnection = NULL;
+        m_pNext = NULL;
+        memset( &m_stAddress, 0, sizeof( m_stAddress ) );
+        m_nAddressLength = ( nAddressLength <= (socklen_t)sizeof( m_stAddress ) ) ? nAddressLength : (socklen_t)sizeof( m_stAddress );
+        memcpy( &m_stAddress, pAddress, m_nAddressLength );
+    }
+
+    CSipInboundMessage::CSipInboundMessage( const CString &strData, CSipTcpConnection *pConnection, const struct sockaddr *pAddress, socklen_t nAddressLength ) : m_strData( strData )
+    {
+        m_pConnection = pConnection;
+        m_pConnection->AddRef();
+        m_pNext = NULL;
+        memset( &m_stAddress, 0, sizeof( m_stAddress ) );
+        m_nAddressLength = ( nAddressLength <= (socklen_t)sizeof( m_stAddress ) ) ? nAddressLength : (socklen_t)sizeof( m_stAddress );
+        memcpy( &m_stAddress, pAddress, m_nAddressLength );
+    }
+
+    CSipInboundMessage::~CSipInboundMessage( void )
+    {
+        if ( m_pConnection )
+        {
+            m_pConnection->Release();
+        }
+        m_pConnection = NULL;
+    }
+
+    IMPLEMENT_OBJECT( CSipDialogWorker, CThread );
+
+    CSipDialogWorker::CSipDialogWorker( CSipServer *pServer, CUDPSocket *pUdpSocket, size_t nWorkerNumber ) : CThread( (const char *)CString::FormatString( "SipDialogWorker_%d", (int)nWorkerNumber ), true, false, true ),
+        m_semAvailable( 0 ),
+        m_transactions( this )
+    {
+        m_pServer = pServer;
+        m_pUdpSocket = pUdpSocket;
+        m_nProcessed = 0;
+        m_nPending = 0;
+        m_pQueueHead = NULL;
+        m_pQueueTail = NULL;
+        m_nQueued = 0;
+        m_bShutdown = false;
+
+        Resume();
+    }
+
+    CSipDialogWorker::~CSipDialogWorker( void )
+    {
+        FlushResponses();
+
+        while ( m_pQueueHead )
+        {
+            CSipInboundMessage *pMessage = m_pQueueHead;
+            m_pQueueHead = pMessage->m_pNext;
+            delete pMessage;
+        }
+        m_pQueueTail = NULL;
+        m_nQueued = 0;
+    }
+
+    void *CSipDialogWorker::Run( void )
+    {
+        while ( ! m_bShutdown )
+        {
+                // Sleep until a message arrives or the next transaction timer
+                // is due.
+            m_semAvailable.TimedWait( m_transactions.GetNextTimeout() );
+
+                // Take everything that has arrived in one go, run the timers,
+                // then send the gathered datagrams with as few system calls
+                // as possible.
+            m_mutexQueue.Lock();
+            CSipInboundMessage *pMessage = m_pQueueHead;
+            m_pQueueHead = NULL;
+            m_pQueueTail = NULL;
+            m_nQueued = 0;
+            m_mutexQueue.Unlock();
+
+            while ( pMessage )
+            {
+                CSipInboundMessage *pNext = pMessage->m_pNext;
+
+                pMessage->m_pNext = NULL;
+                Process( pMessage );
+                pMessage = pNext;
+            }
+
+            m_transactions.Advance();
+
+            FlushResponses();
+        }
+
+        return NULL;
+    }
+
+    /**
+     * Enqueue
+     *
+     *      Hands a message to this worker. Called from the server's I/O
+     * thread; the queue is the only structure shared between the two.
+     */
+    void CSipDialogWorker::Enqueue( CSipInboundMessage *pMessage )
+    {
+        pMessage->m_pNext = NULL;
+
+        m_mutexQueue.Lock();
+        if ( m_pQueueTail )
+        {
+            m_pQueueTail->m_pNext = pMessage;
+        }
+        else
+        {
+            m_pQueueHead = pMessage;
+        }
+        m_pQueueTail = pMessage;
+        m_nQueued++;
+        m_mutexQueue.Unlock();
+
+        m_semAvailable.Post();
+    }
+
+    void CSipDialogWorker::Shutdown( void )
+    {
+        RequestShutdown();
+        m_semAvailable.Post();
+        Join();
+    }
+
+    /**
+     * Process
+     *
+     *      Runs a single message through the transaction layer and, if it is
+     * a new request, through the handlers.
+     */
+    void CSipDialogWorker::Process( CSipInboundMessage *pMessage )
+    {
+        const CString &strData = pMessage->GetData();
+
+            // Responses only ever belong to our own client transactions
+        if ( CSipTransactionManager::GetStatusCode( (const char *)strData, strData.GetLength() ) )
+        {
+            if ( ! m_transactions.ReceiveResponse( strData ) )
+            {
+                DEBUG_LOG( "Dropping SIP response that matches no transaction" );
+            }
+            delete pMessage;
+            return;
+        }
+
+        bool bAbsorbed = false;
+        CSipServerTransaction *pTransaction = m_transactions.ReceiveRequest( strData, pMessage->GetAddress(), pMessage->GetAddressLength(), pMessage->GetConnection(), bAbsorbed );
+
+        if ( bAbsorbed )
+        {
+            delete pMessage;
+            return;
+        }
+
+        CInternetAddress remoteAddress( pMessage->GetAddress() );
+        CString strResponse;
+
+        {
+                // The listener is built without a socket, so it leaves the
+                // transmission of its output to us.
+            CSipListener listener( m_pServer, NULL, remoteAddress, strData );
+            CObject *pResult = NULL;
+
+            try
+            {
+                pResult = listener.Run();
+            }
+            catch ( ... )
+            {
+                ERROR_LOG( "Exception processing SIP message from %s", (const char *)remoteAddress.toStringWithPort() );
+            }
+
+            if ( pResult )
+            {
+                delete pResult;
+            }
+
+            strResponse = listener.getOutput();
+        }
+
+        m_nProcessed++;
+
+        if ( pTransaction )
+        {
+            if ( strResponse.GetLength() )
+            {
+                m_transactions.SendResponse( pTransaction, strResponse );
+            }
+            else
+            {
+                m_transactions.Discard( pTransaction );
+            }
+        }
+        else if ( strResponse.GetLength() )
+        {
+            if ( pMessage->GetConnection() )
+            {
+                pMessage->GetConnection()->Send( strResponse );
+            }
+            else
+            {
+                QueueDatagram( pMessage->GetAddress(), pMessage->GetAddressLength(), strResponse );
+            }
+        }
+
+        delete pMessage;
+    }
+
+    /**
+     * SendTransactionMessage
+     *
+     *      Sends a message on behalf of a transaction, over the connection
+     * it arrived on, or as a datagram.
+     */
+    void CSipDialogWorker::SendTransactionMessage( CSipTransaction *pTransaction, const CString &strMessage )
+    {
+        if ( pTransaction->GetConnection() )
+        {
+            pTransaction->GetConnection()->Send( strMessage );
+        }
+        else
+        {
+            QueueDatagram( pTransaction->GetAddress(), pTransaction->GetAddressLength(), strMessage );
+        }
+    }
+
+    void CSipDialogWorker::QueueDatagram( const struct sockaddr *pAddress, socklen_t nAddressLength, const CString &strData )
+    {
+        if ( nAddressLength > (socklen_t)sizeof( struct sockaddr_storage ) )
+        {
+            nAddressLength = (socklen_t)sizeof( struct sockaddr_storage );
+        }
+
+        CUDPSocket::Datagram *pDatagram = &m_aPending[ m_nPending ];
+
+            // The string keeps the data alive until the batch is flushed
+        m_astrPending[ m_nPending ] = strData;
+        pDatagram->m_pchBuffer = (char *)(const char *)m_astrPending[ m_nPending ];
+        pDatagram->m_nBufferSize = strData.GetLength();
+        pDatagram->m_nLength = strData.GetLength();
+        memcpy( &pDatagram->m_stAddress, pAddress, nAddressLength );
+        pDatagram->m_nAddressLength = nAddressLength;
+        m_nPending++;
+
+        if ( m_nPending == SEND_BATCH_SIZE )
+        {
+            FlushResponses();
+        }
+    }
+
+    void CSipDialogWorker::FlushResponses( void )
+    {
+        if ( m_nPending == 0 )
+        {
+            return;
+        }
+
+        size_t nSent = m_pUdpSocket->SendBatch( m_aPending, m_nPending );
+        if ( nSent < m_nPending )
+        {
+                // UDP delivery is best effort, and the transaction layer (or the
+                // client) will retransmit.
+            WARN_LOG( "Only %d of %d SIP datagrams could be sent: %d - %s", (int)nSent, (int)m_nPending, errno, strerror( errno ) );
+        }
+
+        for ( size_t nX = 0; nX < m_nPending; nX++ )
+        {
+            m_astrPending[ nX ].Clear();
+        }
+        m_nPending = 0;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_MULTI_THREADED__
+#endif // IASLIB_NETWORKING__
@@ -17,6 +17,15 @@
  * response to the request. 
  *      By default the handler factory is set to the base handlers
  * that return default responses to most SIP commands.
+ *      Inbound messages are read by the server thread (batched
+ * datagram reads for UDP, an epoll loop for TCP) and handed to a
+ * fixed set of dialog workers. The worker is chosen by hashing the
+ * Call-ID, so every message of a dialog is processed in order on
+ * the same thread.
+ *      A UDP server can also be given several receive sockets. They
+ * all bind the SIP port with SO_REUSEPORT, each is read by its own
+ * thread, and the kernel spreads the inbound datagrams between them.
+ * Since dispatch is still by Call-ID, dialogs stay on one worker.
  *
  *	Author: Jeffrey R. Naujok
  *	Created: December 21, 2019
@@ -28,38 +37,610 @@
 #ifdef IASLIB_NETWORKING__
 
 #include "NetworkServices/SIP/SipServer.h"
+#include "Exceptions/SocketException.h"
+#include "Logging/LogSink.h"
+#include <errno.h>
+#include <strings.h>
+
+#ifdef IASLIB_LINUX__
+#include <poll.h>
+#include <sys/epoll.h>
+#endif
 
 namespace IASLib
 {
+        // Every receiver thread takes round-robin turns from one counter
+#ifdef IASLIB_MULTI_THREADED__
+    #ifdef IASLIB_WIN32__
+    static long NextTurn( volatile long *pnCounter ) { return InterlockedIncrement( pnCounter ) - 1; }
+    #else
+    static long NextTurn( volatile long *pnCounter ) { return __sync_fetch_and_add( pnCounter, 1 ); }
+    #endif
+#else
+    static long NextTurn( volatile long *pnCounter ) { return (*pnCounter)++; }
+#endif
+
+    IMPLEMENT_OBJECT( CSipUdpReceiver, CThread );
+
+    CSipUdpReceiver::CSipUdpReceiver( CSipServer *pServer, CUDPSocket *pSocket, size_t nReceiverNumber ) : CThread( (const char *)CString::FormatString( "SipUdpReceiver_%d", (int)nReceiverNumber ), true, false, true )
+    {
+        m_pServer = pServer;
+        m_pSocket = pSocket;
+
+        Resume();
+    }
+
+    CSipUdpReceiver::~CSipUdpReceiver( void )
+    {
+        delete m_pSocket;
+        m_pSocket = NULL;
+    }
+
+    void *CSipUdpReceiver::Run( void )
+    {
+        m_pServer->ReceiveDatagrams( m_pSocket, this );
+
+        return NULL;
+    }
+
     IMPLEMENT_OBJECT( CSipServer, CGenericServer );
 
         // Bind to a port on all interfaces Note Port 5060 is default for SIP, 5061 for SIPS
-    CSipServer::CSipServer( int nSipPort, bool bSecure, bool useUDP ) : CGenericServer(), m_bIsUDP( useUDP ), m_bSecure( bSecure )
+    CSipServer::CSipServer( int nSipPort, bool bSecure, bool useUDP, size_t nWorkerThreads, size_t nReceiveSockets ) : CGenericServer( "SipServer", true ), m_bSecure( bSecure ), m_bIsUDP( useUDP ), m_hashConnections( CHash::LARGE )
     {
+        Initialize( nSipPort, nWorkerThreads, nReceiveSockets );
+    }
+
+                                // Bind to a port on a specific interface
+    CSipServer::CSipServer( const char *boundInterface, int nSipPort, bool bSecure, bool useUDP, size_t nWorkerThreads, size_t nReceiveSockets ) : CGenericServer( "SipServer", true ), m_bSecure( bSecure ), m_bIsUDP( useUDP ), m_hashConnections( CHash::LARGE )
+    {
+        if ( boundInterface )
+        {
+            WARN_LOG( "SIP server binding to a specific interface (%s) is not supported, listening on all interfaces.", boundInterface );
+        }
+        Initialize( nSipPort, nWorkerThreads, nReceiveSockets );
+    }
+
+    CSipServer::~CSipServer( void )
+    {
+            // The server's own thread reads the sockets and hands messages
+            // to the workers, so it has to be stopped before any of them go.
+        RequestShutdown();
+        Join();
+
+        for ( size_t nX = 0; nX < m_aReceivers.GetCount(); nX++ )
+        {
+            CSipUdpReceiver *pReceiver = (CSipUdpReceiver *)m_aReceivers[ nX ];
+            pReceiver->RequestShutdown();
+            pReceiver->Join();
+        }
+        m_aReceivers.DeleteAll();
+
+        for ( size_t nX = 0; nX < m_aWorkers.GetCount(); nX++ )
+        {
+            CSipDialogWorker *pWorker = (CSipDialogWorker *)m_aWorkers[ nX ];
+            pWorker->Shutdown();
+        }
+        m_aWorkers.DeleteAll();
+
+        if ( getUdpSocket() )
+        {
+            delete getUdpSocket();
+            setUdpSocket( NULL );
+        }
+
+        if ( m_pServerSocket )
+        {
+            delete m_pServerSocket;
+            m_pServerSocket = NULL;
+        }
+    }
+
+    /**
+     * Initialize
+     *
+     *      Opens the transport socket and starts the dialog workers. The
+     * server thread is created suspended, and is only released once all of
+     * this is in place.
+     *
+     * @param nSipPort
+     *      The port to listen on.
+     * @param nWorkerThreads
+     *      The number of dialog workers to start. Zero starts one per
+     *      online processor.
+     * @param nReceiveSockets
+     *      The number of SO_REUSEPORT sockets (and threads) reading the UDP
+     *      port. The server thread reads the first.
+     */
+    void CSipServer::Initialize( int nSipPort, size_t nWorkerThreads, size_t nReceiveSockets )
+    {
+        m_nPort = nSipPort;
+        m_pServerSocket = NULL;
+        m_nNextWorker = 0;
+        m_hEpoll = -1;
+
+        if ( nWorkerThreads == 0 )
+        {
+#ifdef IASLIB_WIN32__
+            SYSTEM_INFO sysInfo;
+            GetSystemInfo( &sysInfo );
+            nWorkerThreads = (size_t)sysInfo.dwNumberOfProcessors;
+#else
+            long nProcessors = sysconf( _SC_NPROCESSORS_ONLN );
+            nWorkerThreads = ( nProcessors > 0 ) ? (size_t)nProcessors : 1;
+#endif
+        }
+        m_nWorkers = nWorkerThreads;
+
         if ( isUdp() )
         {
+            bool bReusePort = ( nReceiveSockets > 1 );
 
+            setUdpSocket( new CUDPSocket( nSipPort, bReusePort ) );
+            for ( size_t nX = 1; nX < nReceiveSockets; nX++ )
+            {
+                m_aReceivers.Append( new CSipUdpReceiver( this, new CUDPSocket( nSipPort, bReusePort ), nX ) );
+            }
         }
         else
         {
+            m_pServerSocket = new CServerSocket( nSipPort, CServerSocket::DEFAULT_BACKLOG, m_bSecure );
+            setSocket( m_pServerSocket );
+        }
 
+        for ( size_t nX = 0; nX < m_nWorkers; nX++ )
+        {
+            m_aWorkers.Append( new CSipDialogWorker( this, getUdpSocket(), nX ) );
         }
+
+        Resume();
     }
 
-                                // Bind to a port on a specific interface
-    CSipServer::CSipServer( const char *boundInterface, int nSipPort, bool bSecure, bool useUDP ) : CGenericServer(), m_bIsUDP( useUDP ), m_bSecure( bSecure )
+    void *CSipServer::Run( void )
+    {
+        if ( isUdp() )
+        {
+            ReceiveDatagrams( getUdpSocket(), this );
+        }
+        else
+        {
+            if ( isSecure() )
+            {
+                ERROR_LOG( "The SIP transport does not support TLS (SIPS) connections on port %d.", m_nPort );
+                return NULL;
+            }
+            RunTcp();
+        }
+
+        return NULL;
+    }
+
+    /**
+     * GetWorkerIndex
+     *
+     *      Picks the worker for a message by hashing its Call-ID header, so
+     * that all messages in the same dialog land on the same worker. Messages
+     * without a Call-ID do not belong to a dialog and are spread round-robin.
+     */
+    size_t CSipServer::GetWorkerIndex( const char *pchMessage, size_t nLength )
     {
+        size_t nValueLength = 0;
+        const char *pchCallId = FindHeaderValue( pchMessage, nLength, "Call-ID", "i", nValueLength );
+
+        if ( pchCallId == NULL )
+        {
+            return (size_t)(unsigned long)NextTurn( &m_nNextWorker ) % m_nWorkers;
+        }
+
+            // FNV-1a over the raw Call-ID bytes
+        unsigned int nHash = 2166136261U;
+        for ( size_t nX = 0; nX < nValueLength; nX++ )
+        {
+            nHash ^= (unsigned char)pchCallId[ nX ];
+            nHash *= 16777619U;
+        }
 
+        return (size_t)nHash % m_nWorkers;
     }
 
-    CSipServer::~CSipServer( void )
+    /**
+     * FindHeaderValue
+     *
+     *      Locates a header value in a raw SIP message without parsing the
+     * whole message. Header names are matched without regard to case, and
+     * the compact form of the name (RFC 3261 section 7.3.3) is accepted as
+     * well.
+     *
+     * @param pchMessage
+     *      The raw message, starting with the request or status line.
+     * @param nLength
+     *      The number of bytes in the message.
+     * @param strName
+     *      The full name of the header.
+     * @param strCompactName
+     *      The compact name of the header, or NULL if it has none.
+     * @param nValueLength
+     *      [out] The length of the value found, with surrounding white
+     *      space removed.
+     * @return
+     *      A pointer to the first character of the value, or NULL if the
+     *      header isn't present.
+     */
+    const char *CSipServer::FindHeaderValue( const char *pchMessage, size_t nLength, const char *strName, const char *strCompactName, size_t &nValueLength )
     {
+        const char *pchEnd = pchMessage + nLength;
+        const char *pchLine = (const char *)memchr( pchMessage, '\n', nLength );
+        size_t      nNameLength = strlen( strName );
+        size_t      nCompactLength = ( strCompactName ) ? strlen( strCompactName ) : 0;
+
+        nValueLength = 0;
 
+        while ( ( pchLine ) && ( pchLine + 1 < pchEnd ) )
+        {
+            pchLine++;
+
+                // A blank line ends the header block
+            if ( ( *pchLine == '\r' ) || ( *pchLine == '\n' ) )
+            {
+                break;
+            }
+
+            const char *pchEol = (const char *)memchr( pchLine, '\n', (size_t)( pchEnd - pchLine ) );
+            if ( pchEol == NULL )
+            {
+                pchEol = pchEnd;
+            }
+
+            const char *pchColon = (const char *)memchr( pchLine, ':', (size_t)( pchEol - pchLine ) );
+            if ( pchColon )
+            {
+                const char *pchNameEnd = pchColon;
+                while ( ( pchNameEnd > pchLine ) && ( ( pchNameEnd[ -1 ] == ' ' ) || ( pchNameEnd[ -1 ] == '\t' ) ) )
+                {
+                    pchNameEnd--;
+                }
+
+                size_t nFound = (size_t)( pchNameEnd - pchLine );
+
+                if ( ( ( nFound == nNameLength ) && ( strncasecmp( pchLine, strName, nNameLength ) == 0 ) ) ||
+                     ( ( nCompactLength ) && ( nFound == nCompactLength ) && ( strncasecmp( pchLine, strCompactName, nCompactLength ) == 0 ) ) )
+                {
+                    const char *pchValue = pchColon + 1;
+                    const char *pchValueEnd = pchEol;
+
+                    while ( ( pchValue < pchValueEnd ) && ( ( *pchValue == ' ' ) || ( *pchValue == '\t' ) ) )
+                    {
+                        pchValue++;
+                    }
+
+                    while ( ( pchValueEnd > pchValue ) && ( ( pchValueEnd[ -1 ] == '\r' ) || ( pchValueEnd[ -1 ] == ' ' ) || ( pchValueEnd[ -1 ] == '\t' ) ) )
+                    {
+                        pchValueEnd--;
+                    }
+
+                    nValueLength = (size_t)( pchValueEnd - pchValue );
+                    return pchValue;
+                }
+            }
+
+            pchLine = ( pchEol < pchEnd ) ? pchEol : NULL;
+        }
+
+        return NULL;
     }
 
-    void *CSipServer::Run( void )
+    /**
+     * FrameMessage
+     *
+     *      Determines whether a stream buffer holds a complete SIP message.
+     * Over a stream transport the message ends after the blank line that
+     * terminates the headers, plus Content-Length bytes of body.
+     *
+     * @return
+     *      The length of the first complete message in the buffer, zero if
+     *      more data is needed, or NOT_FOUND if the Content-Length isn't a
+     *      number, or is more than a connection may buffer, in which case
+     *      the stream can't be framed any further.
+     */
+    size_t CSipServer::FrameMessage( const char *pchBuffer, size_t nLength )
+    {
+        size_t nHeaderEnd = NOT_FOUND;
+
+        for ( size_t nX = 0; nX + 3 < nLength; nX++ )
+        {
+            if ( ( pchBuffer[ nX ] == '\r' ) && ( pchBuffer[ nX + 1 ] == '\n' ) && ( pchBuffer[ nX + 2 ] == '\r' ) && ( pchBuffer[ nX + 3 ] == '\n' ) )
+            {
+                nHeaderEnd = nX + 4;
+                break;
+            }
+        }
+
+        if ( nHeaderEnd == NOT_FOUND )
+        {
+            return 0;
+        }
+
+        size_t nValueLength = 0;
+        size_t nContentLength = 0;
+        const char *pchValue = FindHeaderValue( pchBuffer, nHeaderEnd, "Content-Length", "l", nValueLength );
+
+        if ( pchValue )
+        {
+            if ( nValueLength == 0 )
+            {
+                return NOT_FOUND;
+            }
+
+            for ( size_t nX = 0; nX < nValueLength; nX++ )
+            {
+                if ( ( pchValue[ nX ] < '0' ) || ( pchValue[ nX ] > '9' ) )
+                {
+                    return NOT_FOUND;
+                }
+
+                nContentLength = ( nContentLength * 10 ) + (size_t)( pchValue[ nX ] - '0' );
+                if ( nContentLength > MAX_STREAM_BUFFER )
+                {
+                    return NOT_FOUND;
+                }
+            }
+        }
+
+        if ( nHeaderEnd + nContentLength > nLength )
+        {
+            return 0;
+        }
+
+        return nHeaderEnd + nContentLength;
+    }
+
+    void CSipServer::Dispatch( CSipInboundMessage *pMessage )
+    {
+        const CString &strData = pMessage->GetData();
+        size_t nWorker = GetWorkerIndex( (const char *)strData, strData.GetLength() );
+
+        ((CSipDialogWorker *)m_aWorkers[ nWorker ])->Enqueue( pMessage );
+    }
+
+    /**
+     * ReceiveDatagrams
+     *
+     *      The datagram receive loop for one socket, run by the server thread
+     * and by each extra receiver. Every wake-up drains the socket in
+     * batches of RECEIVE_BATCH_SIZE datagrams, read into buffers that are
+     * allocated once for the life of the loop.
+     *
+     * @param pSocket
+     *      The socket to read.
+     * @param pThread
+     *      The thread running the loop, which returns once it is asked to
+     *      shut down.
+     */
+    void CSipServer::ReceiveDatagrams( CUDPSocket *pSocket, CThread *pThread )
+    {
+        char                   *pchBuffers = new char[ RECEIVE_BATCH_SIZE * MAX_DATAGRAM_SIZE ];
+        CUDPSocket::Datagram    aDatagrams[ RECEIVE_BATCH_SIZE ];
+
+        for ( size_t nX = 0; nX < RECEIVE_BATCH_SIZE; nX++ )
+        {
+            aDatagrams[ nX ].m_pchBuffer = pchBuffers + ( nX * MAX_DATAGRAM_SIZE );
+            aDatagrams[ nX ].m_nBufferSize = MAX_DATAGRAM_SIZE;
+        }
+
+        while ( ! pThread->IsShutdown() )
+        {
+#ifdef IASLIB_LINUX__
+            struct pollfd stPoll;
+            stPoll.fd = pSocket->GetHandle();
+            stPoll.events = POLLIN;
+            stPoll.revents = 0;
+
+            if ( poll( &stPoll, 1, POLL_TIMEOUT_MS ) <= 0 )
+            {
+                continue;
+            }
+#endif
+
+            size_t nReceived = RECEIVE_BATCH_SIZE;
+            while ( ( nReceived == RECEIVE_BATCH_SIZE ) && ( ! pThread->IsShutdown() ) )
+            {
+                try
+                {
+                    nReceived = pSocket->ReadBatch( aDatagrams, RECEIVE_BATCH_SIZE, false );
+                }
+                catch ( CSocketException *pE )
+                {
+                    WARN_LOG( "SIP datagram read failed: %s", (const char *)*pE );
+                    delete pE;
+                    nReceived = 0;
+                }
+
+                for ( size_t nX = 0; nX < nReceived; nX++ )
+                {
+                    if ( aDatagrams[ nX ].m_nLength > 0 )
+                    {
+                        Dispatch( new CSipInboundMessage( aDatagrams[ nX ].m_pchBuffer, aDatagrams[ nX ].m_nLength, (const struct sockaddr *)&aDatagrams[ nX ].m_stAddress, aDatagrams[ nX ].m_nAddressLength ) );
+                    }
+                }
+            }
+        }
+
+        delete [] pchBuffers;
+    }
+
+    /**
+     * RunTcp
+     *
+     *      The stream transport loop. A single epoll set holds the listening
+     * socket and every accepted connection; complete messages are framed
+     * here and handed to the dialog workers.
+     */
+    void CSipServer::RunTcp( void )
+    {
+#ifdef IASLIB_LINUX__
+        struct epoll_event stEvent;
+        struct epoll_event aEvents[ RECEIVE_BATCH_SIZE ];
+
+        m_hEpoll = epoll_create1( EPOLL_CLOEXEC );
+        if ( m_hEpoll < 0 )
+        {
+            ERROR_LOG( "Unable to create SIP epoll set: %d - %s", errno, strerror( errno ) );
+            return;
+        }
+
+        m_pServerSocket->SetNonBlocking( true );
+
+        memset( &stEvent, 0, sizeof( stEvent ) );
+        stEvent.events = EPOLLIN;
+        stEvent.data.ptr = NULL;
+        epoll_ctl( m_hEpoll, EPOLL_CTL_ADD, m_pServerSocket->GetHandle(), &stEvent );
+
+        while ( ! m_bShutdown )
+        {
+            int nEvents = epoll_wait( m_hEpoll, aEvents, RECEIVE_BATCH_SIZE, POLL_TIMEOUT_MS );
+
+            for ( int nX = 0; nX < nEvents; nX++ )
+            {
+                if ( aEvents[ nX ].data.ptr == NULL )
+                {
+                    AcceptConnections();
+                }
+                else
+                {
+                    ReadConnection( (CSipTcpConnection *)aEvents[ nX ].data.ptr );
+                }
+            }
+        }
+
+        CIterator *pIterator = m_hashConnections.Enumerate();
+        CArray aOpen;
+        while ( pIterator->HasMore() )
+        {
+            aOpen.Append( pIterator->Next() );
+        }
+        delete pIterator;
+
+        for ( size_t nX = 0; nX < aOpen.GetCount(); nX++ )
+        {
+            CloseConnection( (CSipTcpConnection *)aOpen[ nX ] );
+        }
+        aOpen.EmptyAll();
+
+        close( m_hEpoll );
+        m_hEpoll = -1;
+#else
+        ERROR_LOG( "The SIP stream transport requires epoll support." );
+#endif
+    }
+
+    void CSipServer::AcceptConnections( void )
+    {
+#ifdef IASLIB_LINUX__
+        while ( true )
+        {
+            CSocket *pSocket = NULL;
+
+            try
+            {
+                pSocket = m_pServerSocket->Accept();
+            }
+            catch ( CSocketException *pE )
+            {
+                    // EAGAIN - the accept queue has been emptied.
+                delete pE;
+                return;
+            }
+
+            if ( pSocket == NULL )
+            {
+                return;
+            }
+
+            CSipTcpConnection *pConnection = new CSipTcpConnection( pSocket );
+            struct epoll_event stEvent;
+
+            memset( &stEvent, 0, sizeof( stEvent ) );
+            stEvent.events = EPOLLIN | EPOLLRDHUP;
+            stEvent.data.ptr = pConnection;
+
+            if ( epoll_ctl( m_hEpoll, EPOLL_CTL_ADD, pSocket->GetHandle(), &stEvent ) != 0 )
+            {
+                pConnection->Close();
+                pConnection->Release();
+                continue;
+            }
+
+            m_hashConnections.Push( (int)pSocket->GetHandle(), pConnection, false );
+        }
+#endif
+    }
+
+    void CSipServer::ReadConnection( CSipTcpConnection *pConnection )
     {
+        char achBuffer[ 16384 ];
+        SOCKET hSocket = pConnection->GetSocket()->GetHandle();
+
+        int nRead = recv( hSocket, achBuffer, sizeof( achBuffer ), MSG_DONTWAIT );
+
+        if ( nRead < 0 )
+        {
+            if ( ( errno == EAGAIN ) || ( errno == EWOULDBLOCK ) || ( errno == EINTR ) )
+            {
+                return;
+            }
+        }
+
+        if ( nRead <= 0 )
+        {
+            CloseConnection( pConnection );
+            return;
+        }
+
+        CString &strBuffer = pConnection->GetBuffer();
+        strBuffer += CString( achBuffer, (size_t)nRead );
+
+            // Strip keep-alive CRLFs (RFC 5626) sitting between messages
+        size_t nSkip = 0;
+        while ( ( nSkip < strBuffer.GetLength() ) && ( ( strBuffer[ nSkip ] == '\r' ) || ( strBuffer[ nSkip ] == '\n' ) ) )
+        {
+            nSkip++;
+        }
+        if ( nSkip )
+        {
+            strBuffer = strBuffer.Substring( nSkip );
+        }
+
+        size_t nFrame = FrameMessage( (const char *)strBuffer, strBuffer.GetLength() );
+        while ( ( nFrame ) && ( nFrame != NOT_FOUND ) )
+        {
+            Dispatch( new CSipInboundMessage( strBuffer.Substring( 0, (int)nFrame ), pConnection, pConnection->GetPeerAddress(), pConnection->GetPeerAddressLength() ) );
+            strBuffer = strBuffer.Substring( nFrame );
+            nFrame = FrameMessage( (const char *)strBuffer, strBuffer.GetLength() );
+        }
+
+        if ( nFrame == NOT_FOUND )
+        {
+            WARN_LOG( "Dropping SIP connection with a bad Content-Length." );
+            CloseConnection( pConnection );
+        }
+        else if ( strBuffer.GetLength() > MAX_STREAM_BUFFER )
+        {
+            WARN_LOG( "Dropping SIP connection with %d unframed bytes buffered.", (int)strBuffer.GetLength() );
+            CloseConnection( pConnection );
+        }
+    }
+
+    void CSipServer::CloseConnection( CSipTcpConnection *pConnection )
+    {
+        SOCKET hSocket = pConnection->GetSocket()->GetHandle();
+
+#ifdef IASLIB_LINUX__
+        epoll_ctl( m_hEpoll, EPOLL_CTL_DEL, hSocket, NULL );
+#endif
+        m_hashConnections.Remove( (int)hSocket );
 
+        pConnection->Close();
+        pConnection->Release();
     }
 
     CSipHandler *CSipServer::GetHandler( CSipRequest *request, CUUID erid )
@@ -0,0 +1,315 @@
+/**
+ * SIP Timer Wheel class
+ *
+ *      This class provides a hashed timing wheel for the SIP transaction
+ * timers. Timers are dropped into a slot chosen by their expiry tick, and
+ * a timer further out than one revolution of the wheel simply carries the
+ * number of revolutions left to wait. Scheduling and cancelling are
+ * constant time, and advancing the wheel only visits the slots that have
+ * come due, so thousands of outstanding transactions cost no more than a
+ * handful.
+ *      The wheel is not locked. It is owned by a single dialog worker, and
+ * is only ever touched from that worker's thread.
+ *
+ * Author: Jeffrey R. Naujok
+ * Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_NETWORKING__
+
+#include "NetworkServices/SIP/SipTimerWheel.h"
+#include <time.h>
+
+#ifdef IASLIB_WIN32__
+#include <windows.h>
+#endif
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CSipTimerWheel, CObject );
+
+    /**
+     * Constructor
+     *
+     * @param ulTickMilliseconds
+     *      The resolution of the wheel. Timers are rounded up to a whole
+     *      number of ticks.
+     * @param nSlots
+     *      The number of slots in the wheel. Rounded up to a power of two so
+     *      that the slot can be found with a mask.
+     */
+    CSipTimerWheel::CSipTimerWheel( unsigned long ulTickMilliseconds, size_t nSlots )
+    {
+        m_nSlots = 1;
+        while ( m_nSlots < nSlots )
+        {
+            m_nSlots <<= 1;
+        }
+        m_nSlotMask = m_nSlots - 1;
+
+        m_ulTickMilliseconds = ( ulTickMilliseconds ) ? ulTickMilliseconds : 1;
+        m_aSlots = new Timer[ m_nSlots ];
+        for ( size_t nX = 0; nX < m_nSlots; nX++ )
+        {
+            m_aSlots[ nX ].m_pNext = &m_aSlots[ nX ];
+            m_aSlots[ nX ].m_pPrev = &m_aSlots[ nX ];
+        }
+
+        m_nCurrentSlot = 0;
+        m_nTimers = 0;
+        m_pFreeList = NULL;
+        m_ullLastTick = GetMilliseconds();
+    }
+
+    CSipTimerWheel::~CSipTimerWheel( void )
+    {
+        for ( size_t nX = 0; nX < m_nSlots; nX++ )
+        {
+            Timer *pList = &m_aSlots[ nX ];
+            while ( pList->m_pNext != pList )
+            {
+                Timer *pTimer = pList->m_pNext;
+                Unlink( pTimer );
+                delete pTimer;
+            }
+        }
+        delete [] m_aSlots;
+
+        while ( m_pFreeList )
+        {
+            Timer *pTimer = m_pFreeList;
+            m_pFreeList = pTimer->m_pNext;
+            delete pTimer;
+        }
+    }
+
+    CSipTimerWheel::Timer *CSipTimerWheel::Schedule( CSipTimerTarget *pTarget, int nTimer, unsigned long ulDelayMilliseconds )
+    {
+        return Schedule( pTarget, nTimer, ulDelayMilliseconds, GetMilliseconds() );
+    }
+
+    /**
+     * Schedule
+     *
+     *      Arms a timer. The wheel only moves when it's advanced, so after
+     * a quiet spell it can be some ticks behind the clock; the timer is
+     * placed that many ticks further on, so it still fires on time once
+     * the wheel catches up. An empty wheel is just moved up to the clock.
+     *
+     * @param pTarget
+     *      The object to notify when the timer fires.
+     * @param nTimer
+     *      A value identifying the timer to the target.
+     * @param ulDelayMilliseconds
+     *      How long from now the timer should fire.
+     * @param ullNow
+     *      The current time, from GetMilliseconds().
+     * @return
+     *      A handle that can be passed to Cancel() until the timer fires.
+     */
+    CSipTimerWheel::Timer *CSipTimerWheel::Schedule( CSipTimerTarget *pTarget, int nTimer, unsigned long ulDelayMilliseconds, unsigned long long ullNow )
+    {
+        size_t nTicks = (size_t)( ( ulDelayMilliseconds + m_ulTickMilliseconds - 1 ) / m_ulTickMilliseconds );
+        if ( nTicks == 0 )
+        {
+            nTicks = 1;
+        }
+
+        size_t nBehind = 0;
+        if ( ullNow > m_ullLastTick )
+        {
+            nBehind = (size_t)( ( ullNow - m_ullLastTick ) / m_ulTickMilliseconds );
+        }
+
+        if ( m_nTimers == 0 )
+        {
+            m_ullLastTick += (unsigned long long)nBehind * m_ulTickMilliseconds;
+            m_nCurrentSlot = ( m_nCurrentSlot + nBehind ) & m_nSlotMask;
+            nBehind = 0;
+        }
+        nTicks += nBehind;
+
+        Timer *pTimer = AllocateTimer();
+        pTimer->m_pTarget = pTarget;
+        pTimer->m_nTimer = nTimer;
+        pTimer->m_nRounds = ( nTicks - 1 ) / m_nSlots;
+
+        Link( &m_aSlots[ ( m_nCurrentSlot + nTicks ) & m_nSlotMask ], pTimer );
+        m_nTimers++;
+
+        return pTimer;
+    }
+
+    void CSipTimerWheel::Cancel( Timer *pTimer )
+    {
+        if ( pTimer )
+        {
+            Unlink( pTimer );
+            FreeTimer( pTimer );
+            m_nTimers--;
+        }
+    }
+
+    size_t CSipTimerWheel::Advance( void )
+    {
+        return Advance( GetMilliseconds() );
+    }
+
+    /**
+     * Advance
+     *
+     *      Moves the wheel forward to the given time, firing every timer
+     * that has come due along the way. Targets are free to schedule or
+     * cancel timers from inside OnTimer().
+     *
+     * @param ullNow
+     *      The current time, from GetMilliseconds().
+     * @return
+     *      The number of timers fired.
+     */
+    size_t CSipTimerWheel::Advance( unsigned long long ullNow )
+    {
+        size_t nFired = 0;
+
+        while ( ullNow >= m_ullLastTick + m_ulTickMilliseconds )
+        {
+            m_ullLastTick += m_ulTickMilliseconds;
+            m_nCurrentSlot = ( m_nCurrentSlot + 1 ) & m_nSlotMask;
+
+            Timer *pSlot = &m_aSlots[ m_nCurrentSlot ];
+            if ( pSlot->m_pNext == pSlot )
+            {
+                continue;
+            }
+
+                // Move the slot's contents onto a private list, so that timers
+                // scheduled by the callbacks land in the slot untouched.
+            Timer due;
+            due.m_pNext = pSlot->m_pNext;
+            due.m_pPrev = pSlot->m_pPrev;
+            due.m_pNext->m_pPrev = &due;
+            due.m_pPrev->m_pNext = &due;
+            pSlot->m_pNext = pSlot;
+            pSlot->m_pPrev = pSlot;
+
+            while ( due.m_pNext != &due )
+            {
+                Timer *pTimer = due.m_pNext;
+                Unlink( pTimer );
+
+                if ( pTimer->m_nRounds )
+                {
+                    pTimer->m_nRounds--;
+                    Link( pSlot, pTimer );
+                    continue;
+                }
+
+                CSipTimerTarget *pTarget = pTimer->m_pTarget;
+                int nTimer = pTimer->m_nTimer;
+
+                FreeTimer( pTimer );
+                m_nTimers--;
+                nFired++;
+
+                pTarget->OnTimer( nTimer );
+            }
+        }
+
+        return nFired;
+    }
+
+    /**
+     * GetNextTimeout
+     *
+     *      Returns how long the owner can sleep before the wheel next needs
+     * to be advanced, in milliseconds. When nothing is scheduled, the
+     * value returned is 0xFFFFFFFF.
+     */
+    unsigned long CSipTimerWheel::GetNextTimeout( void )
+    {
+        if ( m_nTimers == 0 )
+        {
+            return 0xFFFFFFFFUL;
+        }
+
+        size_t nTicks = 1;
+        while ( nTicks < m_nSlots )
+        {
+            Timer *pSlot = &m_aSlots[ ( m_nCurrentSlot + nTicks ) & m_nSlotMask ];
+            if ( pSlot->m_pNext != pSlot )
+            {
+                break;
+            }
+            nTicks++;
+        }
+
+        unsigned long long ullDue = m_ullLastTick + ( nTicks * m_ulTickMilliseconds );
+        unsigned long long ullNow = GetMilliseconds();
+
+        return ( ullDue > ullNow ) ? (unsigned long)( ullDue - ullNow ) : 0;
+    }
+
+    /**
+     * GetMilliseconds
+     *
+     *      Returns a monotonic clock reading in milliseconds. Only the
+     * differences between readings are meaningful.
+     */
+    unsigned long long CSipTimerWheel::GetMilliseconds( void )
+    {
+#ifdef IASLIB_WIN32__
+        return (unsigned long long)GetTickCount64();
+#else
+        struct timespec ts;
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+        return ( (unsigned long long)ts.tv_sec * 1000ULL ) + (unsigned long long)( ts.tv_nsec / 1000000L );
+#endif
+    }
+
+    void CSipTimerWheel::Link( Timer *pList, Timer *pTimer )
+    {
+        pTimer->m_pPrev = pList->m_pPrev;
+        pTimer->m_pNext = pList;
+        pList->m_pPrev->m_pNext = pTimer;
+        pList->m_pPrev = pTimer;
+    }
+
+    void CSipTimerWheel::Unlink( Timer *pTimer )
+    {
+        pTimer->m_pPrev->m_pNext = pTimer->m_pNext;
+        pTimer->m_pNext->m_pPrev = pTimer->m_pPrev;
+        pTimer->m_pNext = pTimer;
+        pTimer->m_pPrev = pTimer;
+    }
+
+    CSipTimerWheel::Timer *CSipTimerWheel::AllocateTimer( void )
+    {
+        Timer *pTimer = m_pFreeList;
+
+        if ( pTimer )
+        {
+            m_pFreeList = pTimer->m_pNext;
+        }
+        else
+        {
+            pTimer = new Timer;
+        }
+
+        pTimer->m_pNext = pTimer;
+        pTimer->m_pPrev = pTimer;
+
+        return pTimer;
+    }
+
+    void CSipTimerWheel::FreeTimer( Timer *pTimer )
+    {
+        pTimer->m_pTarget = NULL;
+        pTimer->m_pNext = m_pFreeList;
+        m_pFreeList = pTimer;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_NETWORKING__
@@ -0,0 +1,506 @@
+/**
+ * SIP Transaction classes
+ *
+ *      These classes hold the RFC 3261 (section 17) transaction state for
+ * a single request and its responses. Server transactions absorb
+ * retransmitted requests by re-sending the last response, so the handlers
+ * only ever see a request once, and re-send final INVITE responses over
+ * unreliable transports until the ACK arrives (timers G and H). Client
+ * transactions retransmit a request until it is answered or times out
+ * (timers A/B for INVITE, E/F for everything else).
+ *      All timers run on the CSipTimerWheel owned by the transaction's
+ * manager. Transactions are not locked, since the manager and all of its
+ * transactions belong to a single dialog worker.
+ *
+ * Author: Jeffrey R. Naujok
+ * Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_NETWORKING__
+#ifdef IASLIB_MULTI_THREADED__
+
+#include "NetworkServices/SIP/SipTransaction.h"
+#include "NetworkServices/SIP/SipTransactionManager.h"
+#include "NetworkServices/SIP/SipDialogWorker.h"
+#include "NetworkServices/SIP/SipServer.h"
+#include "Logging/LogSink.h"
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CSipTransaction, CObject );
+
+    CSipTransaction::CSipTransaction( CSipTransactionManager *pManager, const CString &strKey, const CString &strBranch, const CString &strMethod, const struct sockaddr *pAddress, socklen_t nAddressLength, CSipTcpConnection *pConnection ) : m_strKey( strKey ), m_strBranch( strBranch ), m_strMethod( strMethod )
+    {
+        m_pManager = pManager;
+        m_bInvite = ( m_strMethod == "INVITE" );
+        m_eState = TRYING;
+        m_nStatusCode = 0;
+        m_ulRetransmitInterval = T1;
+
+        memset( &m_stAddress, 0, sizeof( m_stAddress ) );
+        m_nAddressLength = ( nAddressLength <= (socklen_t)sizeof( m_stAddress ) ) ? nAddressLength : (socklen_t)sizeof( m_stAddress );
+        memcpy( &m_stAddress, pAddress, m_nAddressLength );
+
+        m_pConnection = pConnection;
+        if ( m_pConnection )
+        {
+            m_pConnection->AddRef();
+        }
+
+        for ( int nX = 0; nX < TIMER_COUNT; nX++ )
+        {
+            m_apTimers[ nX ] = NULL;
+        }
+    }
+
+    CSipTransaction::~CSipTransaction( void )
+    {
+        StopAllTimers();
+
+        if ( m_pConnection )
+        {
+            m_pConnection->Release();
+            m_pConnection = NULL;
+        }
+    }
+
+    void CSipTransaction::StartTimer( TransactionTimer eTimer, unsigned long ulMilliseconds )
+    {
+        StopTimer( eTimer );
+        m_apTimers[ eTimer ] = m_pManager->GetWheel().Schedule( this, eTimer, ulMilliseconds );
+    }
+
+    void CSipTransaction::StopTimer( TransactionTimer eTimer )
+    {
+        if ( m_apTimers[ eTimer ] )
+        {
+            m_pManager->GetWheel().Cancel( m_apTimers[ eTimer ] );
+            m_apTimers[ eTimer ] = NULL;
+        }
+    }
+
+    void CSipTransaction::StopAllTimers( void )
+    {
+        for ( int nX = 0; nX < TIMER_COUNT; nX++ )
+        {
+            StopTimer( (TransactionTimer)nX );
+        }
+    }
+
+    void CSipTransaction::Transmit( void )
+    {
+        if ( m_strMessage.GetLength() )
+        {
+            m_pManager->GetOwner()->SendTransactionMessage( this, m_strMessage );
+        }
+    }
+
+    /**
+     * Terminate
+     *
+     *      Moves the transaction to the terminated state and hands it back
+     * to the manager, which deletes it. Nothing may touch the transaction
+     * once this returns.
+     */
+    void CSipTransaction::Terminate( void )
+    {
+        m_eState = TERMINATED;
+        StopAllTimers();
+        m_pManager->Terminated( this );
+    }
+
+    IMPLEMENT_OBJECT( CSipServerTransaction, CSipTransaction );
+
+    CSipServerTransaction::CSipServerTransaction( CSipTransactionManager *pManager, const CString &strKey, const CString &strBranch, const CString &strMethod, const struct sockaddr *pAddress, socklen_t nAddressLength, CSipTcpConnection *pConnection ) : CSipTransaction( pManager, strKey, strBranch, strMethod, pAddress, nAddressLength, pConnection )
+    {
+        m_eState = ( m_bInvite ) ? PROCEEDING : TRYING;
+    }
+
+    CSipServerTransaction::~CSipServerTransaction( void )
+    {
+    }
+
+    /**
+     * ReceiveRetransmission
+     *
+     *      Called when the request that started this transaction arrives
+     * again. The last response is sent again (RFC 3261 17.2.1 and 17.2.2),
+     * and the request goes no further.
+     */
+    void CSipServerTransaction::ReceiveRetransmission( void )
+    {
+        switch ( m_eState )
+        {
+            case PROCEEDING:
+            case COMPLETED:
+            case ACCEPTED:
+                Transmit();
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /**
+     * ReceiveAck
+     *
+     *      Called when the ACK for a non-2xx final response to an INVITE
+     * arrives. Stops the response retransmissions, and waits out timer I
+     * to absorb any ACK retransmissions.
+     */
+    void CSipServerTransaction::ReceiveAck( void )
+    {
+        if ( ( m_bInvite ) && ( m_eState == COMPLETED ) )
+        {
+            StopTimer( TIMER_G );
+            StopTimer( TIMER_H );
+            m_eState = CONFIRMED;
+
+            if ( IsReliable() )
+            {
+                Terminate();
+            }
+            else
+            {
+                StartTimer( TIMER_I, T4 );
+            }
+        }
+    }
+
+    /**
+     * SendResponse
+     *
+     *      Sends a response from the handler, and moves the transaction on
+     * according to its status code.
+     *
+     * @param strResponse
+     *      The fully formatted response.
+     * @param nStatusCode
+     *      The status code of the response.
+     */
+    void CSipServerTransaction::SendResponse( const CString &strResponse, int nStatusCode )
+    {
+        if ( ( m_eState == COMPLETED ) || ( m_eState == CONFIRMED ) || ( m_eState == TERMINATED ) )
+        {
+            return;
+        }
+
+        m_strMessage = strResponse;
+        m_nStatusCode = nStatusCode;
+        Transmit();
+
+        if ( nStatusCode < 200 )
+        {
+                // Handlers answer in one go, so a final response may never
+                // follow; don't hold the transaction open for it forever.
+            m_eState = PROCEEDING;
+            StartTimer( TIMER_GUARD, 64 * T1 );
+            return;
+        }
+
+        StopTimer( TIMER_GUARD );
+
+        if ( m_bInvite )
+        {
+            if ( nStatusCode < 300 )
+            {
+                    // RFC 6026: stay around for 64*T1 so that retransmitted
+                    // INVITEs are answered with the 2xx, not the handler.
+                m_eState = ACCEPTED;
+                StartTimer( TIMER_L, 64 * T1 );
+            }
+            else
+            {
+                m_eState = COMPLETED;
+                if ( ! IsReliable() )
+                {
+                    m_ulRetransmitInterval = T1;
+                    StartTimer( TIMER_G, m_ulRetransmitInterval );
+                }
+                StartTimer( TIMER_H, 64 * T1 );
+            }
+        }
+        else
+        {
+            m_eState = COMPLETED;
+            if ( IsReliable() )
+            {
+                Terminate();
+            }
+            else
+            {
+                StartTimer( TIMER_J, 64 * T1 );
+            }
+        }
+    }
+
+    void CSipServerTransaction::OnTimer( int nTimer )
+    {
+        m_apTimers[ nTimer ] = NULL;
+
+        switch ( nTimer )
+        {
+            case TIMER_G:
+                Transmit();
+                m_ulRetransmitInterval *= 2;
+                if ( m_ulRetransmitInterval > T2 )
+                {
+                    m_ulRetransmitInterval = T2;
+                }
+                StartTimer( TIMER_G, m_ulRetransmitInterval );
+                break;
+
+            case TIMER_H:
+                WARN_LOG( "SIP transaction %s %s: no ACK received for final response %d", (const char *)m_strMethod, (const char *)m_strBranch, m_nStatusCode );
+                Terminate();
+                break;
+
+            case TIMER_GUARD:
+                DEBUG_LOG( "SIP transaction %s %s: no final response after %d", (const char *)m_strMethod, (const char *)m_strBranch, m_nStatusCode );
+                Terminate();
+                break;
+
+            case TIMER_I:
+            case TIMER_J:
+            case TIMER_L:
+                Terminate();
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    IMPLEMENT_OBJECT( CSipClientTransaction, CSipTransaction );
+
+    CSipClientTransaction::CSipClientTransaction( CSipTransactionManager *pManager, const CString &strKey, const CString &strBranch, const CString &strMethod, const CString &strRequest, const struct sockaddr *pAddress, socklen_t nAddressLength, CSipTcpConnection *pConnection ) : CSipTransaction( pManager, strKey, strBranch, strMethod, pAddress, nAddressLength, pConnection ), m_strRequest( strRequest )
+    {
+        m_eState = ( m_bInvite ) ? CALLING : TRYING;
+        m_strMessage = strRequest;
+    }
+
+    CSipClientTransaction::~CSipClientTransaction( void )
+    {
+    }
+
+    /**
+     * Start
+     *
+     *      Sends the request for the first time, and arms the retransmit
+     * (A or E) and timeout (B or F) timers.
+     */
+    void CSipClientTransaction::Start( void )
+    {
+        Transmit();
+
+        m_ulRetransmitInterval = T1;
+        if ( ! IsReliable() )
+        {
+            StartTimer( ( m_bInvite ) ? TIMER_A : TIMER_E, m_ulRetransmitInterval );
+        }
+        StartTimer( ( m_bInvite ) ? TIMER_B : TIMER_F, 64 * T1 );
+    }
+
+    /**
+     * ReceiveResponse
+     *
+     *      Called with every response that matches this transaction. The
+     * owner is told about each new response; retransmitted final responses
+     * are absorbed (and re-ACKed, for INVITE).
+     */
+    void CSipClientTransaction::ReceiveResponse( const CString &strResponse, int nStatusCode )
+    {
+        if ( ( m_eState == COMPLETED ) || ( m_eState == TERMINATED ) )
+        {
+            if ( ( m_bInvite ) && ( m_eState == COMPLETED ) && ( nStatusCode >= 300 ) )
+            {
+                Transmit();
+            }
+            return;
+        }
+
+        m_nStatusCode = nStatusCode;
+        m_pManager->GetOwner()->TransactionResponse( this, nStatusCode, strResponse );
+
+        if ( nStatusCode < 200 )
+        {
+            if ( m_bInvite )
+            {
+                StopTimer( TIMER_A );
+            }
+            else if ( ( m_eState == TRYING ) && ( ! IsReliable() ) )
+            {
+                    // Provisional responses slow timer E down to T2
+                m_ulRetransmitInterval = T2;
+                StartTimer( TIMER_E, m_ulRetransmitInterval );
+            }
+            m_eState = PROCEEDING;
+        }
+        else if ( m_bInvite )
+        {
+            StopTimer( TIMER_A );
+            StopTimer( TIMER_B );
+
+            if ( nStatusCode < 300 )
+            {
+                    // The ACK for a 2xx belongs to the dialog, not to us
+                Terminate();
+            }
+            else
+            {
+                m_eState = COMPLETED;
+                m_strMessage = BuildAck( strResponse );
+                Transmit();
+
+                if ( IsReliable() )
+                {
+                    Terminate();
+                }
+                else
+                {
+                    StartTimer( TIMER_D, 64 * T1 );
+                }
+            }
+        }
+        else
+        {
+            StopTimer( TIMER_E );
+            StopTimer( TIMER_F );
+            m_eState = COMPLETED;
+
+            if ( IsReliable() )
+            {
+                Terminate();
+            }
+            else
+            {
+                StartTimer( TIMER_K, T4 );
+            }
+        }
+    }
+
+    void CSipClientTransaction::OnTimer( int nTimer )
+    {
+        m_apTimers[ nTimer ] = NULL;
+
+        switch ( nTimer )
+        {
+            case TIMER_A:
+                Transmit();
+                m_ulRetransmitInterval *= 2;
+                StartTimer( TIMER_A, m_ulRetransmitInterval );
+                break;
+
+            case TIMER_E:
+                Transmit();
+                m_ulRetransmitInterval *= 2;
+                if ( m_ulRetransmitInterval > T2 )
+                {
+                    m_ulRetransmitInterval = T2;
+                }
+                StartTimer( TIMER_E, m_ulRetransmitInterval );
+                break;
+
+            case TIMER_B:
+            case TIMER_F:
+                m_pManager->GetOwner()->TransactionTimeout( this );
+                Terminate();
+                break;
+
+            case TIMER_D:
+            case TIMER_K:
+                Terminate();
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /**
+     * BuildAck
+     *
+     *      Builds the ACK for a non-2xx final response to our INVITE, as
+     * laid out in RFC 3261 section 17.1.1.3.
+     */
+    CString CSipClientTransaction::BuildAck( const CString &strResponse )
+    {
+        const char *pchRequest = (const char *)m_strRequest;
+        size_t      nRequestLength = m_strRequest.GetLength();
+        size_t      nValueLength = 0;
+        CString     strAck;
+
+            // The Request-URI is the second token of the request line
+        const char *pchUri = (const char *)memchr( pchRequest, ' ', nRequestLength );
+        const char *pchUriEnd = ( pchUri ) ? (const char *)memchr( pchUri + 1, ' ', nRequestLength - (size_t)( pchUri + 1 - pchRequest ) ) : NULL;
+        if ( pchUriEnd == NULL )
+        {
+            return strAck;
+        }
+
+        strAck = "ACK ";
+        strAck += CString( pchUri + 1, (size_t)( pchUriEnd - pchUri - 1 ) );
+        strAck += " SIP/2.0\r\n";
+
+            // Only the top Via is carried over
+        const char *pchValue = CSipServer::FindHeaderValue( pchRequest, nRequestLength, "Via", "v", nValueLength );
+        if ( pchValue )
+        {
+            const char *pchComma = (const char *)memchr( pchValue, ',', nValueLength );
+            strAck += "Via: ";
+            strAck += CString( pchValue, ( pchComma ) ? (size_t)( pchComma - pchValue ) : nValueLength );
+            strAck += "\r\n";
+        }
+
+        strAck += "Max-Forwards: 70\r\n";
+
+        pchValue = CSipServer::FindHeaderValue( pchRequest, nRequestLength, "From", "f", nValueLength );
+        if ( pchValue )
+        {
+            strAck += "From: ";
+            strAck += CString( pchValue, nValueLength );
+            strAck += "\r\n";
+        }
+
+            // To comes from the response, so that it carries the remote tag
+        pchValue = CSipServer::FindHeaderValue( (const char *)strResponse, strResponse.GetLength(), "To", "t", nValueLength );
+        if ( pchValue )
+        {
+            strAck += "To: ";
+            strAck += CString( pchValue, nValueLength );
+            strAck += "\r\n";
+        }
+
+        pchValue = CSipServer::FindHeaderValue( pchRequest, nRequestLength, "Call-ID", "i", nValueLength );
+        if ( pchValue )
+        {
+            strAck += "Call-ID: ";
+            strAck += CString( pchValue, nValueLength );
+            strAck += "\r\n";
+        }
+
+        pchValue = CSipServer::FindHeaderValue( pchRequest, nRequestLength, "CSeq", NULL, nValueLength );
+        if ( pchValue )
+        {
+            size_t nDigits = 0;
+            while ( ( nDigits < nValueLength ) && ( pchValue[ nDigits ] >= '0' ) && ( pchValue[ nDigits ] <= '9' ) )
+            {
+                nDigits++;
+            }
+            strAck += "CSeq: ";
+            strAck += CString( pchValue, nDigits );
+            strAck += " ACK\r\n";
+        }
+
+        strAck += "Content-Length: 0\r\n\r\n";
+
+        return strAck;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_MULTI_THREADED__
+#endif // IASLIB_NETWORKING__
@@ -0,0 +1,319 @@
+/**
+ * SIP Transaction Manager class
+ *
+ *      This class matches inbound SIP messages to their transactions
+ * (RFC 3261 section 17.1.3 and 17.2.3), keyed on the branch parameter of
+ * the top Via header and the method. A retransmitted request is answered
+ * from the transaction, and never reaches the handlers a second time.
+ *      Each dialog worker owns one manager. Since the server always hands
+ * every message of a Call-ID to the same worker, a transaction is only
+ * ever seen by one thread, and none of this needs to be locked.
+ *
+ * Author: Jeffrey R. Naujok
+ * Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_NETWORKING__
+#ifdef IASLIB_MULTI_THREADED__
+
+#include "NetworkServices/SIP/SipTransactionManager.h"
+#include "NetworkServices/SIP/SipServer.h"
+#include <strings.h>
+
+    // RFC 3261 branches all start with this "magic cookie". Anything else
+    // came from an RFC 2543 element, and is handled statelessly.
+#define SIP_BRANCH_COOKIE "z9hG4bK"
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CSipTransactionManager, CObject );
+
+    CSipTransactionManager::CSipTransactionManager( CSipTransactionOwner *pOwner ) : m_hashTransactions( CHash::LARGE )
+    {
+        m_pOwner = pOwner;
+        m_nAbsorbed = 0;
+    }
+
+    CSipTransactionManager::~CSipTransactionManager( void )
+    {
+            // Deleting the transactions cancels their timers, so this has to
+            // happen while the wheel is still around.
+        m_hashTransactions.DeleteAll();
+    }
+
+    /**
+     * ReceiveRequest
+     *
+     *      Matches an inbound request against the server transactions.
+     *
+     * @param strRequest
+     *      The raw request.
+     * @param pAddress
+     *      The address the request came from.
+     * @param nAddressLength
+     *      The length of pAddress.
+     * @param pConnection
+     *      The stream connection the request arrived on, or NULL for a
+     *      datagram.
+     * @param bAbsorbed
+     *      [out] Set when the request was a retransmission (or the ACK of a
+     *      non-2xx response), and has been fully dealt with.
+     * @return
+     *      The new transaction the handler's response must be sent through,
+     *      or NULL when the request should be handled statelessly (or not at
+     *      all, if bAbsorbed is set).
+     */
+    CSipServerTransaction *CSipTransactionManager::ReceiveRequest( const CString &strRequest, const struct sockaddr *pAddress, socklen_t nAddressLength, CSipTcpConnection *pConnection, bool &bAbsorbed )
+    {
+        CString strBranch;
+        CString strMethod;
+
+        bAbsorbed = false;
+
+        if ( ! GetTransactionId( (const char *)strRequest, strRequest.GetLength(), strBranch, strMethod ) )
+        {
+            return NULL;
+        }
+
+        if ( strMethod == "ACK" )
+        {
+                // The ACK of a non-2xx response shares the INVITE's branch. The
+                // ACK of a 2xx has a branch of its own, and goes to the handler.
+            CSipServerTransaction *pInvite = (CSipServerTransaction *)m_hashTransactions.Get( (const char *)( "s " + strBranch + " INVITE" ) );
+            if ( pInvite )
+            {
+                bAbsorbed = true;
+                m_nAbsorbed++;
+                pInvite->ReceiveAck();
+            }
+            return NULL;
+        }
+
+        CString strKey = "s " + strBranch + " " + strMethod;
+
+        CSipServerTransaction *pTransaction = (CSipServerTransaction *)m_hashTransactions.Get( (const char *)strKey );
+        if ( pTransaction )
+        {
+            bAbsorbed = true;
+            m_nAbsorbed++;
+            pTransaction->ReceiveRetransmission();
+            return NULL;
+        }
+
+        pTransaction = new CSipServerTransaction( this, strKey, strBranch, strMethod, pAddress, nAddressLength, pConnection );
+        m_hashTransactions.Push( (const char *)strKey, pTransaction );
+
+        return pTransaction;
+    }
+
+    /**
+     * ReceiveResponse
+     *
+     *      Matches an inbound response against the client transactions.
+     *
+     * @return
+     *      true if the response belonged to one of our transactions.
+     */
+    bool CSipTransactionManager::ReceiveResponse( const CString &strResponse )
+    {
+        CString strBranch;
+        CString strMethod;
+
+        if ( ! GetTransactionId( (const char *)strResponse, strResponse.GetLength(), strBranch, strMethod ) )
+        {
+            return false;
+        }
+
+        CSipClientTransaction *pTransaction = (CSipClientTransaction *)m_hashTransactions.Get( (const char *)( "c " + strBranch + " " + strMethod ) );
+        if ( pTransaction == NULL )
+        {
+            return false;
+        }
+
+        pTransaction->ReceiveResponse( strResponse, GetStatusCode( (const char *)strResponse, strResponse.GetLength() ) );
+
+        return true;
+    }
+
+    void CSipTransactionManager::SendResponse( CSipServerTransaction *pTransaction, const CString &strResponse )
+    {
+        pTransaction->SendResponse( strResponse, GetStatusCode( (const char *)strResponse, strResponse.GetLength() ) );
+    }
+
+    /**
+     * SendRequest
+     *
+     *      Starts a client transaction for an outbound request. The request
+     * must already carry its top Via with an RFC 3261 branch.
+     *
+     * @return
+     *      The transaction, or NULL if the request has no usable branch or
+     *      the branch is already in use.
+     */
+    CSipClientTransaction *CSipTransactionManager::SendRequest( const CString &strRequest, const struct sockaddr *pAddress, socklen_t nAddressLength, CSipTcpConnection *pConnection )
+    {
+        CString strBranch;
+        CString strMethod;
+
+        if ( ! GetTransactionId( (const char *)strRequest, strRequest.GetLength(), strBranch, strMethod ) )
+        {
+            return NULL;
+        }
+
+        CString strKey = "c " + strBranch + " " + strMethod;
+        if ( m_hashTransactions.HasKey( (const char *)strKey ) )
+        {
+            return NULL;
+        }
+
+        CSipClientTransaction *pTransaction = new CSipClientTransaction( this, strKey, strBranch, strMethod, strRequest, pAddress, nAddressLength, pConnection );
+        m_hashTransactions.Push( (const char *)strKey, pTransaction );
+        pTransaction->Start();
+
+        return pTransaction;
+    }
+
+    void CSipTransactionManager::Terminated( CSipTransaction *pTransaction )
+    {
+        m_hashTransactions.Remove( (const char *)pTransaction->GetKey() );
+        delete pTransaction;
+    }
+
+    /**
+     * GetTransactionId
+     *
+     *      Pulls the transaction identifiers out of a raw message: the
+     * branch parameter of the top Via header, and the method (from the
+     * request line, or from CSeq for a response).
+     *
+     * @return
+     *      true if the message has an RFC 3261 branch and a method.
+     */
+    bool CSipTransactionManager::GetTransactionId( const char *pchMessage, size_t nLength, CString &strBranch, CString &strMethod )
+    {
+        size_t      nValueLength = 0;
+        const char *pchVia = CSipServer::FindHeaderValue( pchMessage, nLength, "Via", "v", nValueLength );
+
+        if ( pchVia == NULL )
+        {
+            return false;
+        }
+
+            // Only the first entry of a comma separated Via counts
+        const char *pchViaEnd = (const char *)memchr( pchVia, ',', nValueLength );
+        if ( pchViaEnd == NULL )
+        {
+            pchViaEnd = pchVia + nValueLength;
+        }
+
+        const char *pchBranch = NULL;
+        for ( const char *pchScan = pchVia; pchScan + 8 <= pchViaEnd; pchScan++ )
+        {
+            if ( ( *pchScan == ';' ) && ( strncasecmp( pchScan + 1, "branch", 6 ) == 0 ) )
+            {
+                const char *pchEquals = pchScan + 7;
+                while ( ( pchEquals < pchViaEnd ) && ( ( *pchEquals == ' ' ) || ( *pchEquals == '\t' ) ) )
+                {
+                    pchEquals++;
+                }
+
+                if ( ( pchEquals < pchViaEnd ) && ( *pchEquals == '=' ) )
+                {
+                    pchBranch = pchEquals + 1;
+                    while ( ( pchBranch < pchViaEnd ) && ( ( *pchBranch == ' ' ) || ( *pchBranch == '\t' ) ) )
+                    {
+                        pchBranch++;
+                    }
+                    break;
+                }
+            }
+        }
+
+        if ( pchBranch == NULL )
+        {
+            return false;
+        }
+
+        const char *pchBranchEnd = pchBranch;
+        while ( ( pchBranchEnd < pchViaEnd ) && ( *pchBranchEnd != ';' ) && ( *pchBranchEnd != ' ' ) && ( *pchBranchEnd != '\t' ) )
+        {
+            pchBranchEnd++;
+        }
+
+        size_t nCookieLength = sizeof( SIP_BRANCH_COOKIE ) - 1;
+        if ( ( (size_t)( pchBranchEnd - pchBranch ) <= nCookieLength ) || ( strncmp( pchBranch, SIP_BRANCH_COOKIE, nCookieLength ) != 0 ) )
+        {
+            return false;
+        }
+
+        strBranch = CString( pchBranch, (size_t)( pchBranchEnd - pchBranch ) );
+
+        const char *pchMethod = pchMessage;
+        const char *pchMethodEnd = NULL;
+
+        if ( ( nLength > 8 ) && ( strncmp( pchMessage, "SIP/2.0 ", 8 ) == 0 ) )
+        {
+            pchMethod = CSipServer::FindHeaderValue( pchMessage, nLength, "CSeq", NULL, nValueLength );
+            if ( pchMethod == NULL )
+            {
+                return false;
+            }
+
+            const char *pchCSeqEnd = pchMethod + nValueLength;
+            while ( ( pchMethod < pchCSeqEnd ) && ( *pchMethod >= '0' ) && ( *pchMethod <= '9' ) )
+            {
+                pchMethod++;
+            }
+            while ( ( pchMethod < pchCSeqEnd ) && ( ( *pchMethod == ' ' ) || ( *pchMethod == '\t' ) ) )
+            {
+                pchMethod++;
+            }
+            pchMethodEnd = pchCSeqEnd;
+        }
+        else
+        {
+            pchMethodEnd = (const char *)memchr( pchMessage, ' ', nLength );
+        }
+
+        if ( ( pchMethodEnd == NULL ) || ( pchMethodEnd <= pchMethod ) )
+        {
+            return false;
+        }
+
+        strMethod = CString( pchMethod, (size_t)( pchMethodEnd - pchMethod ) );
+
+        return true;
+    }
+
+    /**
+     * GetStatusCode
+     *
+     *      Returns the status code from the status line of a raw response,
+     * or 0 if the message isn't a response.
+     */
+    int CSipTransactionManager::GetStatusCode( const char *pchMessage, size_t nLength )
+    {
+        if ( ( nLength < 11 ) || ( strncmp( pchMessage, "SIP/2.0 ", 8 ) != 0 ) )
+        {
+            return 0;
+        }
+
+        int nStatusCode = 0;
+        for ( size_t nX = 8; nX < 11; nX++ )
+        {
+            if ( ( pchMessage[ nX ] < '0' ) || ( pchMessage[ nX ] > '9' ) )
+            {
+                return 0;
+            }
+            nStatusCode = ( nStatusCode * 10 ) + ( pchMessage[ nX ] - '0' );
+        }
+
+        return nStatusCode;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_MULTI_THREADED__
+#endif // IASLIB_NETWORKING__
@@ -36,6 +36,27 @@ namespace IASLib
     {
     }
 
+    /**
+     * Client Socket Constructor
+     *
+     * This constructor builds a Client socket that verifies the server's
+     * certificate (and, for a host name, that the certificate matches it).
+     *
+     * @param strConnectTo
+     *      The host (name or IP Address) to connect to.
+     * @param nPort
+     *      The Port to connect to.
+     * @param bVerifyPeer
+     *      Should the server's certificate be verified?
+     * @param strCAFile
+     *      The PEM file of trusted certificates, or NULL for the system
+     *      defaults.
+     */
+    CSecureClientSocket::CSecureClientSocket( const char *strConnectTo, int nPort, bool bVerifyPeer, const char *strCAFile )
+    : CSecureSocket( strConnectTo, nPort, CTlsContextRegistry::GetClientContext( bVerifyPeer, strCAFile ) )
+    {
+    }
+
     /**
      * Client Socket Destructor
      *
@@ -44,6 +65,17 @@ namespace IASLib
     CSecureClientSocket::~CSecureClientSocket()
     {
     }
+
+    /**
+     * doHandshake
+     *
+     * Secures the connection before it is handed to a listener. A failure
+     * isn't thrown here, it surfaces on the first Read() or Send().
+     */
+    void CSecureClientSocket::doHandshake()
+    {
+        DoHandshake();
+    }
 } // namespace IASLib
 
 #endif // IASLIB_NETWORKING__
@@ -21,19 +21,38 @@
 #include "SocketException.h"
 #include <openssl/ssl.h>
 #include <openssl/err.h>
+#include <errno.h>
+#include <poll.h>
+#include "../Stats/Metrics.h"
 
 namespace IASLib
 {
-static bool g_bSSLInitialized = false;
-
 IMPLEMENT_OBJECT(CSecureSocket, CSocket);
 
+#ifdef IASLIB_STATS__
+    // The same counters as CSocket's; these are the plaintext bytes.
+static CCounter *BytesReceived( void )
+{
+    static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_socket_received_bytes_total", "Bytes read from stream sockets." );
+    return s_pCounter;
+}
+
+static CCounter *BytesSent( void )
+{
+    static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_socket_sent_bytes_total", "Bytes written to stream sockets." );
+    return s_pCounter;
+}
+#endif
+
     /**
      *  Pre-existing Socket Constructor
      *
      *      This constructor takes an already existing socket and wraps it
      * in a class. This is especially useful for sockets resulting from
-     * accept calls.
+     * accept calls. The socket uses the shared server context for the
+     * default certificate ("cert.pem" and "key.pem"), and the handshake is
+     * left until the first Read() or Send(), or until the owner drives it
+     * with ContinueHandshake().
      *
      * @param hSocket
      *          The handle of the socket that already exists.
@@ -45,15 +64,18 @@ IMPLEMENT_OBJECT(CSecureSocket, CSocket);
      */
 CSecureSocket::CSecureSocket(SOCKET hSocket, const char *strSockName, void *AddressIn) : CSocket(hSocket, strSockName, AddressIn)
 {
-    // Build the secure context around the socket
-    if (!g_bSSLInitialized)
-    {
-        initSsl();
-        g_bSSLInitialized = true;
-    }
+    AttachServer( CTlsContextRegistry::GetServerContext() );
+}
 
-    m_pContext = createContext();
-    configureContext( m_pContext );
+    /**
+     *  Pre-existing Socket Constructor
+     *
+     *      As above, but with a server context from the registry for some
+     * other certificate.
+     */
+CSecureSocket::CSecureSocket(SOCKET hSocket, const char *strSockName, void *AddressIn, SSL_CTX *pContext) : CSocket(hSocket, strSockName, AddressIn)
+{
+    AttachServer( pContext );
 }
 
 /**
@@ -73,13 +95,17 @@ CSecureSocket::CSecureSocket(int nPort, bool bBlocking) : CSocket(nPort, bBlocki
     // Note, server sockets don't have a context -- they will accept
     // connections and then wrap those sockets in security.
     m_pContext = NULL;
+    m_pSsl = NULL;
+    m_bHandshakeComplete = false;
 }
 
 /**
      *  Client Socket Constructor
      *
      *      This constructor takes a remote host and a port to connect to
-     * and then attempts to connect to that host via that port.
+     * and then attempts to connect to that host via that port. A session
+     * kept from an earlier connection to the same host and port is offered
+     * to the server, so the handshake can be abbreviated.
      *
      * @param strConnectTo
      *          The host name or IP address to connect to.
@@ -88,6 +114,18 @@ CSecureSocket::CSecureSocket(int nPort, bool bBlocking) : CSocket(nPort, bBlocki
      */
 CSecureSocket::CSecureSocket(const char *strConnectTo, int nPort) : CSocket(strConnectTo, nPort)
 {
+    AttachClient( strConnectTo, nPort, CTlsContextRegistry::GetClientContext() );
+}
+
+    /**
+     *  Client Socket Constructor
+     *
+     *      As above, but with a client context from the registry with some
+     * other verification setup.
+     */
+CSecureSocket::CSecureSocket(const char *strConnectTo, int nPort, SSL_CTX *pContext) : CSocket(strConnectTo, nPort)
+{
+    AttachClient( strConnectTo, nPort, pContext );
 }
 
 /**
@@ -98,48 +136,408 @@ CSecureSocket::CSecureSocket(const char *strConnectTo, int nPort) : CSocket(strC
      */
 CSecureSocket::~CSecureSocket()
 {
+    Close();
 }
 
-void CSecureSocket::initSsl()
+    /**
+     * AttachServer
+     *
+     *      Sets up the server side of the TLS layer on an accepted socket.
+     */
+void CSecureSocket::AttachServer( SSL_CTX *pContext )
 {
-    SSL_load_error_strings();
-    OpenSSL_add_ssl_algorithms();
+    m_pContext = pContext;
+    m_pSsl = NULL;
+    m_bHandshakeComplete = false;
+
+    if ( m_pContext == NULL )
+    {
+        IASLIB_THROW_SOCKET_EXCEPTION( EPROTO );
+    }
+
+    if ( IsConnected() )
+    {
+        m_pSsl = SSL_new( m_pContext );
+        SSL_set_fd( m_pSsl, (int)m_hSocket );
+        SSL_set_app_data( m_pSsl, this );
+        SSL_set_accept_state( m_pSsl );
+    }
 }
 
-SSL_CTX *CSecureSocket::createContext()
+    /**
+     * AttachClient
+     *
+     *      Sets up the client side of the TLS layer on a connected socket,
+     * including the server name and any session we're holding for it.
+     */
+void CSecureSocket::AttachClient( const char *strConnectTo, int nPort, SSL_CTX *pContext )
 {
-    const SSL_METHOD *method;
-    SSL_CTX *ctx;
+    m_pContext = pContext;
+    m_pSsl = NULL;
+    m_bHandshakeComplete = false;
+
+    if ( m_pContext == NULL )
+    {
+        IASLIB_THROW_SOCKET_EXCEPTION( EPROTO );
+    }
+
+    if ( ! IsConnected() )
+    {
+        return;
+    }
+
+    m_pSsl = SSL_new( m_pContext );
+    SSL_set_fd( m_pSsl, (int)m_hSocket );
+    SSL_set_app_data( m_pSsl, this );
+    SSL_set_connect_state( m_pSsl );
+
+        // SNI (and the name check, if the context verifies) only make
+        // sense for a host name, not for an address.
+    struct in_addr addrTest;
+    if ( inet_pton( AF_INET, strConnectTo, &addrTest ) != 1 )
+    {
+        SSL_set_tlsext_host_name( m_pSsl, strConnectTo );
+        SSL_set1_host( m_pSsl, strConnectTo );
+    }
+
+    m_strSessionKey.Format( "%s:%d", strConnectTo, nPort );
+
+    SSL_SESSION *pSession = CTlsContextRegistry::GetClientSession( (const char *)m_strSessionKey );
+    if ( pSession )
+    {
+        SSL_set_session( m_pSsl, pSession );
+        SSL_SESSION_free( pSession );
+    }
+}
+
+    /**
+     * ContinueHandshake
+     *
+     *      Runs the handshake as far as it can go without blocking. On a
+     * non-blocking socket, the caller waits for the socket to be readable
+     * or writable (as returned), and then calls this again.
+     *
+     * @return
+     *      HANDSHAKE_COMPLETE once the connection is secured, HANDSHAKE_FAILED
+     *      if it never will be, or the direction the handshake is waiting
+     *      on.
+     */
+CSecureSocket::HandshakeStatus CSecureSocket::ContinueHandshake( void )
+{
+    if ( m_bHandshakeComplete )
+    {
+        return HANDSHAKE_COMPLETE;
+    }
+
+    if ( m_pSsl == NULL )
+    {
+        return HANDSHAKE_FAILED;
+    }
+
+    ERR_clear_error();
+
+    int nRet = SSL_do_handshake( m_pSsl );
+    if ( nRet == 1 )
+    {
+        m_bHandshakeComplete = true;
+        return HANDSHAKE_COMPLETE;
+    }
+
+    switch ( SSL_get_error( m_pSsl, nRet ) )
+    {
+        case SSL_ERROR_WANT_READ:
+            return HANDSHAKE_WANT_READ;
+
+        case SSL_ERROR_WANT_WRITE:
+            return HANDSHAKE_WANT_WRITE;
+
+        default:
+                // Don't offer the same session to this peer again
+            if ( m_strSessionKey.GetLength() )
+            {
+                CTlsContextRegistry::RemoveClientSession( (const char *)m_strSessionKey );
+            }
+            ERR_clear_error();
+            return HANDSHAKE_FAILED;
+    }
+}
+
+    /**
+     * DoHandshake
+     *
+     *      Runs the handshake to completion, waiting on the socket if it
+     * happens to be non-blocking.
+     *
+     * @return
+     *      true if the connection is secured.
+     */
+bool CSecureSocket::DoHandshake( void )
+{
+    for ( ;; )
+    {
+        HandshakeStatus eStatus = ContinueHandshake();
+
+        if ( eStatus == HANDSHAKE_COMPLETE )
+        {
+            return true;
+        }
+
+        if ( ( eStatus == HANDSHAKE_FAILED ) || ( ! WaitFor( eStatus ) ) )
+        {
+            return false;
+        }
+    }
+}
+
+    /**
+     * IsSessionReused
+     *
+     *      Returns true if the handshake resumed an earlier session (from
+     * the server cache or a session ticket), rather than doing a full key
+     * exchange.
+     */
+bool CSecureSocket::IsSessionReused( void )
+{
+    return ( m_bHandshakeComplete && ( SSL_session_reused( m_pSsl ) == 1 ) );
+}
+
+    /**
+     * WaitFor
+     *
+     *      Waits until the socket is ready in the direction OpenSSL asked
+     * for.
+     */
+bool CSecureSocket::WaitFor( HandshakeStatus eStatus )
+{
+    struct pollfd stPoll;
+
+    stPoll.fd = (int)m_hSocket;
+    stPoll.events = ( eStatus == HANDSHAKE_WANT_WRITE ) ? POLLOUT : POLLIN;
+    stPoll.revents = 0;
+
+    int nRet;
+    do
+    {
+        nRet = poll( &stPoll, 1, -1 );
+    } while ( ( nRet < 0 ) && ( errno == EINTR ) );
+
+    return ( nRet > 0 );
+}
+
+bool CSecureSocket::IsConnected( void )
+{
+    return CSocket::IsConnected();
+}
+
+bool CSecureSocket::IsHandshakeComplete( void )
+{
+    return m_bHandshakeComplete;
+}
+
+    /**
+     * Read Method
+     *
+     * This method reads a single unsigned character from the secure stream.
+     */
+unsigned char CSecureSocket::Read( void )
+{
+    char chRead;
+
+    if ( m_pSsl == NULL )
+    {
+        return (unsigned char)'\0';
+    }
+
+    if ( Read( &chRead, 1 ) == 0 )
+    {
+        throw( new CSocketException( EPIPE ) );
+    }
+
+    return (unsigned char)chRead;
+}
+
+    /**
+     * Read Method
+     *
+     * This method reads from the secure stream up to the size of the
+     * buffer, finishing the handshake first if need be. It returns the
+     * number of bytes read, or 0 once the peer has closed the connection.
+     * Like the plain socket, a non-blocking socket with nothing to read
+     * throws EAGAIN.
+     *
+     * @param pchBuffer
+     *          The buffer to store the data read from the socket in.
+     * @param nBufferSize
+     *          The size of the buffer for storing the data.
+     */
+int CSecureSocket::Read( char *pchBuffer, int nBufferSize )
+{
+    if ( m_pSsl == NULL )
+    {
+        return 0;
+    }
+
+    if ( ( ! m_bHandshakeComplete ) && ( ! DoHandshake() ) )
+    {
+        throw( new CSocketException( ECONNABORTED ) );
+    }
+
+    ERR_clear_error();
+
+    int nRet = SSL_read( m_pSsl, pchBuffer, nBufferSize );
+    if ( nRet > 0 )
+    {
+#ifdef IASLIB_STATS__
+        BytesReceived()->Add( nRet );
+#endif
+        return nRet;
+    }
+
+    switch ( SSL_get_error( m_pSsl, nRet ) )
+    {
+        case SSL_ERROR_WANT_READ:
+        case SSL_ERROR_WANT_WRITE:
+            throw( new CSocketException( EAGAIN ) );
+
+        case SSL_ERROR_ZERO_RETURN:
+            return 0;
+
+        case SSL_ERROR_SYSCALL:
+                // A close without a close_notify is still just a close
+            if ( errno == 0 )
+            {
+                return 0;
+            }
+            throw( new CSocketException( errno ) );
+
+        default:
+            ERR_clear_error();
+            throw( new CSocketException( EPROTO ) );
+    }
+}
+
+    /**
+     * Send Method
+     *
+     * This method sends a single unsigned character to the secure stream.
+     */
+int CSecureSocket::Send( unsigned char chSend )
+{
+    char chBuffer = (char)chSend;
 
-    method = SSLv23_server_method();
+    return Send( &chBuffer, 1 );
+}
 
-    ctx = SSL_CTX_new(method);
-    if (!ctx)
+    /**
+     * Send Method
+     *
+     * This method sends all of the data in the buffer, finishing the
+     * handshake first if need be. As with the plain socket, all of the
+     * data is sent even when that takes several writes, waiting on a
+     * non-blocking socket when it fills up.
+     *
+     * @param pchBuffer
+     *          The buffer to be sent to the socket.
+     * @param nBufferSize
+     *          The length of the data in the buffer to be transmitted.
+     */
+int CSecureSocket::Send( const char *pchBuffer, int nBufferSize )
+{
+    int nSent = 0;
+
+    if ( m_pSsl == NULL )
+    {
+        return 0;
+    }
+
+    if ( ( ! m_bHandshakeComplete ) && ( ! DoHandshake() ) )
     {
-        perror("Unable to create SSL context");
-        ERR_print_errors_fp(stderr);
-        exit(EXIT_FAILURE);
+        throw( new CSocketException( ECONNABORTED ) );
     }
 
-    return ctx;
+    while ( nSent < nBufferSize )
+    {
+        ERR_clear_error();
+
+        int nRet = SSL_write( m_pSsl, &( pchBuffer[ nSent ] ), nBufferSize - nSent );
+        if ( nRet > 0 )
+        {
+            nSent += nRet;
+            continue;
+        }
+
+        switch ( SSL_get_error( m_pSsl, nRet ) )
+        {
+            case SSL_ERROR_WANT_READ:
+                WaitFor( HANDSHAKE_WANT_READ );
+                break;
+
+            case SSL_ERROR_WANT_WRITE:
+                WaitFor( HANDSHAKE_WANT_WRITE );
+                break;
+
+            case SSL_ERROR_SYSCALL:
+                throw( new CSocketException( ( errno ) ? errno : EPIPE ) );
+
+            default:
+                ERR_clear_error();
+                throw( new CSocketException( EPROTO ) );
+        }
+    }
+
+#ifdef IASLIB_STATS__
+    BytesSent()->Add( nSent );
+#endif
+    return nSent;
 }
 
-void CSecureSocket::configureContext(SSL_CTX *ctx)
+const char *CSecureSocket::GetAddressString( bool bInternetAddress, bool bIncludePort )
 {
-    SSL_CTX_set_ecdh_auto(ctx, 1);
+    return CSocket::GetAddressString( bInternetAddress, bIncludePort );
+}
 
-    // Set the key and cert
-    if (SSL_CTX_use_certificate_file(ctx, "cert.pem", SSL_FILETYPE_PEM) <= 0)
+    /**
+     *  Close
+     *
+     *      Sends our close_notify (without waiting for the peer's) and
+     * closes the socket. A client's session has already been handed to the
+     * registry by then, so the next connection can still resume it.
+     */
+void CSecureSocket::Close( void )
+{
+    if ( m_pSsl )
     {
-        ERR_print_errors_fp(stderr);
-        exit(EXIT_FAILURE);
+        if ( m_bHandshakeComplete )
+        {
+            SSL_shutdown( m_pSsl );
+        }
+        SSL_free( m_pSsl );
+        m_pSsl = NULL;
     }
+    m_bHandshakeComplete = false;
+
+    CSocket::Close();
+}
+
+void CSecureSocket::SetNonBlocking( bool bDontBlock )
+{
+    CSocket::SetNonBlocking( bDontBlock );
+}
 
-    if (SSL_CTX_use_PrivateKey_file(ctx, "key.pem", SSL_FILETYPE_PEM) <= 0)
+    /**
+     *  HasData
+     *
+     *      Data already decrypted by OpenSSL never shows up on the socket
+     * itself, so check for that first.
+     */
+bool CSecureSocket::HasData( void )
+{
+    if ( ( m_pSsl ) && ( SSL_pending( m_pSsl ) > 0 ) )
     {
-        ERR_print_errors_fp(stderr);
-        exit(EXIT_FAILURE);
+        return true;
     }
+
+    return CSocket::HasData();
 }
 
 }; // namespace IASLib
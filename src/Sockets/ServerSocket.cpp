@@ -3,6 +3,10 @@
  *
  *      This class provides an interface for creating a server
  * socket connection.
+ *      Built from a CSocketConfig, the listener takes its backlog from
+ * the configuration, and can share its port with other listeners
+ * (SO_REUSEPORT) so that several threads can each accept on their own
+ * socket while the kernel balances new connections between them.
  *
  *	Author: Jeffrey R. Naujok
  *	Created: 4/02/1997
@@ -16,6 +20,7 @@
 #ifdef IASLIB_NETWORKING__
 
 #include "ServerSocket.h"
+#include "SecureSocket.h"
 #include "SocketException.h"
 #include <stdio.h>
 #include <errno.h>
@@ -29,6 +34,40 @@ namespace IASLib
 {
     IMPLEMENT_OBJECT( CServerSocket, CSocket );
 
+    /**
+     * Configured Server Socket Constructor
+     *
+     * This constructor builds a server socket from a configuration
+     * object. The listen backlog comes from the configuration, and if it
+     * asks for port re-use the socket can share its port with other
+     * listeners.
+     *
+     * @param config
+     *      The configuration to build the socket with.
+     * @param nPort
+     *      The port number to bind the server to.
+     * @param bindAddress
+     *      The address to bind to, or NULL for all interfaces.
+     * @param bSecure
+     *      Whether connections accepted here should be secured.
+     */
+    CServerSocket::CServerSocket( CSocketConfig config, int nPort, const char *bindAddress, bool bSecure ) : CSocket( config, nPort, bindAddress ), config( config )
+    {
+            // The listening handle is left blocking whatever the
+            // configuration says, so Accept() waits for a client; only
+            // SetNonBlocking() changes that, and what accepted handles get.
+        m_bBlocking = true;
+
+        if ( m_hSocket != NULL_SOCKET )
+        {
+            if ( listen( m_hSocket, config.getBacklogSize() ) == SOCKET_ERROR )
+            {
+                IASLIB_THROW_SOCKET_EXCEPTION( errno );
+            }
+        }
+        m_bSecure = bSecure;
+    }
+
     /**
      * Server Socket Constructor
      *
@@ -79,28 +118,58 @@ namespace IASLib
      */
     CSocket *CServerSocket::Accept( void )
     {
-        SOCKET              hSocket;
-        CSocket            *pRetVal = NULL;
-        struct sockaddr_in *pSockAddr = new struct sockaddr_in;
-        socklen_t          *pnAddrLen = new socklen_t;
-
-        *pnAddrLen = sizeof( struct sockaddr_in );
-
-        hSocket = accept( m_hSocket, (struct sockaddr *)pSockAddr, pnAddrLen );
-
+        struct sockaddr_storage stAddress;
+        socklen_t               nAddrLen = sizeof( stAddress );
+        SOCKET                  hSocket = AcceptHandle( &stAddress, &nAddrLen );
 
         if ( hSocket == SOCKET_ERROR )
         {
             throw( new CSocketException( errno ) );
         }
 
-        if ( ( hSocket != INVALID_SOCKET ) && ( hSocket != SOCKET_ERROR ) )
-            pRetVal = new CSocket( hSocket, "New Socket", pSockAddr );
+        if ( hSocket != INVALID_SOCKET )
+        {
+                // The handshake waits for the first read or write, so a slow
+                // client can't hold up the accepting thread.
+            if ( m_bSecure )
+            {
+                return new CSecureSocket( hSocket, "New Socket", &stAddress );
+            }
+            return new CSocket( hSocket, "New Socket", &stAddress );
+        }
 
-        delete pnAddrLen;
-        delete pSockAddr;
+        return NULL;
+    }
+
+    /**
+     * AcceptHandle
+     *
+     * This method accepts a connection and returns the bare handle,
+     * for callers that manage their own connection objects. On Linux
+     * the handle is created close-on-exec, and non-blocking when the
+     * listening socket has been made non-blocking with SetNonBlocking(),
+     * without any further system calls.
+     *
+     * @param pAddress
+     *      [out] The address of the client.
+     * @param pnAddressLength
+     *      [in/out] The size of pAddress, then the length of the address.
+     * @return
+     *      The new connection, or SOCKET_ERROR (check errno).
+     */
+    SOCKET CServerSocket::AcceptHandle( struct sockaddr_storage *pAddress, socklen_t *pnAddressLength )
+    {
+    #ifdef IASLIB_LINUX__
+        int nFlags = SOCK_CLOEXEC;
+        if ( ! m_bBlocking )
+        {
+            nFlags |= SOCK_NONBLOCK;
+        }
 
-        return pRetVal;
+        return accept4( m_hSocket, (struct sockaddr *)pAddress, pnAddressLength, nFlags );
+    #else
+        return accept( m_hSocket, (struct sockaddr *)pAddress, pnAddressLength );
+    #endif
     }
 } // namespace IASLib
 
@@ -27,6 +27,7 @@
 #include <netinet/tcp.h>
 
 #include "InternetAddress.h"
+#include "../Stats/Metrics.h"
 
 #ifdef IASLIB_WIN32__
 namespace IASLib
@@ -195,10 +196,9 @@ namespace IASLib
     CSocket::CSocket( CSocketConfig config, int nPort, const char *strBoundAddress )
     {
         int     nOption = 1;
-#ifndef IASLIB_NO_LINT__
-        m_bBlocking = config.isBlocking();
-#endif
 
+        m_bBlocking = config.isBlocking();
+        m_internetAddress = NULL;
         m_nPort = 0;
         m_addrIPAddress = 0;
         m_addrLocalIPAddress = 0;
@@ -223,15 +223,29 @@ namespace IASLib
             setsockopt( m_hSocket, SOL_SOCKET, SO_REUSEADDR, (const char *)&nOption , sizeof( nOption )  );
     #endif
 
+                // A buffer size of zero leaves the kernel's default
             int temp = config.getSendBufferSize();
-            setsockopt( m_hSocket, SOL_SOCKET, SO_SNDBUF, &temp, sizeof(int) );
+            if ( temp > 0 )
+            {
+                setsockopt( m_hSocket, SOL_SOCKET, SO_SNDBUF, &temp, sizeof(int) );
+            }
             temp = config.getReceiveBufferSize();
-            setsockopt( m_hSocket, SOL_SOCKET, SO_RCVBUF, &temp, sizeof(int) );
+            if ( temp > 0 )
+            {
+                setsockopt( m_hSocket, SOL_SOCKET, SO_RCVBUF, &temp, sizeof(int) );
+            }
             temp = config.isTcpNoDelay() ? 1:0;
             setsockopt( m_hSocket, IPPROTO_TCP, TCP_NODELAY, &temp, sizeof(int));
             temp = config.isLinger() ? 1:0;
             setsockopt( m_hSocket, SOL_SOCKET, SO_LINGER, &temp, sizeof(int));
-            temp = config.getBacklogSize();
+    #ifdef SO_REUSEPORT
+            if ( config.isReusePort() )
+            {
+                    // Must be in place before the bind, on every socket sharing the port
+                temp = 1;
+                setsockopt( m_hSocket, SOL_SOCKET, SO_REUSEPORT, &temp, sizeof(int));
+            }
+    #endif
 
             CInternetAddress localListen( strBoundAddress, nPort, SOCK_STREAM );
 
@@ -291,8 +305,9 @@ namespace IASLib
     {
         struct sockaddr_in *remote_addr = (struct sockaddr_in *)AddressIn;
 
-        socklen_t nNameSize;
+        socklen_t nNameSize = sizeof( struct sockaddr_in );
 
+        m_bBlocking = true;
         m_nPort = 0;
         m_addrIPAddress = 0;
         m_addrLocalIPAddress = 0;
@@ -373,10 +388,8 @@ namespace IASLib
     CSocket::CSocket( int nPort, bool bBlocking )
     {
         int     nOption = 1;
-#ifndef IASLIB_NO_LINT__
-        bBlocking = bBlocking;
-#endif
 
+        m_bBlocking = bBlocking;
         m_nPort = 0;
         m_addrIPAddress = 0;
         m_addrLocalIPAddress = 0;
@@ -390,6 +403,7 @@ namespace IASLib
         }
     #endif
 	    struct sockaddr_in	listen_addr;
+        memset( &listen_addr, 0, sizeof( struct sockaddr_in ) );
 
         m_hSocket = socket( AF_INET, SOCK_STREAM, 0 );
 
@@ -534,6 +548,22 @@ namespace IASLib
         m_hSocket = NULL_SOCKET;
     }
 
+#ifdef IASLIB_STATS__
+        // Shared with CSecureSocket, which counts the bytes it sends and
+        // receives under the same names, after decryption.
+    static CCounter *BytesReceived( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_socket_received_bytes_total", "Bytes read from stream sockets." );
+        return s_pCounter;
+    }
+
+    static CCounter *BytesSent( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_socket_sent_bytes_total", "Bytes written to stream sockets." );
+        return s_pCounter;
+    }
+#endif
+
     /**
      * Read Method
      *
@@ -553,6 +583,9 @@ namespace IASLib
             if ( nRetVal == 0 )
                 throw( new CSocketException( EPIPE ) );
 
+#ifdef IASLIB_STATS__
+            BytesReceived()->Add();
+#endif
             return (unsigned char)pchBuf[0];
         }
         return (unsigned char)'\0';
@@ -578,6 +611,9 @@ namespace IASLib
         {
             if ( ( nRet = recv( m_hSocket, pchBuffer, nBufferSize, 0 ) ) != SOCKET_ERROR )
             {
+#ifdef IASLIB_STATS__
+                BytesReceived()->Add( nRet );
+#endif
                 return nRet;
             }
 
@@ -606,6 +642,9 @@ namespace IASLib
             pchBuf[0] = (char)chSend;
             if ( send( m_hSocket, pchBuf, 1, 0 ) != SOCKET_ERROR )
             {
+#ifdef IASLIB_STATS__
+                BytesSent()->Add();
+#endif
                 return 1;
             }
         }
@@ -653,6 +692,9 @@ namespace IASLib
                     throw( new CSocketException( errno ) );
                 }
             }
+#ifdef IASLIB_STATS__
+            BytesSent()->Add( nSent );
+#endif
         }
         return nSent;
     }
@@ -751,6 +793,7 @@ namespace IASLib
             }
 
             fcntl( m_hSocket, F_SETFL, nOldFlags );
+            m_bBlocking = ! bDontBlock;
     #endif
         }
     }
@@ -814,7 +857,7 @@ namespace IASLib
                 socklen_t nNameSize = sizeof( struct sockaddr_in6 );
                 struct sockaddr *connect_addr = (sockaddr *)malloc( nNameSize );
 
-                if ( getpeername( m_hSocket, (sockaddr *)&connect_addr, &nNameSize ) != SOCKET_ERROR )
+                if ( getpeername( m_hSocket, connect_addr, &nNameSize ) != SOCKET_ERROR )
                 {
                     m_internetAddress = new CInternetAddress( connect_addr );
                 }
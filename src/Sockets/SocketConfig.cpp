@@ -32,6 +32,16 @@ namespace IASLib
      */
     CSocketConfig::CSocketConfig( void )
     {
+        backlogSize = 32;
+        recvBufferSize = 4096;
+        sendBufferSize = 4096;
+        keepAlive = false;
+        linger = false;
+        reuseSocket = false;
+        reusePort = false;
+        timeoutMillis = 60000;
+        noDelay = false;
+        blocking = false;
     }
 
     /**
@@ -55,6 +65,7 @@ namespace IASLib
         config->keepAlive = keepAlive;
         config->linger = linger;
         config->reuseSocket = reuseSocket;
+        config->reusePort = reusePort;
         config->timeoutMillis = timeoutMillis;
         config->noDelay = noDelay;
         config->blocking = blocking;
@@ -68,6 +79,7 @@ namespace IASLib
         return *this;
     }
 
+        // A buffer size of zero keeps the kernel's default
     CSocketConfigBuilder CSocketConfigBuilder::setReceiveBufferSize( int bufferSize )
     {
         this->recvBufferSize = bufferSize;
@@ -94,6 +106,18 @@ namespace IASLib
         this->reuseSocket = reuse;
         return *this;
     }
+    /**
+     *  setReusePort
+     *
+     *      Lets any number of listening sockets bind the same port
+     * (SO_REUSEPORT). The kernel spreads new connections across them, so
+     * each accepting thread can own its own listener.
+     */
+    CSocketConfigBuilder CSocketConfigBuilder::setReusePort( bool reuse )
+    {
+        this->reusePort = reuse;
+        return *this;
+    }
     CSocketConfigBuilder CSocketConfigBuilder::setTimeout( int timeoutMillis )
     {
         this->timeoutMillis = timeoutMillis;
@@ -118,6 +142,7 @@ namespace IASLib
         keepAlive = false;
         linger = false;
         reuseSocket = false;
+        reusePort = false;
         timeoutMillis = 60000;
         noDelay = false;
         blocking = false;
@@ -131,6 +156,7 @@ namespace IASLib
         keepAlive = oSource.keepAlive;
         linger = oSource.linger;
         reuseSocket = oSource.reuseSocket;
+        reusePort = oSource.reusePort;
         timeoutMillis = oSource.timeoutMillis;
         noDelay = oSource.noDelay;
         blocking = oSource.blocking;
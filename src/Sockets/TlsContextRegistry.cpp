@@ -0,0 +1,393 @@
+/**
+ *  TLS Context Registry class
+ *
+ *      This class keeps the process-wide set of OpenSSL contexts that the
+ * secure sockets share. OpenSSL is initialized exactly once, and each
+ * distinct server certificate (or client verification setup) gets one
+ * SSL_CTX for the life of the process, rather than one per connection.
+ *      Sharing the context is what makes session resumption work at all:
+ * the server side session cache and the session ticket keys both live in
+ * the SSL_CTX, so a context built per socket could never resume anything.
+ * On the client side, sessions are kept here, keyed on "host:port", and
+ * handed back to the next connection to the same peer.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#ifdef IASLIB_NETWORKING__
+
+#include "TlsContextRegistry.h"
+#include "SecureSocket.h"
+#include "Hash.h"
+#include "Mutex.h"
+
+    // Identifies our sessions in the server cache. Sessions are only ever
+    // resumed against a context with the same id.
+#define TLS_SESSION_ID_CONTEXT "IASLib"
+
+namespace IASLib
+{
+    /**
+     *  TLS Context Entry
+     *
+     *      Holds one of the shared contexts in the registry's hash.
+     */
+    class CTlsContextEntry : public CObject
+    {
+        public:
+            SSL_CTX        *m_pContext;
+
+                            CTlsContextEntry( SSL_CTX *pContext ) { m_pContext = pContext; }
+            virtual        ~CTlsContextEntry( void ) { SSL_CTX_free( m_pContext ); }
+
+                            DEFINE_OBJECT( CTlsContextEntry )
+    };
+
+    /**
+     *  TLS Session Entry
+     *
+     *      Holds a reference to a client session in the registry's hash.
+     */
+    class CTlsSessionEntry : public CObject
+    {
+        public:
+            SSL_SESSION    *m_pSession;
+
+                            CTlsSessionEntry( SSL_SESSION *pSession ) { m_pSession = pSession; }
+            virtual        ~CTlsSessionEntry( void ) { SSL_SESSION_free( m_pSession ); }
+
+                            DEFINE_OBJECT( CTlsSessionEntry )
+    };
+
+    IMPLEMENT_OBJECT( CTlsContextEntry, CObject );
+    IMPLEMENT_OBJECT( CTlsSessionEntry, CObject );
+
+    static CMutex   g_mutexRegistry;
+    static bool     g_bSSLInitialized = false;
+    static CHash   *g_pContexts = NULL;
+    static CHash   *g_pSessions = NULL;
+
+    /**
+     * Initialize
+     *
+     *      Initializes OpenSSL, once per process. Every other method calls
+     * this, so there's no need to call it directly, but it is safe to do
+     * so before any threads are started.
+     */
+    void CTlsContextRegistry::Initialize( void )
+    {
+        g_mutexRegistry.Lock();
+        if ( ! g_bSSLInitialized )
+        {
+            SSL_load_error_strings();
+            OpenSSL_add_ssl_algorithms();
+
+            g_pContexts = new CHash( CHash::SMALL );
+            g_pSessions = new CHash( CHash::NORMAL );
+            g_bSSLInitialized = true;
+        }
+        g_mutexRegistry.Unlock();
+    }
+
+    /**
+     * Shutdown
+     *
+     *      Releases every context and cached session. Only call this once
+     * all of the secure sockets are gone, since they use the contexts
+     * without holding a reference of their own.
+     */
+    void CTlsContextRegistry::Shutdown( void )
+    {
+        g_mutexRegistry.Lock();
+        if ( g_bSSLInitialized )
+        {
+            g_pSessions->DeleteAll();
+            delete g_pSessions;
+            g_pSessions = NULL;
+
+            g_pContexts->DeleteAll();
+            delete g_pContexts;
+            g_pContexts = NULL;
+
+            g_bSSLInitialized = false;
+        }
+        g_mutexRegistry.Unlock();
+    }
+
+    /**
+     * GetServerContext
+     *
+     *      Returns the shared server context for a certificate and key,
+     * creating it on first use.
+     *
+     * @param strCertFile
+     *      The PEM file holding the server certificate (chain).
+     * @param strKeyFile
+     *      The PEM file holding the private key.
+     * @return
+     *      The context, or NULL if the certificate or key could not be
+     *      loaded. The registry owns the context.
+     */
+    SSL_CTX *CTlsContextRegistry::GetServerContext( const char *strCertFile, const char *strKeyFile )
+    {
+        Initialize();
+
+        CString strKey;
+        strKey.Format( "server %s %s", strCertFile, strKeyFile );
+
+        g_mutexRegistry.Lock();
+        CTlsContextEntry *pEntry = (CTlsContextEntry *)g_pContexts->Get( (const char *)strKey );
+        if ( pEntry == NULL )
+        {
+            SSL_CTX *pContext = CreateServerContext( strCertFile, strKeyFile );
+            if ( pContext )
+            {
+                pEntry = new CTlsContextEntry( pContext );
+                g_pContexts->Push( (const char *)strKey, pEntry );
+            }
+        }
+        g_mutexRegistry.Unlock();
+
+        return ( pEntry ) ? pEntry->m_pContext : NULL;
+    }
+
+    /**
+     * GetClientContext
+     *
+     *      Returns the shared client context for a verification setup,
+     * creating it on first use.
+     *
+     * @param bVerifyPeer
+     *      Should the server's certificate be verified?
+     * @param strCAFile
+     *      The PEM file of trusted certificates to verify against, or NULL
+     *      for the system default locations.
+     * @return
+     *      The context, or NULL if it could not be created. The registry
+     *      owns the context.
+     */
+    SSL_CTX *CTlsContextRegistry::GetClientContext( bool bVerifyPeer, const char *strCAFile )
+    {
+        Initialize();
+
+        CString strKey;
+        strKey.Format( "client %d %s", bVerifyPeer ? 1 : 0, ( strCAFile ) ? strCAFile : "" );
+
+        g_mutexRegistry.Lock();
+        CTlsContextEntry *pEntry = (CTlsContextEntry *)g_pContexts->Get( (const char *)strKey );
+        if ( pEntry == NULL )
+        {
+            SSL_CTX *pContext = CreateClientContext( bVerifyPeer, strCAFile );
+            if ( pContext )
+            {
+                pEntry = new CTlsContextEntry( pContext );
+                g_pContexts->Push( (const char *)strKey, pEntry );
+            }
+        }
+        g_mutexRegistry.Unlock();
+
+        return ( pEntry ) ? pEntry->m_pContext : NULL;
+    }
+
+    /**
+     * GetClientSession
+     *
+     *      Looks up the last session negotiated with a peer.
+     *
+     * @param strSessionKey
+     *      The peer, as "host:port".
+     * @return
+     *      A new reference to the session (the caller must release it with
+     *      SSL_SESSION_free, which SSL_set_session followed by a free does),
+     *      or NULL if there is no resumable session.
+     */
+    SSL_SESSION *CTlsContextRegistry::GetClientSession( const char *strSessionKey )
+    {
+        SSL_SESSION *pSession = NULL;
+
+        Initialize();
+
+        g_mutexRegistry.Lock();
+        CTlsSessionEntry *pEntry = (CTlsSessionEntry *)g_pSessions->Get( strSessionKey );
+        if ( pEntry )
+        {
+            if ( SSL_SESSION_is_resumable( pEntry->m_pSession ) )
+            {
+                pSession = pEntry->m_pSession;
+                SSL_SESSION_up_ref( pSession );
+            }
+            else
+            {
+                g_pSessions->Delete( strSessionKey );
+            }
+        }
+        g_mutexRegistry.Unlock();
+
+        return pSession;
+    }
+
+    /**
+     * StoreClientSession
+     *
+     *      Keeps a session for the next connection to the same peer,
+     * replacing any session already held for it.
+     *
+     * @param strSessionKey
+     *      The peer, as "host:port".
+     * @param pSession
+     *      The session. The registry takes over the caller's reference.
+     */
+    void CTlsContextRegistry::StoreClientSession( const char *strSessionKey, SSL_SESSION *pSession )
+    {
+        Initialize();
+
+        g_mutexRegistry.Lock();
+        g_pSessions->Push( strSessionKey, new CTlsSessionEntry( pSession ) );
+        g_mutexRegistry.Unlock();
+    }
+
+    /**
+     * RemoveClientSession
+     *
+     *      Forgets the session held for a peer, usually because resuming it
+     * has just failed.
+     */
+    void CTlsContextRegistry::RemoveClientSession( const char *strSessionKey )
+    {
+        Initialize();
+
+        g_mutexRegistry.Lock();
+        if ( g_pSessions->HasKey( strSessionKey ) )
+        {
+            g_pSessions->Delete( strSessionKey );
+        }
+        g_mutexRegistry.Unlock();
+    }
+
+    size_t CTlsContextRegistry::GetClientSessionCount( void )
+    {
+        size_t nCount = 0;
+
+        Initialize();
+
+        g_mutexRegistry.Lock();
+        nCount = g_pSessions->GetLength();
+        g_mutexRegistry.Unlock();
+
+        return nCount;
+    }
+
+    /**
+     * CreateServerContext
+     *
+     *      Builds a server context with the session cache and session
+     * tickets turned on. The ticket keys are generated by OpenSSL when the
+     * context is created, so every connection accepted through this
+     * context can resume a ticket issued by any other.
+     */
+    SSL_CTX *CTlsContextRegistry::CreateServerContext( const char *strCertFile, const char *strKeyFile )
+    {
+        SSL_CTX *pContext = SSL_CTX_new( TLS_server_method() );
+
+        if ( pContext == NULL )
+        {
+            ERR_print_errors_fp( stderr );
+            return NULL;
+        }
+
+        SSL_CTX_set_min_proto_version( pContext, TLS1_2_VERSION );
+        SSL_CTX_set_ecdh_auto( pContext, 1 );
+
+        if ( ( SSL_CTX_use_certificate_chain_file( pContext, strCertFile ) <= 0 ) ||
+             ( SSL_CTX_use_PrivateKey_file( pContext, strKeyFile, SSL_FILETYPE_PEM ) <= 0 ) ||
+             ( SSL_CTX_check_private_key( pContext ) <= 0 ) )
+        {
+            ERR_print_errors_fp( stderr );
+            SSL_CTX_free( pContext );
+            return NULL;
+        }
+
+            // Partial writes let a non-blocking Send() report progress, and
+            // a moving buffer lets it retry from wherever the caller's data
+            // has ended up.
+        SSL_CTX_set_mode( pContext, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER | SSL_MODE_RELEASE_BUFFERS );
+
+        SSL_CTX_set_session_cache_mode( pContext, SSL_SESS_CACHE_SERVER );
+        SSL_CTX_sess_set_cache_size( pContext, DEFAULT_SESSION_CACHE_SIZE );
+        SSL_CTX_set_session_id_context( pContext, (const unsigned char *)TLS_SESSION_ID_CONTEXT, sizeof( TLS_SESSION_ID_CONTEXT ) - 1 );
+        SSL_CTX_set_timeout( pContext, DEFAULT_SESSION_TIMEOUT );
+        SSL_CTX_clear_options( pContext, SSL_OP_NO_TICKET );
+
+        return pContext;
+    }
+
+    /**
+     * CreateClientContext
+     *
+     *      Builds a client context. OpenSSL's own client cache is keyed on
+     * nothing useful, so sessions are handed to the registry as they are
+     * negotiated (including TLS 1.3 tickets, which arrive after the
+     * handshake), and given back to the socket before it connects.
+     */
+    SSL_CTX *CTlsContextRegistry::CreateClientContext( bool bVerifyPeer, const char *strCAFile )
+    {
+        SSL_CTX *pContext = SSL_CTX_new( TLS_client_method() );
+
+        if ( pContext == NULL )
+        {
+            ERR_print_errors_fp( stderr );
+            return NULL;
+        }
+
+        SSL_CTX_set_min_proto_version( pContext, TLS1_2_VERSION );
+
+        if ( bVerifyPeer )
+        {
+            int nRet = ( strCAFile ) ? SSL_CTX_load_verify_locations( pContext, strCAFile, NULL ) : SSL_CTX_set_default_verify_paths( pContext );
+            if ( nRet <= 0 )
+            {
+                ERR_print_errors_fp( stderr );
+                SSL_CTX_free( pContext );
+                return NULL;
+            }
+            SSL_CTX_set_verify( pContext, SSL_VERIFY_PEER, NULL );
+        }
+        else
+        {
+            SSL_CTX_set_verify( pContext, SSL_VERIFY_NONE, NULL );
+        }
+
+        SSL_CTX_set_mode( pContext, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER | SSL_MODE_RELEASE_BUFFERS );
+
+        SSL_CTX_set_session_cache_mode( pContext, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE );
+        SSL_CTX_sess_set_new_cb( pContext, NewClientSession );
+
+        return pContext;
+    }
+
+    /**
+     * NewClientSession
+     *
+     *      OpenSSL calls this whenever a client connection is handed a new
+     * session. Returning 1 tells OpenSSL that we've kept its reference.
+     */
+    int CTlsContextRegistry::NewClientSession( SSL *pSsl, SSL_SESSION *pSession )
+    {
+        CSecureSocket *pSocket = (CSecureSocket *)SSL_get_app_data( pSsl );
+
+        if ( ( pSocket == NULL ) || ( pSocket->GetSessionKey().GetLength() == 0 ) )
+        {
+            return 0;
+        }
+
+        StoreClientSession( (const char *)pSocket->GetSessionKey(), pSession );
+
+        return 1;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_NETWORKING__
@@ -4,6 +4,11 @@
  *      This base class provides platform independent support for UDP
  * sockets. This is the base class for both the UDP server and client socket
  * classes.
+ *      Besides the single datagram Read() and Send(), the socket can move
+ * a whole batch of datagrams per system call (recvmmsg/sendmmsg where the
+ * platform has them) into and out of caller-owned buffers. A server socket
+ * can also be opened with SO_REUSEPORT, so that several threads can each
+ * own a socket on the same port and let the kernel spread the load.
  *
  *	Author: Jeffrey R. Naujok
  *	Created: 7/11/2019
@@ -19,11 +24,38 @@
 #include "UDPSocket.h"
 #include "SocketException.h"
 #include <cerrno>
+#include "../Stats/Metrics.h"
 
 namespace IASLib
 {
+#ifdef IASLIB_STATS__
+    static CCounter *DatagramsReceived( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_udp_received_datagrams_total", "Datagrams read from UDP sockets." );
+        return s_pCounter;
+    }
+
+    static CCounter *BytesReceived( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_udp_received_bytes_total", "Bytes read from UDP sockets." );
+        return s_pCounter;
+    }
+
+    static CCounter *DatagramsSent( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_udp_sent_datagrams_total", "Datagrams written to UDP sockets." );
+        return s_pCounter;
+    }
+
+    static CCounter *BytesSent( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_udp_sent_bytes_total", "Bytes written to UDP sockets." );
+        return s_pCounter;
+    }
+#endif
+
         // Server port constructor
-    CUDPSocket::CUDPSocket( int nPort )
+    CUDPSocket::CUDPSocket( int nPort, bool bReusePort )
     {
         m_addrIPAddress = NULL;
         int     nOption = 1;
@@ -50,6 +82,19 @@ namespace IASLib
             setsockopt( m_hSocket, SOL_SOCKET, SO_REUSEADDR, (const char *)&nOption , sizeof( nOption )  );
     #endif
 
+    #ifdef SO_REUSEPORT
+            if ( bReusePort )
+            {
+                if ( setsockopt( m_hSocket, SOL_SOCKET, SO_REUSEPORT, (void *)&nOption, sizeof( nOption ) ) != 0 )
+                {
+                    int nError = errno;
+                    close( m_hSocket );
+                    m_hSocket = NULL_SOCKET;
+                    IASLIB_THROW_SOCKET_EXCEPTION( nError );
+                }
+            }
+    #endif
+
             listen_addr.sin_family = AF_INET;           // Listen for Internet (TCP/IP) connections
             listen_addr.sin_port = htons( (u_short)nPort );	    // Assign the Port in Network byte order
             listen_addr.sin_addr.s_addr = INADDR_ANY;	// Allow connection on any valid IP for this machine
@@ -157,8 +202,15 @@ namespace IASLib
         int n = recvfrom( m_hSocket, (char *)pchBuffer, nBufferSize,
                     MSG_WAITALL, (struct sockaddr *) &remaddr,
                     &len );
-        pchBuffer[n] = '\0';
-        incomingAddress.SetAddress(&remaddr);
+        if ( n >= 0 )
+        {
+            pchBuffer[n] = '\0';
+            incomingAddress.SetAddress(&remaddr);
+#ifdef IASLIB_STATS__
+            DatagramsReceived()->Add();
+            BytesReceived()->Add( n );
+#endif
+        }
         return n;
     }
 
@@ -177,10 +229,215 @@ namespace IASLib
                 printf( "SendTo RetVal: %d\n", (int) retVal );
                 printf( "Errno: %d - %s\n", errno, strerror( errno ) );
             }
+#ifdef IASLIB_STATS__
+            else
+            {
+                DatagramsSent()->Add();
+                BytesSent()->Add( retVal );
+            }
+#endif
         }
         return retVal;
     }
 
+    /**
+     * ReadBatch
+     *
+     *      Reads up to nCount datagrams with as few system calls as the
+     * platform allows. No memory is allocated; each datagram lands in the
+     * buffer of its slot, and is truncated if the buffer is too small.
+     *
+     * @param aDatagrams
+     *      The slots to fill. m_pchBuffer and m_nBufferSize must be set.
+     * @param nCount
+     *      The number of slots.
+     * @param bWait
+     *      Block until at least one datagram is available. Otherwise, return
+     *      immediately with whatever is already queued.
+     * @return
+     *      The number of slots filled, 0 if nothing was waiting (or the
+     *      call was interrupted).
+     */
+    size_t CUDPSocket::ReadBatch( Datagram *aDatagrams, size_t nCount, bool bWait )
+    {
+        if ( nCount == 0 )
+        {
+            return 0;
+        }
+
+    #ifdef IASLIB_LINUX__
+        struct mmsghdr  aMessages[ MAX_BATCH ];
+        struct iovec    aVectors[ MAX_BATCH ];
+
+        if ( nCount > MAX_BATCH )
+        {
+            nCount = MAX_BATCH;
+        }
+
+        memset( aMessages, 0, sizeof( struct mmsghdr ) * nCount );
+        for ( size_t nX = 0; nX < nCount; nX++ )
+        {
+            aVectors[ nX ].iov_base = aDatagrams[ nX ].m_pchBuffer;
+            aVectors[ nX ].iov_len = aDatagrams[ nX ].m_nBufferSize;
+            aMessages[ nX ].msg_hdr.msg_name = &aDatagrams[ nX ].m_stAddress;
+            aMessages[ nX ].msg_hdr.msg_namelen = sizeof( struct sockaddr_storage );
+            aMessages[ nX ].msg_hdr.msg_iov = &aVectors[ nX ];
+            aMessages[ nX ].msg_hdr.msg_iovlen = 1;
+        }
+
+        int nReceived = recvmmsg( m_hSocket, aMessages, (unsigned int)nCount, ( bWait ) ? MSG_WAITFORONE : MSG_DONTWAIT, NULL );
+        if ( nReceived < 0 )
+        {
+            if ( ( errno == EAGAIN ) || ( errno == EWOULDBLOCK ) || ( errno == EINTR ) )
+            {
+                return 0;
+            }
+            throw( new CSocketException( errno ) );
+        }
+
+        size_t nBytes = 0;
+        for ( int nX = 0; nX < nReceived; nX++ )
+        {
+            aDatagrams[ nX ].m_nLength = aMessages[ nX ].msg_len;
+            aDatagrams[ nX ].m_nAddressLength = aMessages[ nX ].msg_hdr.msg_namelen;
+            nBytes += aMessages[ nX ].msg_len;
+        }
+
+    #ifdef IASLIB_STATS__
+        DatagramsReceived()->Add( nReceived );
+        BytesReceived()->Add( nBytes );
+    #endif
+        return (size_t)nReceived;
+    #else
+        size_t nReceived = 0;
+
+        while ( nReceived < nCount )
+        {
+            Datagram *pDatagram = &aDatagrams[ nReceived ];
+            socklen_t nAddressLength = sizeof( struct sockaddr_storage );
+            int nFlags = 0;
+
+                // Only the first read may block
+        #ifndef IASLIB_WIN32__
+            if ( ( nReceived ) || ( ! bWait ) )
+            {
+                nFlags = MSG_DONTWAIT;
+            }
+        #else
+            if ( ( nReceived ) || ( ! bWait ) )
+            {
+                u_long ulAvailable = 0;
+                if ( ( ioctlsocket( m_hSocket, FIONREAD, &ulAvailable ) != 0 ) || ( ulAvailable == 0 ) )
+                {
+                    break;
+                }
+            }
+        #endif
+
+            int nRead = recvfrom( m_hSocket, pDatagram->m_pchBuffer, (int)pDatagram->m_nBufferSize, nFlags, (struct sockaddr *)&pDatagram->m_stAddress, &nAddressLength );
+            if ( nRead < 0 )
+            {
+                break;
+            }
+
+            pDatagram->m_nLength = (size_t)nRead;
+            pDatagram->m_nAddressLength = nAddressLength;
+            nReceived++;
+    #ifdef IASLIB_STATS__
+            BytesReceived()->Add( nRead );
+    #endif
+        }
+
+    #ifdef IASLIB_STATS__
+        DatagramsReceived()->Add( nReceived );
+    #endif
+        return nReceived;
+    #endif
+    }
+
+    /**
+     * SendBatch
+     *
+     *      Sends a batch of datagrams, each to the address in its slot, with
+     * as few system calls as the platform allows. Datagram delivery is best
+     * effort, so a datagram the kernel refuses is skipped, not retried.
+     *
+     * @return
+     *      The number of datagrams handed to the kernel.
+     */
+    size_t CUDPSocket::SendBatch( const Datagram *aDatagrams, size_t nCount )
+    {
+        size_t nSent = 0;
+
+    #ifdef IASLIB_LINUX__
+        struct mmsghdr  aMessages[ MAX_BATCH ];
+        struct iovec    aVectors[ MAX_BATCH ];
+        size_t          nDone = 0;
+
+        while ( nDone < nCount )
+        {
+            size_t nBatch = ( nCount - nDone > MAX_BATCH ) ? (size_t)MAX_BATCH : nCount - nDone;
+
+            memset( aMessages, 0, sizeof( struct mmsghdr ) * nBatch );
+            for ( size_t nX = 0; nX < nBatch; nX++ )
+            {
+                const Datagram *pDatagram = &aDatagrams[ nDone + nX ];
+                aVectors[ nX ].iov_base = pDatagram->m_pchBuffer;
+                aVectors[ nX ].iov_len = pDatagram->m_nLength;
+                aMessages[ nX ].msg_hdr.msg_name = (void *)&pDatagram->m_stAddress;
+                aMessages[ nX ].msg_hdr.msg_namelen = pDatagram->m_nAddressLength;
+                aMessages[ nX ].msg_hdr.msg_iov = &aVectors[ nX ];
+                aMessages[ nX ].msg_hdr.msg_iovlen = 1;
+            }
+
+            size_t nOffset = 0;
+            while ( nOffset < nBatch )
+            {
+                int nRet = sendmmsg( m_hSocket, &aMessages[ nOffset ], (unsigned int)( nBatch - nOffset ), 0 );
+                if ( nRet < 0 )
+                {
+                    if ( errno == EINTR )
+                    {
+                        continue;
+                    }
+                    nOffset++;
+                }
+                else
+                {
+    #ifdef IASLIB_STATS__
+                    size_t nBytes = 0;
+                    for ( int nX = 0; nX < nRet; nX++ )
+                    {
+                        nBytes += aMessages[ nOffset + nX ].msg_len;
+                    }
+                    BytesSent()->Add( nBytes );
+    #endif
+                    nOffset += (size_t)nRet;
+                    nSent += (size_t)nRet;
+                }
+            }
+
+            nDone += nBatch;
+        }
+    #else
+        for ( size_t nX = 0; nX < nCount; nX++ )
+        {
+            if ( sendto( m_hSocket, aDatagrams[ nX ].m_pchBuffer, (int)aDatagrams[ nX ].m_nLength, 0, (const struct sockaddr *)&aDatagrams[ nX ].m_stAddress, aDatagrams[ nX ].m_nAddressLength ) >= 0 )
+            {
+                nSent++;
+        #ifdef IASLIB_STATS__
+                BytesSent()->Add( aDatagrams[ nX ].m_nLength );
+        #endif
+            }
+        }
+    #endif
+
+    #ifdef IASLIB_STATS__
+        DatagramsSent()->Add( nSent );
+    #endif
+        return nSent;
+    }
+
     void CUDPSocket::Close( void )
     {
         if ( m_hSocket )
@@ -17,189 +17,476 @@
 
 #include "CoverageMap.h"
 
-#ifndef IASLIB_WIN32
-#include <iostream>
-#else
-#include <ostream>
-#endif
+#include <stdio.h>
 
 #ifdef IASLIB_STATS__
 
 namespace IASLib
 {
-    class CCoverageObject : public CObject
-    {
-        protected:
-            size_t      m_nLocation;
-            size_t      m_nSize;
-        public:
-                        CCoverageObject( size_t nLoc, size_t nSize )
-                        {
-                            m_nLocation = nLoc;
-                            m_nSize = nSize;
-                        }
-            virtual    ~CCoverageObject() { }
-
-                        DECLARE_OBJECT( CCoverageObject, CObject );
-
-            size_t      GetSize( void ) { return m_nSize; }
-            size_t      GetLocation( void ) {return m_nLocation; }
-
-            void        SetSize( size_t nSize ) { m_nSize = nSize; }
-    };
-
-    static int ObjectCompareFunc( const CObject *p1, const CObject *p2 )
-    {
-        if ( p1 == p2 )
-            return 0;
-
-        return -1;
-    }
+    IMPLEMENT_OBJECT( CCoverageMap, CObject );
 
     CCoverageMap::CCoverageMap( void )
-        : m_aCoverageMap( ObjectCompareFunc, 2048 )
     {
+        m_pRoot = NULL;
+        m_nRanges = 0;
         m_nMinimum = IASLib::NOT_FOUND;
         m_nMaximum = 0;
         m_fFragmentation = 0.0;
         m_nUsed = 0;
         m_nFree = 0;
         m_nBlockSize = 4096;
+        m_nLinePosition = 0;
     }
 
     CCoverageMap::~CCoverageMap( void )
     {
-        m_aCoverageMap.DeleteAll();
+        deleteAll( m_pRoot );
     }
 
+    /**
+     * Allocate
+     *
+     *      Marks [nBase, nBase + nSize) as used. The extent before it is
+     * taken in if it reaches nBase, then every extent that starts inside
+     * the new range or right at its end, and one range covering them all
+     * is put back in their place.
+     */
     bool CCoverageMap::Allocate( size_t nBase, size_t nSize )
     {
-        CCoverageObject *pNew = new CCoverageObject( nBase, nSize );
-        bool bRetVal = true;
+        if ( nSize == 0 )
+        {
+            return true;
+        }
+
+        if ( nSize > IASLib::NOT_FOUND - nBase )
+        {
+            nSize = IASLib::NOT_FOUND - nBase;
+        }
+
+        size_t nStart = nBase;
         size_t nEnd = nBase + nSize;
+        size_t nJoined = 0;
 
-        size_t nFound = m_aCoverageMap.Find( pNew );
-        if ( nFound != IASLib::NOT_FOUND )
+        Range *pRange = findFloor( nBase );
+        if ( ( pRange ) && ( pRange->m_nEnd >= nBase ) )
         {
-            delete pNew;
-            pNew = (CCoverageObject *)m_aCoverageMap.Get( nFound );
-            if ( ( pNew->GetLocation() + pNew->GetSize() ) < nEnd )
+            nStart = pRange->m_nStart;
+            if ( pRange->m_nEnd > nEnd )
             {
-                pNew->SetSize( nEnd - pNew->GetLocation() );
+                nEnd = pRange->m_nEnd;
             }
-            bRetVal = false;
+            nJoined += pRange->m_nEnd - pRange->m_nStart;
+            removeRange( pRange->m_nStart );
         }
-        else
+
+        pRange = findCeiling( nBase );
+        while ( ( pRange ) && ( pRange->m_nStart <= nEnd ) )
         {
-            m_aCoverageMap.Append( pNew );            
+            if ( pRange->m_nEnd > nEnd )
+            {
+                nEnd = pRange->m_nEnd;
+            }
+            nJoined += pRange->m_nEnd - pRange->m_nStart;
+            removeRange( pRange->m_nStart );
+            pRange = findCeiling( nBase );
         }
+
+        insertRange( nStart, nEnd );
+
+            // Whatever of the merged range wasn't already there is new; if
+            // that's less than was asked for, some of it was in use.
+        size_t nAdded = ( nEnd - nStart ) - nJoined;
+        m_nUsed += nAdded;
+
         if ( nBase < m_nMinimum )
         {
             m_nMinimum = nBase;
         }
-        if ( nEnd > m_nMaximum )
+        if ( nBase + nSize > m_nMaximum )
         {
-            m_nMaximum = nEnd;
+            m_nMaximum = nBase + nSize;
         }
-        return bRetVal;
+        updateStats();
+
+        return ( nAdded == nSize );
     }
 
+    /**
+     * Release
+     *
+     *      Frees [nBase, nBase + nSize). An extent that only overlaps the
+     * start is cut short, one that only overlaps the end has its start
+     * moved up in place (which can't change its order in the tree), and
+     * one that covers the whole range is split in two.
+     */
     bool CCoverageMap::Release( size_t nBase, size_t nSize )
     {
-        CCoverageObject *pNew;
-        bool bRetVal = true;
+        Range *pRange = findFloor( nBase );
 
-        if ( nSize != IASLib::NOT_FOUND )
+        if ( nSize == IASLib::NOT_FOUND )
         {
-            pNew = new CCoverageObject( nBase, nSize );
+            if ( ( pRange == NULL ) || ( pRange->m_nEnd <= nBase ) )
+            {
+                return false;
+            }
+            nSize = pRange->m_nEnd - nBase;
         }
-        else
+        else if ( nSize > IASLib::NOT_FOUND - nBase )
         {
-            pNew = new CCoverageObject( nBase, 0 );
+            nSize = IASLib::NOT_FOUND - nBase;
         }
 
-        size_t nFound = m_aCoverageMap.Find( pNew );
-
-        delete pNew;
+        if ( nSize == 0 )
+        {
+            return true;
+        }
 
-        pNew = (CCoverageObject *)m_aCoverageMap.Get( nFound );
+        size_t nEnd = nBase + nSize;
+        size_t nFreed = 0;
 
-        if ( nFound == IASLib::NOT_FOUND )
+        if ( ( pRange == NULL ) || ( pRange->m_nEnd <= nBase ) )
         {
-            bRetVal = false;
+            pRange = findCeiling( nBase );
         }
-        else
+
+        while ( ( pRange ) && ( pRange->m_nStart < nEnd ) )
         {
-            if ( nBase != pNew->GetLocation() )
+            size_t nFrom = ( pRange->m_nStart > nBase ) ? pRange->m_nStart : nBase;
+            size_t nTo = ( pRange->m_nEnd < nEnd ) ? pRange->m_nEnd : nEnd;
+
+            nFreed += nTo - nFrom;
+
+            if ( ( pRange->m_nStart < nBase ) && ( pRange->m_nEnd > nEnd ) )
             {
-                // Uh-oh, we have a chunk being freed out of the middle 
-                // of a block, or possibly crossing two or more blocks.
-                // We need to figure out how to do this...
-                if ( nBase < pNew->GetLocation() )
-                {
-                    // we have to back up through the coverage array and 
-                    // look for the first block that contains this memory
-                    // block.
-                    while ( ( nFound > 0 ) && ( nBase < pNew->GetLocation() ) )
-                    {
-                        nFound--;
-                        pNew = (CCoverageObject *)m_aCoverageMap.Get( nFound );
-                    }
-                    
-                    if ( ( pNew->GetLocation() < nBase ) && 
-                         ( nBase > ( pNew->GetLocation() + pNew->GetSize() ) ) )
-                    {
-                        nFound++;
-                    }
-
-                    // Well, by here we've found the bottom edge. Now
-                    // we have to walk forward until we have cleaned up to
-                    // the top edge. This might mean making two partial 
-                    // blocks (one at the begining, one at the end.
-                    if ( pNew->GetLocation() != nBase )
-                    {
-                        pNew->SetSize( nBase - pNew->GetLocation() );
-                    }
-                    else
-                    {
-
-                    }
-                }
+                size_t nTail = pRange->m_nEnd;
+
+                pRange->m_nEnd = nBase;
+                insertRange( nEnd, nTail );
+                break;
             }
-            else
+            else if ( pRange->m_nStart < nBase )
             {
-                if ( nSize == IASLib::NOT_FOUND )
-                {
-                    nSize = pNew->GetSize();
-                }
+                pRange->m_nEnd = nBase;
             }
-
-            if ( nSize < pNew->GetSize() )
+            else if ( pRange->m_nEnd > nEnd )
+            {
+                pRange->m_nStart = nEnd;
+                break;
+            }
+            else
             {
-                // We need to split this item into one or more blocks.
+                removeRange( pRange->m_nStart );
             }
+
+            pRange = findCeiling( nBase );
         }
-        return bRetVal;
+
+        m_nUsed -= nFreed;
+        updateStats();
+
+        return ( nFreed == nSize );
+    }
+
+    bool CCoverageMap::IsAllocated( size_t nLocation ) const
+    {
+        Range *pRange = findFloor( nLocation );
+
+        return ( ( pRange ) && ( pRange->m_nEnd > nLocation ) );
+    }
+
+    void CCoverageMap::Clear( void )
+    {
+        deleteAll( m_pRoot );
+        m_pRoot = NULL;
+        m_nRanges = 0;
+        m_nMinimum = IASLib::NOT_FOUND;
+        m_nMaximum = 0;
+        m_nUsed = 0;
+        updateStats();
     }
 
+    /**
+     * Dump
+     *
+     *      Writes the extents in order, one line each, straight to the
+     * stream; nothing but the current line is ever held. With bFillInGaps,
+     * the free space between them is written out as well.
+     */
     void CCoverageMap::Dump( CStream &oStream, OutputFormatSpecifier nFormat, bool bFillInGaps )
     {
-        CIterator  *pIterator1 = m_aCoverageMap.Enumerate();
-        size_t      nBucket;
-        size_t      nStart = IASLib::NOT_FOUND;
-        size_t      nCurrent = IASLib::NOT_FOUND;
+        size_t nLast = m_nMinimum;
 
         FormatStart( oStream, nFormat );
         FormatStartLine( oStream, nFormat );
-        size_t      nTemp = 0;
+        FormatValue( oStream, "Start", nFormat );
+        FormatValue( oStream, "Size", nFormat );
+        FormatValue( oStream, "State", nFormat );
+        FormatEndLine( oStream, nFormat );
 
-            // Leave an empty column for Bucket Name
-        FormatValue( oStream, "", nFormat );
+        dumpRanges( oStream, nFormat, bFillInGaps, m_pRoot, nLast );
 
         FormatEnd( oStream, nFormat );
-        if ( pIterator1 )
+    }
+
+    void CCoverageMap::dumpRanges( CStream &oStream, OutputFormatSpecifier nFormat, bool bFillInGaps, Range *pNode, size_t &nLast )
+    {
+        if ( pNode == NULL )
+        {
+            return;
+        }
+
+        dumpRanges( oStream, nFormat, bFillInGaps, pNode->m_pLeft, nLast );
+
+        if ( ( bFillInGaps ) && ( nLast < pNode->m_nStart ) )
+        {
+            dumpLine( oStream, nFormat, nLast, pNode->m_nStart, "free" );
+        }
+        dumpLine( oStream, nFormat, pNode->m_nStart, pNode->m_nEnd, "used" );
+        nLast = pNode->m_nEnd;
+
+        dumpRanges( oStream, nFormat, bFillInGaps, pNode->m_pRight, nLast );
+    }
+
+    void CCoverageMap::dumpLine( CStream &oStream, OutputFormatSpecifier nFormat, size_t nStart, size_t nEnd, const char *strState )
+    {
+        FormatStartLine( oStream, nFormat );
+        FormatValue( oStream, nStart, nFormat );
+        FormatValue( oStream, nEnd - nStart, nFormat );
+        FormatValue( oStream, strState, nFormat );
+        FormatEndLine( oStream, nFormat );
+    }
+
+        // Fragmentation is the number of breaks between extents against
+        // the most there could be, one between every pair of used blocks.
+    void CCoverageMap::updateStats( void )
+    {
+        size_t nBlocks = ( m_nUsed / m_nBlockSize ) + ( ( m_nUsed % m_nBlockSize ) ? 1 : 0 );
+
+        m_nFree = GetSize() - m_nUsed;
+
+        if ( ( m_nRanges < 2 ) || ( nBlocks < 2 ) )
+        {
+            m_fFragmentation = 0.0;
+        }
+        else if ( m_nRanges >= nBlocks )
+        {
+            m_fFragmentation = 1.0;
+        }
+        else
+        {
+            m_fFragmentation = (double)( m_nRanges - 1 ) / (double)( nBlocks - 1 );
+        }
+    }
+
+    CCoverageMap::Range *CCoverageMap::findFloor( size_t nLocation ) const
+    {
+        Range *pNode = m_pRoot;
+        Range *pRetVal = NULL;
+
+        while ( pNode )
+        {
+            if ( pNode->m_nStart <= nLocation )
+            {
+                pRetVal = pNode;
+                pNode = pNode->m_pRight;
+            }
+            else
+            {
+                pNode = pNode->m_pLeft;
+            }
+        }
+
+        return pRetVal;
+    }
+
+    CCoverageMap::Range *CCoverageMap::findCeiling( size_t nLocation ) const
+    {
+        Range *pNode = m_pRoot;
+        Range *pRetVal = NULL;
+
+        while ( pNode )
+        {
+            if ( pNode->m_nStart >= nLocation )
+            {
+                pRetVal = pNode;
+                pNode = pNode->m_pLeft;
+            }
+            else
+            {
+                pNode = pNode->m_pRight;
+            }
+        }
+
+        return pRetVal;
+    }
+
+    void CCoverageMap::insertRange( size_t nStart, size_t nEnd )
+    {
+        Range *pNew = new Range;
+
+        pNew->m_nStart = nStart;
+        pNew->m_nEnd = nEnd;
+        pNew->m_pLeft = NULL;
+        pNew->m_pRight = NULL;
+        pNew->m_nHeight = 1;
+
+        m_pRoot = insert( m_pRoot, pNew );
+        m_nRanges++;
+    }
+
+    void CCoverageMap::removeRange( size_t nStart )
+    {
+        m_pRoot = remove( m_pRoot, nStart );
+        m_nRanges--;
+    }
+
+    static inline int RangeHeight( int nLeft, int nRight )
+    {
+        return ( ( nLeft > nRight ) ? nLeft : nRight ) + 1;
+    }
+
+        // The tree is an AVL tree; a node's subtrees never differ in height
+        // by more than one, so even millions of ranges are only a few dozen
+        // levels deep, and the recursion here stays shallow.
+    CCoverageMap::Range *CCoverageMap::insert( Range *pNode, Range *pNew )
+    {
+        if ( pNode == NULL )
+        {
+            return pNew;
+        }
+
+        if ( pNew->m_nStart < pNode->m_nStart )
+        {
+            pNode->m_pLeft = insert( pNode->m_pLeft, pNew );
+        }
+        else
+        {
+            pNode->m_pRight = insert( pNode->m_pRight, pNew );
+        }
+
+        return balance( pNode );
+    }
+
+    CCoverageMap::Range *CCoverageMap::remove( Range *pNode, size_t nStart )
+    {
+        if ( pNode == NULL )
+        {
+            return NULL;
+        }
+
+        if ( nStart < pNode->m_nStart )
+        {
+            pNode->m_pLeft = remove( pNode->m_pLeft, nStart );
+        }
+        else if ( nStart > pNode->m_nStart )
+        {
+            pNode->m_pRight = remove( pNode->m_pRight, nStart );
+        }
+        else
+        {
+            Range *pLeft = pNode->m_pLeft;
+            Range *pRight = pNode->m_pRight;
+
+            delete pNode;
+
+            if ( pRight == NULL )
+            {
+                return pLeft;
+            }
+
+            Range *pMinimum = NULL;
+
+            pRight = removeMinimum( pRight, &pMinimum );
+            pMinimum->m_pLeft = pLeft;
+            pMinimum->m_pRight = pRight;
+            pNode = pMinimum;
+        }
+
+        return balance( pNode );
+    }
+
+    CCoverageMap::Range *CCoverageMap::removeMinimum( Range *pNode, Range **ppMinimum )
+    {
+        if ( pNode->m_pLeft == NULL )
+        {
+            *ppMinimum = pNode;
+            return pNode->m_pRight;
+        }
+
+        pNode->m_pLeft = removeMinimum( pNode->m_pLeft, ppMinimum );
+
+        return balance( pNode );
+    }
+
+    CCoverageMap::Range *CCoverageMap::balance( Range *pNode )
+    {
+        int nLeft = ( pNode->m_pLeft ) ? pNode->m_pLeft->m_nHeight : 0;
+        int nRight = ( pNode->m_pRight ) ? pNode->m_pRight->m_nHeight : 0;
+
+        if ( nLeft > nRight + 1 )
+        {
+            Range *pLeft = pNode->m_pLeft;
+            int nOuter = ( pLeft->m_pLeft ) ? pLeft->m_pLeft->m_nHeight : 0;
+            int nInner = ( pLeft->m_pRight ) ? pLeft->m_pRight->m_nHeight : 0;
+
+            if ( nInner > nOuter )
+            {
+                pNode->m_pLeft = rotateLeft( pLeft );
+            }
+            return rotateRight( pNode );
+        }
+
+        if ( nRight > nLeft + 1 )
+        {
+            Range *pRight = pNode->m_pRight;
+            int nOuter = ( pRight->m_pRight ) ? pRight->m_pRight->m_nHeight : 0;
+            int nInner = ( pRight->m_pLeft ) ? pRight->m_pLeft->m_nHeight : 0;
+
+            if ( nInner > nOuter )
+            {
+                pNode->m_pRight = rotateRight( pRight );
+            }
+            return rotateLeft( pNode );
+        }
+
+        pNode->m_nHeight = RangeHeight( nLeft, nRight );
+
+        return pNode;
+    }
+
+    CCoverageMap::Range *CCoverageMap::rotateLeft( Range *pNode )
+    {
+        Range *pPivot = pNode->m_pRight;
+
+        pNode->m_pRight = pPivot->m_pLeft;
+        pPivot->m_pLeft = pNode;
+
+        pNode->m_nHeight = RangeHeight( ( pNode->m_pLeft ) ? pNode->m_pLeft->m_nHeight : 0, ( pNode->m_pRight ) ? pNode->m_pRight->m_nHeight : 0 );
+        pPivot->m_nHeight = RangeHeight( pNode->m_nHeight, ( pPivot->m_pRight ) ? pPivot->m_pRight->m_nHeight : 0 );
+
+        return pPivot;
+    }
+
+    CCoverageMap::Range *CCoverageMap::rotateRight( Range *pNode )
+    {
+        Range *pPivot = pNode->m_pLeft;
+
+        pNode->m_pLeft = pPivot->m_pRight;
+        pPivot->m_pRight = pNode;
+
+        pNode->m_nHeight = RangeHeight( ( pNode->m_pLeft ) ? pNode->m_pLeft->m_nHeight : 0, ( pNode->m_pRight ) ? pNode->m_pRight->m_nHeight : 0 );
+        pPivot->m_nHeight = RangeHeight( ( pPivot->m_pLeft ) ? pPivot->m_pLeft->m_nHeight : 0, pNode->m_nHeight );
+
+        return pPivot;
+    }
+
+    void CCoverageMap::deleteAll( Range *pNode )
+    {
+        if ( pNode )
         {
-            delete pIterator1;
+            deleteAll( pNode->m_pLeft );
+            deleteAll( pNode->m_pRight );
+            delete pNode;
         }
     }
 
@@ -246,13 +533,13 @@ namespace IASLib
         m_nLinePosition = 0;
     }
 
-    void CCoverageMap::FormatValue( CStream &oStream, int nValue, OutputFormatSpecifier nFormat )
+    void CCoverageMap::FormatValue( CStream &oStream, size_t nValue, OutputFormatSpecifier nFormat )
     {
-        CString strTemp;
+        char achValue[ 32 ];
 
-        strTemp.Format( "%d", nValue );
+        snprintf( achValue, sizeof( achValue ), "%llu", (unsigned long long)nValue );
 
-        FormatValue( oStream, strTemp, nFormat );
+        FormatValue( oStream, achValue, nFormat );
     }
 
     void CCoverageMap::FormatValue( CStream &oStream, const char *strValue, OutputFormatSpecifier nFormat )
@@ -322,13 +609,6 @@ namespace IASLib
 
         oStream.PutBuffer( (const char *)strTemp, (int)strTemp.GetLength() );
     }
-
-    size_t CCoverageMap::FindCategory( const char *strCategoryName )
-    {
-        size_t nCount = 0;
-
-        return IASLib::NOT_FOUND;
-    }
 } // namespace IASLib
 
 #endif // IASLIB_STATS__
@@ -0,0 +1,370 @@
+/**
+ * Latency Histogram Class
+ *
+ *  This class records values, usually latencies in microseconds, from
+ * any number of threads at once, and answers percentile questions about
+ * them the way an HDR histogram does.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "LatencyHistogram.h"
+
+#ifdef IASLIB_STATS__
+
+#include <string.h>
+#include <math.h>
+#ifdef IASLIB_WIN32__
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <time.h>
+#endif
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CLatencyHistogram, CObject );
+    IMPLEMENT_OBJECT( CLatencySnapshot, CObject );
+
+    const unsigned long long CLatencyHistogram::MAX_VALUE;
+
+#ifdef IASLIB_MULTI_THREADED__
+    #ifdef IASLIB_WIN32__
+    static __declspec( thread ) size_t s_nThreadShard = 0;
+
+    static void AtomicAdd( volatile unsigned long long *pullValue, unsigned long long ullAdd ) { InterlockedExchangeAdd64( (volatile LONGLONG *)pullValue, (LONGLONG)ullAdd ); }
+    static unsigned long long AtomicTake( volatile unsigned long long *pullValue ) { return (unsigned long long)InterlockedExchange64( (volatile LONGLONG *)pullValue, 0 ); }
+    static void *AtomicPlace( void *volatile *ppSlot, void *pNew ) { return InterlockedCompareExchangePointer( ppSlot, pNew, NULL ); }
+    static size_t NextShard( void ) { static volatile LONG s_nNextShard = 0; return (size_t)InterlockedIncrement( &s_nNextShard ); }
+    #else
+    static __thread size_t s_nThreadShard = 0;
+
+    static void AtomicAdd( volatile unsigned long long *pullValue, unsigned long long ullAdd ) { __sync_fetch_and_add( pullValue, ullAdd ); }
+    static unsigned long long AtomicTake( volatile unsigned long long *pullValue ) { return __sync_fetch_and_and( pullValue, 0ULL ); }
+    static void *AtomicPlace( void *volatile *ppSlot, void *pNew ) { return __sync_val_compare_and_swap( ppSlot, (void *)NULL, pNew ); }
+    static size_t NextShard( void ) { static volatile size_t s_nNextShard = 0; return __sync_add_and_fetch( &s_nNextShard, 1 ); }
+    #endif
+#else
+    static size_t s_nThreadShard = 1;
+
+    static void AtomicAdd( volatile unsigned long long *pullValue, unsigned long long ullAdd ) { *pullValue += ullAdd; }
+    static unsigned long long AtomicTake( volatile unsigned long long *pullValue ) { unsigned long long ullValue = *pullValue; *pullValue = 0; return ullValue; }
+    static void *AtomicPlace( void *volatile *ppSlot, void *pNew ) { void *pOld = *ppSlot; if ( pOld == NULL ) { *ppSlot = pNew; } return pOld; }
+    static size_t NextShard( void ) { return 1; }
+#endif
+
+    static int HighestBit( unsigned long long ullValue )
+    {
+#ifdef IASLIB_WIN32__
+        unsigned long ulIndex;
+        _BitScanReverse64( &ulIndex, ullValue );
+        return (int)ulIndex;
+#else
+        return 63 - __builtin_clzll( ullValue );
+#endif
+    }
+
+    CLatencyHistogram::CLatencyHistogram( void )
+    {
+        for ( size_t nX = 0; nX < SHARDS; nX++ )
+        {
+            m_apShards[ nX ] = NULL;
+        }
+    }
+
+    CLatencyHistogram::~CLatencyHistogram( void )
+    {
+        for ( size_t nX = 0; nX < SHARDS; nX++ )
+        {
+            delete m_apShards[ nX ];
+        }
+    }
+
+    /**
+     * Record
+     *
+     *      Counts one value. Safe to call from any number of threads; it
+     * takes no lock, and makes no allocation after a thread's first call.
+     */
+    void CLatencyHistogram::Record( unsigned long long ullValue )
+    {
+        if ( ullValue > MAX_VALUE )
+        {
+            ullValue = MAX_VALUE;
+        }
+
+        Shard *pShard = GetShard();
+
+        AtomicAdd( &pShard->m_aullCounts[ BucketIndex( ullValue ) ], 1 );
+        AtomicAdd( &pShard->m_ullSum, ullValue );
+    }
+
+    /**
+     * Snapshot
+     *
+     *      Merges every shard's counts into the snapshot. With bReset, the
+     * counts are taken out as they're read, so the next snapshot covers
+     * only what was recorded after this one, and nothing in between is
+     * lost. Values being recorded while this runs may or may not be in it.
+     */
+    void CLatencyHistogram::Snapshot( CLatencySnapshot &snapshot, bool bReset )
+    {
+        snapshot.Clear();
+
+        for ( size_t nShard = 0; nShard < SHARDS; nShard++ )
+        {
+            Shard *pShard = m_apShards[ nShard ];
+            if ( pShard == NULL )
+            {
+                continue;
+            }
+
+            for ( size_t nBucket = 0; nBucket < BUCKETS; nBucket++ )
+            {
+                unsigned long long ullCount = ( bReset ) ? AtomicTake( &pShard->m_aullCounts[ nBucket ] ) : pShard->m_aullCounts[ nBucket ];
+                snapshot.m_pullCounts[ nBucket ] += ullCount;
+                snapshot.m_ullCount += ullCount;
+            }
+
+            snapshot.m_ullSum += ( bReset ) ? AtomicTake( &pShard->m_ullSum ) : pShard->m_ullSum;
+        }
+    }
+
+    void CLatencyHistogram::Reset( void )
+    {
+        CLatencySnapshot discard;
+
+        Snapshot( discard, true );
+    }
+
+        // The bucket a value falls in: the value itself under SUB_BUCKETS,
+        // and above that, its top SUB_BUCKET_BITS - 1 bits after the first
+        // and which power of two it's in.
+    size_t CLatencyHistogram::BucketIndex( unsigned long long ullValue )
+    {
+        if ( ullValue < SUB_BUCKETS )
+        {
+            return (size_t)ullValue;
+        }
+
+        int nShift = HighestBit( ullValue ) - ( SUB_BUCKET_BITS - 1 );
+
+        return SUB_BUCKETS + ( nShift - 1 ) * HALF_SUB_BUCKETS + (size_t)( ( ullValue >> nShift ) - HALF_SUB_BUCKETS );
+    }
+
+    unsigned long long CLatencyHistogram::BucketLow( size_t nBucket )
+    {
+        if ( nBucket < SUB_BUCKETS )
+        {
+            return nBucket;
+        }
+
+        size_t nShift = ( nBucket - SUB_BUCKETS ) / HALF_SUB_BUCKETS + 1;
+        unsigned long long ullSub = ( nBucket - SUB_BUCKETS ) % HALF_SUB_BUCKETS + HALF_SUB_BUCKETS;
+
+        return ullSub << nShift;
+    }
+
+        // The highest value that falls in the bucket, which is what's
+        // reported for it, so a percentile is never understated.
+    unsigned long long CLatencyHistogram::BucketHigh( size_t nBucket )
+    {
+        if ( nBucket < SUB_BUCKETS )
+        {
+            return nBucket;
+        }
+
+        size_t nShift = ( nBucket - SUB_BUCKETS ) / HALF_SUB_BUCKETS + 1;
+
+        return BucketLow( nBucket ) + ( 1ULL << nShift ) - 1;
+    }
+
+        // Microseconds from a clock that only goes forward, for timing.
+    unsigned long long CLatencyHistogram::Now( void )
+    {
+#ifdef IASLIB_WIN32__
+        static LARGE_INTEGER s_liFrequency = { 0 };
+        LARGE_INTEGER liCounter;
+
+        if ( s_liFrequency.QuadPart == 0 )
+        {
+            QueryPerformanceFrequency( &s_liFrequency );
+        }
+        QueryPerformanceCounter( &liCounter );
+
+        return (unsigned long long)( liCounter.QuadPart / s_liFrequency.QuadPart ) * 1000000ULL +
+               (unsigned long long)( liCounter.QuadPart % s_liFrequency.QuadPart ) * 1000000ULL / (unsigned long long)s_liFrequency.QuadPart;
+#else
+        struct timespec ts;
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+        return ( (unsigned long long)ts.tv_sec * 1000000ULL ) + (unsigned long long)( ts.tv_nsec / 1000L );
+#endif
+    }
+
+        // The calling thread's shard, made the first time it's needed. The
+        // threads are dealt out to the shards in turn.
+    CLatencyHistogram::Shard *CLatencyHistogram::GetShard( void )
+    {
+        if ( s_nThreadShard == 0 )
+        {
+            s_nThreadShard = NextShard();
+        }
+
+        size_t nShard = ( s_nThreadShard - 1 ) % SHARDS;
+        Shard *pShard = m_apShards[ nShard ];
+
+        if ( pShard == NULL )
+        {
+            Shard *pNew = new Shard;
+            memset( (void *)pNew, 0, sizeof( Shard ) );
+
+            pShard = (Shard *)AtomicPlace( (void *volatile *)&m_apShards[ nShard ], pNew );
+            if ( pShard == NULL )
+            {
+                pShard = pNew;
+            }
+            else
+            {
+                delete pNew;
+            }
+        }
+
+        return pShard;
+    }
+
+    CLatencySnapshot::CLatencySnapshot( void )
+    {
+        m_pullCounts = new unsigned long long[ CLatencyHistogram::BUCKETS ];
+        Clear();
+    }
+
+    CLatencySnapshot::CLatencySnapshot( const CLatencySnapshot &oSource )
+    {
+        m_pullCounts = new unsigned long long[ CLatencyHistogram::BUCKETS ];
+        memcpy( m_pullCounts, oSource.m_pullCounts, sizeof( unsigned long long ) * CLatencyHistogram::BUCKETS );
+        m_ullCount = oSource.m_ullCount;
+        m_ullSum = oSource.m_ullSum;
+    }
+
+    CLatencySnapshot::~CLatencySnapshot( void )
+    {
+        delete [] m_pullCounts;
+    }
+
+    CLatencySnapshot &CLatencySnapshot::operator =( const CLatencySnapshot &oSource )
+    {
+        if ( this != &oSource )
+        {
+            memcpy( m_pullCounts, oSource.m_pullCounts, sizeof( unsigned long long ) * CLatencyHistogram::BUCKETS );
+            m_ullCount = oSource.m_ullCount;
+            m_ullSum = oSource.m_ullSum;
+        }
+
+        return *this;
+    }
+
+    void CLatencySnapshot::Clear( void )
+    {
+        memset( m_pullCounts, 0, sizeof( unsigned long long ) * CLatencyHistogram::BUCKETS );
+        m_ullCount = 0;
+        m_ullSum = 0;
+    }
+
+        // Adds another snapshot's counts in, to cover both (say, several
+        // intervals, or several histograms).
+    void CLatencySnapshot::Add( const CLatencySnapshot &oOther )
+    {
+        for ( size_t nBucket = 0; nBucket < CLatencyHistogram::BUCKETS; nBucket++ )
+        {
+            m_pullCounts[ nBucket ] += oOther.m_pullCounts[ nBucket ];
+        }
+        m_ullCount += oOther.m_ullCount;
+        m_ullSum += oOther.m_ullSum;
+    }
+
+    double CLatencySnapshot::GetMean( void ) const
+    {
+        return ( m_ullCount ) ? (double)m_ullSum / (double)m_ullCount : 0.0;
+    }
+
+    unsigned long long CLatencySnapshot::GetMin( void ) const
+    {
+        for ( size_t nBucket = 0; nBucket < CLatencyHistogram::BUCKETS; nBucket++ )
+        {
+            if ( m_pullCounts[ nBucket ] )
+            {
+                return CLatencyHistogram::BucketLow( nBucket );
+            }
+        }
+
+        return 0;
+    }
+
+    unsigned long long CLatencySnapshot::GetMax( void ) const
+    {
+        for ( size_t nBucket = CLatencyHistogram::BUCKETS; nBucket > 0; nBucket-- )
+        {
+            if ( m_pullCounts[ nBucket - 1 ] )
+            {
+                return CLatencyHistogram::BucketHigh( nBucket - 1 );
+            }
+        }
+
+        return 0;
+    }
+
+    /**
+     * GetValueAtPercentile
+     *
+     *      The value that dPercentile percent (0 to 100) of the recorded
+     * values are at or under, as the top of its bucket.
+     *
+     * @return
+     *      The value, or 0 if nothing has been recorded.
+     */
+    unsigned long long CLatencySnapshot::GetValueAtPercentile( double dPercentile ) const
+    {
+        if ( m_ullCount == 0 )
+        {
+            return 0;
+        }
+
+        if ( dPercentile > 100.0 )
+        {
+            dPercentile = 100.0;
+        }
+
+        unsigned long long ullTarget = (unsigned long long)ceil( ( dPercentile / 100.0 ) * (double)m_ullCount );
+        if ( ullTarget == 0 )
+        {
+            ullTarget = 1;
+        }
+
+        unsigned long long ullSeen = 0;
+        for ( size_t nBucket = 0; nBucket < CLatencyHistogram::BUCKETS; nBucket++ )
+        {
+            ullSeen += m_pullCounts[ nBucket ];
+            if ( ullSeen >= ullTarget )
+            {
+                return CLatencyHistogram::BucketHigh( nBucket );
+            }
+        }
+
+        return GetMax();
+    }
+
+    CString CLatencySnapshot::ToString( void ) const
+    {
+        return CString::FormatString( "count=%llu mean=%.1f min=%llu p50=%llu p90=%llu p99=%llu p999=%llu max=%llu",
+                                      m_ullCount, GetMean(), GetMin(),
+                                      GetValueAtPercentile( 50.0 ), GetValueAtPercentile( 90.0 ),
+                                      GetValueAtPercentile( 99.0 ), GetValueAtPercentile( 99.9 ),
+                                      GetMax() );
+    }
+} // namespace IASLib
+
+#endif // IASLIB_STATS__
@@ -0,0 +1,347 @@
+/**
+ * Metrics Classes
+ *
+ *  These classes keep the process' operational metrics, counters, gauges
+ * and summaries, and write them out in the Prometheus text format.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "Metrics.h"
+
+#ifdef IASLIB_STATS__
+
+#include <stdio.h>
+#include <string.h>
+#ifdef IASLIB_WIN32__
+#include <windows.h>
+#endif
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CMetric, CObject );
+    IMPLEMENT_OBJECT( CCounter, CMetric );
+    IMPLEMENT_OBJECT( CGauge, CMetric );
+    IMPLEMENT_OBJECT( CSummary, CMetric );
+    IMPLEMENT_OBJECT( CMetricsRegistry, CObject );
+
+#ifdef IASLIB_MULTI_THREADED__
+    #ifdef IASLIB_WIN32__
+    static __declspec( thread ) size_t s_nThreadCell = 0;
+
+    static void AtomicAdd( volatile unsigned long long *pullValue, unsigned long long ullAdd ) { InterlockedExchangeAdd64( (volatile LONGLONG *)pullValue, (LONGLONG)ullAdd ); }
+    static void AtomicAdd( volatile long long *pllValue, long long llAdd ) { InterlockedExchangeAdd64( (volatile LONGLONG *)pllValue, (LONGLONG)llAdd ); }
+    static void AtomicSet( volatile long long *pllValue, long long llValue ) { InterlockedExchange64( (volatile LONGLONG *)pllValue, (LONGLONG)llValue ); }
+    static size_t NextCell( void ) { static volatile LONG s_nNextCell = 0; return (size_t)InterlockedIncrement( &s_nNextCell ); }
+    #else
+    static __thread size_t s_nThreadCell = 0;
+
+    static void AtomicAdd( volatile unsigned long long *pullValue, unsigned long long ullAdd ) { __sync_fetch_and_add( pullValue, ullAdd ); }
+    static void AtomicAdd( volatile long long *pllValue, long long llAdd ) { __sync_fetch_and_add( pllValue, llAdd ); }
+    static void AtomicSet( volatile long long *pllValue, long long llValue ) { __sync_lock_test_and_set( pllValue, llValue ); }
+    static size_t NextCell( void ) { static volatile size_t s_nNextCell = 0; return __sync_add_and_fetch( &s_nNextCell, 1 ); }
+    #endif
+#else
+    static size_t s_nThreadCell = 1;
+
+    static void AtomicAdd( volatile unsigned long long *pullValue, unsigned long long ullAdd ) { *pullValue += ullAdd; }
+    static void AtomicAdd( volatile long long *pllValue, long long llAdd ) { *pllValue += llAdd; }
+    static void AtomicSet( volatile long long *pllValue, long long llValue ) { *pllValue = llValue; }
+    static size_t NextCell( void ) { return 1; }
+#endif
+
+    static void WriteHeader( CString &strOut, const CString &strName, const CString &strHelp, const char *strType )
+    {
+        strOut += "# HELP ";
+        strOut += strName;
+        strOut += " ";
+        strOut += strHelp;
+        strOut += "\n# TYPE ";
+        strOut += strName;
+        strOut += " ";
+        strOut += strType;
+        strOut += "\n";
+    }
+
+    CMetric::CMetric( const char *strName, const char *strHelp, Type type )
+        : m_strName( strName ), m_strHelp( strHelp ), m_type( type )
+    {
+    }
+
+    CMetric::~CMetric( void )
+    {
+    }
+
+    CCounter::CCounter( const char *strName, const char *strHelp )
+        : CMetric( strName, strHelp, COUNTER )
+    {
+        memset( (void *)m_aCells, 0, sizeof( m_aCells ) );
+    }
+
+    CCounter::~CCounter( void )
+    {
+    }
+
+    /**
+     * Add
+     *
+     *      Adds to the cell this thread was handed the first time it counted
+     * anything. Threads are dealt cells in turn, so until there are more
+     * of them than cells, no two share one.
+     */
+    void CCounter::Add( unsigned long long ullAmount )
+    {
+        if ( s_nThreadCell == 0 )
+        {
+            s_nThreadCell = NextCell();
+        }
+
+        AtomicAdd( &m_aCells[ s_nThreadCell % CELLS ].m_ullValue, ullAmount );
+    }
+
+    unsigned long long CCounter::Get( void ) const
+    {
+        unsigned long long ullTotal = 0;
+
+        for ( size_t nX = 0; nX < CELLS; nX++ )
+        {
+            ullTotal += m_aCells[ nX ].m_ullValue;
+        }
+
+        return ullTotal;
+    }
+
+    void CCounter::Write( CString &strOut )
+    {
+        char achLine[ 64 ];
+
+        WriteHeader( strOut, m_strName, m_strHelp, "counter" );
+        strOut += m_strName;
+        snprintf( achLine, sizeof( achLine ), " %llu\n", Get() );
+        strOut += achLine;
+    }
+
+    CGauge::CGauge( const char *strName, const char *strHelp )
+        : CMetric( strName, strHelp, GAUGE ), m_llValue( 0 )
+    {
+    }
+
+    CGauge::~CGauge( void )
+    {
+    }
+
+    void CGauge::Set( long long llValue )
+    {
+        AtomicSet( &m_llValue, llValue );
+    }
+
+    void CGauge::Add( long long llAmount )
+    {
+        AtomicAdd( &m_llValue, llAmount );
+    }
+
+    void CGauge::Write( CString &strOut )
+    {
+        char achLine[ 64 ];
+
+        WriteHeader( strOut, m_strName, m_strHelp, "gauge" );
+        strOut += m_strName;
+        snprintf( achLine, sizeof( achLine ), " %lld\n", Get() );
+        strOut += achLine;
+    }
+
+    CSummary::CSummary( const char *strName, const char *strHelp, double dScale )
+        : CMetric( strName, strHelp, SUMMARY ), m_dScale( dScale )
+    {
+    }
+
+    CSummary::~CSummary( void )
+    {
+    }
+
+    /**
+     * Write
+     *
+     *      Summaries are cumulative, as Prometheus expects; the quantiles
+     * are over everything recorded since the process started.
+     */
+    void CSummary::Write( CString &strOut )
+    {
+        static const char *s_astrQuantiles[] = { "0.5", "0.9", "0.99", "0.999" };
+        static const double s_adPercentiles[] = { 50.0, 90.0, 99.0, 99.9 };
+
+        CLatencySnapshot snapshot;
+        char achLine[ 128 ];
+
+        m_histValues.Snapshot( snapshot );
+
+        WriteHeader( strOut, m_strName, m_strHelp, "summary" );
+        for ( size_t nX = 0; nX < sizeof( s_adPercentiles ) / sizeof( s_adPercentiles[ 0 ] ); nX++ )
+        {
+            strOut += m_strName;
+            snprintf( achLine, sizeof( achLine ), "{quantile=\"%s\"} %.9g\n", s_astrQuantiles[ nX ], (double)snapshot.GetValueAtPercentile( s_adPercentiles[ nX ] ) * m_dScale );
+            strOut += achLine;
+        }
+
+        strOut += m_strName;
+        snprintf( achLine, sizeof( achLine ), "_sum %.9g\n", (double)snapshot.GetSum() * m_dScale );
+        strOut += achLine;
+        strOut += m_strName;
+        snprintf( achLine, sizeof( achLine ), "_count %llu\n", snapshot.GetCount() );
+        strOut += achLine;
+    }
+
+    CMetricsRegistry::CMetricsRegistry( void )
+    {
+    }
+
+    CMetricsRegistry::~CMetricsRegistry( void )
+    {
+        m_aMetrics.DeleteAll();
+    }
+
+    /**
+     * GetInstance
+     *
+     *      The registry is made on first use and never destroyed, since
+     * code anywhere may still be counting into it while statics are being
+     * torn down at exit.
+     */
+    CMetricsRegistry *CMetricsRegistry::GetInstance( void )
+    {
+        static CMetricsRegistry *s_pRegistry = new CMetricsRegistry();
+
+        return s_pRegistry;
+    }
+
+    CCounter *CMetricsRegistry::GetCounter( const char *strName, const char *strHelp )
+    {
+        CCounter *pRetVal = NULL;
+
+#ifdef IASLIB_MULTI_THREADED__
+        m_mutexRegistry.Lock();
+#endif
+        CMetric *pMetric = find( strName );
+        if ( pMetric == NULL )
+        {
+            pRetVal = new CCounter( strName, strHelp );
+            m_aMetrics.Push( pRetVal );
+        }
+        else if ( pMetric->GetMetricType() == CMetric::COUNTER )
+        {
+            pRetVal = (CCounter *)pMetric;
+        }
+#ifdef IASLIB_MULTI_THREADED__
+        m_mutexRegistry.Unlock();
+#endif
+
+        return pRetVal;
+    }
+
+    CGauge *CMetricsRegistry::GetGauge( const char *strName, const char *strHelp )
+    {
+        CGauge *pRetVal = NULL;
+
+#ifdef IASLIB_MULTI_THREADED__
+        m_mutexRegistry.Lock();
+#endif
+        CMetric *pMetric = find( strName );
+        if ( pMetric == NULL )
+        {
+            pRetVal = new CGauge( strName, strHelp );
+            m_aMetrics.Push( pRetVal );
+        }
+        else if ( pMetric->GetMetricType() == CMetric::GAUGE )
+        {
+            pRetVal = (CGauge *)pMetric;
+        }
+#ifdef IASLIB_MULTI_THREADED__
+        m_mutexRegistry.Unlock();
+#endif
+
+        return pRetVal;
+    }
+
+    CSummary *CMetricsRegistry::GetSummary( const char *strName, const char *strHelp, double dScale )
+    {
+        CSummary *pRetVal = NULL;
+
+#ifdef IASLIB_MULTI_THREADED__
+        m_mutexRegistry.Lock();
+#endif
+        CMetric *pMetric = find( strName );
+        if ( pMetric == NULL )
+        {
+            pRetVal = new CSummary( strName, strHelp, dScale );
+            m_aMetrics.Push( pRetVal );
+        }
+        else if ( pMetric->GetMetricType() == CMetric::SUMMARY )
+        {
+            pRetVal = (CSummary *)pMetric;
+        }
+#ifdef IASLIB_MULTI_THREADED__
+        m_mutexRegistry.Unlock();
+#endif
+
+        return pRetVal;
+    }
+
+    CMetric *CMetricsRegistry::Find( const char *strName )
+    {
+#ifdef IASLIB_MULTI_THREADED__
+        m_mutexRegistry.Lock();
+#endif
+        CMetric *pRetVal = find( strName );
+#ifdef IASLIB_MULTI_THREADED__
+        m_mutexRegistry.Unlock();
+#endif
+
+        return pRetVal;
+    }
+
+    /**
+     * Format
+     *
+     *      Writes every metric, in the order they were made, in the
+     * Prometheus text exposition format (version 0.0.4).
+     */
+    CString CMetricsRegistry::Format( void )
+    {
+        CString strRetVal;
+
+#ifdef IASLIB_MULTI_THREADED__
+        m_mutexRegistry.Lock();
+#endif
+        for ( size_t nX = 0; nX < m_aMetrics.GetLength(); nX++ )
+        {
+            ( (CMetric *)m_aMetrics.Get( nX ) )->Write( strRetVal );
+        }
+#ifdef IASLIB_MULTI_THREADED__
+        m_mutexRegistry.Unlock();
+#endif
+
+        return strRetVal;
+    }
+
+        // There are only ever a few dozen metrics, and they're looked up once
+        // each, so a search of the array is all this needs.
+    CMetric *CMetricsRegistry::find( const char *strName )
+    {
+        for ( size_t nX = 0; nX < m_aMetrics.GetLength(); nX++ )
+        {
+            CMetric *pMetric = (CMetric *)m_aMetrics.Get( nX );
+            if ( pMetric->GetName().Compare( strName ) == 0 )
+            {
+                return pMetric;
+            }
+        }
+
+        return NULL;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_STATS__
@@ -24,12 +24,25 @@
 #ifndef IASLIB_WIN32__
 #include <sys/time.h>
 #include <sys/resource.h>
+#include <time.h>
 #endif
 
 namespace IASLib
 {
 
     CCPUUsage::CCPUUsage( void )
+    {
+        Capture( PROCESS );
+    }
+
+        // A snapshot of just the calling thread, where the platform can
+        // tell them apart, else of the process.
+    CCPUUsage::CCPUUsage( Scope scope )
+    {
+        Capture( scope );
+    }
+
+    void CCPUUsage::Capture( Scope scope )
     {
 #ifdef IASLIB_WIN32__
         FILETIME        CreateTime;
@@ -38,7 +51,14 @@ namespace IASLib
         FILETIME        UserTime;
         ULARGE_INTEGER  nTemp;
 
-        GetProcessTimes( GetCurrentProcess(), &CreateTime, &ExitTime, &KernelTime, &UserTime );
+        if ( scope == THREAD )
+        {
+            GetThreadTimes( GetCurrentThread(), &CreateTime, &ExitTime, &KernelTime, &UserTime );
+        }
+        else
+        {
+            GetProcessTimes( GetCurrentProcess(), &CreateTime, &ExitTime, &KernelTime, &UserTime );
+        }
 
         nTemp.HighPart = KernelTime.dwHighDateTime;
         nTemp.LowPart = KernelTime.dwLowDateTime;
@@ -54,16 +74,14 @@ namespace IASLib
 
         m_nTotalSeconds = m_nSysSeconds + m_nUserSeconds;
         m_nTotaluSeconds = m_nSysuSeconds + m_nUseruSeconds;
-
-        while ( m_nTotaluSeconds > 1000000 )
-        {
-            m_nTotalSeconds++;
-            m_nTotaluSeconds -= 1000000;
-        }
 #else
         struct rusage stUsageData;
 
+    #ifdef RUSAGE_THREAD
+        getrusage( ( scope == THREAD ) ? RUSAGE_THREAD : RUSAGE_SELF, &stUsageData );
+    #else
         getrusage( RUSAGE_SELF, &stUsageData );
+    #endif
 
         m_nTotalSeconds = stUsageData.ru_utime.tv_sec + stUsageData.ru_stime.tv_sec;
         m_nTotaluSeconds = stUsageData.ru_utime.tv_usec + stUsageData.ru_stime.tv_usec;
@@ -72,6 +90,12 @@ namespace IASLib
         m_nSysSeconds = stUsageData.ru_stime.tv_sec;
         m_nSysuSeconds = stUsageData.ru_stime.tv_usec;
 #endif
+
+        while ( m_nTotaluSeconds >= 1000000 )
+        {
+            m_nTotalSeconds++;
+            m_nTotaluSeconds -= 1000000;
+        }
     }
 
     CCPUUsage::CCPUUsage( const CCPUUsage &oSource )
@@ -183,5 +207,86 @@ namespace IASLib
         nMicroSec = m_nSysuSeconds;
     }
 
+    /**
+     * GetThreadTime
+     *
+     *      The CPU time, user and system together, used so far by the
+     * calling thread, in microseconds.
+     */
+    unsigned long long CCPUUsage::GetThreadTime( void )
+    {
+#ifdef IASLIB_WIN32__
+        FILETIME        CreateTime;
+        FILETIME        ExitTime;
+        FILETIME        KernelTime;
+        FILETIME        UserTime;
+        ULARGE_INTEGER  nKernel;
+        ULARGE_INTEGER  nUser;
+
+        if ( ! GetThreadTimes( GetCurrentThread(), &CreateTime, &ExitTime, &KernelTime, &UserTime ) )
+        {
+            return 0;
+        }
+
+        nKernel.HighPart = KernelTime.dwHighDateTime;
+        nKernel.LowPart = KernelTime.dwLowDateTime;
+        nUser.HighPart = UserTime.dwHighDateTime;
+        nUser.LowPart = UserTime.dwLowDateTime;
+
+        return ( nKernel.QuadPart + nUser.QuadPart ) / 10;
+#else
+        struct timespec stTime;
+
+        if ( clock_gettime( CLOCK_THREAD_CPUTIME_ID, &stTime ) != 0 )
+        {
+            return 0;
+        }
+
+        return (unsigned long long)stTime.tv_sec * 1000000ULL + (unsigned long long)( stTime.tv_nsec / 1000 );
+#endif
+    }
+
+#ifdef IASLIB_MULTI_THREADED__
+    /**
+     * GetThreadTime
+     *
+     *      The CPU time used so far by another thread, in microseconds, or
+     * 0 if it can't be had. The thread must not have been joined yet.
+     */
+    unsigned long long CCPUUsage::GetThreadTime( THREAD_T ptThread )
+    {
+#ifdef IASLIB_WIN32__
+        FILETIME        CreateTime;
+        FILETIME        ExitTime;
+        FILETIME        KernelTime;
+        FILETIME        UserTime;
+        ULARGE_INTEGER  nKernel;
+        ULARGE_INTEGER  nUser;
+
+        if ( ! GetThreadTimes( ptThread, &CreateTime, &ExitTime, &KernelTime, &UserTime ) )
+        {
+            return 0;
+        }
+
+        nKernel.HighPart = KernelTime.dwHighDateTime;
+        nKernel.LowPart = KernelTime.dwLowDateTime;
+        nUser.HighPart = UserTime.dwHighDateTime;
+        nUser.LowPart = UserTime.dwLowDateTime;
+
+        return ( nKernel.QuadPart + nUser.QuadPart ) / 10;
+#else
+        clockid_t       clockId;
+        struct timespec stTime;
+
+        if ( ( pthread_getcpuclockid( ptThread, &clockId ) != 0 ) || ( clock_gettime( clockId, &stTime ) != 0 ) )
+        {
+            return 0;
+        }
+
+        return (unsigned long long)stTime.tv_sec * 1000000ULL + (unsigned long long)( stTime.tv_nsec / 1000 );
+#endif
+    }
+#endif // IASLIB_MULTI_THREADED__
+
 } // namespace IASLib
 
@@ -0,0 +1,371 @@
+/*
+ * Thread Profiler Class
+ *
+ *  This class counts CPU time, sampled and measured, against the names
+ * of threads and the classes of the pool tasks they run.
+ *
+ *	Author: Jeffrey R. Naujok
+ *	Created: October 19, 2026
+ *
+ * Copyright (C) 2026, The Irene Adler Software Group, all rights reserved.
+ * [A division of BlackStar Enterprises, LLC.]
+ */
+
+#include "ThreadProfiler.h"
+
+#ifdef IASLIB_MULTI_THREADED__
+
+#include "../Threading/Mutex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef IASLIB_WIN32__
+#include <windows.h>
+#else
+#include <errno.h>
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+namespace IASLib
+{
+    IMPLEMENT_OBJECT( CThreadProfiler, CObject );
+
+    static const char *UNNAMED_THREAD = "(unnamed)";
+    static const char *NO_TASK = "-";
+    static const char *OTHER_THREADS = "(other)";
+
+#ifdef IASLIB_WIN32__
+    static __declspec( thread ) const char *s_strThreadLabel = NULL;
+    static __declspec( thread ) const char *s_strTaskLabel = NULL;
+
+    static void AtomicAdd( volatile unsigned long long *pullValue, unsigned long long ullAdd ) { InterlockedExchangeAdd64( (volatile LONGLONG *)pullValue, (LONGLONG)ullAdd ); }
+    static bool AtomicClaim( volatile unsigned long long *pullValue, unsigned long long ullKey ) { return InterlockedCompareExchange64( (volatile LONGLONG *)pullValue, (LONGLONG)ullKey, 0 ) == 0; }
+#else
+    static __thread const char *s_strThreadLabel = NULL;
+    static __thread const char *s_strTaskLabel = NULL;
+
+    static void AtomicAdd( volatile unsigned long long *pullValue, unsigned long long ullAdd ) { __sync_fetch_and_add( pullValue, ullAdd ); }
+    static bool AtomicClaim( volatile unsigned long long *pullValue, unsigned long long ullKey ) { return __sync_bool_compare_and_swap( pullValue, 0ULL, ullKey ); }
+#endif
+
+    static CThreadProfiler::Entry   s_aEntries[ CThreadProfiler::MAX_ENTRIES ];
+    static volatile unsigned long long s_ullSamples = 0;
+    static volatile unsigned long long s_ullDropped = 0;
+    static volatile bool            s_bRunning = false;
+    static unsigned int             s_nHertz = 0;
+
+    static const char              *s_astrLabels[ CThreadProfiler::MAX_LABELS ];
+    static size_t                   s_nLabels = 0;
+
+    static CMutex &LabelMutex( void )
+    {
+        static CMutex s_mutexLabels;
+        return s_mutexLabels;
+    }
+
+        // Finds the entry for a thread and task, making it if there isn't
+        // one. Safe in a signal handler: it only ever claims an empty slot
+        // with a compare-and-swap. Two threads making the same pair at once
+        // may make two entries; Report() adds them together.
+    static CThreadProfiler::Entry *FindEntry( const char *strThread, const char *strTask )
+    {
+        unsigned long long ullKey = ( ( (unsigned long long)(size_t)strThread * 0x9E3779B97F4A7C15ULL ) ^ ( (unsigned long long)(size_t)strTask * 0xC2B2AE3D27D4EB4FULL ) ) | 1ULL;
+        size_t nSlot = (size_t)( ( ullKey >> 17 ) % CThreadProfiler::MAX_ENTRIES );
+
+        for ( size_t nProbe = 0; nProbe < CThreadProfiler::MAX_ENTRIES; nProbe++ )
+        {
+            CThreadProfiler::Entry *pEntry = &s_aEntries[ nSlot ];
+
+            if ( ( pEntry->m_ullKey == 0 ) && ( AtomicClaim( &pEntry->m_ullKey, ullKey ) ) )
+            {
+                pEntry->m_strTask = strTask;
+                pEntry->m_strThread = strThread;
+                return pEntry;
+            }
+
+            if ( ( pEntry->m_ullKey == ullKey ) && ( pEntry->m_strThread == strThread ) && ( pEntry->m_strTask == strTask ) )
+            {
+                return pEntry;
+            }
+
+            nSlot = ( nSlot + 1 ) % CThreadProfiler::MAX_ENTRIES;
+        }
+
+        return NULL;
+    }
+
+#ifndef IASLIB_WIN32__
+    static struct sigaction s_stPreviousAction;
+
+    static void ProfileSignal( int )
+    {
+        int nSavedErrno = errno;
+
+        CThreadProfiler::Entry *pEntry = FindEntry( ( s_strThreadLabel ) ? s_strThreadLabel : UNNAMED_THREAD, ( s_strTaskLabel ) ? s_strTaskLabel : NO_TASK );
+        if ( pEntry )
+        {
+            AtomicAdd( &pEntry->m_ullSamples, 1 );
+        }
+        else
+        {
+            AtomicAdd( &s_ullDropped, 1 );
+        }
+        AtomicAdd( &s_ullSamples, 1 );
+
+        errno = nSavedErrno;
+    }
+#endif
+
+    CThreadProfiler::CThreadProfiler( void )
+    {
+    }
+
+    /**
+     * Start
+     *
+     *      Starts sampling, nHertz times for every second of CPU the process
+     * uses (a prime, by default, so it doesn't beat against anything
+     * periodic). The SIGPROF handler and the ITIMER_PROF timer are the
+     * profiler's while it runs.
+     */
+    bool CThreadProfiler::Start( unsigned int nHertz )
+    {
+#ifdef IASLIB_WIN32__
+        return false;
+#else
+        if ( ( s_bRunning ) || ( nHertz == 0 ) || ( nHertz > 1000000 ) )
+        {
+            return false;
+        }
+
+            // The caller is likely the main thread, which no CThread names.
+        if ( s_strThreadLabel == NULL )
+        {
+            SetThreadLabel( "main" );
+        }
+
+        struct sigaction stAction;
+        memset( &stAction, 0, sizeof( stAction ) );
+        stAction.sa_handler = ProfileSignal;
+        stAction.sa_flags = SA_RESTART;
+        sigemptyset( &stAction.sa_mask );
+
+        if ( sigaction( SIGPROF, &stAction, &s_stPreviousAction ) != 0 )
+        {
+            return false;
+        }
+
+        struct itimerval stTimer;
+        stTimer.it_interval.tv_sec = 0;
+        stTimer.it_interval.tv_usec = ( 1000000 / nHertz > 0 ) ? 1000000 / nHertz : 1;
+        stTimer.it_value = stTimer.it_interval;
+
+        s_nHertz = nHertz;
+        s_bRunning = true;
+
+        if ( setitimer( ITIMER_PROF, &stTimer, NULL ) != 0 )
+        {
+            s_bRunning = false;
+            sigaction( SIGPROF, &s_stPreviousAction, NULL );
+            return false;
+        }
+
+        return true;
+#endif
+    }
+
+    void CThreadProfiler::Stop( void )
+    {
+#ifndef IASLIB_WIN32__
+        if ( s_bRunning )
+        {
+            struct itimerval stTimer;
+            memset( &stTimer, 0, sizeof( stTimer ) );
+            setitimer( ITIMER_PROF, &stTimer, NULL );
+
+            s_bRunning = false;
+
+                // A tick can still be pending once the timer is off, and
+                // the default action for SIGPROF ends the process, so that
+                // one is ignored instead (which discards a pending tick).
+                // Anybody else's handler is put back.
+            struct sigaction stAction = s_stPreviousAction;
+            if ( ( ! ( stAction.sa_flags & SA_SIGINFO ) ) && ( stAction.sa_handler == SIG_DFL ) )
+            {
+                stAction.sa_handler = SIG_IGN;
+            }
+            sigaction( SIGPROF, &stAction, NULL );
+        }
+#endif
+    }
+
+    bool CThreadProfiler::IsRunning( void )
+    {
+        return s_bRunning;
+    }
+
+        // Clears the counts, keeping the labels and entries.
+    void CThreadProfiler::Reset( void )
+    {
+        for ( size_t nX = 0; nX < MAX_ENTRIES; nX++ )
+        {
+            s_aEntries[ nX ].m_ullSamples = 0;
+            s_aEntries[ nX ].m_ullTasks = 0;
+            s_aEntries[ nX ].m_ullTaskMicros = 0;
+        }
+
+        s_ullSamples = 0;
+        s_ullDropped = 0;
+    }
+
+    void CThreadProfiler::SetThreadLabel( const char *strName )
+    {
+        const char *strLabel = OTHER_THREADS;
+
+        if ( ( strName == NULL ) || ( *strName == '\0' ) )
+        {
+            s_strThreadLabel = UNNAMED_THREAD;
+            return;
+        }
+
+        LabelMutex().Lock();
+        for ( size_t nX = 0; nX < s_nLabels; nX++ )
+        {
+            if ( strcmp( s_astrLabels[ nX ], strName ) == 0 )
+            {
+                strLabel = s_astrLabels[ nX ];
+                break;
+            }
+        }
+
+        if ( ( strLabel == OTHER_THREADS ) && ( s_nLabels < MAX_LABELS ) )
+        {
+            size_t nLength = strlen( strName );
+            char *strCopy = new char[ nLength + 1 ];
+            memcpy( strCopy, strName, nLength + 1 );
+            s_astrLabels[ s_nLabels++ ] = strCopy;
+            strLabel = strCopy;
+        }
+        LabelMutex().Unlock();
+
+        s_strThreadLabel = strLabel;
+    }
+
+    void CThreadProfiler::SetTaskLabel( const char *strTask )
+    {
+        s_strTaskLabel = strTask;
+    }
+
+        // Counts one finished task, and the CPU it used, for this thread.
+    void CThreadProfiler::RecordTask( const char *strTask, unsigned long long ullMicros )
+    {
+        Entry *pEntry = FindEntry( ( s_strThreadLabel ) ? s_strThreadLabel : UNNAMED_THREAD, ( strTask ) ? strTask : NO_TASK );
+        if ( pEntry )
+        {
+            AtomicAdd( &pEntry->m_ullTasks, 1 );
+            AtomicAdd( &pEntry->m_ullTaskMicros, ullMicros );
+        }
+    }
+
+    unsigned long long CThreadProfiler::GetSamples( void )
+    {
+        return s_ullSamples;
+    }
+
+    unsigned long long CThreadProfiler::GetDroppedSamples( void )
+    {
+        return s_ullDropped;
+    }
+
+    static int CompareEntries( const void *pFirst, const void *pSecond )
+    {
+        const CThreadProfiler::Entry *pOne = (const CThreadProfiler::Entry *)pFirst;
+        const CThreadProfiler::Entry *pTwo = (const CThreadProfiler::Entry *)pSecond;
+
+        if ( pOne->m_ullSamples != pTwo->m_ullSamples )
+        {
+            return ( pOne->m_ullSamples > pTwo->m_ullSamples ) ? -1 : 1;
+        }
+
+        if ( pOne->m_ullTaskMicros != pTwo->m_ullTaskMicros )
+        {
+            return ( pOne->m_ullTaskMicros > pTwo->m_ullTaskMicros ) ? -1 : 1;
+        }
+
+        return 0;
+    }
+
+    /**
+     * Report
+     *
+     *      One line for each thread and task pair: the samples counted
+     * against it (and their share of all samples), then the pool tasks it
+     * finished and the CPU they measured.
+     */
+    CString CThreadProfiler::Report( void )
+    {
+        Entry          *aRows = new Entry[ MAX_ENTRIES ];
+        size_t          nRows = 0;
+        CString         strRetVal;
+        char            achLine[ 512 ];
+
+        for ( size_t nX = 0; nX < MAX_ENTRIES; nX++ )
+        {
+            const Entry *pEntry = &s_aEntries[ nX ];
+            const char *strThread = pEntry->m_strThread;
+            const char *strTask = pEntry->m_strTask;
+
+            if ( ( pEntry->m_ullKey == 0 ) || ( strThread == NULL ) || ( strTask == NULL ) )
+            {
+                continue;
+            }
+
+            if ( ( pEntry->m_ullSamples == 0 ) && ( pEntry->m_ullTasks == 0 ) )
+            {
+                continue;
+            }
+
+            size_t nRow = 0;
+            while ( ( nRow < nRows ) && ( ( aRows[ nRow ].m_strThread != strThread ) || ( aRows[ nRow ].m_strTask != strTask ) ) )
+            {
+                nRow++;
+            }
+
+            if ( nRow == nRows )
+            {
+                memset( (void *)&aRows[ nRow ], 0, sizeof( Entry ) );
+                aRows[ nRow ].m_strThread = strThread;
+                aRows[ nRow ].m_strTask = strTask;
+                nRows++;
+            }
+
+            aRows[ nRow ].m_ullSamples += pEntry->m_ullSamples;
+            aRows[ nRow ].m_ullTasks += pEntry->m_ullTasks;
+            aRows[ nRow ].m_ullTaskMicros += pEntry->m_ullTaskMicros;
+        }
+
+        qsort( aRows, nRows, sizeof( Entry ), CompareEntries );
+
+        unsigned long long ullSamples = s_ullSamples;
+
+        snprintf( achLine, sizeof( achLine ), "%llu samples (%u Hz), %llu dropped\n", ullSamples, s_nHertz, (unsigned long long)s_ullDropped );
+        strRetVal += achLine;
+        snprintf( achLine, sizeof( achLine ), "%10s %6s %10s %12s  %s\n", "samples", "%", "tasks", "task cpu s", "thread / task" );
+        strRetVal += achLine;
+
+        for ( size_t nRow = 0; nRow < nRows; nRow++ )
+        {
+            double dPercent = ( ullSamples ) ? ( 100.0 * (double)aRows[ nRow ].m_ullSamples / (double)ullSamples ) : 0.0;
+
+            snprintf( achLine, sizeof( achLine ), "%10llu %5.1f%% %10llu %12.3f  %s / %s\n", (unsigned long long)aRows[ nRow ].m_ullSamples, dPercent, (unsigned long long)aRows[ nRow ].m_ullTasks, (double)aRows[ nRow ].m_ullTaskMicros / 1000000.0, aRows[ nRow ].m_strThread, aRows[ nRow ].m_strTask );
+            strRetVal += achLine;
+        }
+
+        delete [] aRows;
+
+        return strRetVal;
+    }
+} // namespace IASLib
+
+#endif // IASLIB_MULTI_THREADED__
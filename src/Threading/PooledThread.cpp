@@ -17,6 +17,8 @@
 #include "PooledThread.h"
 #include "ThreadPool.h"
 #include "Date.h"
+#include "../Status/CPUUsage.h"
+#include "../Status/ThreadProfiler.h"
 
 namespace IASLib
 {
@@ -53,6 +55,12 @@ namespace IASLib
                     m_RunMutex.Lock();
                     if ( m_pActiveTask )
                     {
+                            // The task is labelled by its class, for the profiler,
+                            // and its CPU time is measured on this thread's clock.
+                        const char *strTask = m_pActiveTask->GetType();
+                        CThreadProfiler::SetTaskLabel( strTask );
+                        unsigned long long ullStartCPU = CCPUUsage::GetThreadTime();
+
                         m_pActiveTask->setRunning();
                         CObject *result = NULL;
                         try
@@ -65,6 +73,11 @@ namespace IASLib
                             m_pActiveTask->setException();
                             std::cerr << e.what() << '\n';
                         }
+
+                        m_pActiveTask->m_ullCPUTime = CCPUUsage::GetThreadTime() - ullStartCPU;
+                        CThreadProfiler::RecordTask( strTask, m_pActiveTask->m_ullCPUTime );
+                        CThreadProfiler::SetTaskLabel( NULL );
+
                         m_pParent->SetResult( result );
                         m_pActiveTask = NULL;
                     }
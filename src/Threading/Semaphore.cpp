@@ -13,6 +13,12 @@
 #include "Semaphore.h"
 #include <exception>
 #include <stdexcept>
+#include <time.h>
+#include <errno.h>
+
+#ifdef IASLIB_SUN__
+#include <unistd.h>
+#endif
 
 #ifdef IASLIB_MULTI_THREADED__
 
@@ -25,7 +31,7 @@ namespace IASLib
     #endif
 
     #ifdef IASLIB_PTHREAD__
-        printf( "Semaphore init returns: %d\n", sem_init( &m_threadSemaphore, 0, nValue ) );
+        sem_init( &m_threadSemaphore, 0, nValue );
     #endif
 
     #ifdef IASLIB_WIN32__
@@ -53,7 +59,11 @@ namespace IASLib
     #endif
 
     #ifdef IASLIB_PTHREAD__
-        sem_wait( &m_threadSemaphore );
+            // A signal (the profiler's SIGPROF, say) interrupts sem_wait even
+            // with SA_RESTART; that's not a post.
+        while ( ( sem_wait( &m_threadSemaphore ) != 0 ) && ( errno == EINTR ) )
+        {
+        }
     #endif
 
     #ifdef IASLIB_WIN32__
@@ -99,6 +109,61 @@ namespace IASLib
 
         return false;
     }
+
+    /**
+     * TimedWait
+     *
+     *      Waits for the semaphore, giving up after the given number of
+     * milliseconds. A timeout of 0xFFFFFFFF waits forever.
+     *
+     * @return
+     *      true if the semaphore was taken, false on timeout.
+     */
+    bool CSemaphore::TimedWait( unsigned long ulMilliseconds )
+    {
+        if ( ulMilliseconds == 0xFFFFFFFFUL )
+        {
+            Wait();
+            return true;
+        }
+
+    #ifdef IASLIB_SUN__
+        for ( unsigned long ulWaited = 0; ulWaited < ulMilliseconds; ulWaited++ )
+        {
+            if ( sema_trywait( &m_threadSemaphore ) == 0 )
+            {
+                return true;
+            }
+            usleep( 1000 );
+        }
+        return ( sema_trywait( &m_threadSemaphore ) == 0 );
+    #endif
+
+    #ifdef IASLIB_PTHREAD__
+        struct timespec tsDeadline;
+        clock_gettime( CLOCK_REALTIME, &tsDeadline );
+        tsDeadline.tv_sec += (time_t)( ulMilliseconds / 1000 );
+        tsDeadline.tv_nsec += (long)( ulMilliseconds % 1000 ) * 1000000L;
+        if ( tsDeadline.tv_nsec >= 1000000000L )
+        {
+            tsDeadline.tv_sec++;
+            tsDeadline.tv_nsec -= 1000000000L;
+        }
+
+        int nRet;
+        while ( ( ( nRet = sem_timedwait( &m_threadSemaphore, &tsDeadline ) ) != 0 ) && ( errno == EINTR ) )
+        {
+        }
+
+        return ( nRet == 0 );
+    #endif
+
+    #ifdef IASLIB_WIN32__
+        return ( WaitForSingleObject( m_threadSemaphore, (DWORD)ulMilliseconds ) == WAIT_OBJECT_0 );
+    #endif
+
+        return false;
+    }
 } // namespace IASLib
 
 #endif
\ No newline at end of file
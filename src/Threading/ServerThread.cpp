@@ -9,6 +9,11 @@
 **      It also provides a static interface for checking whether the
 ** server is active and can also check the thread information to see
 ** if it should be shut down, etc.
+**      Given more than one acceptor, the server opens that many
+** listening sockets on the same port (SO_REUSEPORT), each accepted on
+** by its own thread, and the kernel balances new connections between
+** them. HandleConnection is then called from all of those threads at
+** once, and must be safe to do so.
 **
 **  $AUTHOR$
 **  $LOG$
@@ -20,6 +25,9 @@
 #include "Exception.h"
 #include "SocketException.h"
 #include "ServerThread.h"
+#include "Logging/LogSink.h"
+#include <errno.h>
+#include <string.h>
 
 #ifdef IASLIB_MULTI_THREADED__
 namespace IASLib
@@ -29,65 +37,196 @@ namespace IASLib
         m_nPortNumber = nPortNumber;
         m_nMaxBacklog = nMaxBacklog;
         m_pServerSocket = NULL;
+        m_nAcceptors = 1;
+    }
+
+    CServerThread::CServerThread( const char *strThreadName, int nPortNumber, size_t nAcceptors, int nMaxBacklog ) : CThread( strThreadName, true )
+    {
+        m_nPortNumber = nPortNumber;
+        m_nMaxBacklog = nMaxBacklog;
+        m_pServerSocket = NULL;
+        m_nAcceptors = ( nAcceptors ) ? nAcceptors : 1;
     }
 
     CServerThread::~CServerThread( void )
     {
+        StopAcceptors();
         delete m_pServerSocket;
     }
 
     void *CServerThread::Run( void )
     {
-        CSocket *pNewSocket = NULL;
+        try
+        {
+            m_pServerSocket = CreateServerSocket();
+        }
+        catch ( ... )
+        {
+            m_nReturnCode = -1;
+            return NULL;
+        }
+
+            // The server still runs on however many extra acceptors could
+            // listen, but says which ones couldn't.
+        for ( size_t nX = 1; nX < m_nAcceptors; nX++ )
+        {
+            try
+            {
+                m_aAcceptors.Append( new CServerAcceptorThread( this, CreateServerSocket(), nX ) );
+            }
+            catch ( ... )
+            {
+                int nError = errno;
+                WARN_LOG( "%s: acceptor %d of %d couldn't listen on port %d: %s (errno %d)", GetName(), (int)nX, (int)m_nAcceptors, m_nPortNumber, strerror( nError ), nError );
+            }
+        }
 
-        m_pServerSocket = new CServerSocket( m_nPortNumber, m_nMaxBacklog );
         if ( m_pServerSocket->IsConnected() )
         {
-            m_pServerSocket->SetNonBlocking( false );
+            AcceptConnections( m_pServerSocket, this );
+            m_nReturnCode = 0;
+        }
+        else
+        {
+            m_nReturnCode = -1;
+            delete m_pServerSocket;
+            m_pServerSocket = NULL;
+        }
+
+        StopAcceptors();
+
+        return NULL;
+    }
+
+    /**
+     * AcceptConnections
+     *
+     *      The accept loop, run on one listening socket by the server thread
+     * and by each extra acceptor, until that thread is shut down.
+     */
+    void CServerThread::AcceptConnections( CServerSocket *pSocket, CThread *pThread )
+    {
+        CSocket *pNewSocket = NULL;
+
+        pSocket->SetNonBlocking( false );
 
-            while ( ! IsShutdown( ) )
+        while ( ! pThread->IsShutdown( ) )
+        {
+            try
             {
-                try
-                {
-                    pNewSocket = m_pServerSocket->Accept();
-                }
-                catch ( CSocketException *pExcept )
-                {
-                    delete pExcept;
-                    pNewSocket = NULL;
-                }
-                catch ( ... )
+                pNewSocket = pSocket->Accept();
+            }
+            catch ( CSocketException *pExcept )
+            {
+                delete pExcept;
+                pNewSocket = NULL;
+            }
+            catch ( ... )
+            {
+                pNewSocket = NULL;
+            }
+
+            try
+            {
+                if ( ( pNewSocket ) && ( pNewSocket->IsConnected() ) )
                 {
-                    pNewSocket = NULL;
+                    HandleConnection( pNewSocket );
                 }
-
-                try
+                else
                 {
-                    if ( ( pNewSocket ) && ( pNewSocket->IsConnected() ) )
-                    {
-                        HandleConnection( pNewSocket );
-                    }
-                    else
+                    if ( pNewSocket )
                     {
-                        if ( pNewSocket )
-                        {
-                            delete pNewSocket;
-                        }
+                        delete pNewSocket;
                     }
                 }
-                catch ( ... )
-                {
-//                    ErrorLog( "%s: Unknown exception thrown.\n", (const char *)m_strThreadName );
-                }
             }
-            m_nReturnCode = 0;
+            catch ( ... )
+            {
+//                ErrorLog( "%s: Unknown exception thrown.\n", (const char *)m_strThreadName );
+            }
         }
-        else
+    }
+
+    /**
+     * CreateServerSocket
+     *
+     *      Opens one listening socket. With a single acceptor this is the
+     * plain server socket; with several, each shares the port through
+     * SO_REUSEPORT.
+     */
+    CServerSocket *CServerThread::CreateServerSocket( void )
+    {
+        if ( m_nAcceptors == 1 )
         {
-            m_nReturnCode = -1;
-            delete m_pServerSocket;
-            m_pServerSocket = NULL;
+            return new CServerSocket( m_nPortNumber, m_nMaxBacklog );
+        }
+
+        CSocketConfigBuilder builder;
+        builder.setBacklogSize( m_nMaxBacklog );
+            // Accepted sockets inherit the listener's buffers; keep the
+            // kernel's, as the single listener does.
+        builder.setReceiveBufferSize( 0 );
+        builder.setSendBufferSize( 0 );
+        builder.setReusePort( true );
+        builder.setBlocking( true );
+
+        CSocketConfig *pConfig = builder.build();
+        CServerSocket *pRetVal = NULL;
+
+        try
+        {
+            pRetVal = new CServerSocket( *pConfig, m_nPortNumber );
+        }
+        catch ( ... )
+        {
+            delete pConfig;
+            throw;
+        }
+
+        delete pConfig;
+
+        return pRetVal;
+    }
+
+    /**
+     * StopAcceptors
+     *
+     *      Shuts down the extra acceptors. Their listening sockets are shut
+     * down to wake them out of accept().
+     */
+    void CServerThread::StopAcceptors( void )
+    {
+        for ( size_t nX = 0; nX < m_aAcceptors.GetCount(); nX++ )
+        {
+            CServerAcceptorThread *pAcceptor = (CServerAcceptorThread *)m_aAcceptors[ nX ];
+
+            pAcceptor->RequestShutdown();
+    #ifdef IASLIB_WIN32__
+            shutdown( pAcceptor->GetServerSocket()->GetHandle(), SD_BOTH );
+    #else
+            shutdown( pAcceptor->GetServerSocket()->GetHandle(), SHUT_RDWR );
+    #endif
+            pAcceptor->Join();
         }
+        m_aAcceptors.DeleteAll();
+    }
+
+    CServerAcceptorThread::CServerAcceptorThread( CServerThread *pServer, CServerSocket *pServerSocket, size_t nAcceptorNumber ) : CThread( (const char *)CString::FormatString( "ServerAcceptor_%d", (int)nAcceptorNumber ), true, false, true )
+    {
+        m_pServer = pServer;
+        m_pServerSocket = pServerSocket;
+
+        Resume();
+    }
+
+    CServerAcceptorThread::~CServerAcceptorThread( void )
+    {
+        delete m_pServerSocket;
+    }
+
+    void *CServerAcceptorThread::Run( void )
+    {
+        m_pServer->AcceptConnections( m_pServerSocket, this );
 
         return NULL;
     }
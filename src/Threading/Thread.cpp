@@ -20,6 +20,8 @@
 #include "ThreadMonitor.h"
 #include "Mutex.h"
 #include "Object.h"
+#include "../Status/CPUUsage.h"
+#include "../Status/ThreadProfiler.h"
 
 #ifndef IASLIB_WIN32__
     #include <unistd.h>
@@ -43,7 +45,9 @@ extern "C"
         DWORD   *pRetVal = NULL;
 
         pThread->SetRunning( true );
+        IASLib::CThreadProfiler::SetThreadLabel( pThread->GetName() );
         pRetVal = (DWORD *)pThread->Run();
+        pThread->RecordCPUTime();
         pThread->SetRunning( false );
         if ( pRetVal )
             return *pRetVal;
@@ -69,6 +73,8 @@ extern "C"
 		pThread->m_mutexStartSuspended.Unlock();
 #endif
 
+        IASLib::CThreadProfiler::SetThreadLabel( pThread->GetName() );
+
         try
         {
             pRetVal = pThread->Run();
@@ -78,6 +84,7 @@ extern "C"
             //CObject::ErrorLog( "%x: Exception caught in Thread->Run", (long)pThreadObject );
         }
 
+        pThread->RecordCPUTime();
         pThread->SetRunning( false );
         return pRetVal;
     }
@@ -105,6 +112,7 @@ CThread::CThread( const char *strThreadName, bool bStartSuspended, bool bDetache
     m_bContained = false;
     m_bNoDelete = false;
     m_bDaemon = false;
+    m_ullCPUTime = 0;
     
 #ifdef IASLIB_PTHREAD__
     memset( &m_stAttributes, 0, sizeof( m_stAttributes ) );
@@ -266,6 +274,7 @@ CThread::CThread( THREAD_T ptThreadID, const char *strThreadName )
     m_nReturnCode = 0;
     m_bDetached = false;
     m_bContained = false;
+    m_ullCPUTime = 0;
 
     pMonitor = CThreadMonitor::GetThreadMonitor();
     pMonitor->AddThread( this, m_strThreadName );
@@ -476,6 +485,30 @@ bool CThread::Detach( void )
     return false;
 }
 
+/**
+ * GetCPUTime
+ *
+ *      The CPU time, in microseconds, the thread has used so far, or used
+ * in all, once it has finished running.
+ */
+unsigned long long CThread::GetCPUTime( void )
+{
+#ifdef IASLIB_MULTI_THREADED__
+    if ( m_bIsRunning )
+    {
+        return CCPUUsage::GetThreadTime( m_ptThreadID );
+    }
+#endif // IASLIB_MULTI_THREADED__
+    return m_ullCPUTime;
+}
+
+    // Called on the thread itself as Run() returns, to keep its CPU time
+    // for after the thread is gone.
+void CThread::RecordCPUTime( void )
+{
+    m_ullCPUTime = CCPUUsage::GetThreadTime();
+}
+
 void CThread::SetTimeout( int nSeconds )
 {
 #ifdef IASLIB_MULTI_THREADED__
@@ -442,8 +442,8 @@ const char *CThreadMonitor::GetThreadIdentifier( CThread *pThread )
 **
 **      Given an array index, this function returns a complete set of
 ** formatted data for the thread, including ID number, Name, and start
-** time for the thread. This is useful for displaying a list of currently
-** running threads on the system.
+** time for the thread, and the CPU time it has used. This is useful for
+** displaying a list of currently running threads on the system.
 **
 ***********************************************************************/
 CString CThreadMonitor::GetThreadData( int nThread )
@@ -452,6 +452,7 @@ CString CThreadMonitor::GetThreadData( int nThread )
     CString         strRetVal;
     CDate           dttNow;
     int             nElapsed;
+    int             nCPU;
     CString         strRunFlag;
 
     m_mutexArray.Lock();
@@ -472,13 +473,15 @@ CString CThreadMonitor::GetThreadData( int nThread )
             strRunFlag = "[";
         }
 
+        nCPU = (int)( pStorage->m_pThread->GetCPUTime() / 1000 );
+
         if ( pStorage->m_nTimeout > 0 )
         {
-            strRetVal.Format( "%s%4d] %-40s %-22s %5d.%03d (%5d.%03d)", (const char *)strRunFlag, pStorage->m_nThreadID, (const char *)pStorage->m_strIdentifier, (const char *)(pStorage->m_dttStartTime.PrettyDate() ), (nElapsed / 1000), (nElapsed % 1000), (pStorage->m_nTimeout / 1000), (pStorage->m_nTimeout % 1000) );
+            strRetVal.Format( "%s%4d] %-40s %-22s %5d.%03d cpu %5d.%03d (%5d.%03d)", (const char *)strRunFlag, pStorage->m_nThreadID, (const char *)pStorage->m_strIdentifier, (const char *)(pStorage->m_dttStartTime.PrettyDate() ), (nElapsed / 1000), (nElapsed % 1000), (nCPU / 1000), (nCPU % 1000), (pStorage->m_nTimeout / 1000), (pStorage->m_nTimeout % 1000) );
         }
         else
         {
-            strRetVal.Format( "%s%4d] %-40s %-22s %5d.%03d", (const char *)strRunFlag, pStorage->m_nThreadID, (const char *)pStorage->m_strIdentifier, (const char *)(pStorage->m_dttStartTime.PrettyDate() ), (nElapsed / 1000), (nElapsed % 1000) );
+            strRetVal.Format( "%s%4d] %-40s %-22s %5d.%03d cpu %5d.%03d", (const char *)strRunFlag, pStorage->m_nThreadID, (const char *)pStorage->m_strIdentifier, (const char *)(pStorage->m_dttStartTime.PrettyDate() ), (nElapsed / 1000), (nElapsed % 1000), (nCPU / 1000), (nCPU % 1000) );
         }
     }
     m_mutexArray.Unlock();
@@ -490,8 +493,8 @@ CString CThreadMonitor::GetThreadData( int nThread )
 **  GetThreadData method
 **
 **      Given a thread pointer, this function returns a complete set of
-** formatted data for the thread, including ID number, Name, and start
-** time for the thread. 
+** formatted data for the thread, including ID number, Name, start time
+** and CPU time for the thread.
 **
 ***********************************************************************/
 CString CThreadMonitor::GetThreadData( CThread *pThread )
@@ -501,6 +504,7 @@ CString CThreadMonitor::GetThreadData( CThread *pThread )
     CString         strRetVal;
     CDate           dttNow;
     int             nElapsed;
+    int             nCPU;
     CString         strRunFlag;
 
     m_mutexArray.Lock();
@@ -522,13 +526,15 @@ CString CThreadMonitor::GetThreadData( CThread *pThread )
                 strRunFlag = "[";
             }
 
+            nCPU = (int)( pStorage->m_pThread->GetCPUTime() / 1000 );
+
             if ( pStorage->m_nTimeout > 0 )
             {
-                strRetVal.Format( "%s%4d] %-40s %-22s %5d.%03d (%5d.%03d)", (const char *)strRunFlag, pStorage->m_nThreadID, (const char *)pStorage->m_strIdentifier, (const char *)(pStorage->m_dttStartTime.PrettyDate() ), (nElapsed / 1000), (nElapsed % 1000), (pStorage->m_nTimeout / 1000), (pStorage->m_nTimeout % 1000) );
+                strRetVal.Format( "%s%4d] %-40s %-22s %5d.%03d cpu %5d.%03d (%5d.%03d)", (const char *)strRunFlag, pStorage->m_nThreadID, (const char *)pStorage->m_strIdentifier, (const char *)(pStorage->m_dttStartTime.PrettyDate() ), (nElapsed / 1000), (nElapsed % 1000), (nCPU / 1000), (nCPU % 1000), (pStorage->m_nTimeout / 1000), (pStorage->m_nTimeout % 1000) );
             }
             else
             {
-                strRetVal.Format( "%s%4d] %-40s %-22s %5d.%03d", (const char *)strRunFlag, pStorage->m_nThreadID, (const char *)pStorage->m_strIdentifier, (const char *)(pStorage->m_dttStartTime.PrettyDate() ), (nElapsed / 1000), (nElapsed % 1000) );
+                strRetVal.Format( "%s%4d] %-40s %-22s %5d.%03d cpu %5d.%03d", (const char *)strRunFlag, pStorage->m_nThreadID, (const char *)pStorage->m_strIdentifier, (const char *)(pStorage->m_dttStartTime.PrettyDate() ), (nElapsed / 1000), (nElapsed % 1000), (nCPU / 1000), (nCPU % 1000) );
             }
             break;
         }
@@ -49,9 +49,37 @@
 #include "PooledThread.h"
 #include "Semaphore.h"
 #include "ThreadException.h"
+#include "../Stats/Metrics.h"
 
 namespace IASLib
 {
+#ifdef IASLIB_STATS__
+        // These are for all of the process' pools together.
+    static CGauge *QueuedTasks( void )
+    {
+        static CGauge *s_pGauge = CMetricsRegistry::GetInstance()->GetGauge( "iaslib_threadpool_queued_tasks", "Tasks waiting for a pooled thread." );
+        return s_pGauge;
+    }
+
+    static CGauge *ActiveThreads( void )
+    {
+        static CGauge *s_pGauge = CMetricsRegistry::GetInstance()->GetGauge( "iaslib_threadpool_active_threads", "Pooled threads running a task." );
+        return s_pGauge;
+    }
+
+    static CCounter *TasksAdded( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_threadpool_tasks_added_total", "Tasks given to thread pools." );
+        return s_pCounter;
+    }
+
+    static CCounter *TasksCompleted( void )
+    {
+        static CCounter *s_pCounter = CMetricsRegistry::GetInstance()->GetCounter( "iaslib_threadpool_tasks_completed_total", "Tasks finished by pooled threads." );
+        return s_pCounter;
+    }
+#endif
+
     class CQueueingThread : public CThread
     {
         private:
@@ -162,6 +190,9 @@ namespace IASLib
         }
         m_aAvailableThreads.EmptyAll();
         m_mutexArray.Unlock();
+#ifdef IASLIB_STATS__
+        QueuedTasks()->Add( -(long long)m_qTaskQueue.GetLength() );
+#endif
         m_qTaskQueue.DeleteAll();
     }
 
@@ -175,6 +206,10 @@ namespace IASLib
         {
             m_mutexArray.Lock();
             m_qTaskQueue.Push( task );
+#ifdef IASLIB_STATS__
+            QueuedTasks()->Add( 1 );
+            TasksAdded()->Add();
+#endif
             if ( m_aAvailableThreads.GetLength() )
                 retVal = true;
             m_mutexArray.Unlock();
@@ -221,6 +256,10 @@ namespace IASLib
                 {
                     m_nPeakThreads = m_nCurrentThreads;
                 }
+#ifdef IASLIB_STATS__
+                QueuedTasks()->Add( -1 );
+                ActiveThreads()->Add( 1 );
+#endif
 
                 workThread->SetTask( task );
                 retVal = true;
@@ -264,6 +303,10 @@ namespace IASLib
                     {
                         m_aBusyThreads.Remove( nX );
                         m_nCurrentThreads--;
+#ifdef IASLIB_STATS__
+                        ActiveThreads()->Add( -1 );
+                        TasksCompleted()->Add();
+#endif
                         break;
                     }
                 }
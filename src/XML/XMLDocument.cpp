@@ -49,6 +49,7 @@ namespace IASLib
 
     bool CXMLDocument::Read( CStream *pInput )
     {
+        CArenaScope                 scope( m_arena );
         m_pInput = pInput;
 
         char                        chCurrent;
@@ -0,0 +1,261 @@
+// MemoryManagerBench.cpp : Times the fixed-block memory manager against
+// the C library's malloc() on the sort of work strings make for it: lots
+// of short blocks coming and going, strings grown a piece at a time, and
+// a document's worth of tokens allocated and then dropped all at once.
+// Build the library with USE_MEMORY_MANAGER (and without USE_DEBUG, or
+// the debugging calls are what gets timed by the string stubs).
+//
+
+    // IASLib.h packs what it includes to single bytes, which the library
+    // itself isn't built with; the classes shared with it, or made here
+    // and used there, have to come in first with their real layouts.
+#include "MemoryManager/MemoryManager.h"
+#include "Threading/Thread.h"
+#include "Threading/Semaphore.h"
+#include "IASLib.h"
+#include <string.h>
+#include <stdio.h>
+using namespace IASLib;
+
+#ifdef IASLIB_MEMORY_MANAGER__
+
+struct Allocator
+{
+    void       *(*pfnAllocate)( size_t nSize );
+    void       *(*pfnReallocate)( void *p, size_t nSize );
+    void        (*pfnRelease)( void *p );
+};
+
+static void *ManagerAllocate( size_t nSize ) { return CMemoryManager::GetNewAllocator()->Allocate( nSize ); }
+static void *ManagerReallocate( void *p, size_t nSize ) { return CMemoryManager::GetNewAllocator()->Reallocate( p, nSize ); }
+static void ManagerRelease( void *p ) { CMemoryManager::GetNewAllocator()->Release( p ); }
+
+static const Allocator s_malloc = { malloc, realloc, free };
+static const Allocator s_manager = { ManagerAllocate, ManagerReallocate, ManagerRelease };
+
+    // Mostly short strings, a few paragraphs, the odd page.
+static size_t StringLength( unsigned int &nSeed )
+{
+    nSeed = nSeed * 1103515245 + 12345;
+    unsigned int nPick = ( nSeed >> 16 ) % 100;
+
+    nSeed = nSeed * 1103515245 + 12345;
+    unsigned int nRandom = nSeed >> 8;
+
+    if ( nPick < 80 )
+        return 8 + nRandom % 56;
+    if ( nPick < 97 )
+        return 64 + nRandom % 448;
+    return 512 + nRandom % 3584;
+}
+
+static size_t Churn( const Allocator &oAlloc, size_t nLive, size_t nSteps )
+{
+    void **apLive = (void **)calloc( nLive, sizeof( void * ) );
+    unsigned int nSeed = 1;
+    size_t nSink = 0;
+
+    for ( size_t nStep = 0; nStep < nSteps; nStep++ )
+    {
+        size_t nSlot = nStep % nLive;
+        size_t nSize = StringLength( nSeed );
+
+        oAlloc.pfnRelease( apLive[ nSlot ] );
+        apLive[ nSlot ] = oAlloc.pfnAllocate( nSize );
+        memset( apLive[ nSlot ], 'x', 8 );
+        nSink += ((char *)apLive[ nSlot ])[ 0 ];
+    }
+
+    for ( size_t nSlot = 0; nSlot < nLive; nSlot++ )
+    {
+        oAlloc.pfnRelease( apLive[ nSlot ] );
+    }
+    free( apLive );
+
+    return nSink;
+}
+
+static size_t Grow( const Allocator &oAlloc, size_t nStrings )
+{
+    unsigned int nSeed = 7;
+    size_t nSink = 0;
+
+    for ( size_t nString = 0; nString < nStrings; nString++ )
+    {
+        size_t nTarget = StringLength( nSeed ) * 4;
+        size_t nSize = 16;
+        char *pString = (char *)oAlloc.pfnAllocate( nSize );
+
+        for ( size_t nLength = 0; nLength < nTarget; nLength += 12 )
+        {
+            if ( nLength + 13 > nSize )
+            {
+                nSize += nSize / 2 + 13;
+                pString = (char *)oAlloc.pfnReallocate( pString, nSize );
+            }
+            memcpy( pString + nLength, "appended    ", 12 );
+        }
+
+        nSink += pString[ 0 ];
+        oAlloc.pfnRelease( pString );
+    }
+
+    return nSink;
+}
+
+static size_t Tokens( const Allocator &oAlloc, size_t nTokens, int nRounds )
+{
+    void **apTokens = (void **)malloc( nTokens * sizeof( void * ) );
+    unsigned int nSeed = 3;
+    size_t nSink = 0;
+
+    for ( int nRound = 0; nRound < nRounds; nRound++ )
+    {
+        for ( size_t nToken = 0; nToken < nTokens; nToken++ )
+        {
+            nSeed = nSeed * 1103515245 + 12345;
+            apTokens[ nToken ] = oAlloc.pfnAllocate( 4 + ( nSeed >> 16 ) % 28 );
+            *(char *)apTokens[ nToken ] = 't';
+        }
+
+        for ( size_t nToken = 0; nToken < nTokens; nToken++ )
+        {
+            nSink += *(char *)apTokens[ nToken ];
+            oAlloc.pfnRelease( apTokens[ nToken ] );
+        }
+    }
+    free( apTokens );
+
+    return nSink;
+}
+
+    // Set before the threads are made: a thread can be running before
+    // its constructor has finished, and Join() doesn't wait for one that
+    // hasn't got going yet, so they say when they're done as well.
+static const Allocator *s_pThreadAlloc = NULL;
+static CSemaphore *s_pThreadsDone = NULL;
+
+class CChurnThread : public CThread
+{
+    public:
+                            CChurnThread( void ) : CThread( "Churn", true, false, true ) {}
+
+        virtual void       *Run( void )
+        {
+            Churn( *s_pThreadAlloc, 2000, 500000 );
+            s_pThreadsDone->Post();
+            return NULL;
+        }
+};
+
+static void ChurnThreads( const Allocator &oAlloc, int nThreads )
+{
+    CChurnThread **apThreads = new CChurnThread *[ nThreads ];
+    CSemaphore semDone( 0 );
+
+    s_pThreadAlloc = &oAlloc;
+    s_pThreadsDone = &semDone;
+
+    for ( int nThread = 0; nThread < nThreads; nThread++ )
+    {
+        apThreads[ nThread ] = new CChurnThread();
+        apThreads[ nThread ]->Resume();
+    }
+
+    for ( int nThread = 0; nThread < nThreads; nThread++ )
+    {
+        semDone.Wait();
+    }
+
+    for ( int nThread = 0; nThread < nThreads; nThread++ )
+    {
+        apThreads[ nThread ]->Join();
+        delete apThreads[ nThread ];
+    }
+
+    delete [] apThreads;
+}
+
+static double Elapsed( CCPUUsage &oStart )
+{
+    CCPUUsage oEnd;
+    int nSec;
+    int nMicroSec;
+
+    oEnd.TotalElapsed( oStart, nSec, nMicroSec );
+    return nSec * 1000.0 + nMicroSec / 1000.0;
+}
+
+static void Report( const char *strName, double dMalloc, double dManager )
+{
+    printf( "%-34s %10.2f ms %10.2f ms %8.2fx\n", strName, dMalloc, dManager, ( dManager > 0.0 ) ? dMalloc / dManager : 0.0 );
+}
+
+int main( int argc, char **argv )
+{
+    int nScale = ( argc > 1 ) ? atoi( argv[1] ) : 1;
+    size_t nSink = 0;
+    double adTimes[ 2 ];
+
+    printf( "%-34s %13s %13s %9s\n", "", "malloc", "manager", "speedup" );
+
+    for ( int nPass = 0; nPass < 2; nPass++ )
+    {
+        CCPUUsage oStart;
+        nSink += Churn( ( nPass ) ? s_manager : s_malloc, 10000, 2000000 * nScale );
+        adTimes[ nPass ] = Elapsed( oStart );
+    }
+    Report( "Churn (10K live, 2M replaced)", adTimes[ 0 ], adTimes[ 1 ] );
+
+    for ( int nPass = 0; nPass < 2; nPass++ )
+    {
+        CCPUUsage oStart;
+        nSink += Grow( ( nPass ) ? s_manager : s_malloc, 200000 * nScale );
+        adTimes[ nPass ] = Elapsed( oStart );
+    }
+    Report( "Grow (200K strings, 1.5x steps)", adTimes[ 0 ], adTimes[ 1 ] );
+
+    for ( int nPass = 0; nPass < 2; nPass++ )
+    {
+        CCPUUsage oStart;
+        nSink += Tokens( ( nPass ) ? s_manager : s_malloc, 100000, 20 * nScale );
+        adTimes[ nPass ] = Elapsed( oStart );
+    }
+    Report( "Tokens (100K, 20 rounds)", adTimes[ 0 ], adTimes[ 1 ] );
+
+    for ( int nPass = 0; nPass < 2; nPass++ )
+    {
+        CCPUUsage oStart;
+        ChurnThreads( ( nPass ) ? s_manager : s_malloc, 4 );
+        adTimes[ nPass ] = Elapsed( oStart );
+    }
+    Report( "Churn (4 threads, 500K each)", adTimes[ 0 ], adTimes[ 1 ] );
+
+    CMemoryManager *pManager = CMemoryManager::GetNewAllocator();
+    pManager->Collect();
+    printf( "\nCompact() released %lu KB\n", (unsigned long)( pManager->Compact() / 1024 ) );
+    printf( "%6s %8s %12s %12s %8s %8s\n", "class", "size", "allocations", "releases", "in use", "slabs" );
+    for ( size_t nClass = 0; nClass < pManager->GetClassCount(); nClass++ )
+    {
+        CMemoryManager::HeapStats stats;
+
+        pManager->GetClassStats( nClass, stats );
+        if ( stats.m_ullAllocations )
+        {
+            printf( "%6lu %8lu %12llu %12llu %8lu %8lu\n", (unsigned long)nClass, (unsigned long)stats.m_nBlockSize,
+                    stats.m_ullAllocations, stats.m_ullReleases, (unsigned long)stats.m_nInUse, (unsigned long)stats.m_nSlabs );
+        }
+    }
+
+    return ( nSink == 0 ) ? 1 : 0;
+}
+
+#else
+
+int main( int argc, char **argv )
+{
+    printf( "The library was built without the memory manager (USE_MEMORY_MANAGER).\n" );
+    return 0;
+}
+
+#endif
@@ -0,0 +1,143 @@
+// StringSearchBench.cpp : Times CString's searches against the way they
+// used to be done (strstr, lower-cased copies, and Replace() starting over
+// after every substitution), and the vector searches against the plain
+// byte loops.
+//
+
+#include "IASLib.h"
+#include <string.h>
+#include <stdio.h>
+using namespace IASLib;
+
+static size_t LegacyIndexOf( const CString &strHaystack, const char *strSearch, bool bCaseInsensitive )
+{
+    const char *pFound;
+
+    if ( bCaseInsensitive )
+    {
+        CString strCopy = strHaystack;
+        CString strSearchCopy = strSearch;
+
+        strCopy.ToLowerCase();
+        strSearchCopy.ToLowerCase();
+        pFound = strstr( (const char *)strCopy, (const char *)strSearchCopy );
+        return ( pFound ) ? (size_t)( pFound - (const char *)strCopy ) : NOT_FOUND;
+    }
+
+    pFound = strstr( (const char *)strHaystack, strSearch );
+    return ( pFound ) ? (size_t)( pFound - (const char *)strHaystack ) : NOT_FOUND;
+}
+
+static size_t LegacyIndexOfChar( const CString &strHaystack, char chSearch )
+{
+    const char *pData = strHaystack;
+    size_t nCount;
+
+    for ( nCount = 0; ( nCount < strHaystack.GetLength() ) && ( pData[ nCount ] != chSearch ); nCount++ );
+
+    return ( nCount == strHaystack.GetLength() ) ? NOT_FOUND : nCount;
+}
+
+static void LegacyReplace( CString &strTarget, const char *strReplace, const char *strTo )
+{
+    size_t nReplacePoint;
+    size_t nReplaceLength = strlen( strReplace );
+    CString strTemp;
+
+    while ( ( nReplacePoint = LegacyIndexOf( strTarget, strReplace, false ) ) != NOT_FOUND )
+    {
+        strTemp = strTarget.Substring( 0, (int)nReplacePoint );
+        strTemp += strTo;
+        strTemp += strTarget.Substring( nReplacePoint + nReplaceLength );
+        strTarget = strTemp;
+    }
+}
+
+static double Elapsed( CCPUUsage &oStart )
+{
+    CCPUUsage oEnd;
+    int nSec;
+    int nMicroSec;
+
+    oEnd.TotalElapsed( oStart, nSec, nMicroSec );
+    return nSec * 1000.0 + nMicroSec / 1000.0;
+}
+
+static void Report( const char *strName, double dLegacy, double dCurrent )
+{
+    printf( "%-34s %10.2f ms %10.2f ms %8.1fx\n", strName, dLegacy, dCurrent, ( dCurrent > 0.0 ) ? dLegacy / dCurrent : 0.0 );
+}
+
+int main( int argc, char **argv )
+{
+    int nRepeat = ( argc > 1 ) ? atoi( argv[1] ) : 200;
+    size_t nLength = 1 << 16;
+    CString strHaystack;
+    volatile size_t nSink = 0;
+        // Through volatiles, so the searches can't be hoisted out of the loops
+    const char * volatile strNeedle = "Needle in";
+    const char * volatile strNeedleUpper = "NEEDLE IN";
+
+        // Text that's mostly near misses for the needle
+    strHaystack.Reserve( nLength );
+    while ( strHaystack.GetLength() < nLength )
+    {
+        strHaystack += "abcdefgh nedle NEEDLX ";
+    }
+    CString strFind = strHaystack + "Needle in the haystack#";
+
+    printf( "%-34s %13s %13s %9s\n", "", "legacy", "current", "speedup" );
+
+    for ( int nPass = 0; nPass < 2; nPass++ )
+    {
+        CStringSearch::SetAcceleration( nPass == 1 );
+        printf( "-- %s --\n", CStringSearch::GetImplementation() );
+
+        CCPUUsage oStart;
+        for ( int nX = 0; nX < nRepeat; nX++ )
+            nSink += LegacyIndexOf( strFind, strNeedle, false );
+        double dLegacy = Elapsed( oStart );
+        CCPUUsage oStart2;
+        for ( int nX = 0; nX < nRepeat; nX++ )
+            nSink += strFind.IndexOf( strNeedle );
+        Report( "IndexOf (64KB, case sensitive)", dLegacy, Elapsed( oStart2 ) );
+
+        CCPUUsage oStart3;
+        for ( int nX = 0; nX < nRepeat; nX++ )
+            nSink += LegacyIndexOf( strFind, strNeedleUpper, true );
+        dLegacy = Elapsed( oStart3 );
+        CCPUUsage oStart4;
+        for ( int nX = 0; nX < nRepeat; nX++ )
+            nSink += strFind.IndexOf( strNeedleUpper, 0, true );
+        Report( "IndexOf (64KB, case insensitive)", dLegacy, Elapsed( oStart4 ) );
+
+        CCPUUsage oStart5;
+        for ( int nX = 0; nX < nRepeat; nX++ )
+            nSink += LegacyIndexOfChar( strFind, '#' );
+        dLegacy = Elapsed( oStart5 );
+        CCPUUsage oStart6;
+        for ( int nX = 0; nX < nRepeat; nX++ )
+            nSink += strFind.IndexOf( '#' );
+        Report( "IndexOf (64KB, character)", dLegacy, Elapsed( oStart6 ) );
+
+        CString strSmall = strHaystack.Substring( 0, 16384 );
+        CCPUUsage oStart7;
+        for ( int nX = 0; nX < nRepeat / 20 + 1; nX++ )
+        {
+            CString strWork = strSmall;
+            LegacyReplace( strWork, "nedle", "needle" );
+            nSink += strWork.GetLength();
+        }
+        dLegacy = Elapsed( oStart7 );
+        CCPUUsage oStart8;
+        for ( int nX = 0; nX < nRepeat / 20 + 1; nX++ )
+        {
+            CString strWork = strSmall;
+            strWork.Replace( "nedle", "needle" );
+            nSink += strWork.GetLength();
+        }
+        Report( "Replace (16KB, every 22 bytes)", dLegacy, Elapsed( oStart8 ) );
+    }
+
+    return ( nSink == 0 ) ? 1 : 0;
+}
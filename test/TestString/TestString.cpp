@@ -0,0 +1,136 @@
+// TestString.cpp : Checks the CString matching and editing semantics that
+// changed when the searches moved to CStringSearch: wildcard patterns,
+// single-pass Replace(), and Remove() keeping the length right.
+//
+
+#include "IASLib.h"
+#include <iostream>
+using namespace IASLib;
+
+static int g_nFailures = 0;
+
+    // ASSERT only prints, and only in debug builds; the test has to fail
+#define TEST_CHECK(x) { if ( !(x) ) { std::cout << "FAILED: " << #x << " - " << __FILE__ << ":" << __LINE__ << std::endl; g_nFailures++; } }
+
+bool testWildcardCompare() {
+    int nFailures = g_nFailures;
+
+    std::cout << "TESTING CString::WildcardCompare" << std::endl;
+
+    CString strText = "SIP/2.0 200 OK";
+
+    // -- TRAILING STAR --
+    TEST_CHECK( strText.WildcardCompare( "SIP/*" ) );
+    TEST_CHECK( strText.WildcardCompare( "SIP/2.0 200 OK*" ) );
+    TEST_CHECK( strText.WildcardCompare( "*" ) );
+    TEST_CHECK( strText.WildcardCompare( "SIP/2.0 200 OK**" ) );
+    TEST_CHECK( ! strText.WildcardCompare( "HTTP/*" ) );
+
+    // -- STAR ON BOTH ENDS --
+    TEST_CHECK( strText.WildcardCompare( "*200*" ) );
+    TEST_CHECK( strText.WildcardCompare( "*SIP*" ) );
+    TEST_CHECK( strText.WildcardCompare( "*OK*" ) );
+    TEST_CHECK( ! strText.WildcardCompare( "*404*" ) );
+    TEST_CHECK( strText.WildcardCompare( "*ok*", false ) );
+    TEST_CHECK( ! strText.WildcardCompare( "*ok*" ) );
+
+    // -- BACKTRACKING --
+    CString strRepeat = "aaab";
+    TEST_CHECK( strRepeat.WildcardCompare( "*ab" ) );
+    TEST_CHECK( strRepeat.WildcardCompare( "a*a*b" ) );
+    TEST_CHECK( strRepeat.WildcardCompare( "?a?b" ) );
+    TEST_CHECK( ! strRepeat.WildcardCompare( "*ba" ) );
+
+    CString strEmpty;
+    TEST_CHECK( strEmpty.WildcardCompare( "*" ) );
+    TEST_CHECK( ! strEmpty.WildcardCompare( "*x*" ) );
+
+    std::cout << "WildcardCompare testing complete." << std::endl << std::endl;
+    return ( nFailures == g_nFailures );
+}
+
+bool testReplace() {
+    int nFailures = g_nFailures;
+
+    std::cout << "TESTING CString::Replace" << std::endl;
+
+    // -- REPLACEMENT CONTAINS THE SEARCH (used to loop forever) --
+    CString strText = "a-b-c";
+    strText.Replace( "-", "--" );
+    TEST_CHECK( strText == "a--b--c" );
+    TEST_CHECK( strText.GetLength() == 7 );
+
+    strText = "xx";
+    strText.Replace( "x", "axa" );
+    TEST_CHECK( strText == "axaaxa" );
+
+    // -- SHRINKING, IN PLACE --
+    strText = "one, two, three";
+    strText.Replace( ", ", "," );
+    TEST_CHECK( strText == "one,two,three" );
+    TEST_CHECK( strText.GetLength() == 13 );
+
+    // -- NO MATCH, AND REMOVING A SUBSTRING --
+    strText = "unchanged";
+    strText.Replace( "zz", "y" );
+    TEST_CHECK( strText == "unchanged" );
+
+    strText = "\r\nline\r\n";
+    strText.Remove( "\r\n" );
+    TEST_CHECK( strText == "line" );
+    TEST_CHECK( strText.GetLength() == 4 );
+
+    // -- A COPY IS NOT CHANGED --
+    CString strOriginal = "a.b";
+    CString strCopy = strOriginal;
+    strCopy.Replace( ".", "::" );
+    TEST_CHECK( strCopy == "a::b" );
+    TEST_CHECK( strOriginal == "a.b" );
+
+    std::cout << "Replace testing complete." << std::endl << std::endl;
+    return ( nFailures == g_nFailures );
+}
+
+bool testRemoveChar() {
+    int nFailures = g_nFailures;
+
+    std::cout << "TESTING CString::Remove( char )" << std::endl;
+
+    CString strText = "1,234,567";
+    strText.Remove( ',' );
+    TEST_CHECK( strText == "1234567" );
+    TEST_CHECK( strText.GetLength() == 7 );
+
+    strText = ",,,";
+    strText.Remove( ',' );
+    TEST_CHECK( strText.GetLength() == 0 );
+
+    strText = "abc";
+    strText.Remove( 'z' );
+    TEST_CHECK( strText == "abc" );
+    TEST_CHECK( strText.GetLength() == 3 );
+
+    // The new length has to hold for what comes after, too
+    strText = "a b c";
+    strText.Remove( ' ' );
+    strText += "d";
+    TEST_CHECK( strText == "abcd" );
+    TEST_CHECK( strText.IndexOf( 'd' ) == 3 );
+
+    std::cout << "Remove testing complete." << std::endl << std::endl;
+    return ( nFailures == g_nFailures );
+}
+
+int main( void )
+{
+    testWildcardCompare();
+    testReplace();
+    testRemoveChar();
+
+    if ( g_nFailures )
+    {
+        std::cout << g_nFailures << " check(s) failed." << std::endl;
+        return 1;
+    }
+    return 0;
+}